@@ -82,7 +82,7 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
 #endif //JVET_P2008_OUTPUT_LOG
 
 #if ENABLE_SIMD_OPT
-  ("SIMD",                      ignore,                                string(""), "SIMD extension to use (SCALAR, SSE41, SSE42, AVX, AVX2, AVX512), default: the highest supported extension\n")
+  ("SIMD",                      ignore,                                string(""), "SIMD extension to use (SCALAR, SSE41, SSE42, AVX, AVX2, AVX512), default: the extension set by the environment variable VTM_SIMD or the highest supported one\n")
 #endif
 
   ("WarnUnknowParameter,w",     warnUnknowParameter,                   0,          "warn for unknown configuration parameters instead of failing")
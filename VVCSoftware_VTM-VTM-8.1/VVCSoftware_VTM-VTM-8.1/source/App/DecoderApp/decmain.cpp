@@ -70,6 +70,9 @@ int main(int argc, char* argv[])
   fprintf( stdout, "[ENABLE_TRACING] " );
 #endif
   fprintf( stdout, "\n" );
+#if ENABLE_SIMD_OPT
+  fprintf( stdout, "SIMD kernels: %s\n", read_x86_kernel_tiers().c_str() );
+#endif
 
   DecApp *pcDecApp = new DecApp;
   // parse configuration
@@ -113,6 +113,9 @@ int main(int argc, char* argv[])
   fprintf( stdout, "]" );
 #endif
   fprintf( stdout, "\n" );
+#if ENABLE_SIMD_OPT
+  fprintf( stdout, "SIMD kernels: %s\n", read_x86_kernel_tiers().c_str() );
+#endif
 
   std::fstream bitstream;
   EncLibCommon encLibCommon;
@@ -68,6 +68,7 @@ AdaptiveLoopFilter::AdaptiveLoopFilter()
 #endif
   m_filter5x5Blk = filterBlk<ALF_FILTER_5>;
   m_filter7x7Blk = filterBlk<ALF_FILTER_7>;
+  m_accumulateCovariance = accumulateCovarianceCore;
 
 #if ENABLE_SIMD_OPT_ALF
 #ifdef TARGET_SIMD_X86
@@ -1445,3 +1446,21 @@ void AdaptiveLoopFilter::filterBlkCcAlf(const PelBuf &dstBuf, const CPelUnitBuf
   }
 }
 #endif
+
+void AdaptiveLoopFilter::accumulateCovarianceCore( const int16_t* features, const int numSamples, const int numFeatures, const int groupSize, int* sums )
+{
+  for( int s = 0; s < numSamples; s++ )
+  {
+    const int16_t* f = features + s * MaxAlfCovFeatures;
+
+    for( int m = 0; m < numFeatures; m++ )
+    {
+      int* sumsRow = sums + m * MaxAlfCovFeatures;
+
+      for( int n = m - m % groupSize; n < numFeatures; n++ )
+      {
+        sumsRow[n] += f[m] * f[n];
+      }
+    }
+  }
+}
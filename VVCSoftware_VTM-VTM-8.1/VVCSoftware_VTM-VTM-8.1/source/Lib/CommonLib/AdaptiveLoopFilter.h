@@ -74,11 +74,16 @@ public:
 
   static constexpr int AlfNumClippingValues[MAX_NUM_CHANNEL_TYPE] = { 4, 4 };
   static constexpr int MaxAlfNumClippingValues = 4;
+  // encoder statistics: luma coefficients of all clipping values and the sample error, padded to a multiple of 8
+  static constexpr int MaxAlfCovFeatures = MAX_NUM_ALF_LUMA_COEFF * MaxAlfNumClippingValues + 4;
 
   static constexpr int   m_NUM_BITS = 8;
   static constexpr int   m_CLASSIFICATION_BLK_SIZE = 32;  //non-normative, local buffer size
   static constexpr int m_ALF_UNUSED_CLASSIDX = 255;
   static constexpr int m_ALF_UNUSED_TRANSPOSIDX = 255;
+#if JVET_Q0795_CCALF
+  static constexpr int   m_scaleBits = 7; // 8-bits
+#endif
 
   AdaptiveLoopFilter();
   virtual ~AdaptiveLoopFilter() {}
@@ -127,6 +132,11 @@ public:
                          const short *fClipSet, const ClpRng &clpRng, CodingStructure &cs, const int vbCTUHeight,
                          int vbPos);
 
+  // encoder statistics, adds the products f[m] * f[n] of the features of numSamples samples (stride MaxAlfCovFeatures,
+  // zero padded to a multiple of 8) to sums[m * MaxAlfCovFeatures + n] for n >= m rounded down to a multiple of groupSize
+  static void accumulateCovarianceCore( const int16_t* features, const int numSamples, const int numFeatures, const int groupSize, int* sums );
+  void (*m_accumulateCovariance)( const int16_t* features, const int numSamples, const int numFeatures, const int groupSize, int* sums );
+
 #ifdef TARGET_SIMD_X86
   void initAdaptiveLoopFilterX86();
   template <X86_VEXT vext>
@@ -136,7 +146,6 @@ public:
 protected:
   bool isCrossedByVirtualBoundaries( const CodingStructure& cs, const int xPos, const int yPos, const int width, const int height, bool& clipTop, bool& clipBottom, bool& clipLeft, bool& clipRight, int& numHorVirBndry, int& numVerVirBndry, int horVirBndryPos[], int verVirBndryPos[], int& rasterSliceAlfPad );
 #if JVET_Q0795_CCALF
-  static constexpr int   m_scaleBits = 7; // 8-bits
   CcAlfFilterParam       m_ccAlfFilterParam;
   uint8_t*               m_ccAlfFilterControl[2];
 #endif
@@ -281,6 +281,146 @@ void linTfCore( const T* src, int srcStride, Pel *dst, int dstStride, int width,
 #undef LINTF_CORE_INC
 }
 
+// explicit weighted prediction of WeightPrediction (U0040 rounding and clipping)
+template<typename T>
+void wghtBiCore( const T* src0, int src0Stride, const T* src1, int src1Stride, Pel *dst, int dstStride, int width, int height, int w0, int w1, int round, int shift, int offset, const ClpRng& clpRng )
+{
+#define WGHT_BI_CORE_OP( ADDR ) dst[ADDR] = ClipPel( ( w0 * ( src0[ADDR] + IF_INTERNAL_OFFS ) + w1 * ( src1[ADDR] + IF_INTERNAL_OFFS ) + round + ( offset << ( shift - 1 ) ) ) >> shift, clpRng )
+#define WGHT_BI_CORE_INC  \
+  src0 += src0Stride;     \
+  src1 += src1Stride;     \
+  dst  += dstStride;      \
+
+  SIZE_AWARE_PER_EL_OP( WGHT_BI_CORE_OP, WGHT_BI_CORE_INC );
+
+#undef WGHT_BI_CORE_OP
+#undef WGHT_BI_CORE_INC
+}
+
+template<typename T>
+void wghtUniCore( const T* src0, int src0Stride, Pel *dst, int dstStride, int width, int height, int w0, int round, int shift, int offset, const ClpRng& clpRng )
+{
+#define WGHT_UNI_CORE_OP( ADDR ) dst[ADDR] = ClipPel( ( ( w0 * ( src0[ADDR] + IF_INTERNAL_OFFS ) + round ) >> shift ) + offset, clpRng )
+#define WGHT_UNI_CORE_INC \
+  src0 += src0Stride;     \
+  dst  += dstStride;      \
+
+  SIZE_AWARE_PER_EL_OP( WGHT_UNI_CORE_OP, WGHT_UNI_CORE_INC );
+
+#undef WGHT_UNI_CORE_OP
+#undef WGHT_UNI_CORE_INC
+}
+
+// luma mapping with the forward or inverse LUT of the reshaper
+void applyLutCore( Pel* ptr, int stride, int width, int height, const Pel* lut )
+{
+#define APPLY_LUT_CORE_OP( ADDR ) ptr[ADDR] = lut[ptr[ADDR]]
+#define APPLY_LUT_CORE_INC ptr += stride;
+
+  SIZE_AWARE_PER_EL_OP( APPLY_LUT_CORE_OP, APPLY_LUT_CORE_INC );
+
+#undef APPLY_LUT_CORE_OP
+#undef APPLY_LUT_CORE_INC
+}
+
+// forward chroma residual scaling (encoder side)
+void scaleSignalFwdCore( Pel* ptr, int stride, int width, int height, int scale, const ClpRng& clpRng )
+{
+  const int maxAbsclipBD = ( 1 << clpRng.bd ) - 1;
+
+  for( int y = 0; y < height; y++, ptr += stride )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const int sign   = ptr[x] >= 0 ? 1 : -1;
+      const int absval = sign * ptr[x];
+      ptr[x] = ( Pel ) Clip3( -maxAbsclipBD, maxAbsclipBD, sign * ( ( ( absval << CSCALE_FP_PREC ) + ( scale >> 1 ) ) / scale ) );
+    }
+  }
+}
+
+// inverse chroma residual scaling
+void scaleSignalInvCore( Pel* ptr, int stride, int width, int height, int scale, const ClpRng& clpRng )
+{
+  const int maxAbsclipBD = ( 1 << clpRng.bd ) - 1;
+
+  for( int y = 0; y < height; y++, ptr += stride )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const Pel val    = Clip3( ( Pel ) ( -maxAbsclipBD - 1 ), ( Pel ) maxAbsclipBD, ptr[x] );
+      const int sign   = val >= 0 ? 1 : -1;
+      const int absval = sign * val;
+      ptr[x] = ( Pel ) Clip3<int>( -32768, 32767, sign * ( ( absval * scale + ( 1 << ( CSCALE_FP_PREC - 1 ) ) ) >> CSCALE_FP_PREC ) );
+    }
+  }
+}
+
+// conversion of 8 bit or 16 bit little-endian file samples of a line, dst[x] = src[( x << sxDown ) >> sxUp]
+void unpackSamplesCore( const uint8_t* src, Pel* dst, int width, bool is16bit, int sxDown, int sxUp )
+{
+  if( !is16bit )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      dst[x] = src[( x << sxDown ) >> sxUp];
+    }
+  }
+  else
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const int pos = ( x << sxDown ) >> sxUp;
+      dst[x] = Pel( src[pos * 2 + 0] ) | ( Pel( src[pos * 2 + 1] ) << 8 );
+    }
+  }
+}
+
+// bit depth scaling of a sample as in VideoIOYuv, shiftbits > 0 multiplies, shiftbits < 0 divides with rounding and clips
+static inline Pel scaleSample( const Pel val, const int shiftbits, const Pel minval, const Pel maxval )
+{
+  if( shiftbits > 0 )
+  {
+    return val << shiftbits;
+  }
+  else if( shiftbits < 0 )
+  {
+    return Clip3( minval, maxval, Pel( ( val + ( 1 << ( -shiftbits - 1 ) ) ) >> -shiftbits ) );
+  }
+  return val;
+}
+
+void packSamplesCore( const Pel* src, uint8_t* dst, int width, bool is16bit, int shiftbits, Pel minval, Pel maxval )
+{
+  if( !is16bit )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      dst[x] = ( uint8_t ) scaleSample( src[x], shiftbits, minval, maxval );
+    }
+  }
+  else
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const Pel val = scaleSample( src[x], shiftbits, minval, maxval );
+      dst[2 * x    ] = ( val >> 0 ) & 0xff;
+      dst[2 * x + 1] = ( val >> 8 ) & 0xff;
+    }
+  }
+}
+
+void scaleSamplesCore( Pel* ptr, int stride, int width, int height, int shiftbits, Pel minval, Pel maxval )
+{
+  for( int y = 0; y < height; y++, ptr += stride )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      ptr[x] = scaleSample( ptr[x], shiftbits, minval, maxval );
+    }
+  }
+}
+
 PelBufferOps::PelBufferOps()
 {
   addAvg4 = addAvgCore<Pel>;
@@ -292,9 +432,23 @@ PelBufferOps::PelBufferOps()
   linTf4 = linTfCore<Pel>;
   linTf8 = linTfCore<Pel>;
 
+  wghtBi4  = wghtBiCore<Pel>;
+  wghtBi8  = wghtBiCore<Pel>;
+  wghtUni4 = wghtUniCore<Pel>;
+  wghtUni8 = wghtUniCore<Pel>;
+
+  applyLut       = applyLutCore;
+  scaleSignalFwd = scaleSignalFwdCore;
+  scaleSignalInv = scaleSignalInvCore;
+
+  unpackSamples = unpackSamplesCore;
+  packSamples   = packSamplesCore;
+  scaleSamples  = scaleSamplesCore;
+
   addBIOAvg4      = addBIOAvgCore;
   bioGradFilter   = gradFilterCore;
-  calcBIOSums = calcBIOSumsCore;
+  calcBIOSums     = calcBIOSumsCore;
+  calcBlkGradient = calcBlkGradientCore;
 
   copyBuffer = copyBufferCore;
   padding = paddingCore;
@@ -379,6 +533,13 @@ void AreaBuf<Pel>::addWeightedAvg(const AreaBuf<const Pel> &other1, const AreaBu
 template<>
 void AreaBuf<Pel>::rspSignal(std::vector<Pel>& pLUT)
 {
+#if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
+  if( ( width & 3 ) == 0 )
+  {
+    g_pelBufOP.applyLut( buf, stride, width, height, pLUT.data() );
+    return;
+  }
+#endif
   Pel* dst = buf;
   Pel* src = buf;
     for (unsigned y = 0; y < height; y++)
@@ -406,6 +567,12 @@ void AreaBuf<Pel>::scaleSignal(const int scale, const bool dir, const ClpRng& cl
     {
       THROW("Blocks of width = 1 not supported");
     }
+#if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
+    else if( ( width & 3 ) == 0 )
+    {
+      g_pelBufOP.scaleSignalFwd( buf, stride, width, height, scale, clpRng );
+    }
+#endif
     else
     {
       for (unsigned y = 0; y < height; y++)
@@ -421,6 +588,12 @@ void AreaBuf<Pel>::scaleSignal(const int scale, const bool dir, const ClpRng& cl
       }
     }
   }
+#if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
+  else if( ( width & 3 ) == 0 )
+  {
+    g_pelBufOP.scaleSignalInv( buf, stride, width, height, scale, clpRng );
+  }
+#endif
   else // inverse
   {
     for (unsigned y = 0; y < height; y++)
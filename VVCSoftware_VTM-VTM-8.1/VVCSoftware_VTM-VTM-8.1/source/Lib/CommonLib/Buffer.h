@@ -67,6 +67,16 @@ struct PelBufferOps
   void ( *reco8 )         ( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height,                                   const ClpRng& clpRng );
   void ( *linTf4 )        ( const Pel* src0, int src0Stride,                                  Pel *dst, int dstStride, int width, int height, int scale, int shift, int offset, const ClpRng& clpRng, bool bClip );
   void ( *linTf8 )        ( const Pel* src0, int src0Stride,                                  Pel *dst, int dstStride, int width, int height, int scale, int shift, int offset, const ClpRng& clpRng, bool bClip );
+  void ( *wghtBi4 )       ( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height, int w0, int w1, int round, int shift, int offset, const ClpRng& clpRng );
+  void ( *wghtBi8 )       ( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height, int w0, int w1, int round, int shift, int offset, const ClpRng& clpRng );
+  void ( *wghtUni4 )      ( const Pel* src0, int src0Stride,                                  Pel *dst, int dstStride, int width, int height, int w0,         int round, int shift, int offset, const ClpRng& clpRng );
+  void ( *wghtUni8 )      ( const Pel* src0, int src0Stride,                                  Pel *dst, int dstStride, int width, int height, int w0,         int round, int shift, int offset, const ClpRng& clpRng );
+  void ( *applyLut )      ( Pel* ptr, int stride, int width, int height, const Pel* lut );
+  void ( *scaleSignalFwd )( Pel* ptr, int stride, int width, int height, int scale, const ClpRng& clpRng );
+  void ( *scaleSignalInv )( Pel* ptr, int stride, int width, int height, int scale, const ClpRng& clpRng );
+  void ( *unpackSamples ) ( const uint8_t* src, Pel* dst, int width, bool is16bit, int sxDown, int sxUp );
+  void ( *packSamples )   ( const Pel* src, uint8_t* dst, int width, bool is16bit, int shiftbits, Pel minval, Pel maxval );
+  void ( *scaleSamples )  ( Pel* ptr, int stride, int width, int height, int shiftbits, Pel minval, Pel maxval );
   void(*addBIOAvg4)    (const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, const Pel *gradX0, const Pel *gradX1, const Pel *gradY0, const Pel*gradY1, int gradStride, int width, int height, int tmpx, int tmpy, int shift, int offset, const ClpRng& clpRng);
   void(*bioGradFilter) (Pel* pSrc, int srcStride, int width, int height, int gradStride, Pel* gradX, Pel* gradY, const int bitDepth);
   void(*calcBIOPar)    (const Pel* srcY0Temp, const Pel* srcY1Temp, const Pel* gradX0, const Pel* gradX1, const Pel* gradY0, const Pel* gradY1, int* dotProductTemp1, int* dotProductTemp2, int* dotProductTemp3, int* dotProductTemp5, int* dotProductTemp6, const int src0Stride, const int src1Stride, const int gradStride, const int widthG, const int heightG, const int bitDepth);
@@ -89,6 +99,9 @@ extern PelBufferOps g_pelBufOP;
 
 void paddingCore(Pel *ptr, int stride, int width, int height, int padSize);
 void copyBufferCore(Pel *src, int srcStride, Pel *Dst, int dstStride, int width, int height);
+void unpackSamplesCore( const uint8_t* src, Pel* dst, int width, bool is16bit, int sxDown, int sxUp );
+void packSamplesCore( const Pel* src, uint8_t* dst, int width, bool is16bit, int shiftbits, Pel minval, Pel maxval );
+void scaleSamplesCore( Pel* ptr, int stride, int width, int height, int shiftbits, Pel minval, Pel maxval );
 
 template<typename T>
 struct AreaBuf : public Size
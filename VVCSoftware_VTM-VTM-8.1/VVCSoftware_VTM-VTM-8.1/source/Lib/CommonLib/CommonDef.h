@@ -644,6 +644,10 @@ typedef enum{
   AVX2,
   AVX512
 } X86_VEXT;
+// instruction set extensions that are not implied by the X86_VEXT level
+typedef enum{
+  X86_FEATURE_PCLMUL = 1 << 0
+} X86_FEATURE;
 #elif defined (__ARM_NEON__)
 #define TARGET_SIMD_ARM 1
 #else
@@ -653,6 +657,8 @@ typedef enum{
 #ifdef TARGET_SIMD_X86
 X86_VEXT read_x86_extension_flags(const std::string &extStrId = std::string());
 const char* read_x86_extension(const std::string &extStrId);
+unsigned    read_x86_feature_flags();    // X86_FEATURE flags of the CPU
+std::string read_x86_kernel_tiers();   // extension used by each kernel family
 #endif
 
 #endif //ENABLE_SIMD_OPT
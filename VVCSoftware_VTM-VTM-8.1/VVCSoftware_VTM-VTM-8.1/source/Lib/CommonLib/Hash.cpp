@@ -46,8 +46,10 @@
  // ====================================================================================================================
 
 int TComHash::m_blockSizeToIndex[65][65];
-TCRCCalculatorLight TComHash::m_crcCalculator1(24, 0x5D6DCB);
-TCRCCalculatorLight TComHash::m_crcCalculator2(24, 0x864CFB);
+TCRCCalculatorLight TComHash::m_crcCalculator1(24, m_crcPoly1);
+TCRCCalculatorLight TComHash::m_crcCalculator2(24, m_crcPoly2);
+uint32_t (*TComHash::m_getCRCValue1)(unsigned char* p, int length) = TComHash::getCRCValue1Core;
+uint32_t (*TComHash::m_getCRCValue2)(unsigned char* p, int length) = TComHash::getCRCValue2Core;
 
 TCRCCalculatorLight::TCRCCalculatorLight(uint32_t bits, uint32_t truncPoly)
 {
@@ -113,6 +115,12 @@ TComHash::TComHash()
   {
     hashPic[i] = NULL;
   }
+
+#if ENABLE_SIMD_OPT_IBC
+#ifdef TARGET_SIMD_X86
+  initTComHashX86();
+#endif
+#endif
 }
 
 TComHash::~TComHash()
@@ -699,14 +707,14 @@ void TComHash::initBlockSizeToIndex()
   m_blockSizeToIndex[4][4] = 4;
 }
 
-uint32_t TComHash::getCRCValue1(unsigned char* p, int length)
+uint32_t TComHash::getCRCValue1Core(unsigned char* p, int length)
 {
   m_crcCalculator1.reset();
   m_crcCalculator1.processData(p, length);
   return m_crcCalculator1.getCRC();
 }
 
-uint32_t TComHash::getCRCValue2(unsigned char* p, int length)
+uint32_t TComHash::getCRCValue2Core(unsigned char* p, int length)
 {
   m_crcCalculator2.reset();
   m_crcCalculator2.processData(p, length);
@@ -109,8 +109,10 @@ public:
 
 
 public:
-  static uint32_t getCRCValue1(unsigned char* p, int length);
-  static uint32_t getCRCValue2(unsigned char* p, int length);
+  static uint32_t getCRCValue1(unsigned char* p, int length) { return m_getCRCValue1(p, length); }
+  static uint32_t getCRCValue2(unsigned char* p, int length) { return m_getCRCValue2(p, length); }
+  static uint32_t getCRCValue1Core(unsigned char* p, int length);
+  static uint32_t getCRCValue2Core(unsigned char* p, int length);
   static void getPixelsIn1DCharArrayByBlock2x2(const PelUnitBuf &curPicBuf, unsigned char* pixelsIn1D, int xStart, int yStart, const BitDepths& bitDepths, bool includeAllComponent = true);
   static bool isBlock2x2RowSameValue(unsigned char* p, bool includeAllComponent = true);
   static bool isBlock2x2ColSameValue(unsigned char* p, bool includeAllComponent = true);
@@ -119,6 +121,17 @@ public:
   static bool isHorizontalPerfectLuma(const Pel* srcPel, int stride, int width, int height);
   static bool isVerticalPerfectLuma(const Pel* srcPel, int stride, int width, int height);
 
+  static const uint32_t m_crcPoly1 = 0x5D6DCB;
+  static const uint32_t m_crcPoly2 = 0x864CFB;
+  static uint32_t (*m_getCRCValue1)(unsigned char* p, int length);
+  static uint32_t (*m_getCRCValue2)(unsigned char* p, int length);
+
+#ifdef TARGET_SIMD_X86
+  static void initTComHashX86();
+  template <X86_VEXT vext>
+  static void _initTComHashX86();
+#endif
+
 private:
   std::vector<BlockHash>** m_lookupTable;
   bool tableHasContent;
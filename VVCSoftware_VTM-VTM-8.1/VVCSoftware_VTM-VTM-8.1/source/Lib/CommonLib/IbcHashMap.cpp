@@ -55,7 +55,7 @@ IbcHashMap::IbcHashMap()
   m_picWidth = 0;
   m_picHeight = 0;
   m_pos2Hash = NULL;
-  m_computeCrc32c = xxComputeCrc32c16bit;
+  m_calcBlockHashRow = xxCalcBlockHashRow;
 
 #if ENABLE_SIMD_OPT_IBC
 #ifdef TARGET_SIMD_X86
@@ -184,17 +184,23 @@ uint32_t IbcHashMap::xxComputeCrc32c16bit(uint32_t crc, const Pel pel)
 // CRC calculation in C code
 ////////////////////////////////////////////////////////
 
-unsigned int IbcHashMap::xxCalcBlockHash(const Pel* pel, const int stride, const int width, const int height, unsigned int crc)
+void IbcHashMap::xxCalcBlockHashRow(const Pel* pel, const int stride, const int width, const int height, const int posShift, const int numPos, unsigned int* crc)
 {
-  for (int y = 0; y < height; y++)
+  for (int i = 0; i < numPos; i++)
   {
-    for (int x = 0; x < width; x++)
+    const Pel* blk = pel + (i >> posShift);
+    unsigned int hashValue = crc[i];
+
+    for (int y = 0; y < height; y++)
     {
-      crc = m_computeCrc32c(crc, pel[x]);
+      for (int x = 0; x < width; x++)
+      {
+        hashValue = xxComputeCrc32c16bit(hashValue, blk[x]);
+      }
+      blk += stride;
     }
-    pel += stride;
+    crc[i] = hashValue;
   }
-  return crc;
 }
 
 template<ChromaFormat chromaFormat>
@@ -208,6 +214,8 @@ void IbcHashMap::xxBuildPicHashMap(const PelUnitBuf& pic)
   const Pel* pelCb = NULL;
   const Pel* pelCr = NULL;
 
+  const int numPos = pic.Y().width - MIN_PU_SIZE + 1;
+
   Position pos;
   for (pos.y = 0; pos.y + MIN_PU_SIZE <= pic.Y().height; pos.y++)
   {
@@ -220,25 +228,24 @@ void IbcHashMap::xxBuildPicHashMap(const PelUnitBuf& pic)
       pelCr = pic.Cr().bufAt(0, chromaY);
     }
 
-    for (pos.x = 0; pos.x + MIN_PU_SIZE <= pic.Y().width; pos.x++)
-    {
-      // 0x1FF is just an initial value
-      unsigned int hashValue = 0x1FF;
+    // the hashes of all blocks of the row are built in place, 0x1FF is just an initial value
+    unsigned int* hashRow = m_pos2Hash[pos.y];
+    std::fill(hashRow, hashRow + numPos, 0x1FF);
 
-      // luma part
-      hashValue = xxCalcBlockHash(&pelY[pos.x], pic.Y().stride, MIN_PU_SIZE, MIN_PU_SIZE, hashValue);
+    // luma part
+    m_calcBlockHashRow(pelY, pic.Y().stride, MIN_PU_SIZE, MIN_PU_SIZE, 0, numPos, hashRow);
 
-      // chroma part
-      if (chromaFormat != CHROMA_400)
-      {
-        int chromaX = pos.x >> chromaScalingX;
-        hashValue = xxCalcBlockHash(&pelCb[chromaX], pic.Cb().stride, chromaMinBlkWidth, chromaMinBlkHeight, hashValue);
-        hashValue = xxCalcBlockHash(&pelCr[chromaX], pic.Cr().stride, chromaMinBlkWidth, chromaMinBlkHeight, hashValue);
-      }
+    // chroma part
+    if (chromaFormat != CHROMA_400)
+    {
+      m_calcBlockHashRow(pelCb, pic.Cb().stride, chromaMinBlkWidth, chromaMinBlkHeight, chromaScalingX, numPos, hashRow);
+      m_calcBlockHashRow(pelCr, pic.Cr().stride, chromaMinBlkWidth, chromaMinBlkHeight, chromaScalingX, numPos, hashRow);
+    }
 
-      // hash table
-      m_hash2Pos[hashValue].push_back(pos);
-      m_pos2Hash[pos.y][pos.x] = hashValue;
+    // hash table
+    for (pos.x = 0; pos.x < numPos; pos.x++)
+    {
+      m_hash2Pos[hashRow[pos.x]].push_back(pos);
     }
   }
 }
@@ -63,15 +63,15 @@ private:
   unsigned int**  m_pos2Hash;
   std::unordered_map<unsigned int, std::vector<Position>> m_hash2Pos;
 
-  unsigned int xxCalcBlockHash(const Pel* pel, const int stride, const int width, const int height, unsigned int crc);
-
   template<ChromaFormat chromaFormat>
   void    xxBuildPicHashMap(const PelUnitBuf& pic);
 
   static  uint32_t xxComputeCrc32c16bit(uint32_t crc, const Pel pel);
+  static  void     xxCalcBlockHashRow(const Pel* pel, const int stride, const int width, const int height, const int posShift, const int numPos, unsigned int* crc);
 
 public:
-  uint32_t (*m_computeCrc32c) (uint32_t crc, const Pel pel);
+  // continues the hashes crc[i] of numPos blocks in a row with the block starting at pel + (i >> posShift)
+  void     (*m_calcBlockHashRow) (const Pel* pel, const int stride, const int width, const int height, const int posShift, const int numPos, unsigned int* crc);
 
   IbcHashMap();
   virtual ~IbcHashMap();
@@ -789,18 +789,7 @@ void InterPrediction::xPredInterBlk ( const ComponentID& compID, const Predictio
   }
   else
   {
-    PelBuf tmpBuf = dmvrWidth ? PelBuf(m_filteredBlockTmp[0][compID], Size(dmvrWidth, dmvrHeight)) : PelBuf(m_filteredBlockTmp[0][compID], pu.blocks[compID]);
-    if (dmvrWidth == 0)
-      tmpBuf.stride = dstBuf.stride;
-
-    int vFilterSize = isLuma(compID) ? NTAPS_LUMA : NTAPS_CHROMA;
-    if (bilinearMC)
-    {
-      vFilterSize = NTAPS_BILINEAR;
-    }
-    m_if.filterHor(compID, (Pel*)refBuf.buf - ((vFilterSize >> 1) - 1) * refBuf.stride, refBuf.stride, tmpBuf.buf, tmpBuf.stride, backupWidth, backupHeight + vFilterSize - 1, xFrac, false, chFmt, clpRng, bilinearMC, bilinearMC, useAltHpelIf);
-    JVET_J0090_SET_CACHE_ENABLE( false );
-    m_if.filterVer(compID, (Pel*)tmpBuf.buf + ((vFilterSize >> 1) - 1) * tmpBuf.stride, tmpBuf.stride, dstBuf.buf, dstBuf.stride, backupWidth, backupHeight, yFrac, false, rndRes, chFmt, clpRng, bilinearMC, bilinearMC, useAltHpelIf);
+    m_if.filter2D(compID, (Pel*)refBuf.buf, refBuf.stride, dstBuf.buf, dstBuf.stride, backupWidth, backupHeight, xFrac, yFrac, rndRes, chFmt, clpRng, bilinearMC, bilinearMC, useAltHpelIf);
   }
   JVET_J0090_SET_CACHE_ENABLE((srcPadStride == 0) && (bioApplied == false)); // Enabled only in non-DMVR-non-BDOF process, In DMVR process, srcPadStride is always non-zero
   if (bioApplied && compID == COMPONENT_Y)
@@ -1997,19 +1986,19 @@ void xSubPelErrorSrfc(uint64_t *sadBuffer, int32_t *deltaMv)
 
 void InterPrediction::xBIPMVRefine(int bd, Pel *pRefL0, Pel *pRefL1, uint64_t& minCost, int16_t *deltaMV, uint64_t *pSADsArray, int width, int height)
 {
-  const int32_t refStrideL0 = m_biLinearBufStride;
-  const int32_t refStrideL1 = m_biLinearBufStride;
-  Pel *pRefL0Orig = pRefL0;
-  Pel *pRefL1Orig = pRefL1;
+  const int gridSize   = (2 * DMVR_NUM_ITERATION) + 1;
+  const int gridCenter = (gridSize * gridSize) >> 1;
+  Distortion gridCosts[gridSize * gridSize];
+
+  // the costs of the whole search grid are computed in one pass, equal to xDMVRCost() for each offset
+  m_pcRdCost->getDmvrCosts(pRefL0, pRefL1, m_biLinearBufStride, width, height, bd, gridCosts);
+
   for (int nIdx = 0; (nIdx < 25); ++nIdx)
   {
     int32_t sadOffset = ((m_pSearchOffset[nIdx].getVer() * ((2 * DMVR_NUM_ITERATION) + 1)) + m_pSearchOffset[nIdx].getHor());
-    pRefL0 = pRefL0Orig + m_pSearchOffset[nIdx].hor + (m_pSearchOffset[nIdx].ver * refStrideL0);
-    pRefL1 = pRefL1Orig - m_pSearchOffset[nIdx].hor - (m_pSearchOffset[nIdx].ver * refStrideL1);
     if (*(pSADsArray + sadOffset) == MAX_UINT64)
     {
-      const uint64_t cost = xDMVRCost(bd, pRefL0, refStrideL0, pRefL1, refStrideL1, width, height);
-      *(pSADsArray + sadOffset) = cost;
+      *(pSADsArray + sadOffset) = gridCosts[gridCenter + sadOffset] >> 1;
     }
     if (*(pSADsArray + sadOffset) < minCost)
     {
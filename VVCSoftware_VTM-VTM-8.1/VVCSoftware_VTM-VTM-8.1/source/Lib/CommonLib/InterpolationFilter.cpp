@@ -371,6 +371,13 @@ InterpolationFilter::InterpolationFilter()
   m_filterCopy[1][0]   = filterCopy<true, false>;
   m_filterCopy[1][1]   = filterCopy<true, true>;
 
+  m_filter2D[0][0]     = filter2D<8, false>;
+  m_filter2D[0][1]     = filter2D<8, true>;
+  m_filter2D[1][0]     = filter2D<4, false>;
+  m_filter2D[1][1]     = filter2D<4, true>;
+  m_filter2D[2][0]     = filter2D<2, false>;
+  m_filter2D[2][1]     = filter2D<2, true>;
+
 #if !JVET_Q0806
   m_weightedTriangleBlk = xWeightedTriangleBlk;
 #else
@@ -649,6 +656,41 @@ void InterpolationFilter::filter(const ClpRng& clpRng, Pel const *src, int srcSt
   }
 }
 
+/**
+ * \brief Apply separable 2D FIR filter (horizontal, then vertical) to a block of samples
+ *
+ * \tparam N          Number of taps
+ * \tparam isLast     Flag indicating whether it is the last filtering operation
+ * \param  clpRng     Clipping range
+ * \param  src        Pointer to source samples
+ * \param  srcStride  Stride of source samples
+ * \param  dst        Pointer to destination samples
+ * \param  dstStride  Stride of destination samples
+ * \param  width      Width of block
+ * \param  height     Height of block
+ * \param  coeffH     Pointer to horizontal filter taps
+ * \param  coeffV     Pointer to vertical filter taps
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// !!! NOTE !!!
+//
+//  This is the scalar version of the function.
+//  If you change the functionality here, consider to switch off the SIMD implementation of this function.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<int N, bool isLast>
+void InterpolationFilter::filter2D(const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeffH, TFilterCoeff const *coeffV, bool biMCForDMVR)
+{
+  CHECK( width > MAX_CU_SIZE || height > MAX_CU_SIZE, "Unsupported block size" );
+
+  Pel tmp[( MAX_CU_SIZE + N - 1 ) * MAX_CU_SIZE];
+
+  filter<N, false, true, false>( clpRng, src - ( N / 2 - 1 ) * srcStride, srcStride, tmp, width, width, height + N - 1, coeffH, biMCForDMVR );
+  JVET_J0090_SET_CACHE_ENABLE( false );
+  filter<N, true, false, isLast>( clpRng, tmp + ( N / 2 - 1 ) * width, width, dst, dstStride, width, height, coeffV, biMCForDMVR );
+}
+
 /**
  * \brief Filter a block of samples (horizontal)
  *
@@ -892,6 +934,86 @@ void InterpolationFilter::filterVer(const ComponentID compID, Pel const *src, in
   }
 }
 
+/**
+ * \brief Select the filter taps of one direction, following filterHor and filterVer
+ *
+ * \param  compID       Colour component ID
+ * \param  frac         Fractional sample offset
+ * \param  csf          Chroma scale factor of the filtering direction
+ * \param  nFilterIdx   Filter index
+ * \param  useAltHpelIf Use the alternative half-sample filter
+ * \param  is4x4        Flag indicating a 4x4 luma block
+ */
+TFilterCoeff const* InterpolationFilter::xGetFilterCoeff( const ComponentID compID, const int frac, const uint32_t csf, const int nFilterIdx, const bool useAltHpelIf, const bool is4x4 )
+{
+  if( isLuma( compID ) )
+  {
+    CHECK( frac < 0 || frac >= LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS, "Invalid fraction" );
+    switch( nFilterIdx )
+    {
+    case 1:  return m_bilinearFilterPrec4[frac];
+    case 2:  return m_lumaFilter4x4[frac];
+    case 3:  return m_lumaFilterRPR1[frac];
+    case 4:  return m_lumaFilterRPR2[frac];
+#if JVET_Q0517_RPR_AFFINE_DS
+    case 5:  return m_affineLumaFilterRPR1[frac];
+    case 6:  return m_affineLumaFilterRPR2[frac];
+#endif
+    default: break;
+    }
+    if( frac == 8 && useAltHpelIf )
+    {
+      return m_lumaAltHpelIFilter;
+    }
+    return is4x4 ? m_lumaFilter4x4[frac] : m_lumaFilter[frac];
+  }
+
+  CHECK( frac < 0 || csf >= 2 || ( frac << ( 1 - csf ) ) >= CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS, "Invalid fraction" );
+  switch( nFilterIdx )
+  {
+  case 3:  return m_chromaFilterRPR1[frac << ( 1 - csf )];
+  case 4:  return m_chromaFilterRPR2[frac << ( 1 - csf )];
+  default: return m_chromaFilter    [frac << ( 1 - csf )];
+  }
+}
+
+/**
+ * \brief Filter a block of Luma/Chroma samples horizontally and vertically in one pass
+ *
+ * Equivalent to filterHor (isLast = false) over height + N - 1 rows followed by filterVer (isFirst = false),
+ * without the caller providing the intermediate buffer.
+ *
+ * \param  compID     Colour component ID
+ * \param  src        Pointer to source samples
+ * \param  srcStride  Stride of source samples
+ * \param  dst        Pointer to destination samples
+ * \param  dstStride  Stride of destination samples
+ * \param  width      Width of block
+ * \param  height     Height of block
+ * \param  xFrac      Horizontal fractional sample offset, must not be zero
+ * \param  yFrac      Vertical fractional sample offset, must not be zero
+ * \param  isLast     Flag indicating whether it is the last filtering operation
+ * \param  fmt        Chroma format
+ * \param  clpRng     Clipping range
+ */
+void InterpolationFilter::filter2D(const ComponentID compID, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, int xFrac, int yFrac, bool isLast, const ChromaFormat fmt, const ClpRng& clpRng, int nFilterIdx, bool biMCForDMVR, bool useAltHpelIf)
+{
+  CHECK( xFrac == 0 || yFrac == 0, "Use filterHor/filterVer for integer positions" );
+
+  const bool          is4x4  = width == 4 && height == 4;
+  TFilterCoeff const* coeffH = xGetFilterCoeff( compID, xFrac, getComponentScaleX( compID, fmt ), nFilterIdx, useAltHpelIf, is4x4 );
+  TFilterCoeff const* coeffV = xGetFilterCoeff( compID, yFrac, getComponentScaleY( compID, fmt ), nFilterIdx, useAltHpelIf, is4x4 );
+
+  if( isLuma( compID ) )
+  {
+    m_filter2D[nFilterIdx == 1 ? 2 : 0][isLast]( clpRng, src, srcStride, dst, dstStride, width, height, coeffH, coeffV, biMCForDMVR );
+  }
+  else
+  {
+    m_filter2D[1][isLast]( clpRng, src, srcStride, dst, dstStride, width, height, coeffH, coeffV, biMCForDMVR );
+  }
+}
+
 #if !JVET_Q0806
 void InterpolationFilter::xWeightedTriangleBlk( const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const bool splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1 )
 {
@@ -994,28 +1116,19 @@ void InterpolationFilter::weightedGeoBlk(const PredictionUnit &pu, const uint32_
   m_weightedGeoBlk(pu, width, height, compIdx, splitDir, predDst, predSrc0, predSrc1);
 }
 
-void InterpolationFilter::xWeightedGeoBlk(const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1)
+/** Returns the first weight of the (possibly mirrored) prestored GEO mask for a block, together with the horizontal
+    step between the weights of neighbouring samples and the step from the end of one row to the start of the next.
+*/
+const int16_t* InterpolationFilter::xGetGeoWeights(const PredictionUnit &pu, const ComponentID compIdx, const uint8_t splitDir, int& stepX, int& stepY)
 {
-  Pel*    dst = predDst.get(compIdx).buf;
-  Pel*    src0 = predSrc0.get(compIdx).buf;
-  Pel*    src1 = predSrc1.get(compIdx).buf;
-  int32_t strideDst = predDst.get(compIdx).stride - width;
-  int32_t strideSrc0 = predSrc0.get(compIdx).stride - width;
-  int32_t strideSrc1 = predSrc1.get(compIdx).stride - width;
-
-  const char    log2WeightBase = 3;
-  const ClpRng  clipRng = pu.cu->slice->clpRngs().comp[compIdx];
-  const int32_t clipbd = clipRng.bd;
-  const int32_t shiftWeighted = std::max<int>(2, (IF_INTERNAL_PREC - clipbd)) + log2WeightBase;
-  const int32_t offsetWeighted = (1 << (shiftWeighted - 1)) + (IF_INTERNAL_OFFS << log2WeightBase);
   const uint32_t scaleX = getComponentScaleX(compIdx, pu.chromaFormat);
   const uint32_t scaleY = getComponentScaleY(compIdx, pu.chromaFormat);
 
   int16_t angle = g_GeoParams[splitDir][0];
   int16_t wIdx = floorLog2(pu.lwidth()) - GEO_MIN_CU_LOG2;
   int16_t hIdx = floorLog2(pu.lheight()) - GEO_MIN_CU_LOG2;
-  int16_t stepX = 1 << scaleX;
-  int16_t stepY = 0;
+  stepX = 1 << scaleX;
+  stepY = 0;
   int16_t* weight = nullptr;
   if (g_angle2mirror[angle] == 2)
   {
@@ -1033,6 +1146,27 @@ void InterpolationFilter::xWeightedGeoBlk(const PredictionUnit &pu, const uint32
     stepY = (GEO_WEIGHT_MASK_SIZE << scaleY) - pu.lwidth();
     weight = &g_globalGeoWeights[g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
   }
+  return weight;
+}
+
+void InterpolationFilter::xWeightedGeoBlk(const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1)
+{
+  Pel*    dst = predDst.get(compIdx).buf;
+  Pel*    src0 = predSrc0.get(compIdx).buf;
+  Pel*    src1 = predSrc1.get(compIdx).buf;
+  int32_t strideDst = predDst.get(compIdx).stride - width;
+  int32_t strideSrc0 = predSrc0.get(compIdx).stride - width;
+  int32_t strideSrc1 = predSrc1.get(compIdx).stride - width;
+
+  const char    log2WeightBase = 3;
+  const ClpRng  clipRng = pu.cu->slice->clpRngs().comp[compIdx];
+  const int32_t clipbd = clipRng.bd;
+  const int32_t shiftWeighted = std::max<int>(2, (IF_INTERNAL_PREC - clipbd)) + log2WeightBase;
+  const int32_t offsetWeighted = (1 << (shiftWeighted - 1)) + (IF_INTERNAL_OFFS << log2WeightBase);
+
+  int stepX = 0;
+  int stepY = 0;
+  const int16_t* weight = xGetGeoWeights(pu, compIdx, splitDir, stepX, stepY);
   for( int y = 0; y < height; y++ )
   {
     for( int x = 0; x < width; x++ )
@@ -67,6 +67,212 @@ const uint8_t IntraPrediction::m_aucIntraFilter[MAX_INTRA_FILTER_DEPTHS] =
   0   // 128xn
 };
 
+// ====================================================================================================================
+// Prediction kernels
+// ====================================================================================================================
+
+//NOTE: Bit-Limit - 24-bit source
+void intraPredPlanarCore( const Pel* top, const Pel* left, Pel* dst, int dstStride, int width, int height )
+{
+  const uint32_t log2W = floorLog2( width );
+  const uint32_t log2H = floorLog2( height );
+
+  int leftColumn[MAX_CU_SIZE + 1], topRow[MAX_CU_SIZE + 1], bottomRow[MAX_CU_SIZE], rightColumn[MAX_CU_SIZE];
+  const uint32_t offset = 1 << (log2W + log2H);
+
+  // Get left and above reference column and row
+  for( int k = 0; k < width + 1; k++ )
+  {
+    topRow[k] = top[k];
+  }
+
+  for( int k = 0; k < height + 1; k++ )
+  {
+    leftColumn[k] = left[k];
+  }
+
+  // Prepare intermediate variables used in interpolation
+  int bottomLeft = left[height];
+  int topRight = top[width];
+
+  for( int k = 0; k < width; k++ )
+  {
+    bottomRow[k] = bottomLeft - topRow[k];
+    topRow[k]    = topRow[k] << log2H;
+  }
+
+  for( int k = 0; k < height; k++ )
+  {
+    rightColumn[k] = topRight - leftColumn[k];
+    leftColumn[k]  = leftColumn[k] << log2W;
+  }
+
+  const uint32_t finalShift = 1 + log2W + log2H;
+  Pel*       pred       = dst;
+  for( int y = 0; y < height; y++, pred += dstStride )
+  {
+    int horPred = leftColumn[y];
+
+    for( int x = 0; x < width; x++ )
+    {
+      horPred += rightColumn[y];
+      topRow[x] += bottomRow[x];
+
+      int vertPred = topRow[x];
+      pred[x]      = ( ( horPred << log2H ) + ( vertPred << log2W ) + offset ) >> finalShift;
+    }
+  }
+}
+
+void intraPdpcPlanarDcCore( const Pel* top, const Pel* left, Pel* dst, int dstStride, int width, int height, int scale )
+{
+  for (int y = 0; y < height; y++, dst += dstStride)
+  {
+    const int wT = 32 >> std::min(31, ((y << 1) >> scale));
+    for (int x = 0; x < width; x++)
+    {
+      const int wL  = 32 >> std::min(31, ((x << 1) >> scale));
+      const Pel val = dst[x];
+      dst[x]        = val + ((wL * (left[y] - val) + wT * (top[x] - val) + 32) >> 6);
+    }
+  }
+}
+
+void intraPredAngLumaCore( const Pel* refMain, Pel* dst, int dstStride, int width, int height, int deltaPos, int intraPredAngle, bool useCubicFilter, const ClpRng& clpRng )
+{
+  for (int y = 0; y < height; y++, deltaPos += intraPredAngle, dst += dstStride)
+  {
+    const int deltaInt   = deltaPos >> 5;
+    const int deltaFract = deltaPos & 31;
+
+    const TFilterCoeff        intraSmoothingFilter[4] = {TFilterCoeff(16 - (deltaFract >> 1)), TFilterCoeff(32 - (deltaFract >> 1)), TFilterCoeff(16 + (deltaFract >> 1)), TFilterCoeff(deltaFract >> 1)};
+    const TFilterCoeff* const f                       = (useCubicFilter) ? InterpolationFilter::getChromaFilterTable(deltaFract) : intraSmoothingFilter;
+
+    for (int x = 0; x < width; x++)
+    {
+      Pel p[4];
+
+      p[0] = refMain[deltaInt + x];
+      p[1] = refMain[deltaInt + x + 1];
+      p[2] = refMain[deltaInt + x + 2];
+      p[3] = refMain[deltaInt + x + 3];
+
+      Pel val = (f[0] * p[0] + f[1] * p[1] + f[2] * p[2] + f[3] * p[3] + 32) >> 6;
+
+      dst[x] = ClipPel(val, clpRng);   // always clip even though not always needed
+    }
+  }
+}
+
+void intraPredAngChromaCore( const Pel* refMain, Pel* dst, int dstStride, int width, int height, int deltaPos, int intraPredAngle )
+{
+  for (int y = 0; y < height; y++, deltaPos += intraPredAngle, dst += dstStride)
+  {
+    const int deltaInt   = deltaPos >> 5;
+    const int deltaFract = deltaPos & 31;
+
+    // Do linear filtering
+    for (int x = 0; x < width; x++)
+    {
+      Pel p[2];
+
+      p[0] = refMain[deltaInt + x + 1];
+      p[1] = refMain[deltaInt + x + 2];
+
+      dst[x] = p[0] + ((deltaFract * (p[1] - p[0]) + 16) >> 5);
+    }
+  }
+}
+
+void intraPdpcHorVerCore( const Pel* refSide, Pel topLeft, Pel* dst, int dstStride, int width, int height, int scale, const ClpRng& clpRng )
+{
+  for (int y = 0; y < height; y++, dst += dstStride)
+  {
+    const Pel left = refSide[1 + y];
+    for (int x = 0; x < std::min(3 << scale, width); x++)
+    {
+      const int wL  = 32 >> (2 * x >> scale);
+      const Pel val = dst[x];
+      dst[x]        = ClipPel(val + ((wL * (left - topLeft) + 32) >> 6), clpRng);
+    }
+  }
+}
+
+void intraPdpcAngCore( const Pel* refSide, Pel* dst, int dstStride, int width, int height, int scale, int invAngle )
+{
+  for (int y = 0; y < height; y++, dst += dstStride)
+  {
+    int invAngleSum = 256;
+
+    for (int x = 0; x < std::min(3 << scale, width); x++)
+    {
+      invAngleSum += invAngle;
+
+      int wL   = 32 >> (2 * x >> scale);
+      Pel left = refSide[y + (invAngleSum >> 9) + 1];
+      dst[x]   = dst[x] + ((wL * (left - dst[x]) + 32) >> 6);
+    }
+  }
+}
+
+void intraTransposeCore( const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      dst[x * dstStride + y] = src[x];
+    }
+    src += srcStride;
+  }
+}
+
+// CCLM luma downsampling with the regular (all neighbours available) filters, one output row per chroma row
+void intraLumaDownsampleCore( const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height, const ChromaFormat chFmt, const bool collocated )
+{
+  const int srcStep = chFmt == CHROMA_420 ? 2 * srcStride : srcStride;
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      if( chFmt == CHROMA_444 )
+      {
+        dst[x] = src[x];
+      }
+      else if( chFmt == CHROMA_422 )
+      {
+        dst[x] = collocated ? src[2 * x] : ( 2 * src[2 * x] + src[2 * x - 1] + src[2 * x + 1] + 2 ) >> 2;
+      }
+      else if( collocated )
+      {
+        dst[x] = ( src[2 * x - srcStride] + 4 * src[2 * x] + src[2 * x - 1] + src[2 * x + 1] + src[2 * x + srcStride] + 4 ) >> 3;
+      }
+      else
+      {
+        dst[x] = ( 2 * src[2 * x]             + src[2 * x - 1]             + src[2 * x + 1]
+                 + 2 * src[2 * x + srcStride] + src[2 * x - 1 + srcStride] + src[2 * x + 1 + srcStride] + 4 ) >> 3;
+      }
+    }
+    src += srcStep;
+    dst += dstStride;
+  }
+}
+
+IntraPredOps::IntraPredOps()
+{
+  predPlanar     = intraPredPlanarCore;
+  pdpcPlanarDc   = intraPdpcPlanarDcCore;
+  predAngLuma    = intraPredAngLumaCore;
+  predAngChroma  = intraPredAngChromaCore;
+  pdpcHorVer     = intraPdpcHorVerCore;
+  pdpcAng        = intraPdpcAngCore;
+  transpose      = intraTransposeCore;
+  lumaDownsample = intraLumaDownsampleCore;
+}
+
+IntraPredOps g_intraPredOP = IntraPredOps();
+
 
 // ====================================================================================================================
 // Constructor / destructor / initialize
@@ -244,18 +450,7 @@ void IntraPrediction::predIntraAng( const ComponentID compId, PelBuf &piPred, co
 
     if (uiDirMode == PLANAR_IDX || uiDirMode == DC_IDX)
     {
-      for (int y = 0; y < iHeight; y++)
-      {
-        const int wT   = 32 >> std::min(31, ((y << 1) >> scale));
-        const Pel left = srcBuf.at(y + 1, 1);
-        for (int x = 0; x < iWidth; x++)
-        {
-          const int wL    = 32 >> std::min(31, ((x << 1) >> scale));
-          const Pel top   = srcBuf.at(x + 1, 0);
-          const Pel val   = dstBuf.at(x, y);
-          dstBuf.at(x, y) = val + ((wL * (left - val) + wT * (top - val) + 32) >> 6);
-        }
-      }
+      g_intraPredOP.pdpcPlanarDc(&srcBuf.at(1, 0), &srcBuf.at(1, 1), dstBuf.buf, dstBuf.stride, iWidth, iHeight, scale);
     }
   }
 }
@@ -277,70 +472,30 @@ void IntraPrediction::predIntraChromaLM(const ComponentID compID, PelBuf &piPred
   int a, b, iShift;
   xGetLMParameters(pu, compID, chromaArea, a, b, iShift);
 
-  ////// final prediction
-  piPred.copyFrom(Temp);
-  piPred.linearTransform(a, iShift, b, true, pu.cs->slice->clpRng(compID));
-}
-
-/** Function for deriving planar intra prediction. This function derives the prediction samples for planar mode (intra coding).
- */
-
-//NOTE: Bit-Limit - 24-bit source
-void IntraPrediction::xPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst )
-{
-  const uint32_t width  = pDst.width;
-  const uint32_t height = pDst.height;
-
-  const uint32_t log2W = floorLog2( width );
-  const uint32_t log2H = floorLog2( height );
-
-  int leftColumn[MAX_CU_SIZE + 1], topRow[MAX_CU_SIZE + 1], bottomRow[MAX_CU_SIZE], rightColumn[MAX_CU_SIZE];
-  const uint32_t offset = 1 << (log2W + log2H);
-
-  // Get left and above reference column and row
-  for( int k = 0; k < width + 1; k++ )
-  {
-    topRow[k] = pSrc.at( k + 1, 0 );
-  }
-
-  for( int k = 0; k < height + 1; k++ )
+  ////// final prediction, the linear model is applied directly from the downsampled luma
+  const ClpRng& clpRng = pu.cs->slice->clpRng(compID);
+  if( ( piPred.width & 7 ) == 0 )
   {
-    leftColumn[k] = pSrc.at(k + 1, 1);
+    g_pelBufOP.linTf8( Temp.buf, Temp.stride, piPred.buf, piPred.stride, piPred.width, piPred.height, a, iShift, b, clpRng, true );
   }
-
-  // Prepare intermediate variables used in interpolation
-  int bottomLeft = leftColumn[height];
-  int topRight = topRow[width];
-
-  for( int k = 0; k < width; k++ )
+  else if( ( piPred.width & 3 ) == 0 )
   {
-    bottomRow[k] = bottomLeft - topRow[k];
-    topRow[k]    = topRow[k] << log2H;
+    g_pelBufOP.linTf4( Temp.buf, Temp.stride, piPred.buf, piPred.stride, piPred.width, piPred.height, a, iShift, b, clpRng, true );
   }
-
-  for( int k = 0; k < height; k++ )
+  else
   {
-    rightColumn[k] = topRight - leftColumn[k];
-    leftColumn[k]  = leftColumn[k] << log2W;
+    piPred.copyFrom(Temp);
+    piPred.linearTransform(a, iShift, b, true, clpRng);
   }
+}
 
-  const uint32_t finalShift = 1 + log2W + log2H;
-  const uint32_t stride     = pDst.stride;
-  Pel*       pred       = pDst.buf;
-  for( int y = 0; y < height; y++, pred += stride )
-  {
-    int horPred = leftColumn[y];
-
-    for( int x = 0; x < width; x++ )
-    {
-      horPred += rightColumn[y];
-      topRow[x] += bottomRow[x];
-
-      int vertPred = topRow[x];
-      pred[x]      = ( ( horPred << log2H ) + ( vertPred << log2W ) + offset ) >> finalShift;
-    }
-  }
+/** Function for deriving planar intra prediction. This function derives the prediction samples for planar mode (intra coding).
+ */
+void IntraPrediction::xPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst )
+{
+  g_intraPredOP.predPlanar( &pSrc.at( 1, 0 ), &pSrc.at( 1, 1 ), pDst.buf, pDst.stride, pDst.width, pDst.height );
 }
+
 void IntraPrediction::xPredIntraDc( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const bool enableBoundaryFilter )
 {
   const Pel dcval = xGetPredValDc( pSrc, pDst );
@@ -531,113 +686,65 @@ void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
   refMain += multiRefIdx;
   refSide += multiRefIdx;
 
-  Pel *pDsty = pDstBuf;
-
   if( intraPredAngle == 0 )  // pure vertical or pure horizontal
   {
+    Pel *pDsty = pDstBuf;
     for( int y = 0; y < height; y++ )
     {
       for( int x = 0; x < width; x++ )
       {
         pDsty[x] = refMain[x + 1];
       }
-
-      if (m_ipaParam.applyPDPC)
-      {
-        const int scale   = (floorLog2(width) + floorLog2(height) - 2) >> 2;
-        const Pel topLeft = refMain[0];
-        const Pel left    = refSide[1 + y];
-        for (int x = 0; x < std::min(3 << scale, width); x++)
-        {
-          const int wL  = 32 >> (2 * x >> scale);
-          const Pel val = pDsty[x];
-          pDsty[x]      = ClipPel(val + ((wL * (left - topLeft) + 32) >> 6), clpRng);
-        }
-      }
-
       pDsty += dstStride;
     }
+
+    if (m_ipaParam.applyPDPC)
+    {
+      const int scale = (floorLog2(width) + floorLog2(height) - 2) >> 2;
+      g_intraPredOP.pdpcHorVer(refSide, refMain[0], pDstBuf, dstStride, width, height, scale, clpRng);
+    }
   }
   else
   {
-    for (int y = 0, deltaPos = intraPredAngle * (1 + multiRefIdx); y<height; y++, deltaPos += intraPredAngle, pDsty += dstStride)
-    {
-      const int deltaInt   = deltaPos >> 5;
-      const int deltaFract = deltaPos & 31;
+    const int deltaPos0 = intraPredAngle * (1 + multiRefIdx);
 
-      if ( !isIntegerSlope( abs(intraPredAngle) ) )
+    if ( !isIntegerSlope( abs(intraPredAngle) ) )
+    {
+      if( isLuma(channelType) )
       {
-        if( isLuma(channelType) )
-        {
-          const bool useCubicFilter = !m_ipaParam.interpolationFlag;
-
-          const TFilterCoeff        intraSmoothingFilter[4] = {TFilterCoeff(16 - (deltaFract >> 1)), TFilterCoeff(32 - (deltaFract >> 1)), TFilterCoeff(16 + (deltaFract >> 1)), TFilterCoeff(deltaFract >> 1)};
-          const TFilterCoeff* const f                       = (useCubicFilter) ? InterpolationFilter::getChromaFilterTable(deltaFract) : intraSmoothingFilter;
+        const bool useCubicFilter = !m_ipaParam.interpolationFlag;
 
-          for (int x = 0; x < width; x++)
-          {
-            Pel p[4];
-
-            p[0] = refMain[deltaInt + x];
-            p[1] = refMain[deltaInt + x + 1];
-            p[2] = refMain[deltaInt + x + 2];
-            p[3] = refMain[deltaInt + x + 3];
-
-            Pel val = (f[0] * p[0] + f[1] * p[1] + f[2] * p[2] + f[3] * p[3] + 32) >> 6;
-
-            pDsty[x] = ClipPel(val, clpRng);   // always clip even though not always needed
-          }
-        }
-        else
-        {
-          // Do linear filtering
-          for (int x = 0; x < width; x++)
-          {
-            Pel p[2];
-
-            p[0] = refMain[deltaInt + x + 1];
-            p[1] = refMain[deltaInt + x + 2];
-
-            pDsty[x] = p[0] + ((deltaFract * (p[1] - p[0]) + 16) >> 5);
-          }
-        }
+        g_intraPredOP.predAngLuma(refMain, pDstBuf, dstStride, width, height, deltaPos0, intraPredAngle, useCubicFilter, clpRng);
       }
       else
       {
-        // Just copy the integer samples
+        g_intraPredOP.predAngChroma(refMain, pDstBuf, dstStride, width, height, deltaPos0, intraPredAngle);
+      }
+    }
+    else
+    {
+      // Just copy the integer samples
+      Pel *pDsty = pDstBuf;
+      for (int y = 0, deltaPos = deltaPos0; y < height; y++, deltaPos += intraPredAngle, pDsty += dstStride)
+      {
+        const int deltaInt = deltaPos >> 5;
         for( int x = 0; x < width; x++ )
         {
           pDsty[x] = refMain[x + deltaInt + 1];
         }
       }
-      if (m_ipaParam.applyPDPC)
-      {
-        const int scale       = m_ipaParam.angularScale;
-        int       invAngleSum = 256;
-
-        for (int x = 0; x < std::min(3 << scale, width); x++)
-        {
-          invAngleSum += invAngle;
+    }
 
-          int wL   = 32 >> (2 * x >> scale);
-          Pel left = refSide[y + (invAngleSum >> 9) + 1];
-          pDsty[x] = pDsty[x] + ((wL * (left - pDsty[x]) + 32) >> 6);
-        }
-      }
+    if (m_ipaParam.applyPDPC)
+    {
+      g_intraPredOP.pdpcAng(refSide, pDstBuf, dstStride, width, height, m_ipaParam.angularScale, invAngle);
     }
   }
 
   // Flip the block if this is the horizontal mode
   if( !bIsModeVer )
   {
-    for( int y = 0; y < height; y++ )
-    {
-      for( int x = 0; x < width; x++ )
-      {
-        pDst.at( y, x ) = pDstBuf[x];
-      }
-      pDstBuf += dstStride;
-    }
+    g_intraPredOP.transpose( pDstBuf, dstStride, pDst.buf, pDst.stride, width, height );
   }
 }
 
@@ -1461,7 +1568,17 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
     {
       addedAboveRight = avaiAboveRightUnits*chromaUnitWidth;
     }
-    for (int i = 0; i < uiCWidth + addedAboveRight; i++)
+    // the regular filters are applied to the whole line, the sample next to an unavailable left neighbour
+    // is refiltered below (for 4:4:4 the padded and the regular filters of the last sample are identical)
+    if( isFirstRowOfCtu )
+    {
+      g_intraPredOP.lumaDownsample( pRecSrc0 - iRecStride, iRecStride, pDst, iDstStride, uiCWidth + addedAboveRight, 1, pu.chromaFormat == CHROMA_444 ? CHROMA_444 : CHROMA_422, false );
+    }
+    else
+    {
+      g_intraPredOP.lumaDownsample( pRecSrc0 - iRecStride2, iRecStride, pDst, iDstStride, uiCWidth + addedAboveRight, 1, pu.chromaFormat, pu.cs->sps->getCclmCollocatedChromaFlag() );
+    }
+    for( int i = 0; i < ( bLeftAvaillable ? 0 : 1 ); i++ )
     {
       if (isFirstRowOfCtu)
       {
@@ -1574,10 +1691,15 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
     }
   }
 
-  // inner part from reconstructed picture buffer
+  // inner part from reconstructed picture buffer, the samples next to unavailable neighbours are refiltered below
+  g_intraPredOP.lumaDownsample( pRecSrc0, iRecStride, pDst0, iDstStride, uiCWidth, uiCHeight, pu.chromaFormat, pu.cs->sps->getCclmCollocatedChromaFlag() );
+
   for( int j = 0; j < uiCHeight; j++ )
   {
-    for( int i = 0; i < uiCWidth; i++ )
+    const bool padRow = pu.cs->sps->getCclmCollocatedChromaFlag() && j == 0 && !bAboveAvaillable;
+    const int  numPad = padRow ? uiCWidth : ( bLeftAvaillable ? 0 : 1 );
+
+    for( int i = 0; i < numPad; i++ )
     {
       if( pu.cs->sps->getCclmCollocatedChromaFlag() )
       {
@@ -1917,6 +2039,18 @@ void IntraPrediction::predIntraMip( const ComponentID compId, PelBuf &piPred, co
     }
   }
 }
+
+void IntraPrediction::predIntraMipAllModes( const ComponentID compId, Pel* const dst, const PredictionUnit &pu )
+{
+  CHECK( compId != COMPONENT_Y, "Error: chroma not supported" );
+  CHECK( pu.lwidth() > MIP_MAX_WIDTH || pu.lheight() > MIP_MAX_HEIGHT, "Error: block size not supported for MIP" );
+  CHECK( pu.lwidth() != (1 << floorLog2(pu.lwidth())) || pu.lheight() != (1 << floorLog2(pu.lheight())), "Error: expecting blocks of size 2^M x 2^N" );
+
+  // predictions of all MIP modes for the boundary prepared by initIntraMip, the transposed modes follow the regular ones
+  const int bitDepth = pu.cu->slice->getSPS()->getBitDepth( CHANNEL_TYPE_LUMA );
+
+  m_matrixIntraPred.predBlockAllModes( dst, bitDepth );
+}
 void IntraPrediction::reorderPLT(CodingStructure& cs, Partitioner& partitioner, ComponentID compBegin, uint32_t numComp)
 {
   CodingUnit &cu = *cs.getCU(partitioner.chType);
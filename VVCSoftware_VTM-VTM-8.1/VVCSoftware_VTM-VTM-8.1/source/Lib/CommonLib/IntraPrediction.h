@@ -63,6 +63,37 @@ enum PredBuf
 
 static const uint32_t MAX_INTRA_FILTER_DEPTHS=8;
 
+struct IntraPredOps
+{
+  IntraPredOps();
+
+#if ENABLE_SIMD_OPT_INTRA && defined(TARGET_SIMD_X86)
+  void initIntraPredOpsX86();
+  template<X86_VEXT vext>
+  void _initIntraPredOpsX86();
+#endif
+
+  void ( *predPlanar )    ( const Pel* top, const Pel* left, Pel* dst, int dstStride, int width, int height );
+  void ( *pdpcPlanarDc )  ( const Pel* top, const Pel* left, Pel* dst, int dstStride, int width, int height, int scale );
+  void ( *predAngLuma )   ( const Pel* refMain, Pel* dst, int dstStride, int width, int height, int deltaPos, int intraPredAngle, bool useCubicFilter, const ClpRng& clpRng );
+  void ( *predAngChroma ) ( const Pel* refMain, Pel* dst, int dstStride, int width, int height, int deltaPos, int intraPredAngle );
+  void ( *pdpcHorVer )    ( const Pel* refSide, Pel topLeft, Pel* dst, int dstStride, int width, int height, int scale, const ClpRng& clpRng );
+  void ( *pdpcAng )       ( const Pel* refSide, Pel* dst, int dstStride, int width, int height, int scale, int invAngle );
+  void ( *transpose )     ( const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height );
+  void ( *lumaDownsample )( const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height, const ChromaFormat chFmt, const bool collocated );
+};
+
+extern IntraPredOps g_intraPredOP;
+
+void intraPredPlanarCore    ( const Pel* top, const Pel* left, Pel* dst, int dstStride, int width, int height );
+void intraPdpcPlanarDcCore  ( const Pel* top, const Pel* left, Pel* dst, int dstStride, int width, int height, int scale );
+void intraPredAngLumaCore   ( const Pel* refMain, Pel* dst, int dstStride, int width, int height, int deltaPos, int intraPredAngle, bool useCubicFilter, const ClpRng& clpRng );
+void intraPredAngChromaCore ( const Pel* refMain, Pel* dst, int dstStride, int width, int height, int deltaPos, int intraPredAngle );
+void intraPdpcHorVerCore    ( const Pel* refSide, Pel topLeft, Pel* dst, int dstStride, int width, int height, int scale, const ClpRng& clpRng );
+void intraPdpcAngCore       ( const Pel* refSide, Pel* dst, int dstStride, int width, int height, int scale, int invAngle );
+void intraTransposeCore     ( const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height );
+void intraLumaDownsampleCore( const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height, const ChromaFormat chFmt, const bool collocated );
+
 class IntraPrediction
 {
 protected:
@@ -163,6 +194,7 @@ public:
   // Matrix-based intra prediction
   void initIntraMip               (const PredictionUnit &pu, const CompArea &area);
   void predIntraMip               (const ComponentID compId, PelBuf &piPred, const PredictionUnit &pu);
+  void predIntraMipAllModes       (const ComponentID compId, Pel* const dst, const PredictionUnit &pu);
 
   void geneWeightedPred           (const ComponentID compId, PelBuf &pred, const PredictionUnit &pu, Pel *srcBuf);
   Pel* getPredictorPtr2           (const ComponentID compID, uint32_t idx) { return m_yuvExt2[compID][idx]; }
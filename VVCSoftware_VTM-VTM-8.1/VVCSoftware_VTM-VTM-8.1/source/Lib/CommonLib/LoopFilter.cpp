@@ -114,6 +114,14 @@ static bool isAvailableAbove( const CodingUnit& cu, const CodingUnit& cu2, const
 
 LoopFilter::LoopFilter()
 {
+  m_filterLumaEdge   = filterLumaEdgeCore;
+  m_filterChromaEdge = filterChromaEdgeCore;
+
+#if ENABLE_SIMD_OPT_DBLF
+#ifdef TARGET_SIMD_X86
+  initLoopFilterX86();
+#endif
+#endif
 }
 
 LoopFilter::~LoopFilter()
@@ -980,10 +988,8 @@ void LoopFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeDir edg
   unsigned     uiNumParts   = ( ( ( edgeDir == EDGE_VER ) ? lumaArea.height / pcv.minCUHeight : lumaArea.width / pcv.minCUWidth ) );
   int          pelsInPart   = pcv.minCUWidth;
   unsigned     uiBsAbsIdx   = 0, uiBs = 0;
-  int          iOffset, iSrcStep;
+  int          iSrcStep;
 
-  bool  bPartPNoFilter  = false;
-  bool  bPartQNoFilter  = false;
   int   betaOffsetDiv2  = slice.getDeblockingFilterBetaOffsetDiv2();
   int   tcOffsetDiv2    = slice.getDeblockingFilterTcOffsetDiv2();
   int   xoffset, yoffset;
@@ -994,7 +1000,6 @@ void LoopFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeDir edg
   {
     xoffset   = 0;
     yoffset   = pelsInPart;
-    iOffset   = 1;
     iSrcStep  = iStride;
     piTmpSrc += iEdge * pelsInPart;
     pos       = Position{ lumaArea.x + iEdge * pelsInPart, lumaArea.y - yoffset };
@@ -1003,7 +1008,6 @@ void LoopFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeDir edg
   {
     xoffset   = pelsInPart;
     yoffset   = 0;
-    iOffset   = iStride;
     iSrcStep  = 1;
     piTmpSrc += iEdge*pelsInPart*iStride;
     pos       = Position{ lumaArea.x - xoffset, lumaArea.y + iEdge * pelsInPart };
@@ -1011,12 +1015,24 @@ void LoopFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeDir edg
 
   const int iBitdepthScale = 1 << (bitDepthLuma - 8);
 
+  // the filter decisions of a segment only depend on its own 4 lines, so the parameters of all
+  // segments are derived first and the whole edge is filtered at once
+  CHECK( pelsInPart & 3, "Deblocking segments have to cover multiples of 4 lines" );
+  const unsigned uiBlocksInPart = pelsInPart / 4;
+  LFEdgeSegment  segs[MAX_CU_SIZE / 4];
+  int            numSeg         = 0;
+
   // dec pos since within the loop we first calc the pos
-  for( int iIdx = 0; iIdx < uiNumParts; iIdx++ )
+  for( int iIdx = 0; iIdx < uiNumParts; iIdx++, numSeg += uiBlocksInPart )
   {
     pos.x += xoffset;
     pos.y += yoffset;
 
+    for( int iBlkIdx = 0; iBlkIdx < uiBlocksInPart; iBlkIdx++ )
+    {
+      segs[numSeg + iBlkIdx].filter = false;
+    }
+
     // Deblock luma boundaries on 4x4 grid only
     if (edgeDir == EDGE_HOR && (pos.y % 4) != 0)
     {
@@ -1105,115 +1121,145 @@ void LoopFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeDir edg
       {
         sidePisLarge = false;
       }
+
       const int iIndexTC  = Clip3(0, MAX_QP + DEFAULT_INTRA_TC_OFFSET, int(iQP + DEFAULT_INTRA_TC_OFFSET*(uiBs - 1) + (tcOffsetDiv2 << 1)));
       const int iIndexB   = Clip3(0, MAX_QP, iQP + (betaOffsetDiv2 << 1));
 
-      const int iTc = bitDepthLuma < 10 ? ((sm_tcTable[iIndexTC] + 2) >> (10 - bitDepthLuma)) : ((sm_tcTable[iIndexTC]) << (bitDepthLuma - 10));
-      const int iBeta     = sm_betaTable[iIndexB ] * iBitdepthScale;
-      const int iSideThreshold = ( iBeta + ( iBeta >> 1 ) ) >> 3;
-      const int iThrCut   = iTc * 10;
-
-      const unsigned uiBlocksInPart = pelsInPart / 4 ? pelsInPart / 4 : 1;
-
       for( int iBlkIdx = 0; iBlkIdx < uiBlocksInPart; iBlkIdx++ )
       {
-        const int dp0 = xCalcDP(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 0), iOffset);
-        const int dq0 = xCalcDQ(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 0), iOffset);
-        const int dp3 = xCalcDP(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 3), iOffset);
-        const int dq3 = xCalcDQ(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 3), iOffset);
-        int dp0L = dp0;
-        int dq0L = dq0;
-        int dp3L = dp3;
-        int dq3L = dq3;
-
-        if (sidePisLarge)
-        {
-          dp0L = (dp0L + xCalcDP(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 0) - 3 * iOffset, iOffset) + 1) >> 1;
-          dp3L = (dp3L + xCalcDP(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 3) - 3 * iOffset, iOffset) + 1) >> 1;
-        }
-        if (sideQisLarge)
-        {
-          dq0L = (dq0L + xCalcDQ(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 0) + 3 * iOffset, iOffset) + 1) >> 1;
-          dq3L = (dq3L + xCalcDQ(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 3) + 3 * iOffset, iOffset) + 1) >> 1;
-        }
-        bool useLongtapFilter = false;
-        if (sidePisLarge || sideQisLarge)
-        {
-          int d0L = dp0L + dq0L;
-          int d3L = dp3L + dq3L;
+        LFEdgeSegment& seg   = segs[numSeg + iBlkIdx];
+        seg.filter           = true;
+        seg.tc               = bitDepthLuma < 10 ? ((sm_tcTable[iIndexTC] + 2) >> (10 - bitDepthLuma)) : ((sm_tcTable[iIndexTC]) << (bitDepthLuma - 10));
+        seg.beta             = sm_betaTable[iIndexB ] * iBitdepthScale;
+        seg.maxFilterLengthP = maxFilterLengthP;
+        seg.maxFilterLengthQ = maxFilterLengthQ;
+        seg.sidePisLarge     = sidePisLarge;
+        seg.sideQisLarge     = sideQisLarge;
+        // check if each of PUs is palette coded
+        seg.partPNoFilter    = spsPaletteEnabledFlag && CU::isPLT(cuP);
+        seg.partQNoFilter    = spsPaletteEnabledFlag && CU::isPLT(cuQ);
+      }
+    }
+  }
 
-          int dpL = dp0L + dp3L;
-          int dqL = dq0L + dq3L;
+  m_filterLumaEdge( piTmpSrc, iStride, edgeDir, segs, numSeg, clpRng );
+}
 
-          int dL = d0L + d3L;
+/**
+ - Deblocking of the 4-line segments of one luma edge
+ .
+ \param src       pointer to the first sample of the Q side of the edge
+ \param stride    stride of the picture data
+ \param edgeDir   direction of the edge
+ \param seg       filter parameters of the segments, segment i covers the lines 4*i to 4*i+3
+ \param numSeg    number of segments
+ \param clpRng    clipping range of the luma component
+*/
+void LoopFilter::filterLumaEdgeCore( Pel* src, const int stride, const DeblockEdgeDir edgeDir, const LFEdgeSegment* seg, const int numSeg, const ClpRng& clpRng )
+{
+  const int iOffset  = edgeDir == EDGE_VER ? 1 : stride;
+  const int iSrcStep = edgeDir == EDGE_VER ? stride : 1;
 
-          bPartPNoFilter = bPartQNoFilter = false;
-          if (spsPaletteEnabledFlag)
-          {
-            // check if each of PUs is palette coded
-            bPartPNoFilter = bPartPNoFilter || CU::isPLT(cuP);
-            bPartQNoFilter = bPartQNoFilter || CU::isPLT(cuQ);
-          }
+  for( int iSeg = 0; iSeg < numSeg; iSeg++ )
+  {
+    const LFEdgeSegment& s = seg[iSeg];
 
-          if (dL < iBeta)
-          {
-            const bool filterP = (dpL < iSideThreshold);
-            const bool filterQ = (dqL < iSideThreshold);
+    if( !s.filter )
+    {
+      continue;
+    }
 
-            Pel* src0 = piTmpSrc + iSrcStep * (iIdx*pelsInPart + iBlkIdx * 4 + 0);
-            Pel* src3 = piTmpSrc + iSrcStep * (iIdx*pelsInPart + iBlkIdx * 4 + 3);
+    Pel* piTmpSrc = src + iSrcStep * iSeg * 4;
+
+    const int  iTc              = s.tc;
+    const int  iBeta            = s.beta;
+    const int  iSideThreshold   = ( iBeta + ( iBeta >> 1 ) ) >> 3;
+    const int  iThrCut          = iTc * 10;
+    const bool sidePisLarge     = s.sidePisLarge;
+    const bool sideQisLarge     = s.sideQisLarge;
+    const int  maxFilterLengthP = s.maxFilterLengthP;
+    const int  maxFilterLengthQ = s.maxFilterLengthQ;
+    const bool bPartPNoFilter   = s.partPNoFilter;
+    const bool bPartQNoFilter   = s.partQNoFilter;
+
+    const int dp0 = xCalcDP(piTmpSrc + iSrcStep * 0, iOffset);
+    const int dq0 = xCalcDQ(piTmpSrc + iSrcStep * 0, iOffset);
+    const int dp3 = xCalcDP(piTmpSrc + iSrcStep * 3, iOffset);
+    const int dq3 = xCalcDQ(piTmpSrc + iSrcStep * 3, iOffset);
+    int dp0L = dp0;
+    int dq0L = dq0;
+    int dp3L = dp3;
+    int dq3L = dq3;
 
-            // adjust decision so that it is not read beyond p5 is maxFilterLengthP is 5 and q5 if maxFilterLengthQ is 5
-            const bool swL = xUseStrongFiltering(src0, iOffset, 2 * d0L, iBeta, iTc, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ)
-              && xUseStrongFiltering(src3, iOffset, 2 * d3L, iBeta, iTc, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ);
-            if (swL)
-            {
-              useLongtapFilter = true;
-              for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++)
-              {
-                xPelFilterLuma(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + i), iOffset, iTc, swL, bPartPNoFilter, bPartQNoFilter, iThrCut, filterP, filterQ, clpRng, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ);
-              }
-            }
+    if (sidePisLarge)
+    {
+      dp0L = (dp0L + xCalcDP(piTmpSrc + iSrcStep * 0 - 3 * iOffset, iOffset) + 1) >> 1;
+      dp3L = (dp3L + xCalcDP(piTmpSrc + iSrcStep * 3 - 3 * iOffset, iOffset) + 1) >> 1;
+    }
+    if (sideQisLarge)
+    {
+      dq0L = (dq0L + xCalcDQ(piTmpSrc + iSrcStep * 0 + 3 * iOffset, iOffset) + 1) >> 1;
+      dq3L = (dq3L + xCalcDQ(piTmpSrc + iSrcStep * 3 + 3 * iOffset, iOffset) + 1) >> 1;
+    }
+    bool useLongtapFilter = false;
+    if (sidePisLarge || sideQisLarge)
+    {
+      int d0L = dp0L + dq0L;
+      int d3L = dp3L + dq3L;
+
+      int dpL = dp0L + dp3L;
+      int dqL = dq0L + dq3L;
+
+      int dL = d0L + d3L;
+
+      if (dL < iBeta)
+      {
+        const bool filterP = (dpL < iSideThreshold);
+        const bool filterQ = (dqL < iSideThreshold);
+
+        Pel* src0 = piTmpSrc + iSrcStep * 0;
+        Pel* src3 = piTmpSrc + iSrcStep * 3;
 
+        // adjust decision so that it is not read beyond p5 is maxFilterLengthP is 5 and q5 if maxFilterLengthQ is 5
+        const bool swL = xUseStrongFiltering(src0, iOffset, 2 * d0L, iBeta, iTc, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ)
+          && xUseStrongFiltering(src3, iOffset, 2 * d3L, iBeta, iTc, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ);
+        if (swL)
+        {
+          useLongtapFilter = true;
+          for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++)
+          {
+            xPelFilterLuma(piTmpSrc + iSrcStep * i, iOffset, iTc, swL, bPartPNoFilter, bPartQNoFilter, iThrCut, filterP, filterQ, clpRng, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ);
           }
         }
-        if (!useLongtapFilter)
-        {
-        const int d0 = dp0 + dq0;
-        const int d3 = dp3 + dq3;
+      }
+    }
+    if (!useLongtapFilter)
+    {
+      const int d0 = dp0 + dq0;
+      const int d3 = dp3 + dq3;
 
-        const int dp = dp0 + dp3;
-        const int dq = dq0 + dq3;
-        const int d  = d0  + d3;
+      const int dp = dp0 + dp3;
+      const int dq = dq0 + dq3;
+      const int d  = d0  + d3;
 
-        bPartPNoFilter = bPartQNoFilter = false;
-        if( spsPaletteEnabledFlag)
+      if( d < iBeta )
+      {
+        bool bFilterP = false;
+        bool bFilterQ = false;
+        if (maxFilterLengthP > 1 && maxFilterLengthQ > 1)
         {
-          // check if each of PUs is palette coded
-          bPartPNoFilter = bPartPNoFilter || CU::isPLT(cuP);
-          bPartQNoFilter = bPartQNoFilter || CU::isPLT(cuQ);
+          bFilterP = (dp < iSideThreshold);
+          bFilterQ = (dq < iSideThreshold);
         }
-
-        if( d < iBeta )
+        bool sw = false;
+        if (maxFilterLengthP > 2 && maxFilterLengthQ > 2)
         {
-          bool bFilterP = false;
-          bool bFilterQ = false;
-          if (maxFilterLengthP > 1 && maxFilterLengthQ > 1)
-          {
-            bFilterP = (dp < iSideThreshold);
-            bFilterQ = (dq < iSideThreshold);
-          }
-          bool sw = false;
-          if (maxFilterLengthP > 2 && maxFilterLengthQ > 2)
-          {
-            sw = xUseStrongFiltering(piTmpSrc + iSrcStep * (iIdx*pelsInPart + iBlkIdx * 4 + 0), iOffset, 2 * d0, iBeta, iTc)
-              && xUseStrongFiltering(piTmpSrc + iSrcStep * (iIdx*pelsInPart + iBlkIdx * 4 + 3), iOffset, 2 * d3, iBeta, iTc);
-          }
-          for( int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++ )
-          {
-            xPelFilterLuma( piTmpSrc + iSrcStep*( iIdx*pelsInPart + iBlkIdx * 4 + i ), iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng );
-          }
+          sw = xUseStrongFiltering(piTmpSrc + iSrcStep * 0, iOffset, 2 * d0, iBeta, iTc)
+            && xUseStrongFiltering(piTmpSrc + iSrcStep * 3, iOffset, 2 * d3, iBeta, iTc);
         }
+        for( int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++ )
+        {
+          xPelFilterLuma( piTmpSrc + iSrcStep * i, iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng );
         }
       }
     }
@@ -1240,7 +1286,6 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
   const unsigned uiPelsInPartChromaH = pcv.minCUWidth  >> ::getComponentScaleX(COMPONENT_Cb, nChromaFormat);
   const unsigned uiPelsInPartChromaV = pcv.minCUHeight >> ::getComponentScaleY(COMPONENT_Cb, nChromaFormat);
 
-  int       iOffset, iSrcStep;
   unsigned  uiLoopLength;
 
   bool      bPartPNoFilter  = false;
@@ -1281,8 +1326,6 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
   {
     xoffset      = 0;
     yoffset      = uiNumPelsLuma;
-    iOffset      = 1;
-    iSrcStep     = iStride;
     piTmpSrcCb  += iEdge*uiPelsInPartChromaH;
     piTmpSrcCr  += iEdge*uiPelsInPartChromaH;
     uiLoopLength = uiPelsInPartChromaV;
@@ -1292,8 +1335,6 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
   {
     xoffset      = uiNumPelsLuma;
     yoffset      = 0;
-    iOffset      = iStride;
-    iSrcStep     = 1;
     piTmpSrcCb  += iEdge*iStride*uiPelsInPartChromaV;
     piTmpSrcCr  += iEdge*iStride*uiPelsInPartChromaV;
     uiLoopLength = uiPelsInPartChromaH;
@@ -1302,11 +1343,17 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
 
   const int iBitdepthScale = 1 << (sps.getBitDepth(CHANNEL_TYPE_CHROMA) - 8);
 
+  // the filter decisions use the first and the last line of each segment
+  CHECK( int( uiLoopLength ) - 1 != ( ( ( edgeDir == EDGE_VER ) ? m_shiftVer : m_shiftHor ) == 1 ? 1 : 3 ), "Unsupported chroma deblocking segment length" );
+  LFEdgeSegment segs[2][MAX_CU_SIZE / 4];
+
   for( int iIdx = 0; iIdx < uiNumParts; iIdx++ )
   {
     pos.x += xoffset;
     pos.y += yoffset;
 
+    segs[0][iIdx].filter = segs[1][iIdx].filter = false;
+
     uiBsAbsIdx = getRasterIdx( pos, pcv );
     unsigned tmpBs = m_aapucBS[edgeDir][uiBsAbsIdx];
 
@@ -1373,9 +1420,6 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
       {
         if ((bS[chromaIdx] == 2) || (largeBoundary && (bS[chromaIdx] == 1)))
         {
-        const ClpRng& clpRng( cu.cs->slice->clpRng( ComponentID( chromaIdx + 1 )) );
-        Pel* piTmpSrcChroma = (chromaIdx == 0) ? piTmpSrcCb : piTmpSrcCr;
-
         const TransformUnit& tuQ = *cuQ.cs->getTU(recalcPosition( cu.chromaFormat, CHANNEL_TYPE_LUMA, CHANNEL_TYPE_CHROMA, pos), CHANNEL_TYPE_CHROMA);
         const TransformUnit& tuP = *cuP.cs->getTU(recalcPosition( cu.chromaFormat, CHANNEL_TYPE_LUMA, CHANNEL_TYPE_CHROMA, (edgeDir == EDGE_VER) ? pos.offset(-1, 0) : pos.offset(0, -1)), CHANNEL_TYPE_CHROMA);
 
@@ -1394,52 +1438,98 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
 
 #if JVET_Q0121_DEBLOCKING_CONTROL_PARAMETERS
         const int iIndexTC = Clip3<int>(0, MAX_QP + DEFAULT_INTRA_TC_OFFSET, iQP + DEFAULT_INTRA_TC_OFFSET * (bS[chromaIdx] - 1) + (tcOffsetDiv2[chromaIdx] << 1));
+        const int indexB   = Clip3<int>(0, MAX_QP, iQP + (betaOffsetDiv2[chromaIdx] << 1));
 #else
         const int iIndexTC = Clip3<int>(0, MAX_QP + DEFAULT_INTRA_TC_OFFSET, iQP + DEFAULT_INTRA_TC_OFFSET * (bS[chromaIdx] - 1) + (tcOffsetDiv2 << 1));
+        const int indexB   = Clip3<int>(0, MAX_QP, iQP + (betaOffsetDiv2 << 1));
 #endif
-        const int iTc = sps.getBitDepth(CHANNEL_TYPE_CHROMA) < 10 ? ((sm_tcTable[iIndexTC] + 2) >> (10 - sps.getBitDepth(CHANNEL_TYPE_CHROMA))) : ((sm_tcTable[iIndexTC]) << (sps.getBitDepth(CHANNEL_TYPE_CHROMA) - 10));
-        bool useLongFilter = false;
-        if (largeBoundary)
-        {
-#if JVET_Q0121_DEBLOCKING_CONTROL_PARAMETERS
-        const int indexB = Clip3<int>(0, MAX_QP, iQP + (betaOffsetDiv2[chromaIdx] << 1));
-#else
-        const int indexB = Clip3<int>(0, MAX_QP, iQP + (betaOffsetDiv2 << 1));
-#endif
-        const int beta = sm_betaTable[indexB] * iBitdepthScale;
 
-        const int dp0 = xCalcDP(piTmpSrcChroma + iSrcStep*(iIdx*uiLoopLength + 0), iOffset, isChromaHorCTBBoundary);
-        const int dq0 = xCalcDQ(piTmpSrcChroma + iSrcStep*(iIdx*uiLoopLength + 0), iOffset);
-        const int subSamplingShift = ( edgeDir == EDGE_VER ) ? m_shiftVer : m_shiftHor;
-        const int dp3 = (subSamplingShift == 1) ? xCalcDP(piTmpSrcChroma + iSrcStep*(iIdx*uiLoopLength + 1), iOffset, isChromaHorCTBBoundary) : xCalcDP(piTmpSrcChroma + iSrcStep*(iIdx*uiLoopLength + 3), iOffset, isChromaHorCTBBoundary);
-        const int dq3 = ( subSamplingShift == 1 ) ? xCalcDQ(piTmpSrcChroma + iSrcStep*(iIdx*uiLoopLength + 1), iOffset) : xCalcDQ(piTmpSrcChroma + iSrcStep*(iIdx*uiLoopLength + 3), iOffset);
+        LFEdgeSegment& seg         = segs[chromaIdx][iIdx];
+        seg.filter                 = true;
+        seg.tc                     = sps.getBitDepth(CHANNEL_TYPE_CHROMA) < 10 ? ((sm_tcTable[iIndexTC] + 2) >> (10 - sps.getBitDepth(CHANNEL_TYPE_CHROMA))) : ((sm_tcTable[iIndexTC]) << (sps.getBitDepth(CHANNEL_TYPE_CHROMA) - 10));
+        seg.beta                   = sm_betaTable[indexB] * iBitdepthScale;
+        seg.largeBoundary          = largeBoundary;
+        seg.isChromaHorCTBBoundary = isChromaHorCTBBoundary;
+        seg.partPNoFilter          = bPartPNoFilter;
+        seg.partQNoFilter          = bPartQNoFilter;
+        }
+      }
+    }
+  }
 
-        const int d0 = dp0 + dq0;
-        const int d3 = dp3 + dq3;
-        const int d = d0 + d3;
+  const ClpRng& clpRngCb( cu.cs->slice->clpRng( COMPONENT_Cb ) );
+  const ClpRng& clpRngCr( cu.cs->slice->clpRng( COMPONENT_Cr ) );
 
-          if (d < beta)
-          {
-            useLongFilter = true;
-            const bool sw = xUseStrongFiltering(piTmpSrcChroma + iSrcStep*(iIdx*uiLoopLength + 0), iOffset, 2 * d0, beta, iTc, false, false, 7, 7, isChromaHorCTBBoundary)
-              && xUseStrongFiltering(piTmpSrcChroma + iSrcStep*(iIdx*uiLoopLength + ((subSamplingShift == 1) ? 1 : 3)), iOffset, 2 * d3, beta, iTc, false, false, 7, 7, isChromaHorCTBBoundary);
+  m_filterChromaEdge( piTmpSrcCb, iStride, edgeDir, segs[0], uiNumParts, uiLoopLength, clpRngCb );
+  m_filterChromaEdge( piTmpSrcCr, iStride, edgeDir, segs[1], uiNumParts, uiLoopLength, clpRngCr );
+}
 
-            for (unsigned step = 0; step < uiLoopLength; step++)
-            {
-              xPelFilterChroma(piTmpSrcChroma + iSrcStep*(step + iIdx*uiLoopLength), iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
-            }
-          }
-        }
-        if ( !useLongFilter )
+/**
+ - Deblocking of the segments of one chroma edge
+ .
+ \param src       pointer to the first sample of the Q side of the edge
+ \param stride    stride of the picture data
+ \param edgeDir   direction of the edge
+ \param seg       filter parameters of the segments, segment i covers the lines segLength*i to segLength*(i+1)-1
+ \param numSeg    number of segments
+ \param segLength number of lines of a segment, the filter decisions use its first and last line
+ \param clpRng    clipping range of the chroma component
+*/
+void LoopFilter::filterChromaEdgeCore( Pel* src, const int stride, const DeblockEdgeDir edgeDir, const LFEdgeSegment* seg, const int numSeg, const int segLength, const ClpRng& clpRng )
+{
+  const int iOffset  = edgeDir == EDGE_VER ? 1 : stride;
+  const int iSrcStep = edgeDir == EDGE_VER ? stride : 1;
+
+  for( int iSeg = 0; iSeg < numSeg; iSeg++ )
+  {
+    const LFEdgeSegment& s = seg[iSeg];
+
+    if( !s.filter )
+    {
+      continue;
+    }
+
+    Pel* piTmpSrcChroma = src + iSrcStep * iSeg * segLength;
+
+    const int  iTc                    = s.tc;
+    const bool largeBoundary          = s.largeBoundary;
+    const bool isChromaHorCTBBoundary = s.isChromaHorCTBBoundary;
+    const bool bPartPNoFilter         = s.partPNoFilter;
+    const bool bPartQNoFilter         = s.partQNoFilter;
+
+    bool useLongFilter = false;
+    if (largeBoundary)
+    {
+      const int beta = s.beta;
+
+      const int dp0 = xCalcDP(piTmpSrcChroma, iOffset, isChromaHorCTBBoundary);
+      const int dq0 = xCalcDQ(piTmpSrcChroma, iOffset);
+      const int dp3 = xCalcDP(piTmpSrcChroma + iSrcStep * (segLength - 1), iOffset, isChromaHorCTBBoundary);
+      const int dq3 = xCalcDQ(piTmpSrcChroma + iSrcStep * (segLength - 1), iOffset);
+
+      const int d0 = dp0 + dq0;
+      const int d3 = dp3 + dq3;
+      const int d = d0 + d3;
+
+      if (d < beta)
+      {
+        useLongFilter = true;
+        const bool sw = xUseStrongFiltering(piTmpSrcChroma, iOffset, 2 * d0, beta, iTc, false, false, 7, 7, isChromaHorCTBBoundary)
+          && xUseStrongFiltering(piTmpSrcChroma + iSrcStep * (segLength - 1), iOffset, 2 * d3, beta, iTc, false, false, 7, 7, isChromaHorCTBBoundary);
+
+        for (unsigned step = 0; step < segLength; step++)
         {
-          for (unsigned step = 0; step < uiLoopLength; step++)
-          {
-            xPelFilterChroma(piTmpSrcChroma + iSrcStep*(step + iIdx*uiLoopLength), iOffset, iTc, false, bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
-          }
-        }
+          xPelFilterChroma(piTmpSrcChroma + iSrcStep * step, iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
         }
       }
     }
+    if ( !useLongFilter )
+    {
+      for (unsigned step = 0; step < segLength; step++)
+      {
+        xPelFilterChroma(piTmpSrcChroma + iSrcStep * step, iOffset, iTc, false, bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
+      }
+    }
   }
 }
 
@@ -1459,7 +1549,7 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
  \param bFilterSecondQ  decision weak filter/no filter for partQ
  \param bitDepthLuma    luma bit depth
 */
-inline void LoopFilter::xBilinearFilter(Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc) const
+inline void LoopFilter::xBilinearFilter(Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc)
 {
     int src;
     const char tc7[7] = { 6, 5, 4, 3, 2, 1, 1};
@@ -1480,7 +1570,7 @@ inline void LoopFilter::xBilinearFilter(Pel* srcP, Pel* srcQ, int offset, int re
     }
 }
 
-inline void LoopFilter::xFilteringPandQ(Pel* src, int offset, int numberPSide, int numberQSide, int tc) const
+inline void LoopFilter::xFilteringPandQ(Pel* src, int offset, int numberPSide, int numberQSide, int tc)
 {
   CHECK(numberPSide <= 3 && numberQSide <= 3, "Short filtering in long filtering function");
   Pel* srcP = src-offset;
@@ -1554,7 +1644,7 @@ inline void LoopFilter::xFilteringPandQ(Pel* src, int offset, int numberPSide, i
   xBilinearFilter(srcP,srcQ,offset,refMiddle,refP,refQ,numberPSide,numberQSide,dbCoeffsP,dbCoeffsQ,tc);
 }
 
-inline void LoopFilter::xPelFilterLuma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP, int maxFilterLengthQ) const
+inline void LoopFilter::xPelFilterLuma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP, int maxFilterLengthQ)
 {
   int delta;
 
@@ -1654,7 +1744,7 @@ inline void LoopFilter::xPelFilterLuma(Pel* piSrc, const int iOffset, const int
  \param bPartQNoFilter  indicator to disable filtering on partQ
  \param bitDepthChroma  chroma bit depth
  */
-inline void LoopFilter::xPelFilterChroma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary) const
+inline void LoopFilter::xPelFilterChroma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary)
 {
   int delta;
 
@@ -1723,7 +1813,7 @@ inline void LoopFilter::xPelFilterChroma(Pel* piSrc, const int iOffset, const in
  \param tc              tc value
  \param piSrc           pointer to picture data
  */
-inline bool LoopFilter::xUseStrongFiltering(Pel* piSrc, const int iOffset, const int d, const int beta, const int tc, bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP, int maxFilterLengthQ, bool isChromaHorCTBBoundary) const
+inline bool LoopFilter::xUseStrongFiltering(Pel* piSrc, const int iOffset, const int d, const int beta, const int tc, bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP, int maxFilterLengthQ, bool isChromaHorCTBBoundary)
 {
   const Pel m4 = piSrc[ 0          ];
   const Pel m3 = piSrc[-iOffset    ];
@@ -1809,7 +1899,7 @@ inline bool LoopFilter::xUseStrongFiltering(Pel* piSrc, const int iOffset, const
   return ( ( d_strong < ( beta >> 3 ) ) && ( d < ( beta >> 2 ) ) && ( abs( m3 - m4 ) < ( ( tc * 5 + 1 ) >> 1 ) ) );
 }
 
-inline int LoopFilter::xCalcDP(Pel* piSrc, const int iOffset, const bool isChromaHorCTBBoundary) const
+inline int LoopFilter::xCalcDP(Pel* piSrc, const int iOffset, const bool isChromaHorCTBBoundary)
 {
   if (isChromaHorCTBBoundary)
   {
@@ -1821,7 +1911,7 @@ inline int LoopFilter::xCalcDP(Pel* piSrc, const int iOffset, const bool isChrom
   }
 }
 
-inline int LoopFilter::xCalcDQ( Pel* piSrc, const int iOffset ) const
+inline int LoopFilter::xCalcDQ( Pel* piSrc, const int iOffset )
 {
   return abs( piSrc[0] - 2 * piSrc[iOffset] + piSrc[iOffset * 2] );
 }
@@ -47,6 +47,22 @@
 
 #define DEBLOCK_SMALLEST_BLOCK  8
 
+/// filter parameters of one edge segment, i.e. 4 luma lines or 2/4 chroma lines across the edge
+struct LFEdgeSegment
+{
+  bool    filter;                 ///< segment is filtered (bS > 0 and the neighbour is available)
+  int     tc;
+  int     beta;
+  uint8_t maxFilterLengthP;       ///< luma: maximum filter length of the P side, after the sub-block restriction
+  uint8_t maxFilterLengthQ;       ///< luma: maximum filter length of the Q side
+  bool    sidePisLarge;           ///< luma: long filters may be used on the P side
+  bool    sideQisLarge;           ///< luma: long filters may be used on the Q side
+  bool    largeBoundary;          ///< chroma: strong filters may be used
+  bool    isChromaHorCTBBoundary; ///< chroma: horizontal edge on a CTU boundary, the P side is restricted to 1 sample
+  bool    partPNoFilter;          ///< the P side is palette coded and not modified
+  bool    partQNoFilter;          ///< the Q side is palette coded and not modified
+};
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -88,19 +104,19 @@ private:
   void xSetMaxFilterLengthPQFromTransformSizes( const DeblockEdgeDir edgeDir, const CodingUnit& cu, const TransformUnit& currTU );
   void xSetMaxFilterLengthPQForCodingSubBlocks( const DeblockEdgeDir edgeDir, const CodingUnit& cu, const PredictionUnit& currPU, const bool& mvSubBlocks, const int& subBlockSize, const Area& areaPu );
 
-  inline void xBilinearFilter     ( Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc ) const;
-  inline void xFilteringPandQ     ( Pel* src, int offset, int numberPSide, int numberQSide, int tc ) const;
-  inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7 ) const;
-  inline void xPelFilterChroma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary) const;
-  inline bool xUseStrongFiltering(Pel* piSrc, const int iOffset, const int d, const int beta, const int tc, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7, bool isChromaHorCTBBoundary = false) const;//move the computation outside the function
+  static inline void xBilinearFilter     ( Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc );
+  static inline void xFilteringPandQ     ( Pel* src, int offset, int numberPSide, int numberQSide, int tc );
+  static inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7 );
+  static inline void xPelFilterChroma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary);
+  static inline bool xUseStrongFiltering(Pel* piSrc, const int iOffset, const int d, const int beta, const int tc, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7, bool isChromaHorCTBBoundary = false);//move the computation outside the function
   inline unsigned BsSet(unsigned val, const ComponentID compIdx) const;
   inline unsigned BsGet(unsigned val, const ComponentID compIdx) const;
 
   inline bool isCrossedByVirtualBoundaries ( const int xPos, const int yPos, const int width, const int height, int& numHorVirBndry, int& numVerVirBndry, int horVirBndryPos[], int verVirBndryPos[], const PicHeader* picHeader );
   inline void xDeriveEdgefilterParam       ( const int xPos, const int yPos, const int numVerVirBndry, const int numHorVirBndry, const int verVirBndryPos[], const int horVirBndryPos[], bool &verEdgeFilter, bool &horEdgeFilter );
 
-  inline int xCalcDP(Pel* piSrc, const int iOffset, const bool isChromaHorCTBBoundary = false) const;
-  inline int xCalcDQ              ( Pel* piSrc, const int iOffset ) const;
+  static inline int xCalcDP(Pel* piSrc, const int iOffset, const bool isChromaHorCTBBoundary = false);
+  static inline int xCalcDQ       ( Pel* piSrc, const int iOffset );
   static const uint16_t sm_tcTable[MAX_QP + 3];
   static const uint8_t sm_betaTable[MAX_QP + 1];
 
@@ -129,6 +145,19 @@ public:
   }
 
   void resetFilterLengths();
+
+  /// filter the segments of one edge, segment i starts at line i * 4 (luma) or i * segLength (chroma) of the edge at src
+  static void filterLumaEdgeCore  ( Pel* src, const int stride, const DeblockEdgeDir edgeDir, const LFEdgeSegment* seg, const int numSeg, const ClpRng& clpRng );
+  static void filterChromaEdgeCore( Pel* src, const int stride, const DeblockEdgeDir edgeDir, const LFEdgeSegment* seg, const int numSeg, const int segLength, const ClpRng& clpRng );
+
+  void ( *m_filterLumaEdge )  ( Pel* src, const int stride, const DeblockEdgeDir edgeDir, const LFEdgeSegment* seg, const int numSeg, const ClpRng& clpRng );
+  void ( *m_filterChromaEdge )( Pel* src, const int stride, const DeblockEdgeDir edgeDir, const LFEdgeSegment* seg, const int numSeg, const int segLength, const ClpRng& clpRng );
+
+#ifdef TARGET_SIMD_X86
+  void initLoopFilterX86();
+  template <X86_VEXT vext>
+  void _initLoopFilterX86();
+#endif
 };
 
 //! \}
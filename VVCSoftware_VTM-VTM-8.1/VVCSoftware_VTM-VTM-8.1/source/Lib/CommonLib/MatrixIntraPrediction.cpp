@@ -56,6 +56,18 @@ MatrixIntraPrediction::MatrixIntraPrediction():
   m_upsmpFactorHor( 0 ),
   m_upsmpFactorVer( 0 )
 {
+  m_boundaryDownsampling1D     = boundaryDownsampling1DCore;
+  m_predictionUpsampling1D     = predictionUpsampling1DCore;
+  m_computeReducedPred         = computeReducedPredCore;
+#if JVET_Q0446_MIP_CONST_SHIFT_OFFSET
+  m_computeReducedPredAllModes = computeReducedPredAllModesCore;
+#endif
+
+#if ENABLE_SIMD_OPT_MIP
+#ifdef TARGET_SIMD_X86
+  initMatrixIntraPredictionX86();
+#endif
+#endif
 }
 
 
@@ -83,10 +95,10 @@ void MatrixIntraPrediction::prepareInputForPred(const CPelBuf &pSrc, const Area&
   m_reducedBoundaryTransposed.resize( inputSize );
 
   int* const topReduced = m_reducedBoundary.data();
-  boundaryDownsampling1D( topReduced, m_refSamplesTop.data(), block.width, m_reducedBdrySize );
+  m_boundaryDownsampling1D( topReduced, m_refSamplesTop.data(), block.width, m_reducedBdrySize );
 
   int* const leftReduced = m_reducedBoundary.data() + m_reducedBdrySize;
-  boundaryDownsampling1D( leftReduced, m_refSamplesLeft.data(), block.height, m_reducedBdrySize );
+  m_boundaryDownsampling1D( leftReduced, m_refSamplesLeft.data(), block.height, m_reducedBdrySize );
 
   int* const leftReducedTransposed = m_reducedBoundaryTransposed.data();
   int* const topReducedTransposed  = m_reducedBoundaryTransposed.data() + m_reducedBdrySize;
@@ -134,10 +146,11 @@ void MatrixIntraPrediction::predBlock(int* const result, const int modeIdx, cons
   static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> bufReducedPred( m_reducedPredSize * m_reducedPredSize );
   int* const       reducedPred     = needUpsampling ? bufReducedPred.data() : result;
   const int* const reducedBoundary = transpose ? m_reducedBoundaryTransposed.data() : m_reducedBoundary.data();
+  const int        inputOffset     = transpose ? m_inputOffsetTransp : m_inputOffset;
 #if JVET_Q0446_MIP_CONST_SHIFT_OFFSET
-  computeReducedPred(reducedPred, reducedBoundary, matrix, transpose, bitDepth);
+  m_computeReducedPred( reducedPred, reducedBoundary, matrix, m_sizeId, inputOffset, transpose, bitDepth );
 #else
-  computeReducedPred( reducedPred, reducedBoundary, matrix, shiftMatrix, offsetMatrix, transpose, bitDepth );
+  m_computeReducedPred( reducedPred, reducedBoundary, matrix, shiftMatrix, offsetMatrix, m_sizeId, inputOffset, transpose, bitDepth );
 #endif
   if( needUpsampling )
   {
@@ -145,6 +158,50 @@ void MatrixIntraPrediction::predBlock(int* const result, const int modeIdx, cons
   }
 }
 
+void MatrixIntraPrediction::predBlockAllModes( Pel* const result, const int bitDepth )
+{
+  // all modes share the boundary prepared by prepareInputForPred, the non-transposed modes come first
+  const int numModes  = getNumModesMip( m_blockSize );
+  const int blockArea = m_blockSize.area();
+
+  static_vector<int, MIP_MAX_WIDTH * MIP_MAX_HEIGHT> predMip( blockArea );
+
+#if JVET_Q0446_MIP_CONST_SHIFT_OFFSET
+  // each matrix of the size class is applied to the regular and the transposed boundary in one pass
+  const int  numOutputs     = m_reducedPredSize * m_reducedPredSize;
+  const bool needUpsampling = ( m_upsmpFactorHor > 1 ) || ( m_upsmpFactorVer > 1 );
+
+  static_vector<int, MAX_NUM_MIP_MODE * MIP_MAX_REDUCED_OUTPUT_SAMPLES> reducedPred( 2 * numModes * numOutputs );
+  m_computeReducedPredAllModes( reducedPred.data(), m_reducedBoundary.data(), m_reducedBoundaryTransposed.data(), getMatrixData( 0 ),
+                                numModes, m_sizeId, m_inputOffset, m_inputOffsetTransp, bitDepth );
+#endif
+
+  for( int modeFull = 0; modeFull < 2 * numModes; modeFull++ )
+  {
+#if JVET_Q0446_MIP_CONST_SHIFT_OFFSET
+    const int* pred = reducedPred.data() + modeFull * numOutputs;
+
+    if( needUpsampling )
+    {
+      predictionUpsampling( predMip.data(), pred );
+      pred = predMip.data();
+    }
+#else
+    const bool transpose = modeFull >= numModes;
+
+    predBlock( predMip.data(), transpose ? modeFull - numModes : modeFull, transpose, bitDepth );
+
+    const int* pred = predMip.data();
+#endif
+
+    Pel* const dst = result + modeFull * blockArea;
+    for( int i = 0; i < blockArea; i++ )
+    {
+      dst[i] = Pel( pred[i] );
+    }
+  }
+}
+
 
 void MatrixIntraPrediction::initPredBlockParams(const Size& block)
 {
@@ -169,7 +226,7 @@ void MatrixIntraPrediction::initPredBlockParams(const Size& block)
 
 
 
-void MatrixIntraPrediction::boundaryDownsampling1D(int* reducedDst, const int* const fullSrc, const SizeType srcLen, const SizeType dstLen)
+void MatrixIntraPrediction::boundaryDownsampling1DCore(int* reducedDst, const int* const fullSrc, const SizeType srcLen, const SizeType dstLen)
 {
   if (dstLen < srcLen)
   {
@@ -200,12 +257,12 @@ void MatrixIntraPrediction::boundaryDownsampling1D(int* reducedDst, const int* c
 }
 
 
-void MatrixIntraPrediction::predictionUpsampling1D(int* const dst, const int* const src, const int* const bndry,
-                                                   const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
-                                                   const SizeType srcStep, const SizeType srcStride,
-                                                   const SizeType dstStep, const SizeType dstStride,
-                                                   const SizeType bndryStep,
-                                                   const unsigned int upsmpFactor )
+void MatrixIntraPrediction::predictionUpsampling1DCore(int* const dst, const int* const src, const int* const bndry,
+                                                       const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
+                                                       const SizeType srcStep, const SizeType srcStride,
+                                                       const SizeType dstStep, const SizeType dstStride,
+                                                       const SizeType bndryStep,
+                                                       const unsigned int upsmpFactor )
 {
   const int log2UpsmpFactor = floorLog2( upsmpFactor );
   CHECKD( upsmpFactor <= 1, "Upsampling factor must be at least 2." );
@@ -260,18 +317,18 @@ void MatrixIntraPrediction::predictionUpsampling( int* const dst, const int* con
     verSrc = horDst;
     verSrcStep *= m_upsmpFactorVer;
 
-    predictionUpsampling1D( horDst, src, m_refSamplesLeft.data(),
-                            m_reducedPredSize, m_reducedPredSize,
-                            1, m_reducedPredSize, 1, verSrcStep,
-                            m_upsmpFactorVer, m_upsmpFactorHor );
+    m_predictionUpsampling1D( horDst, src, m_refSamplesLeft.data(),
+                              m_reducedPredSize, m_reducedPredSize,
+                              1, m_reducedPredSize, 1, verSrcStep,
+                              m_upsmpFactorVer, m_upsmpFactorHor );
   }
 
   if( m_upsmpFactorVer > 1 )
   {
-    predictionUpsampling1D( dst, verSrc, m_refSamplesTop.data(),
-                            m_reducedPredSize, m_blockSize.width,
-                            verSrcStep, 1, m_blockSize.width, 1,
-                            1, m_upsmpFactorVer );
+    m_predictionUpsampling1D( dst, verSrc, m_refSamplesTop.data(),
+                              m_reducedPredSize, m_blockSize.width,
+                              verSrcStep, 1, m_blockSize.width, 1,
+                              1, m_upsmpFactorVer );
   }
 }
 
@@ -310,18 +367,19 @@ void MatrixIntraPrediction::getMatrixData(const uint8_t*& matrix, int &shiftMatr
   }
 }
 
-void MatrixIntraPrediction::computeReducedPred( int*const result, const int* const input, 
+void MatrixIntraPrediction::computeReducedPredCore( int*const result, const int* const input,
 #if JVET_Q0446_MIP_CONST_SHIFT_OFFSET
-                                                const uint8_t* matrix,
+                                                    const uint8_t* matrix,
 #else
-                                                const uint8_t*matrix, const int shiftMatrix, const int offsetMatrix,
+                                                    const uint8_t*matrix, const int shiftMatrix, const int offsetMatrix,
 #endif
-                                                const bool transpose, const int bitDepth )
+                                                    const int sizeId, const int inputOffset, const bool transpose, const int bitDepth )
 {
-  const int inputSize = 2 * m_reducedBdrySize;
+  const int inputSize       = ( sizeId == 0 ) ? 4 : 8;
+  const int reducedPredSize = ( sizeId < 2 ) ? 4 : 8;
 
   // use local buffer for transposed result
-  static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> resBufTransposed( m_reducedPredSize * m_reducedPredSize );
+  static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> resBufTransposed( reducedPredSize * reducedPredSize );
   int*const resPtr = (transpose) ? resBufTransposed.data() : result;
 
   int sum = 0;
@@ -334,13 +392,12 @@ void MatrixIntraPrediction::computeReducedPred( int*const result, const int* con
   CHECK( inputSize != 4 * (inputSize >> 2), "Error, input size not divisible by four" );
 
   const uint8_t *weight = matrix;
-  const int   inputOffset = transpose ? m_inputOffsetTransp : m_inputOffset;
 
-  const bool redSize = (m_sizeId == 2);
+  const bool redSize = (sizeId == 2);
   int posRes = 0;
-  for( int y = 0; y < m_reducedPredSize; y++ )
+  for( int y = 0; y < reducedPredSize; y++ )
   {
-    for( int x = 0; x < m_reducedPredSize; x++ )
+    for( int x = 0; x < reducedPredSize; x++ )
     {
       if( redSize ) weight -= 1;
       int tmp0 = redSize ? 0 : (input[0] * weight[0]);
@@ -366,12 +423,28 @@ void MatrixIntraPrediction::computeReducedPred( int*const result, const int* con
 
   if( transpose )
   {
-    for( int y = 0; y < m_reducedPredSize; y++ )
+    for( int y = 0; y < reducedPredSize; y++ )
     {
-      for( int x = 0; x < m_reducedPredSize; x++ )
+      for( int x = 0; x < reducedPredSize; x++ )
       {
-        result[ y * m_reducedPredSize + x ] = resPtr[ x * m_reducedPredSize + y ];
+        result[ y * reducedPredSize + x ] = resPtr[ x * reducedPredSize + y ];
       }
     }
   }
 }
+
+#if JVET_Q0446_MIP_CONST_SHIFT_OFFSET
+void MatrixIntraPrediction::computeReducedPredAllModesCore( int* const result, const int* const input, const int* const inputTransp,
+                                                            const uint8_t* matrices, const int numModes, const int sizeId,
+                                                            const int inputOffset, const int inputOffsetTransp, const int bitDepth )
+{
+  const int numOutputs = ( sizeId < 2 ) ? 16 : 64;
+  const int matrixSize = numOutputs * ( ( sizeId == 0 ) ? 4 : ( sizeId == 1 ) ? 8 : 7 );
+
+  for( int mode = 0; mode < numModes; mode++ )
+  {
+    computeReducedPredCore( result + mode * numOutputs,              input,       matrices + mode * matrixSize, sizeId, inputOffset,       false, bitDepth );
+    computeReducedPredCore( result + ( numModes + mode ) * numOutputs, inputTransp, matrices + mode * matrixSize, sizeId, inputOffsetTransp, true,  bitDepth );
+  }
+}
+#endif
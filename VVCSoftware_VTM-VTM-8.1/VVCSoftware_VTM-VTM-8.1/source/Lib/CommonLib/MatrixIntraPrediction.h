@@ -52,6 +52,55 @@ public:
 
   void prepareInputForPred(const CPelBuf &pSrc, const Area& block, const int bitDepth);
   void predBlock(int* const result, const int modeIdx, const bool transpose, const int bitDepth);
+  void predBlockAllModes(Pel* const result, const int bitDepth);
+
+  static void boundaryDownsampling1DCore( int* reducedDst, const int* const fullSrc, const SizeType srcLen, const SizeType dstLen );
+  static void predictionUpsampling1DCore( int* const dst, const int* const src, const int* const bndry,
+                                          const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
+                                          const SizeType srcStep, const SizeType srcStride,
+                                          const SizeType dstStep, const SizeType dstStride,
+                                          const SizeType bndryStep,
+                                          const unsigned int upsmpFactor );
+  static void computeReducedPredCore( int* const result, const int* const input,
+#if JVET_Q0446_MIP_CONST_SHIFT_OFFSET
+                                      const uint8_t* matrix,
+#else
+                                      const uint8_t* matrix, const int shiftMatrix, const int offsetMatrix,
+#endif
+                                      const int sizeId, const int inputOffset, const bool transpose, const int bitDepth );
+#if JVET_Q0446_MIP_CONST_SHIFT_OFFSET
+  static void computeReducedPredAllModesCore( int* const result, const int* const input, const int* const inputTransp,
+                                              const uint8_t* matrices, const int numModes, const int sizeId,
+                                              const int inputOffset, const int inputOffsetTransp, const int bitDepth );
+#endif
+
+  void (*m_boundaryDownsampling1D)( int* reducedDst, const int* const fullSrc, const SizeType srcLen, const SizeType dstLen );
+  void (*m_predictionUpsampling1D)( int* const dst, const int* const src, const int* const bndry,
+                                    const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
+                                    const SizeType srcStep, const SizeType srcStride,
+                                    const SizeType dstStep, const SizeType dstStride,
+                                    const SizeType bndryStep,
+                                    const unsigned int upsmpFactor );
+  void (*m_computeReducedPred)( int* const result, const int* const input,
+#if JVET_Q0446_MIP_CONST_SHIFT_OFFSET
+                                const uint8_t* matrix,
+#else
+                                const uint8_t* matrix, const int shiftMatrix, const int offsetMatrix,
+#endif
+                                const int sizeId, const int inputOffset, const bool transpose, const int bitDepth );
+#if JVET_Q0446_MIP_CONST_SHIFT_OFFSET
+  // reduced predictions of the numModes consecutive matrices for the regular and the transposed boundary, the results
+  // of the transposed modes follow the regular ones and are transposed like those of m_computeReducedPred
+  void (*m_computeReducedPredAllModes)( int* const result, const int* const input, const int* const inputTransp,
+                                        const uint8_t* matrices, const int numModes, const int sizeId,
+                                        const int inputOffset, const int inputOffsetTransp, const int bitDepth );
+#endif
+
+#ifdef TARGET_SIMD_X86
+  void initMatrixIntraPredictionX86();
+  template <X86_VEXT vext>
+  void _initMatrixIntraPredictionX86();
+#endif
 
   private:
     static_vector<int, MIP_MAX_INPUT_SIZE> m_reducedBoundary;           // downsampled             boundary of a block
@@ -70,15 +119,7 @@ public:
 
     void initPredBlockParams(const Size& block);
 
-    static void boundaryDownsampling1D(int* reducedDst, const int* const fullSrc, const SizeType srcLen, const SizeType dstLen);
-
     void predictionUpsampling( int* const dst, const int* const src ) const;
-    static void predictionUpsampling1D( int* const dst, const int* const src, const int* const bndry,
-                                        const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
-                                        const SizeType srcStep, const SizeType srcStride,
-                                        const SizeType dstStep, const SizeType dstStride,
-                                        const SizeType bndryStep,
-                                        const unsigned int upsmpFactor );
 
 #if JVET_Q0446_MIP_CONST_SHIFT_OFFSET
     const uint8_t* getMatrixData(const int modeIdx) const;
@@ -86,14 +127,6 @@ public:
     void getMatrixData(const uint8_t*& matrix, int &shiftMatrix, int &offsetMatrix, const int modeIdx) const;
 #endif
 
-
-    void computeReducedPred( int*const result, const int* const input, 
-#if JVET_Q0446_MIP_CONST_SHIFT_OFFSET
-                             const uint8_t* matrix,
-#else
-                             const uint8_t*matrix, const int shiftMatrix, const int offsetMatrix,
-#endif
-                             const bool transpose, const int bitDepth );
   };
 
 #endif //__MATRIXINTRAPPREDICTION__
@@ -49,6 +49,11 @@
 
 
 FpDistFunc RdCost::m_afpDistortFunc[DF_TOTAL_FUNCTIONS] = { nullptr, };
+FpDmvrCostFunc RdCost::m_fpDmvrCosts = nullptr;
+FpPlaneSSEFunc RdCost::m_fpPlaneSSE  = nullptr;
+#if WCG_WPSNR
+FpPlaneWtdSSEFunc RdCost::m_fpPlaneWtdSSE = nullptr;
+#endif
 
 RdCost::RdCost()
 {
@@ -209,6 +214,12 @@ void RdCost::init()
   m_afpDistortFunc[DF_SAD_WITH_MASK] = RdCost::xGetSADwMask;
 #endif
 
+  m_fpDmvrCosts = RdCost::xGetDmvrCosts;
+  m_fpPlaneSSE  = RdCost::xGetPlaneSSE;
+#if WCG_WPSNR
+  m_fpPlaneWtdSSE = RdCost::xGetPlaneWtdSSE;
+#endif
+
 #if ENABLE_SIMD_OPT_DIST
 #ifdef TARGET_SIMD_X86
   initRdCostX86();
@@ -474,6 +485,35 @@ Distortion RdCost::getDistPart( const CPelBuf &org, const CPelBuf &cur, int bitD
 // SAD
 // --------------------------------------------------------------------------------------------------------------------
 
+/** DMVR costs of the integer search grid
+ * The L1 block is displaced in the opposite direction of the L0 block (mirrored MVD). Only every second row is
+ * used, so the costs equal the distortion of the DMVR SAD with a sub-sampling shift of 1.
+ */
+void RdCost::xGetDmvrCosts( const Pel* pRefL0, const Pel* pRefL1, int stride, int width, int height, int bitDepth, Distortion* pCosts )
+{
+  for( int offY = -DMVR_NUM_ITERATION; offY <= DMVR_NUM_ITERATION; offY++ )
+  {
+    for( int offX = -DMVR_NUM_ITERATION; offX <= DMVR_NUM_ITERATION; offX++ )
+    {
+      const Pel* piL0 = pRefL0 + offY * stride + offX;
+      const Pel* piL1 = pRefL1 - offY * stride - offX;
+      Distortion uiSum = 0;
+
+      for( int y = 0; y < height; y += 2 )
+      {
+        for( int x = 0; x < width; x++ )
+        {
+          uiSum += abs( piL0[x] - piL1[x] );
+        }
+        piL0 += stride << 1;
+        piL1 += stride << 1;
+      }
+
+      *pCosts++ = ( uiSum << 1 ) >> DISTORTION_PRECISION_ADJUSTMENT( bitDepth );
+    }
+  }
+}
+
 Distortion RdCost::xGetSAD_full( const DistParam& rcDtParam )
 {
   CHECK( rcDtParam.applyWeight, "Cannot apply weight when using full-bit SAD!" );
@@ -2143,6 +2183,45 @@ Distortion RdCost::xGetSSE64( const DistParam &rcDtParam )
   return ( uiSum );
 }
 
+Distortion RdCost::xGetPlaneSSE( const Pel* pSrc0, int stride0, const Pel* pSrc1, int stride1, int width, int height )
+{
+  Distortion uiSum = 0;
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
+      uiSum += Distortion( iTemp * iTemp );
+    }
+    pSrc0 += stride0;
+    pSrc1 += stride1;
+  }
+
+  return uiSum;
+}
+
+#if WCG_WPSNR
+double RdCost::xGetPlaneWtdSSE( const Pel* pSrc0, int stride0, const Pel* pSrc1, int stride1, const Pel* pLuma, int strideLuma, int csx, int csy, int width, int height, const double* weightLUT )
+{
+  double dSum = 0;
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
+      dSum += weightLUT[pLuma[x << csx]] * ( double ) iTemp * ( double ) iTemp;
+    }
+    pSrc0 += stride0;
+    pSrc1 += stride1;
+    pLuma += strideLuma << csy;
+  }
+
+  return dSum;
+}
+#endif
+
 // --------------------------------------------------------------------------------------------------------------------
 // HADAMARD with step (used in fractional search)
 // --------------------------------------------------------------------------------------------------------------------
@@ -58,6 +58,11 @@ class EncCfg;
 
 // for function pointer
 typedef Distortion (*FpDistFunc) (const DistParam&);
+typedef void       (*FpDmvrCostFunc) (const Pel*, const Pel*, int, int, int, int, Distortion*);
+typedef Distortion (*FpPlaneSSEFunc) (const Pel*, int, const Pel*, int, int, int);
+#if WCG_WPSNR
+typedef double     (*FpPlaneWtdSSEFunc) (const Pel*, int, const Pel*, int, const Pel*, int, int, int, int, int, const double*);
+#endif
 
 // ====================================================================================================================
 // Class definition
@@ -115,6 +120,11 @@ private:
   // for distortion
 
   static FpDistFunc       m_afpDistortFunc[DF_TOTAL_FUNCTIONS]; // [eDFunc]
+  static FpDmvrCostFunc   m_fpDmvrCosts;
+  static FpPlaneSSEFunc   m_fpPlaneSSE;
+#if WCG_WPSNR
+  static FpPlaneWtdSSEFunc m_fpPlaneWtdSSE;
+#endif
   CostMode                m_costMode;
   double                  m_distortionWeight[MAX_NUM_COMPONENT]; // only chroma values are used.
   double                  m_dLambda;
@@ -184,6 +194,16 @@ public:
   void           setDistParam( DistParam &rcDP, const CPelBuf &org, const Pel* piRefY, int iRefStride, const Pel* mask, int iMaskStride, int stepX, int iMaskStride2, int bitDepth,  ComponentID compID);
 #endif
 
+  // DMVR costs of all (2 * DMVR_NUM_ITERATION + 1)^2 integer offsets around the given positions, row by row
+  void           getDmvrCosts( const Pel* pRefL0, const Pel* pRefL1, int stride, int width, int height, int bitDepth, Distortion* pCosts ) { m_fpDmvrCosts( pRefL0, pRefL1, stride, width, height, bitDepth, pCosts ); }
+
+  // full precision SSE of two planes of any size (e.g. for the PSNR of a picture)
+  Distortion     getPlaneSSE( const CPelBuf& pic0, const CPelBuf& pic1 ) { return m_fpPlaneSSE( pic0.buf, pic0.stride, pic1.buf, pic1.stride, pic0.width, pic0.height ); }
+#if WCG_WPSNR
+  // SSE weighted by the WPSNR luma level weight of the co-located luma sample in picLuma
+  double         getPlaneWeightedSSE( const CPelBuf& pic0, const CPelBuf& pic1, const CPelBuf& picLuma, int csx, int csy ) { return m_fpPlaneWtdSSE( pic0.buf, pic0.stride, pic1.buf, pic1.stride, picLuma.buf, picLuma.stride, csx, csy, pic0.width, pic0.height, m_lumaLevelToWeightPLUT.data() ); }
+#endif
+
   double         getMotionLambda          ( )  { return m_dLambdaMotionSAD; }
   void           selectMotionLambda       ( )  { m_motionLambda = getMotionLambda( ); }
   void           setPredictor             ( const Mv& rcMv )
@@ -370,6 +390,11 @@ private:
 #if JVET_Q0806
   static Distortion xGetSADwMask      ( const DistParam& pcDtParam );
 #endif
+  static void       xGetDmvrCosts     ( const Pel* pRefL0, const Pel* pRefL1, int stride, int width, int height, int bitDepth, Distortion* pCosts );
+  static Distortion xGetPlaneSSE      ( const Pel* pSrc0, int stride0, const Pel* pSrc1, int stride1, int width, int height );
+#if WCG_WPSNR
+  static double     xGetPlaneWtdSSE   ( const Pel* pSrc0, int stride0, const Pel* pSrc1, int stride1, const Pel* pLuma, int strideLuma, int csx, int csy, int width, int height, const double* weightLUT );
+#endif
 
   static Distortion xGetMRSAD         ( const DistParam& pcDtParam );
   static Distortion xGetMRSAD4        ( const DistParam& pcDtParam );
@@ -405,6 +430,20 @@ private:
   static Distortion xGetSAD_NxN_SIMD( const DistParam& pcDtParam );
   template<X86_VEXT vext>
   static Distortion xGetSAD_IBD_SIMD( const DistParam& pcDtParam );
+  template<X86_VEXT vext>
+  static Distortion xGetMRSAD_SIMD  ( const DistParam& pcDtParam );
+  template<X86_VEXT vext>
+  static void       xGetDmvrCosts_SIMD( const Pel* pRefL0, const Pel* pRefL1, int stride, int width, int height, int bitDepth, Distortion* pCosts );
+  template<X86_VEXT vext>
+  static Distortion xGetPlaneSSE_SIMD ( const Pel* pSrc0, int stride0, const Pel* pSrc1, int stride1, int width, int height );
+#if WCG_WPSNR
+  template<X86_VEXT vext>
+  static double     xGetPlaneWtdSSE_SIMD( const Pel* pSrc0, int stride0, const Pel* pSrc1, int stride1, const Pel* pLuma, int strideLuma, int csx, int csy, int width, int height, const double* weightLUT );
+#endif
+#if WCG_EXT
+  template<X86_VEXT vext>
+  static Distortion xGetSSE_WTD_SIMD( const DistParam& pcDtParam );
+#endif
 
   template<X86_VEXT vext>
   static Distortion xGetHADs_SIMD   ( const DistParam& pcDtParam );
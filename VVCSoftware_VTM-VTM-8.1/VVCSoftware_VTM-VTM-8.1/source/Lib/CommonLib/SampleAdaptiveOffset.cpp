@@ -113,6 +113,16 @@ const SAOBlkParam& SAOBlkParam::operator= (const SAOBlkParam& src)
 SampleAdaptiveOffset::SampleAdaptiveOffset()
 {
   m_numberOfComponents = 0;
+
+  m_offsetBlock = offsetBlockCore;
+  m_calcEdgeStats = calcEdgeStatsCore;
+  m_calcBandStats = calcBandStatsCore;
+
+#if ENABLE_SIMD_OPT_SAO
+#ifdef TARGET_SIMD_X86
+  initSampleAdaptiveOffsetX86();
+#endif
+#endif
 }
 
 
@@ -295,6 +305,19 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
                                           , bool isLeftAvail,  bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail
                                           , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
   )
+{
+  m_offsetBlock( channelBitDepth, clpRng, typeIdx, offset, srcBlk, resBlk, srcStride, resStride, width, height
+               , isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail, isBelowLeftAvail, isBelowRightAvail
+               , isCtuCrossedByVirtualBoundaries, horVirBndryPos, verVirBndryPos, numHorVirBndry, numVerVirBndry
+               , m_signLineBuf1, m_signLineBuf2 );
+}
+
+void SampleAdaptiveOffset::offsetBlockCore(const int channelBitDepth, const ClpRng& clpRng, int typeIdx, int* offset
+                                          , const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride,  int width, int height
+                                          , bool isLeftAvail,  bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail
+                                          , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
+                                          , std::vector<int8_t>& signLineBuf1, std::vector<int8_t>& signLineBuf2
+  )
 {
   int x,y, startX, startY, endX, endY, edgeType;
   int firstLineStartX, firstLineEndX, lastLineStartX, lastLineEndX;
@@ -335,7 +358,7 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
   case SAO_TYPE_EO_90:
     {
       offset += 2;
-      int8_t *signUpLine = &m_signLineBuf1[0];
+      int8_t *signUpLine = &signLineBuf1[0];
 
       startY = isAboveAvail ? 0 : 1;
       endY   = isBelowAvail ? height : height-1;
@@ -380,8 +403,8 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
       offset += 2;
       int8_t *signUpLine, *signDownLine, *signTmpLine;
 
-      signUpLine  = &m_signLineBuf1[0];
-      signDownLine= &m_signLineBuf2[0];
+      signUpLine  = &signLineBuf1[0];
+      signDownLine= &signLineBuf2[0];
 
       startX = isLeftAvail ? 0 : 1 ;
       endX   = isRightAvail ? width : (width-1);
@@ -458,7 +481,7 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
   case SAO_TYPE_EO_45:
     {
       offset += 2;
-      int8_t *signUpLine = &m_signLineBuf1[1];
+      int8_t *signUpLine = &signLineBuf1[1];
 
       startX = isLeftAvail ? 0 : 1;
       endX   = isRightAvail ? width : (width -1);
@@ -546,6 +569,38 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
   }
 }
 
+void SampleAdaptiveOffset::calcEdgeStatsCore( const Pel* srcLine, int srcStride, const Pel* orgLine, int orgStride, int startX, int endX, int height
+                                            , ptrdiff_t offA, ptrdiff_t offB, int64_t* diff, int64_t* count )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = startX; x < endX; x++ )
+    {
+      const int edgeType = sgn( srcLine[x] - srcLine[x + offA] ) + sgn( srcLine[x] - srcLine[x + offB] );
+      diff [edgeType] += ( orgLine[x] - srcLine[x] );
+      count[edgeType] ++;
+    }
+    srcLine += srcStride;
+    orgLine += orgStride;
+  }
+}
+
+void SampleAdaptiveOffset::calcBandStatsCore( const Pel* srcLine, int srcStride, const Pel* orgLine, int orgStride, int startX, int endX, int height
+                                            , int shiftBits, int64_t* diff, int64_t* count )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = startX; x < endX; x++ )
+    {
+      const int bandIdx = srcLine[x] >> shiftBits;
+      diff [bandIdx] += ( orgLine[x] - srcLine[x] );
+      count[bandIdx] ++;
+    }
+    srcLine += srcStride;
+    orgLine += orgStride;
+  }
+}
+
 void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& src, PelUnitBuf& res, SAOBlkParam& saoblkParam, CodingStructure& cs)
 {
   const uint32_t numberOfComponents = getNumberValidComponents( area.chromaFormat );
@@ -87,13 +87,44 @@ protected:
                   , bool isLeftAvail, bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail
                   , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
     );
+public:
+  static void offsetBlockCore(const int channelBitDepth, const ClpRng& clpRng, int typeIdx, int* offset, const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride,  int width, int height
+                  , bool isLeftAvail, bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail
+                  , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
+                  , std::vector<int8_t>& signLineBuf1, std::vector<int8_t>& signLineBuf2
+    );
+
+  void (*m_offsetBlock)(const int channelBitDepth, const ClpRng& clpRng, int typeIdx, int* offset, const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride,  int width, int height
+                  , bool isLeftAvail, bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail
+                  , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
+                  , std::vector<int8_t>& signLineBuf1, std::vector<int8_t>& signLineBuf2
+    );
+
+  // encoder statistics of the samples [startX, endX) of height lines, the edge class of a sample is derived from its
+  // neighbours at srcLine + offA and srcLine + offB, diff and count point to the edge class 0 (edge index 2)
+  static void calcEdgeStatsCore( const Pel* srcLine, int srcStride, const Pel* orgLine, int orgStride, int startX, int endX, int height
+                               , ptrdiff_t offA, ptrdiff_t offB, int64_t* diff, int64_t* count );
+  static void calcBandStatsCore( const Pel* srcLine, int srcStride, const Pel* orgLine, int orgStride, int startX, int endX, int height
+                               , int shiftBits, int64_t* diff, int64_t* count );
+
+  void (*m_calcEdgeStats)( const Pel* srcLine, int srcStride, const Pel* orgLine, int orgStride, int startX, int endX, int height
+                         , ptrdiff_t offA, ptrdiff_t offB, int64_t* diff, int64_t* count );
+  void (*m_calcBandStats)( const Pel* srcLine, int srcStride, const Pel* orgLine, int orgStride, int startX, int endX, int height
+                         , int shiftBits, int64_t* diff, int64_t* count );
+
+#ifdef TARGET_SIMD_X86
+  void initSampleAdaptiveOffsetX86();
+  template <X86_VEXT vext>
+  void _initSampleAdaptiveOffsetX86();
+#endif
+protected:
   void invertQuantOffsets(ComponentID compIdx, int typeIdc, int typeAuxInfo, int* dstOffsets, int* srcOffsets);
   void reconstructBlkSAOParam(SAOBlkParam& recParam, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
   int  getMergeList(CodingStructure& cs, int ctuRsAddr, SAOBlkParam* blkParams, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
   void offsetCTU(const UnitArea& area, const CPelUnitBuf& src, PelUnitBuf& res, SAOBlkParam& saoblkParam, CodingStructure& cs);
   void xReconstructBlkSAOParams(CodingStructure& cs, SAOBlkParam* saoBlkParams);
   bool isCrossedByVirtualBoundaries(const int xPos, const int yPos, const int width, const int height, int& numHorVirBndry, int& numVerVirBndry, int horVirBndryPos[], int verVirBndryPos[], const PicHeader* picHeader);
-  inline bool isProcessDisabled(int xPos, int yPos, int numVerVirBndry, int numHorVirBndry, int verVirBndryPos[], int horVirBndryPos[])
+  static inline bool isProcessDisabled(int xPos, int yPos, int numVerVirBndry, int numHorVirBndry, int verVirBndryPos[], int horVirBndryPos[])
   {
     bool bDisabledFlag = false;
     for (int i = 0; i < numVerVirBndry; i++)
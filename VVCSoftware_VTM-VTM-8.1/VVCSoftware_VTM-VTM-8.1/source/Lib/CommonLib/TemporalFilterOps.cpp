@@ -0,0 +1,141 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TemporalFilterOps.cpp
+    \brief    sample kernels of the motion compensated temporal pre-filter
+*/
+
+#include "TemporalFilterOps.h"
+
+#include <cmath>
+
+//! \ingroup CommonLib
+//! \{
+
+int tempFilterBlockSSECore( const Pel* org, int orgStride, const Pel* cur, int curStride, int width, int height, int maxError )
+{
+  int error = 0;
+
+  for( int y = 0; y < height; y++, org += orgStride, cur += curStride )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const int diff = org[x] - cur[x];
+      error += diff * diff;
+    }
+    if( error > maxError )
+    {
+      return error;
+    }
+  }
+
+  return error;
+}
+
+void tempFilterInterpolateCore( const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height, const int* xFilter, const int* yFilter, Pel maxValue )
+{
+  const int numFilterTaps   = 7;
+  const int centreTapOffset = 3;
+
+  CHECK( width > 64 || height > 64, "Unsupported block size" );
+
+  int tempArray[64 + numFilterTaps][64];
+
+  for( int by = 1; by < height + numFilterTaps; by++ )
+  {
+    const Pel* sourceRow = src + ( by - centreTapOffset ) * srcStride;
+    for( int bx = 0; bx < width; bx++ )
+    {
+      const Pel* rowStart = sourceRow + bx - centreTapOffset;
+
+      int sum = 0;
+      sum += xFilter[1] * rowStart[1];
+      sum += xFilter[2] * rowStart[2];
+      sum += xFilter[3] * rowStart[3];
+      sum += xFilter[4] * rowStart[4];
+      sum += xFilter[5] * rowStart[5];
+      sum += xFilter[6] * rowStart[6];
+
+      tempArray[by][bx] = sum;
+    }
+  }
+
+  for( int by = 0; by < height; by++, dst += dstStride )
+  {
+    for( int bx = 0; bx < width; bx++ )
+    {
+      int sum = 0;
+      sum += yFilter[1] * tempArray[by + 1][bx];
+      sum += yFilter[2] * tempArray[by + 2][bx];
+      sum += yFilter[3] * tempArray[by + 3][bx];
+      sum += yFilter[4] * tempArray[by + 4][bx];
+      sum += yFilter[5] * tempArray[by + 5][bx];
+      sum += yFilter[6] * tempArray[by + 6][bx];
+
+      sum = ( sum + ( 1 << 11 ) ) >> 12;
+      dst[bx] = sum < 0 ? 0 : ( sum > maxValue ? maxValue : sum );
+    }
+  }
+}
+
+void tempFilterBilateralRowCore( const Pel* org, const Pel* const* refs, const double* const* weightLUTs, int numRefs, Pel* dst, int width, Pel maxValue )
+{
+  for( int x = 0; x < width; x++ )
+  {
+    const int orgVal = ( int ) org[x];
+    double temporalWeightSum = 1.0;
+    double newVal = ( double ) orgVal;
+    for( int i = 0; i < numRefs; i++ )
+    {
+      const int    refVal = ( int ) refs[i][x];
+      const double weight = weightLUTs[i][refVal - orgVal];
+      newVal += weight * refVal;
+      temporalWeightSum += weight;
+    }
+    newVal /= temporalWeightSum;
+    Pel sampleVal = ( Pel ) round( newVal );
+    sampleVal = ( sampleVal < 0 ? 0 : ( sampleVal > maxValue ? maxValue : sampleVal ) );
+    dst[x] = sampleVal;
+  }
+}
+
+TemporalFilterOps::TemporalFilterOps()
+{
+  blockSSE     = tempFilterBlockSSECore;
+  interpolate  = tempFilterInterpolateCore;
+  bilateralRow = tempFilterBilateralRowCore;
+}
+
+TemporalFilterOps g_tempFilterOP = TemporalFilterOps();
+
+//! \}
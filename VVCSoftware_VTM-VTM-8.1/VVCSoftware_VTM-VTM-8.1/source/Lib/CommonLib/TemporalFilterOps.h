@@ -0,0 +1,76 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TemporalFilterOps.h
+    \brief    sample kernels of the motion compensated temporal pre-filter (header)
+*/
+
+#ifndef __TEMPORALFILTEROPS__
+#define __TEMPORALFILTEROPS__
+
+#include "CommonDef.h"
+
+//! \ingroup CommonLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+struct TemporalFilterOps
+{
+  TemporalFilterOps();
+
+#if ENABLE_SIMD_OPT_MCTF && defined(TARGET_SIMD_X86)
+  void initTemporalFilterOpsX86();
+  template<X86_VEXT vext>
+  void _initTemporalFilterOpsX86();
+#endif
+
+  // SSE of a block, may return early with a partial error as soon as it exceeds maxError
+  int  ( *blockSSE )      ( const Pel* org, int orgStride, const Pel* cur, int curStride, int width, int height, int maxError );
+  // separable 6-tap interpolation with the taps 1..6 of the 8-tap filters, src points at the integer sample position
+  void ( *interpolate )   ( const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height, const int* xFilter, const int* yFilter, Pel maxValue );
+  // blending of a row with the motion compensated references, the weights are looked up by the difference ref - org
+  void ( *bilateralRow )  ( const Pel* org, const Pel* const* refs, const double* const* weightLUTs, int numRefs, Pel* dst, int width, Pel maxValue );
+};
+
+extern TemporalFilterOps g_tempFilterOP;
+
+int  tempFilterBlockSSECore    ( const Pel* org, int orgStride, const Pel* cur, int curStride, int width, int height, int maxError );
+void tempFilterInterpolateCore ( const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height, const int* xFilter, const int* yFilter, Pel maxValue );
+void tempFilterBilateralRowCore( const Pel* org, const Pel* const* refs, const double* const* weightLUTs, int numRefs, Pel* dst, int width, Pel maxValue );
+
+//! \}
+
+#endif // __TEMPORALFILTEROPS__
@@ -180,6 +180,16 @@ TrQuant::TrQuant() : m_quant( nullptr )
     m_fwdICT[ 3]  = fwdTransformCbCr< 3>;
     m_fwdICT[-3]  = fwdTransformCbCr<-3>;
   }
+
+  m_invTrans2D      = invTransform2DCore;
+  m_fwdTrans2D      = fwdTransform2DCore;
+  m_fwdTrans2DMulti = fwdTransform2DMultiCore;
+
+#if ENABLE_SIMD_OPT_TRAFO
+#ifdef TARGET_SIMD_X86
+  initTrQuantX86();
+#endif
+#endif
 }
 
 TrQuant::~TrQuant()
@@ -746,22 +756,15 @@ void TrQuant::getTrTypes(const TransformUnit tu, const ComponentID compID, int &
 
 
 
-void TrQuant::xT( const TransformUnit &tu, const ComponentID &compID, const CPelBuf &resi, CoeffBuf &dstCoeff, const int width, const int height )
+void TrQuant::xGetTrParams( const TransformUnit &tu, const ComponentID &compID, const int width, const int height, int &trTypeHor, int &trTypeVer, int &skipWidth, int &skipHeight )
 {
-  const unsigned maxLog2TrDynamicRange  = tu.cs->sps->getMaxLog2TrDynamicRange( toChannelType( compID ) );
-  const unsigned bitDepth               = tu.cs->sps->getBitDepth(              toChannelType( compID ) );
-  const int      TRANSFORM_MATRIX_SHIFT = g_transformMatrixShift[TRANSFORM_FORWARD];
-  const uint32_t transformWidthIndex    = floorLog2(width ) - 1;  // nLog2WidthMinus1, since transform start from 2-point
-  const uint32_t transformHeightIndex   = floorLog2(height) - 1;  // nLog2HeightMinus1, since transform start from 2-point
-
-
-  int trTypeHor = DCT2;
-  int trTypeVer = DCT2;
+  trTypeHor = DCT2;
+  trTypeVer = DCT2;
 
   getTrTypes ( tu, compID, trTypeHor, trTypeVer );
 
-  int  skipWidth  = ( trTypeHor != DCT2 && width  == 32 ) ? 16 : width  > JVET_C0024_ZERO_OUT_TH ? width  - JVET_C0024_ZERO_OUT_TH : 0;
-  int  skipHeight = ( trTypeVer != DCT2 && height == 32 ) ? 16 : height > JVET_C0024_ZERO_OUT_TH ? height - JVET_C0024_ZERO_OUT_TH : 0;
+  skipWidth  = ( trTypeHor != DCT2 && width  == 32 ) ? 16 : width  > JVET_C0024_ZERO_OUT_TH ? width  - JVET_C0024_ZERO_OUT_TH : 0;
+  skipHeight = ( trTypeVer != DCT2 && height == 32 ) ? 16 : height > JVET_C0024_ZERO_OUT_TH ? height - JVET_C0024_ZERO_OUT_TH : 0;
   if( tu.cs->sps->getUseLFNST() && tu.cu->lfnstIdx )
   {
     if( (width == 4 && height > 4) || (width > 4 && height == 4) )
@@ -775,6 +778,20 @@ void TrQuant::xT( const TransformUnit &tu, const ComponentID &compID, const CPel
       skipHeight = height - 8;
     }
   }
+}
+
+void TrQuant::xT( const TransformUnit &tu, const ComponentID &compID, const CPelBuf &resi, CoeffBuf &dstCoeff, const int width, const int height )
+{
+  const unsigned maxLog2TrDynamicRange  = tu.cs->sps->getMaxLog2TrDynamicRange( toChannelType( compID ) );
+  const unsigned bitDepth               = tu.cs->sps->getBitDepth(              toChannelType( compID ) );
+  const int      TRANSFORM_MATRIX_SHIFT = g_transformMatrixShift[TRANSFORM_FORWARD];
+  const uint32_t transformWidthIndex    = floorLog2(width ) - 1;  // nLog2WidthMinus1, since transform start from 2-point
+  const uint32_t transformHeightIndex   = floorLog2(height) - 1;  // nLog2HeightMinus1, since transform start from 2-point
+
+
+  int trTypeHor, trTypeVer, skipWidth, skipHeight;
+
+  xGetTrParams( tu, compID, width, height, trTypeHor, trTypeVer, skipWidth, skipHeight );
 
 #if RExt__DECODER_DEBUG_TOOL_STATISTICS
   if ( trTypeHor != DCT2 )
@@ -783,6 +800,16 @@ void TrQuant::xT( const TransformUnit &tu, const ComponentID &compID, const CPel
   }
 #endif
 
+  if( width > 1 && height > 1 ) // 2-D transform
+  {
+    const int      shift_1st              = ((floorLog2(width )) + bitDepth + TRANSFORM_MATRIX_SHIFT) - maxLog2TrDynamicRange + COM16_C806_TRANS_PREC;
+    const int      shift_2nd              =  (floorLog2(height))            + TRANSFORM_MATRIX_SHIFT                          + COM16_C806_TRANS_PREC;
+    CHECK( shift_1st < 0, "Negative shift" );
+    CHECK( shift_2nd < 0, "Negative shift" );
+    m_fwdTrans2D( resi.buf, resi.stride, dstCoeff.buf, width, height, trTypeHor, trTypeVer, skipWidth, skipHeight, shift_1st, shift_2nd );
+    return;
+  }
+
   ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, TCoeff block[MAX_TB_SIZEY * MAX_TB_SIZEY] );
 
   const Pel *resiBuf    = resi.buf;
@@ -796,18 +823,7 @@ void TrQuant::xT( const TransformUnit &tu, const ComponentID &compID, const CPel
     }
   }
 
-  if( width > 1 && height > 1 ) // 2-D transform
-  {
-    const int      shift_1st              = ((floorLog2(width )) + bitDepth + TRANSFORM_MATRIX_SHIFT) - maxLog2TrDynamicRange + COM16_C806_TRANS_PREC;
-    const int      shift_2nd              =  (floorLog2(height))            + TRANSFORM_MATRIX_SHIFT                          + COM16_C806_TRANS_PREC;
-    CHECK( shift_1st < 0, "Negative shift" );
-    CHECK( shift_2nd < 0, "Negative shift" );
-  TCoeff *tmp = ( TCoeff * ) alloca( width * height * sizeof( TCoeff ) );
-
-  fastFwdTrans[trTypeHor][transformWidthIndex ](block,        tmp, shift_1st, height,        0, skipWidth);
-  fastFwdTrans[trTypeVer][transformHeightIndex](tmp, dstCoeff.buf, shift_2nd, width, skipWidth, skipHeight);
-  }
-  else if( height == 1 ) //1-D horizontal transform
+  if( height == 1 ) //1-D horizontal transform
   {
     const int      shift              = ((floorLog2(width )) + bitDepth + TRANSFORM_MATRIX_SHIFT) - maxLog2TrDynamicRange + COM16_C806_TRANS_PREC;
     CHECK( shift < 0, "Negative shift" );
@@ -823,6 +839,104 @@ void TrQuant::xT( const TransformUnit &tu, const ComponentID &compID, const CPel
   }
 }
 
+void TrQuant::xTMulti( TransformUnit &tu, const ComponentID &compID, const CPelBuf &resi, const std::vector<TrMode> &trModes )
+{
+  const int      width                  = resi.width;
+  const int      height                 = resi.height;
+  const unsigned maxLog2TrDynamicRange  = tu.cs->sps->getMaxLog2TrDynamicRange( toChannelType( compID ) );
+  const unsigned bitDepth               = tu.cs->sps->getBitDepth(              toChannelType( compID ) );
+  const int      TRANSFORM_MATRIX_SHIFT = g_transformMatrixShift[TRANSFORM_FORWARD];
+  const int      shift_1st              = ((floorLog2(width )) + bitDepth + TRANSFORM_MATRIX_SHIFT) - maxLog2TrDynamicRange + COM16_C806_TRANS_PREC;
+  const int      shift_2nd              =  (floorLog2(height))            + TRANSFORM_MATRIX_SHIFT                          + COM16_C806_TRANS_PREC;
+  CHECK( shift_1st < 0, "Negative shift" );
+  CHECK( shift_2nd < 0, "Negative shift" );
+  CHECK( width < 2 || height < 2, "Only 2-D transforms are supported" );
+
+  TCoeff* dst       [NUM_TRAFO_MODES_MTS];
+  int     trTypeHor [NUM_TRAFO_MODES_MTS];
+  int     trTypeVer [NUM_TRAFO_MODES_MTS];
+  int     skipWidth [NUM_TRAFO_MODES_MTS];
+  int     skipHeight[NUM_TRAFO_MODES_MTS];
+  int     numTr = 0;
+
+  for( const TrMode &trMode : trModes )
+  {
+    if( trMode.first == MTS_SKIP )
+    {
+      continue;
+    }
+
+    tu.mtsIdx[compID] = trMode.first;
+    dst[numTr]        = m_mtsCoeffs[trMode.first];
+
+    xGetTrParams( tu, compID, width, height, trTypeHor[numTr], trTypeVer[numTr], skipWidth[numTr], skipHeight[numTr] );
+
+#if RExt__DECODER_DEBUG_TOOL_STATISTICS
+    if ( trTypeHor[numTr] != DCT2 )
+    {
+      CodingStatistics::IncrementStatisticTool( CodingStatisticsClassType{ STATS__TOOL_EMT, uint32_t( width ), uint32_t( height ), compID } );
+    }
+#endif
+    numTr++;
+  }
+
+  if( numTr )
+  {
+    m_fwdTrans2DMulti( resi.buf, resi.stride, dst, numTr, width, height, trTypeHor, trTypeVer, skipWidth, skipHeight, shift_1st, shift_2nd );
+  }
+}
+
+void TrQuant::fwdTransform2DCore( const Pel* src, const int srcStride, TCoeff* dst, const int width, const int height, const int trTypeHor, const int trTypeVer,
+                                  const int skipWidth, const int skipHeight, const int shift1st, const int shift2nd )
+{
+  const uint32_t transformWidthIndex  = floorLog2( width  ) - 1;
+  const uint32_t transformHeightIndex = floorLog2( height ) - 1;
+
+  TCoeff *block = ( TCoeff * ) alloca( width * height * sizeof( TCoeff ) );
+  TCoeff *tmp   = ( TCoeff * ) alloca( width * height * sizeof( TCoeff ) );
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      block[( y * width ) + x] = src[( y * srcStride ) + x];
+    }
+  }
+
+  fastFwdTrans[trTypeHor][transformWidthIndex ]( block, tmp, shift1st, height,         0, skipWidth  );
+  fastFwdTrans[trTypeVer][transformHeightIndex]( tmp,   dst, shift2nd, width,  skipWidth, skipHeight );
+}
+
+void TrQuant::fwdTransform2DMultiCore( const Pel* src, const int srcStride, TCoeff* const* dst, const int numTr, const int width, const int height, const int* trTypeHor,
+                                       const int* trTypeVer, const int* skipWidth, const int* skipHeight, const int shift1st, const int shift2nd )
+{
+  for( int i = 0; i < numTr; i++ )
+  {
+    fwdTransform2DCore( src, srcStride, dst[i], width, height, trTypeHor[i], trTypeVer[i], skipWidth[i], skipHeight[i], shift1st, shift2nd );
+  }
+}
+
+void TrQuant::invTransform2DCore( const TCoeff* src, Pel* dst, const int dstStride, const int width, const int height, const int trTypeHor, const int trTypeVer,
+                                  const int skipWidth, const int skipHeight, const int shift1st, const int shift2nd, const TCoeff clipMinimum, const TCoeff clipMaximum )
+{
+  const uint32_t transformWidthIndex  = floorLog2( width  ) - 1;
+  const uint32_t transformHeightIndex = floorLog2( height ) - 1;
+
+  TCoeff *tmp   = ( TCoeff * ) alloca( width * height * sizeof( TCoeff ) );
+  TCoeff *block = ( TCoeff * ) alloca( width * height * sizeof( TCoeff ) );
+
+  fastInvTrans[trTypeVer][transformHeightIndex]( src, tmp,   shift1st, width,  skipWidth, skipHeight, clipMinimum, clipMaximum );
+  fastInvTrans[trTypeHor][transformWidthIndex] ( tmp, block, shift2nd, height,         0, skipWidth,  clipMinimum, clipMaximum );
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      dst[( y * dstStride ) + x] = Pel( block[( y * width ) + x] );
+    }
+  }
+}
+
 void TrQuant::xIT( const TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pCoeff, PelBuf &pResidual )
 {
   const int      width                  = pCoeff.width;
@@ -836,27 +950,9 @@ void TrQuant::xIT( const TransformUnit &tu, const ComponentID &compID, const CCo
   const uint32_t transformHeightIndex   = floorLog2(height) - 1;                                // nLog2HeightMinus1, since transform start from 2-point
 
 
-  int trTypeHor = DCT2;
-  int trTypeVer = DCT2;
-
-  getTrTypes ( tu, compID, trTypeHor, trTypeVer );
-  int skipWidth  = ( trTypeHor != DCT2 && width  == 32 ) ? 16 : width  > JVET_C0024_ZERO_OUT_TH ? width  - JVET_C0024_ZERO_OUT_TH : 0;
-  int skipHeight = ( trTypeVer != DCT2 && height == 32 ) ? 16 : height > JVET_C0024_ZERO_OUT_TH ? height - JVET_C0024_ZERO_OUT_TH : 0;
-  if( tu.cs->sps->getUseLFNST() && tu.cu->lfnstIdx )
-  {
-    if( (width == 4 && height > 4) || (width > 4 && height == 4) )
-    {
-      skipWidth  = width  - 4;
-      skipHeight = height - 4;
-    }
-    else if( (width >= 8 && height >= 8) )
-    {
-      skipWidth  = width  - 8;
-      skipHeight = height - 8;
-    }
-  }
+  int trTypeHor, trTypeVer, skipWidth, skipHeight;
 
-  TCoeff *block = ( TCoeff * ) alloca( width * height * sizeof( TCoeff ) );
+  xGetTrParams( tu, compID, width, height, trTypeHor, trTypeVer, skipWidth, skipHeight );
 
   if( width > 1 && height > 1 ) //2-D transform
   {
@@ -864,11 +960,13 @@ void TrQuant::xIT( const TransformUnit &tu, const ComponentID &compID, const CCo
     const int      shift_2nd              = ( TRANSFORM_MATRIX_SHIFT + maxLog2TrDynamicRange - 1 ) - bitDepth + COM16_C806_TRANS_PREC;
     CHECK( shift_1st < 0, "Negative shift" );
     CHECK( shift_2nd < 0, "Negative shift" );
-    TCoeff *tmp = ( TCoeff * ) alloca( width * height * sizeof( TCoeff ) );
-  fastInvTrans[trTypeVer][transformHeightIndex](pCoeff.buf, tmp, shift_1st, width, skipWidth, skipHeight, clipMinimum, clipMaximum);
-  fastInvTrans[trTypeHor][transformWidthIndex] (tmp,      block, shift_2nd, height,         0, skipWidth, clipMinimum, clipMaximum);
+    m_invTrans2D( pCoeff.buf, pResidual.buf, pResidual.stride, width, height, trTypeHor, trTypeVer, skipWidth, skipHeight, shift_1st, shift_2nd, clipMinimum, clipMaximum );
+    return;
   }
-  else if( width == 1 ) //1-D vertical transform
+
+  TCoeff *block = ( TCoeff * ) alloca( width * height * sizeof( TCoeff ) );
+
+  if( width == 1 ) //1-D vertical transform
   {
     int shift = ( TRANSFORM_MATRIX_SHIFT + maxLog2TrDynamicRange - 1 ) - bitDepth + COM16_C806_TRANS_PREC;
     CHECK( shift < 0, "Negative shift" );
@@ -935,6 +1033,14 @@ void TrQuant::transformNxN( TransformUnit& tu, const ComponentID& compID, const
   std::vector<TrCost> trCosts;
   std::vector<TrMode>::iterator it = trModes->begin();
   const double facBB[] = { 1.2, 1.3, 1.3, 1.4, 1.5 };
+
+  // the candidates share the residual, transform it once for all of them
+  const bool batchTr = !tu.noResidual && width > 1 && height > 1;
+  if( batchTr )
+  {
+    xTMulti( tu, compID, resiBuf, *trModes );
+  }
+
   while( it != trModes->end() )
   {
     tu.mtsIdx[compID] = it->first;
@@ -951,7 +1057,7 @@ void TrQuant::transformNxN( TransformUnit& tu, const ComponentID& compID, const
     {
       xTransformSkip( tu, compID, resiBuf, tempCoeff.buf );
     }
-    else
+    else if( !batchTr )
     {
       xT( tu, compID, resiBuf, tempCoeff, width, height );
     }
@@ -122,6 +122,29 @@ public:
   void    copyState( const TrQuant& other );
 #endif
 
+  static void invTransform2DCore( const TCoeff* src, Pel* dst, const int dstStride, const int width, const int height, const int trTypeHor, const int trTypeVer,
+                                  const int skipWidth, const int skipHeight, const int shift1st, const int shift2nd, const TCoeff clipMinimum, const TCoeff clipMaximum );
+
+  void ( *m_invTrans2D )( const TCoeff* src, Pel* dst, const int dstStride, const int width, const int height, const int trTypeHor, const int trTypeVer,
+                          const int skipWidth, const int skipHeight, const int shift1st, const int shift2nd, const TCoeff clipMinimum, const TCoeff clipMaximum );
+
+  static void fwdTransform2DCore( const Pel* src, const int srcStride, TCoeff* dst, const int width, const int height, const int trTypeHor, const int trTypeVer,
+                                  const int skipWidth, const int skipHeight, const int shift1st, const int shift2nd );
+  static void fwdTransform2DMultiCore( const Pel* src, const int srcStride, TCoeff* const* dst, const int numTr, const int width, const int height, const int* trTypeHor,
+                                       const int* trTypeVer, const int* skipWidth, const int* skipHeight, const int shift1st, const int shift2nd );
+
+  void ( *m_fwdTrans2D )( const Pel* src, const int srcStride, TCoeff* dst, const int width, const int height, const int trTypeHor, const int trTypeVer,
+                          const int skipWidth, const int skipHeight, const int shift1st, const int shift2nd );
+  // transforms one residual block with several transform type pairs, e.g. the MTS candidates
+  void ( *m_fwdTrans2DMulti )( const Pel* src, const int srcStride, TCoeff* const* dst, const int numTr, const int width, const int height, const int* trTypeHor,
+                               const int* trTypeVer, const int* skipWidth, const int* skipHeight, const int shift1st, const int shift2nd );
+
+#ifdef TARGET_SIMD_X86
+  void initTrQuantX86();
+  template <X86_VEXT vext>
+  void _initTrQuantX86();
+#endif
+
 protected:
   TCoeff   m_tempCoeff[MAX_TB_SIZEY * MAX_TB_SIZEY];
 
@@ -137,9 +160,15 @@ private:
   std::pair<int64_t,int64_t>(**m_fwdICT)(const PelBuf&,const PelBuf&,PelBuf&,PelBuf&);
 
 
+  // transform types and zero-out region
+  void xGetTrParams     (const TransformUnit &tu, const ComponentID &compID, const int width, const int height, int &trTypeHor, int &trTypeVer, int &skipWidth, int &skipHeight);
+
   // forward Transform
   void xT               (const TransformUnit &tu, const ComponentID &compID, const CPelBuf &resi, CoeffBuf &dstCoeff, const int width, const int height);
 
+  // forward Transform of all MTS candidates into m_mtsCoeffs
+  void xTMulti          (TransformUnit &tu, const ComponentID &compID, const CPelBuf &resi, const std::vector<TrMode> &trModes);
+
   // skipping Transform
   void xTransformSkip   (const TransformUnit &tu, const ComponentID &compID, const CPelBuf &resi, TCoeff* psCoeff);
 
@@ -197,6 +197,13 @@ void WeightPrediction::addWeightBi(const CPelUnitBuf          &pcYuvSrc0,
     const uint32_t iSrc1Stride = pcYuvSrc1.bufs[compID].stride;
     const uint32_t iDstStride =  rpcYuvDst.bufs[compID].stride;
 
+    if ((iWidth & 3) == 0)
+    {
+      const auto wghtBi = (iWidth & 7) == 0 ? g_pelBufOP.wghtBi8 : g_pelBufOP.wghtBi4;
+      wghtBi(pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, iWidth, iHeight, w0, w1, round, shift, offset, clpRng);
+      continue;
+    }
+
     for (int y = iHeight - 1; y >= 0; y--)
     {
       // do it in batches of 4 (partial unroll)
@@ -254,6 +261,13 @@ void WeightPrediction::addWeightBiComponent(const CPelUnitBuf          &pcYuvSrc
   const uint32_t src1Stride = pcYuvSrc1.bufs[compID].stride;
   const uint32_t dstStride =  rpcYuvDst.bufs[compID].stride;
 
+  if ((width & 3) == 0)
+  {
+    const auto wghtBi = (width & 7) == 0 ? g_pelBufOP.wghtBi8 : g_pelBufOP.wghtBi4;
+    wghtBi(src0, src0Stride, src1, src1Stride, dst, dstStride, width, height, w0, w1, round, shift, offset, clpRng);
+    return;
+  }
+
   for (int y = height - 1; y >= 0; y--)
   {
     // do it in batches of 4 (partial unroll)
@@ -311,6 +325,17 @@ void  WeightPrediction::addWeightUni(const CPelUnitBuf          &pcYuvSrc0,
     const int  iHeight      = rpcYuvDst.bufs[compID].height;
     const int  iWidth       = rpcYuvDst.bufs[compID].width;
 
+    if ((iWidth & 3) == 0)
+    {
+      // the unweighted cases are the weighted one with w0 = 1 and the plain rounding shift
+      const bool weighted  = w0 != 1 << wp0[compID].shift;
+      const int  wghtShift = weighted ? shift : shiftNum;
+      const int  round     = (wghtShift > 0) ? (1 << (wghtShift - 1)) : 0;
+      const auto wghtUni   = (iWidth & 7) == 0 ? g_pelBufOP.wghtUni8 : g_pelBufOP.wghtUni4;
+      wghtUni(pSrc0, iSrc0Stride, pDst, iDstStride, iWidth, iHeight, weighted ? w0 : 1, round, wghtShift, offset, clpRng);
+      continue;
+    }
+
     if (w0 != 1 << wp0[compID].shift)
     {
       const int  round = (shift > 0) ? (1 << (shift - 1)) : 0;
@@ -0,0 +1,1062 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     AdaptiveLoopFilterX86.h
+    \brief    adaptive loop filter class, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../AdaptiveLoopFilter.h"
+
+#if ENABLE_SIMD_OPT_ALF
+#ifdef TARGET_SIMD_X86
+
+//! \ingroup CommonLib
+//! \{
+
+// --------------------------------------------------------------------------------------------------------------------
+// classification
+// --------------------------------------------------------------------------------------------------------------------
+
+// Laplacians of the 8 samples at x of row r1 with the neighbouring rows r0 and r2
+static ALWAYS_INLINE void xAlfLaplacian_SSE( const Pel* r0, const Pel* r1, const Pel* r2, __m128i* lap )
+{
+  const __m128i vc  = _mm_loadu_si128( ( const __m128i* ) r1 );
+  const __m128i vc2 = _mm_add_epi16( vc, vc );
+
+  lap[VER]   = _mm_abs_epi16( _mm_sub_epi16( _mm_sub_epi16( vc2, _mm_loadu_si128( ( const __m128i* ) r0 ) ),       _mm_loadu_si128( ( const __m128i* ) r2 ) ) );
+  lap[HOR]   = _mm_abs_epi16( _mm_sub_epi16( _mm_sub_epi16( vc2, _mm_loadu_si128( ( const __m128i* ) ( r1 + 1 ) ) ), _mm_loadu_si128( ( const __m128i* ) ( r1 - 1 ) ) ) );
+  lap[DIAG0] = _mm_abs_epi16( _mm_sub_epi16( _mm_sub_epi16( vc2, _mm_loadu_si128( ( const __m128i* ) ( r0 - 1 ) ) ), _mm_loadu_si128( ( const __m128i* ) ( r2 + 1 ) ) ) );
+  lap[DIAG1] = _mm_abs_epi16( _mm_sub_epi16( _mm_sub_epi16( vc2, _mm_loadu_si128( ( const __m128i* ) ( r2 - 1 ) ) ), _mm_loadu_si128( ( const __m128i* ) ( r0 + 1 ) ) ) );
+}
+
+static ALWAYS_INLINE void xAlfLaplacian4_SSE( const Pel* r0, const Pel* r1, const Pel* r2, __m128i* lap )
+{
+  const __m128i vc  = _mm_loadl_epi64( ( const __m128i* ) r1 );
+  const __m128i vc2 = _mm_add_epi16( vc, vc );
+
+  lap[VER]   = _mm_abs_epi16( _mm_sub_epi16( _mm_sub_epi16( vc2, _mm_loadl_epi64( ( const __m128i* ) r0 ) ),       _mm_loadl_epi64( ( const __m128i* ) r2 ) ) );
+  lap[HOR]   = _mm_abs_epi16( _mm_sub_epi16( _mm_sub_epi16( vc2, _mm_loadl_epi64( ( const __m128i* ) ( r1 + 1 ) ) ), _mm_loadl_epi64( ( const __m128i* ) ( r1 - 1 ) ) ) );
+  lap[DIAG0] = _mm_abs_epi16( _mm_sub_epi16( _mm_sub_epi16( vc2, _mm_loadl_epi64( ( const __m128i* ) ( r0 - 1 ) ) ), _mm_loadl_epi64( ( const __m128i* ) ( r2 + 1 ) ) ) );
+  lap[DIAG1] = _mm_abs_epi16( _mm_sub_epi16( _mm_sub_epi16( vc2, _mm_loadl_epi64( ( const __m128i* ) ( r2 - 1 ) ) ), _mm_loadl_epi64( ( const __m128i* ) ( r0 + 1 ) ) ) );
+}
+
+#ifdef USE_AVX2
+static ALWAYS_INLINE void xAlfLaplacian_AVX2( const Pel* r0, const Pel* r1, const Pel* r2, __m256i* lap )
+{
+  const __m256i vc  = _mm256_loadu_si256( ( const __m256i* ) r1 );
+  const __m256i vc2 = _mm256_add_epi16( vc, vc );
+
+  lap[VER]   = _mm256_abs_epi16( _mm256_sub_epi16( _mm256_sub_epi16( vc2, _mm256_loadu_si256( ( const __m256i* ) r0 ) ),       _mm256_loadu_si256( ( const __m256i* ) r2 ) ) );
+  lap[HOR]   = _mm256_abs_epi16( _mm256_sub_epi16( _mm256_sub_epi16( vc2, _mm256_loadu_si256( ( const __m256i* ) ( r1 + 1 ) ) ), _mm256_loadu_si256( ( const __m256i* ) ( r1 - 1 ) ) ) );
+  lap[DIAG0] = _mm256_abs_epi16( _mm256_sub_epi16( _mm256_sub_epi16( vc2, _mm256_loadu_si256( ( const __m256i* ) ( r0 - 1 ) ) ), _mm256_loadu_si256( ( const __m256i* ) ( r2 + 1 ) ) ) );
+  lap[DIAG1] = _mm256_abs_epi16( _mm256_sub_epi16( _mm256_sub_epi16( vc2, _mm256_loadu_si256( ( const __m256i* ) ( r2 - 1 ) ) ), _mm256_loadu_si256( ( const __m256i* ) ( r0 + 1 ) ) ) );
+}
+#endif
+
+// The scalar code adds the Laplacian of an even sample of row src1 to the one of the following odd sample of row src2
+// and sums four such values horizontally and vertically for each 4x4 block. Blending both rows and a madd with ones
+// gives these pair sums, neighbouring pairs are added to one value per 4 columns which is stored in laplacian[dir][i][k]
+// for the column offset 4 * k. A 4x4 block at column 4 * k then needs the entries k and k + 1 of four rows.
+template<X86_VEXT vext>
+static void simdDeriveClassificationBlk( AlfClassifier **classifier, int **laplacian[NUM_DIRECTIONS], const CPelBuf &srcLuma, const Area &blkDst, const Area &blk, const int shift, const int vbCTUHeight, int vbPos )
+{
+  CHECK( ( vbCTUHeight & ( vbCTUHeight - 1 ) ) != 0, "vbCTUHeight must be a power of 2" );
+  CHECK( blk.width & 3, "Unsupported width" );
+  static_assert( sizeof( AlfClassifier ) == 2, "AlfClassifier is written as a 16 bit value" );
+
+  // the Laplacians are computed with 16 bit intermediates
+  if( shift - 4 > 13 )
+  {
+    AdaptiveLoopFilter::deriveClassificationBlk( classifier, laplacian, srcLuma, blkDst, blk, shift, vbCTUHeight, vbPos );
+    return;
+  }
+
+  const int  stride = srcLuma.stride;
+  const Pel* src    = srcLuma.buf;
+
+  const int height     = blk.height + 4;
+  const int numEntries = ( blk.width >> 2 ) + 1;
+  const int posX       = blk.pos().x;
+  const int posY       = blk.pos().y;
+
+  const __m128i vone = _mm_set1_epi16( 1 );
+
+  for( int i = 0; i < height; i += 2 )
+  {
+    const int yoffset = ( i - 2 + posY ) * stride + posX - 2;
+    const Pel *src0 = &src[yoffset - stride];
+    const Pel *src1 = &src[yoffset];
+    const Pel *src2 = &src[yoffset + stride];
+    const Pel *src3 = &src[yoffset + stride * 2];
+
+    const int y = blkDst.pos().y - 2 + i;
+    if( y > 0 && ( y & ( vbCTUHeight - 1 ) ) == vbPos - 2 )
+    {
+      src3 = &src[yoffset + stride];
+    }
+    else if( y > 0 && ( y & ( vbCTUHeight - 1 ) ) == vbPos )
+    {
+      src0 = &src[yoffset];
+    }
+
+    int k = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vone256 = _mm256_set1_epi16( 1 );
+
+      for( ; k + 4 <= numEntries; k += 4 )
+      {
+        __m256i lap1[NUM_DIRECTIONS], lap2[NUM_DIRECTIONS];
+        xAlfLaplacian_AVX2( src0 + 4 * k, src1 + 4 * k, src2 + 4 * k, lap1 );
+        xAlfLaplacian_AVX2( src1 + 4 * k, src2 + 4 * k, src3 + 4 * k, lap2 );
+
+        for( int dir = 0; dir < NUM_DIRECTIONS; dir++ )
+        {
+          __m256i v = _mm256_madd_epi16( _mm256_blend_epi16( lap1[dir], lap2[dir], 0xaa ), vone256 );
+          v = _mm256_permute4x64_epi64( _mm256_hadd_epi32( v, v ), 0x08 );
+          _mm_storeu_si128( ( __m128i* ) &laplacian[dir][i][k], _mm256_castsi256_si128( v ) );
+        }
+      }
+    }
+#endif
+    for( ; k + 2 <= numEntries; k += 2 )
+    {
+      __m128i lap1[NUM_DIRECTIONS], lap2[NUM_DIRECTIONS];
+      xAlfLaplacian_SSE( src0 + 4 * k, src1 + 4 * k, src2 + 4 * k, lap1 );
+      xAlfLaplacian_SSE( src1 + 4 * k, src2 + 4 * k, src3 + 4 * k, lap2 );
+
+      for( int dir = 0; dir < NUM_DIRECTIONS; dir++ )
+      {
+        const __m128i v = _mm_madd_epi16( _mm_blend_epi16( lap1[dir], lap2[dir], 0xaa ), vone );
+        _mm_storel_epi64( ( __m128i* ) &laplacian[dir][i][k], _mm_hadd_epi32( v, v ) );
+      }
+    }
+    if( k < numEntries )
+    {
+      __m128i lap1[NUM_DIRECTIONS], lap2[NUM_DIRECTIONS];
+      xAlfLaplacian4_SSE( src0 + 4 * k, src1 + 4 * k, src2 + 4 * k, lap1 );
+      xAlfLaplacian4_SSE( src1 + 4 * k, src2 + 4 * k, src3 + 4 * k, lap2 );
+
+      for( int dir = 0; dir < NUM_DIRECTIONS; dir++ )
+      {
+        const __m128i v = _mm_madd_epi16( _mm_blend_epi16( lap1[dir], lap2[dir], 0xaa ), vone );
+        laplacian[dir][i][k] = _mm_cvtsi128_si32( _mm_hadd_epi32( v, v ) );
+      }
+    }
+  }
+
+  const __m128i vth        = _mm_setr_epi8( 0, 1, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 4 );
+  const __m128i vtranspose = _mm_setr_epi8( 0, 1, 0, 2, 2, 3, 1, 3, 0, 0, 0, 0, 0, 0, 0, 0 );
+  const __m128i vsign      = _mm_set1_epi32( 0x80000000 );
+  const __m128i vmaxAct    = _mm_set1_epi32( 15 );
+  const __m128i vshift     = _mm_cvtsi32_si128( shift );
+
+  for( int i = 0; i < blk.height; i += 4 )
+  {
+    // rows of the Laplacians summed up for this line of 4x4 blocks
+    const int yVb      = ( i + blkDst.pos().y ) & ( vbCTUHeight - 1 );
+    const int rowFirst = yVb == vbPos ? 2 : 0;
+    const int rowLast  = yVb == vbPos - 4 ? 4 : 6;
+    const __m128i vmult = _mm_set1_epi32( yVb == vbPos - 4 || yVb == vbPos ? 96 : 64 );
+
+    for( int j = 0; j < blk.width; j += 16 )
+    {
+      const int k = j >> 2;
+      __m128i vsum[NUM_DIRECTIONS];
+
+      for( int dir = 0; dir < NUM_DIRECTIONS; dir++ )
+      {
+        vsum[dir] = _mm_setzero_si128();
+        for( int row = i + rowFirst; row <= i + rowLast; row += 2 )
+        {
+          const int* lap = laplacian[dir][row];
+          vsum[dir] = _mm_add_epi32( vsum[dir], _mm_add_epi32( _mm_loadu_si128( ( const __m128i* ) &lap[k] ), _mm_loadu_si128( ( const __m128i* ) &lap[k + 1] ) ) );
+        }
+      }
+
+      const __m128i sumV  = vsum[VER];
+      const __m128i sumH  = vsum[HOR];
+      const __m128i sumD0 = vsum[DIAG0];
+      const __m128i sumD1 = vsum[DIAG1];
+
+      // activity in the lowest byte of each lane, looked up in th[]
+      __m128i activity = _mm_sra_epi32( _mm_mullo_epi32( _mm_add_epi32( sumV, sumH ), vmult ), vshift );
+      activity = _mm_min_epi32( vmaxAct, _mm_max_epi32( _mm_setzero_si128(), activity ) );
+      __m128i classIdx = _mm_shuffle_epi8( vth, activity );
+
+      const __m128i hvGt  = _mm_cmpgt_epi32( sumV, sumH );
+      const __m128i hv1   = _mm_max_epi32( sumV, sumH );
+      const __m128i hv0   = _mm_min_epi32( sumV, sumH );
+      const __m128i dirHV = _mm_sub_epi32( _mm_set1_epi32( 3 ), _mm_and_si128( hvGt, _mm_set1_epi32( 2 ) ) );
+      const __m128i dGt   = _mm_cmpgt_epi32( sumD0, sumD1 );
+      const __m128i d1    = _mm_max_epi32( sumD0, sumD1 );
+      const __m128i d0    = _mm_min_epi32( sumD0, sumD1 );
+      const __m128i dirD  = _mm_andnot_si128( dGt, _mm_set1_epi32( 2 ) );
+
+      // unsigned 32 bit products compared as in the scalar code
+      const __m128i prodD  = _mm_xor_si128( _mm_mullo_epi32( d1, hv0 ), vsign );
+      const __m128i prodHV = _mm_xor_si128( _mm_mullo_epi32( hv1, d0 ), vsign );
+      const __m128i useD   = _mm_cmpgt_epi32( prodD, prodHV );
+
+      const __m128i hvd1      = _mm_blendv_epi8( hv1, d1, useD );
+      const __m128i hvd0      = _mm_blendv_epi8( hv0, d0, useD );
+      const __m128i mainDir   = _mm_blendv_epi8( dirHV, dirD, useD );
+      const __m128i secondDir = _mm_blendv_epi8( dirD, dirHV, useD );
+
+      // both masks are -1 when set, the second one implies the first one
+      const __m128i strength1 = _mm_cmpgt_epi32( hvd1, _mm_slli_epi32( hvd0, 1 ) );
+      const __m128i strength2 = _mm_cmpgt_epi32( _mm_slli_epi32( hvd1, 1 ), _mm_mullo_epi32( hvd0, _mm_set1_epi32( 9 ) ) );
+      __m128i classOff = _mm_sub_epi32( _mm_slli_epi32( _mm_and_si128( mainDir, _mm_set1_epi32( 1 ) ), 1 ), _mm_add_epi32( strength1, strength2 ) );
+      classOff = _mm_and_si128( strength1, _mm_add_epi32( classOff, _mm_slli_epi32( classOff, 2 ) ) );
+      classIdx = _mm_add_epi32( classIdx, classOff );
+
+      const __m128i transposeIdx = _mm_shuffle_epi8( vtranspose, _mm_add_epi32( _mm_add_epi32( mainDir, mainDir ), _mm_srli_epi32( secondDir, 1 ) ) );
+
+      // one AlfClassifier per block, replicated to the 4 columns of each block
+      __m128i vcls = _mm_or_si128( classIdx, _mm_slli_epi32( transposeIdx, 8 ) );
+      vcls = _mm_packus_epi32( vcls, vcls );
+      vcls = _mm_unpacklo_epi16( vcls, vcls );
+      const __m128i vcls01 = _mm_unpacklo_epi32( vcls, vcls );
+      const __m128i vcls23 = _mm_unpackhi_epi32( vcls, vcls );
+
+      const int numBlocks = std::min<int>( 4, ( blk.width - j ) >> 2 );
+      const int xOffset   = j + blkDst.pos().x;
+
+      for( int ii = 0; ii < 4; ii++ )
+      {
+        AlfClassifier* cl = classifier[i + blkDst.pos().y + ii] + xOffset;
+
+        if( numBlocks == 4 )
+        {
+          _mm_storeu_si128( ( __m128i* ) cl,       vcls01 );
+          _mm_storeu_si128( ( __m128i* ) ( cl + 8 ), vcls23 );
+        }
+        else if( numBlocks == 3 )
+        {
+          _mm_storeu_si128( ( __m128i* ) cl,       vcls01 );
+          _mm_storel_epi64( ( __m128i* ) ( cl + 8 ), vcls23 );
+        }
+        else if( numBlocks == 2 )
+        {
+          _mm_storeu_si128( ( __m128i* ) cl, vcls01 );
+        }
+        else
+        {
+          _mm_storel_epi64( ( __m128i* ) cl, vcls01 );
+        }
+      }
+    }
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// filtering
+// --------------------------------------------------------------------------------------------------------------------
+
+// sample rows (index into the row pointers, 0 being the current row) and column offsets of the two inputs of each tap,
+// in the order of the coefficients used by AdaptiveLoopFilter::filterBlk
+static const int g_alfTaps7x7[12][4] =
+{
+  { 5,  0, 6,  0 },
+  { 3,  1, 4, -1 }, { 3,  0, 4,  0 }, { 3, -1, 4,  1 },
+  { 1,  2, 2, -2 }, { 1,  1, 2, -1 }, { 1,  0, 2,  0 }, { 1, -1, 2,  1 }, { 1, -2, 2,  2 },
+  { 0,  3, 0, -3 }, { 0,  2, 0, -2 }, { 0,  1, 0, -1 }
+};
+
+static const int g_alfTaps5x5[6][4] =
+{
+  { 3,  0, 4,  0 },
+  { 1,  1, 2, -1 }, { 1,  0, 2,  0 }, { 1, -1, 2,  1 },
+  { 0,  2, 0, -2 }, { 0,  1, 0, -1 }
+};
+
+// coefficient orders of the geometric transforms, see AdaptiveLoopFilter::filterBlk
+static const int g_alfTranspose7x7[4][MAX_NUM_ALF_LUMA_COEFF] =
+{
+  { 0, 1,  2, 3, 4, 5,  6, 7, 8, 9, 10, 11, 12 },
+  { 9, 4, 10, 8, 1, 5, 11, 7, 3, 0,  2,  6, 12 },
+  { 0, 3,  2, 1, 8, 7,  6, 5, 4, 9, 10, 11, 12 },
+  { 9, 8, 10, 4, 3, 7, 11, 5, 1, 0,  2,  6, 12 }
+};
+
+static const int g_alfTranspose5x5[4][MAX_NUM_ALF_CHROMA_COEFF] =
+{
+  { 0, 1, 2, 3, 4, 5, 6 },
+  { 4, 1, 5, 3, 0, 2, 6 },
+  { 0, 3, 2, 1, 4, 5, 6 },
+  { 4, 3, 5, 1, 0, 2, 6 }
+};
+
+// coefficients of two taps interleaved for _mm_madd_epi16 and the clipping values of one 4x4 block
+template<AlfFilterType filtType>
+static ALWAYS_INLINE void xAlfBlockCoeffs( const short* coef, const short* clip, const int transposeIdx, int* coefPairs, short* clipVals )
+{
+  const int  numTaps = filtType == ALF_FILTER_7 ? 12 : 6;
+  const int* order   = filtType == ALF_FILTER_7 ? g_alfTranspose7x7[transposeIdx] : g_alfTranspose5x5[transposeIdx];
+
+  for( int k = 0; k < numTaps; k += 2 )
+  {
+    coefPairs[k >> 1] = ( coef[order[k]] & 0xffff ) | ( int( coef[order[k + 1]] ) << 16 );
+    clipVals[k]       = clip[order[k]];
+    clipVals[k + 1]   = clip[order[k + 1]];
+  }
+}
+
+// row pointers of the 4 lines of a 4x4 block row, with the padding at the ALF virtual boundary
+template<bool bChroma>
+static ALWAYS_INLINE void xAlfRowPointers( const Pel* pImg0, const int srcStride, const int yVb, const int vbPos, const Pel** img, bool& isNearVB )
+{
+  const Pel* pImg1 = pImg0 + srcStride;
+  const Pel* pImg2 = pImg0 - srcStride;
+  const Pel* pImg3 = pImg1 + srcStride;
+  const Pel* pImg4 = pImg2 - srcStride;
+  const Pel* pImg5 = pImg3 + srcStride;
+  const Pel* pImg6 = pImg4 - srcStride;
+
+  if( yVb < vbPos && ( yVb >= vbPos - ( bChroma ? 2 : 4 ) ) )   // above
+  {
+    pImg1 = ( yVb == vbPos - 1 ) ? pImg0 : pImg1;
+    pImg3 = ( yVb >= vbPos - 2 ) ? pImg1 : pImg3;
+    pImg5 = ( yVb >= vbPos - 3 ) ? pImg3 : pImg5;
+
+    pImg2 = ( yVb == vbPos - 1 ) ? pImg0 : pImg2;
+    pImg4 = ( yVb >= vbPos - 2 ) ? pImg2 : pImg4;
+    pImg6 = ( yVb >= vbPos - 3 ) ? pImg4 : pImg6;
+  }
+  else if( yVb >= vbPos && ( yVb <= vbPos + ( bChroma ? 1 : 3 ) ) )   // bottom
+  {
+    pImg2 = ( yVb == vbPos ) ? pImg0 : pImg2;
+    pImg4 = ( yVb <= vbPos + 1 ) ? pImg2 : pImg4;
+    pImg6 = ( yVb <= vbPos + 2 ) ? pImg4 : pImg6;
+
+    pImg1 = ( yVb == vbPos ) ? pImg0 : pImg1;
+    pImg3 = ( yVb <= vbPos + 1 ) ? pImg1 : pImg3;
+    pImg5 = ( yVb <= vbPos + 2 ) ? pImg3 : pImg5;
+  }
+
+  img[0] = pImg0; img[1] = pImg1; img[2] = pImg2; img[3] = pImg3; img[4] = pImg4; img[5] = pImg5; img[6] = pImg6;
+
+#if JVET_Q0150
+  isNearVB = yVb == vbPos - 1 || yVb == vbPos;
+#else
+  isNearVB = false;
+#endif
+}
+
+// filters 8 samples of one row (4 if !full), the lower and upper half belong to two 4x4 blocks with own coefficients
+template<AlfFilterType filtType, bool full>
+static ALWAYS_INLINE void xAlfFilterRow_SSE( const Pel* const* img, const int x, Pel* rec, const __m128i* vcoefLo, const __m128i* vcoefHi, const __m128i* vclip, const __m128i vshift, const ClpRng& clpRng )
+{
+  const int numTaps = filtType == ALF_FILTER_7 ? 12 : 6;
+  const int ( *taps )[4] = filtType == ALF_FILTER_7 ? g_alfTaps7x7 : g_alfTaps5x5;
+
+#define ALF_LOAD( p ) ( full ? _mm_loadu_si128( ( const __m128i* ) ( p ) ) : _mm_loadl_epi64( ( const __m128i* ) ( p ) ) )
+
+  const __m128i vcurr = ALF_LOAD( img[0] + x );
+  __m128i accLo = _mm_setzero_si128();
+  __m128i accHi = _mm_setzero_si128();
+
+  for( int k = 0; k < numTaps; k += 2 )
+  {
+    __m128i vdiff[2];
+    for( int t = 0; t < 2; t++ )
+    {
+      const int*    tap   = taps[k + t];
+      const __m128i vmax  = vclip[k + t];
+      const __m128i vmin  = _mm_sub_epi16( _mm_setzero_si128(), vmax );
+      const __m128i vval0 = _mm_sub_epi16( ALF_LOAD( img[tap[0]] + x + tap[1] ), vcurr );
+      const __m128i vval1 = _mm_sub_epi16( ALF_LOAD( img[tap[2]] + x + tap[3] ), vcurr );
+      vdiff[t] = _mm_add_epi16( _mm_min_epi16( vmax, _mm_max_epi16( vmin, vval0 ) ), _mm_min_epi16( vmax, _mm_max_epi16( vmin, vval1 ) ) );
+    }
+    accLo = _mm_add_epi32( accLo, _mm_madd_epi16( _mm_unpacklo_epi16( vdiff[0], vdiff[1] ), vcoefLo[k >> 1] ) );
+    if( full )
+    {
+      accHi = _mm_add_epi32( accHi, _mm_madd_epi16( _mm_unpackhi_epi16( vdiff[0], vdiff[1] ), vcoefHi[k >> 1] ) );
+    }
+  }
+
+#undef ALF_LOAD
+
+  const int     shift   = AdaptiveLoopFilter::m_NUM_BITS - 1;
+  const __m128i voffset = _mm_set1_epi32( 1 << ( shift - 1 ) );
+
+  // the current sample is added with 32 bits, the result can exceed the 16 bit range before clipping
+  accLo = _mm_add_epi32( _mm_sra_epi32( _mm_add_epi32( accLo, voffset ), vshift ), _mm_srai_epi32( _mm_unpacklo_epi16( vcurr, vcurr ), 16 ) );
+  accHi = _mm_add_epi32( _mm_sra_epi32( _mm_add_epi32( accHi, voffset ), vshift ), _mm_srai_epi32( _mm_unpackhi_epi16( vcurr, vcurr ), 16 ) );
+
+  __m128i vres = _mm_packs_epi32( accLo, accHi );
+  vres = _mm_min_epi16( _mm_set1_epi16( clpRng.max ), _mm_max_epi16( _mm_set1_epi16( clpRng.min ), vres ) );
+
+  if( full )
+  {
+    _mm_storeu_si128( ( __m128i* ) rec, vres );
+  }
+  else
+  {
+    _mm_storel_epi64( ( __m128i* ) rec, vres );
+  }
+}
+
+#ifdef USE_AVX2
+// filters 16 samples of one row, 128 bit lane l holds the samples of the 4x4 blocks 2 * l and 2 * l + 1
+template<AlfFilterType filtType>
+static ALWAYS_INLINE void xAlfFilterRow_AVX2( const Pel* const* img, const int x, Pel* rec, const __m256i* vcoefLo, const __m256i* vcoefHi, const __m256i* vclip, const __m128i vshift, const ClpRng& clpRng )
+{
+  const int numTaps = filtType == ALF_FILTER_7 ? 12 : 6;
+  const int ( *taps )[4] = filtType == ALF_FILTER_7 ? g_alfTaps7x7 : g_alfTaps5x5;
+
+  const __m256i vcurr = _mm256_loadu_si256( ( const __m256i* ) ( img[0] + x ) );
+  __m256i accLo = _mm256_setzero_si256();
+  __m256i accHi = _mm256_setzero_si256();
+
+  for( int k = 0; k < numTaps; k += 2 )
+  {
+    __m256i vdiff[2];
+    for( int t = 0; t < 2; t++ )
+    {
+      const int*    tap   = taps[k + t];
+      const __m256i vmax  = vclip[k + t];
+      const __m256i vmin  = _mm256_sub_epi16( _mm256_setzero_si256(), vmax );
+      const __m256i vval0 = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) ( img[tap[0]] + x + tap[1] ) ), vcurr );
+      const __m256i vval1 = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) ( img[tap[2]] + x + tap[3] ) ), vcurr );
+      vdiff[t] = _mm256_add_epi16( _mm256_min_epi16( vmax, _mm256_max_epi16( vmin, vval0 ) ), _mm256_min_epi16( vmax, _mm256_max_epi16( vmin, vval1 ) ) );
+    }
+    accLo = _mm256_add_epi32( accLo, _mm256_madd_epi16( _mm256_unpacklo_epi16( vdiff[0], vdiff[1] ), vcoefLo[k >> 1] ) );
+    accHi = _mm256_add_epi32( accHi, _mm256_madd_epi16( _mm256_unpackhi_epi16( vdiff[0], vdiff[1] ), vcoefHi[k >> 1] ) );
+  }
+
+  const int     shift   = AdaptiveLoopFilter::m_NUM_BITS - 1;
+  const __m256i voffset = _mm256_set1_epi32( 1 << ( shift - 1 ) );
+
+  accLo = _mm256_add_epi32( _mm256_sra_epi32( _mm256_add_epi32( accLo, voffset ), vshift ), _mm256_srai_epi32( _mm256_unpacklo_epi16( vcurr, vcurr ), 16 ) );
+  accHi = _mm256_add_epi32( _mm256_sra_epi32( _mm256_add_epi32( accHi, voffset ), vshift ), _mm256_srai_epi32( _mm256_unpackhi_epi16( vcurr, vcurr ), 16 ) );
+
+  __m256i vres = _mm256_packs_epi32( accLo, accHi );
+  vres = _mm256_min_epi16( _mm256_set1_epi16( clpRng.max ), _mm256_max_epi16( _mm256_set1_epi16( clpRng.min ), vres ) );
+  _mm256_storeu_si256( ( __m256i* ) rec, vres );
+}
+#endif
+
+#ifdef USE_AVX512
+// filters 32 samples of one row, 128 bit lane l holds the samples of the 4x4 blocks 2 * l and 2 * l + 1
+template<AlfFilterType filtType>
+static ALWAYS_INLINE void xAlfFilterRow_AVX512( const Pel* const* img, const int x, Pel* rec, const __m512i* vcoefLo, const __m512i* vcoefHi, const __m512i* vclip, const __m128i vshift, const ClpRng& clpRng )
+{
+  const int numTaps = filtType == ALF_FILTER_7 ? 12 : 6;
+  const int ( *taps )[4] = filtType == ALF_FILTER_7 ? g_alfTaps7x7 : g_alfTaps5x5;
+
+  const __m512i vcurr = _mm512_loadu_si512( ( const void* ) ( img[0] + x ) );
+  __m512i accLo = _mm512_setzero_si512();
+  __m512i accHi = _mm512_setzero_si512();
+
+  for( int k = 0; k < numTaps; k += 2 )
+  {
+    __m512i vdiff[2];
+    for( int t = 0; t < 2; t++ )
+    {
+      const int*    tap   = taps[k + t];
+      const __m512i vmax  = vclip[k + t];
+      const __m512i vmin  = _mm512_sub_epi16( _mm512_setzero_si512(), vmax );
+      const __m512i vval0 = _mm512_sub_epi16( _mm512_loadu_si512( ( const void* ) ( img[tap[0]] + x + tap[1] ) ), vcurr );
+      const __m512i vval1 = _mm512_sub_epi16( _mm512_loadu_si512( ( const void* ) ( img[tap[2]] + x + tap[3] ) ), vcurr );
+      vdiff[t] = _mm512_add_epi16( _mm512_min_epi16( vmax, _mm512_max_epi16( vmin, vval0 ) ), _mm512_min_epi16( vmax, _mm512_max_epi16( vmin, vval1 ) ) );
+    }
+    accLo = _mm512_add_epi32( accLo, _mm512_madd_epi16( _mm512_unpacklo_epi16( vdiff[0], vdiff[1] ), vcoefLo[k >> 1] ) );
+    accHi = _mm512_add_epi32( accHi, _mm512_madd_epi16( _mm512_unpackhi_epi16( vdiff[0], vdiff[1] ), vcoefHi[k >> 1] ) );
+  }
+
+  const int     shift   = AdaptiveLoopFilter::m_NUM_BITS - 1;
+  const __m512i voffset = _mm512_set1_epi32( 1 << ( shift - 1 ) );
+
+  accLo = _mm512_add_epi32( _mm512_sra_epi32( _mm512_add_epi32( accLo, voffset ), vshift ), _mm512_srai_epi32( _mm512_unpacklo_epi16( vcurr, vcurr ), 16 ) );
+  accHi = _mm512_add_epi32( _mm512_sra_epi32( _mm512_add_epi32( accHi, voffset ), vshift ), _mm512_srai_epi32( _mm512_unpackhi_epi16( vcurr, vcurr ), 16 ) );
+
+  __m512i vres = _mm512_packs_epi32( accLo, accHi );
+  vres = _mm512_min_epi16( _mm512_set1_epi16( clpRng.max ), _mm512_max_epi16( _mm512_set1_epi16( clpRng.min ), vres ) );
+  _mm512_storeu_si512( ( void* ) rec, vres );
+}
+
+// 32 bit values of the blocks 0, 2, 4 and 6 (or 1, 3, 5 and 7) broadcast to the 128 bit lanes 0 to 3
+static const int32_t g_alfLanePermute512[16] = { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3 };
+// 16 bit values of the blocks 0 to 7 broadcast to the 64 bit halves of the 128 bit lanes
+static const int16_t g_alfHalfPermute512[32] = { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7 };
+#endif
+
+template<X86_VEXT vext, AlfFilterType filtType>
+static void simdFilterBlk( AlfClassifier **classifier, const PelUnitBuf &recDst, const CPelUnitBuf &recSrc, const Area &blkDst, const Area &blk, const ComponentID compId, const short *filterSet, const short *fClipSet, const ClpRng &clpRng, CodingStructure &cs, const int vbCTUHeight, int vbPos )
+{
+  CHECK( ( vbCTUHeight & ( vbCTUHeight - 1 ) ) != 0, "vbCTUHeight must be a power of 2" );
+
+  const bool bChroma = isChroma( compId );
+  if( bChroma )
+  {
+    CHECK( filtType != 0, "Chroma needs to have filtType == 0" );
+  }
+
+  // the clipped differences are computed with 16 bits
+  if( clpRng.bd > 14 )
+  {
+    AdaptiveLoopFilter::filterBlk<filtType>( classifier, recDst, recSrc, blkDst, blk, compId, filterSet, fClipSet, clpRng, cs, vbCTUHeight, vbPos );
+    return;
+  }
+
+  const CPelBuf srcLuma = recSrc.get( compId );
+  PelBuf dstLuma = recDst.get( compId );
+
+  const int srcStride = srcLuma.stride;
+  const int dstStride = dstLuma.stride;
+
+  const int clsSizeY = 4;
+  const int clsSizeX = 4;
+
+  CHECK( blk.y % clsSizeY, "Wrong startHeight in filtering" );
+  CHECK( blk.x % clsSizeX, "Wrong startWidth in filtering" );
+  CHECK( blk.height % clsSizeY, "Wrong endHeight in filtering" );
+  CHECK( blk.width % clsSizeX, "Wrong endWidth in filtering" );
+
+  const int numPairs = filtType == ALF_FILTER_7 ? 6 : 3;
+  const int numTaps  = 2 * numPairs;
+  const int shift    = AdaptiveLoopFilter::m_NUM_BITS - 1;
+
+  const Pel* src = srcLuma.buf + blk.y * srcStride + blk.x;
+  Pel*       dst = dstLuma.buf + blkDst.y * dstStride + blkDst.x;
+
+  // coefficients and clipping values of up to 8 horizontally neighbouring 4x4 blocks, chroma uses one set for all
+  int   coefPairs[8][6] = { { 0 } };
+  short clipVals[8][12] = { { 0 } };
+
+  if( bChroma )
+  {
+    for( int b = 0; b < 8; b++ )
+    {
+      xAlfBlockCoeffs<filtType>( filterSet, fClipSet, 0, coefPairs[b], clipVals[b] );
+    }
+  }
+
+  auto getBlockCoeffs = [&]( const AlfClassifier* pClass, const int numBlocks )
+  {
+    if( !bChroma )
+    {
+      for( int b = 0; b < numBlocks; b++ )
+      {
+        const AlfClassifier& cl = pClass[4 * b];
+        xAlfBlockCoeffs<filtType>( filterSet + cl.classIdx * MAX_NUM_ALF_LUMA_COEFF, fClipSet + cl.classIdx * MAX_NUM_ALF_LUMA_COEFF, cl.transposeIdx, coefPairs[b], clipVals[b] );
+      }
+    }
+  };
+
+  for( int i = 0; i < blk.height; i += clsSizeY )
+  {
+    const Pel* img[clsSizeY][7];
+    __m128i    vshift[clsSizeY];
+
+    for( int ii = 0; ii < clsSizeY; ii++ )
+    {
+      bool isNearVB = false;
+      const int yVb = ( blkDst.y + i + ii ) & ( vbCTUHeight - 1 );
+      if( bChroma )
+      {
+        xAlfRowPointers<true >( src + ( i + ii ) * srcStride, srcStride, yVb, vbPos, img[ii], isNearVB );
+      }
+      else
+      {
+        xAlfRowPointers<false>( src + ( i + ii ) * srcStride, srcStride, yVb, vbPos, img[ii], isNearVB );
+      }
+      vshift[ii] = _mm_cvtsi32_si128( isNearVB ? shift + 3 : shift );
+    }
+
+    const AlfClassifier* pClass = bChroma ? nullptr : classifier[blkDst.y + i] + blkDst.x;
+    Pel* rec = dst + i * dstStride;
+    int  j   = 0;
+
+#ifdef USE_AVX512
+    if( vext >= AVX512 )
+    {
+      const __m512i vlanes = _mm512_loadu_si512( ( const void* ) g_alfLanePermute512 );
+      const __m512i vhalfs = _mm512_loadu_si512( ( const void* ) g_alfHalfPermute512 );
+
+      for( ; j + 32 <= blk.width; j += 32 )
+      {
+        getBlockCoeffs( pClass + j, 8 );
+
+        __m512i vcoefLo[6], vcoefHi[6], vclip[12];
+        for( int p = 0; p < numPairs; p++ )
+        {
+          vcoefLo[p] = _mm512_permutexvar_epi32( vlanes, _mm512_castsi128_si512( _mm_setr_epi32( coefPairs[0][p], coefPairs[2][p], coefPairs[4][p], coefPairs[6][p] ) ) );
+          vcoefHi[p] = _mm512_permutexvar_epi32( vlanes, _mm512_castsi128_si512( _mm_setr_epi32( coefPairs[1][p], coefPairs[3][p], coefPairs[5][p], coefPairs[7][p] ) ) );
+        }
+        for( int k = 0; k < numTaps; k++ )
+        {
+          const __m128i vclip8 = _mm_setr_epi16( clipVals[0][k], clipVals[1][k], clipVals[2][k], clipVals[3][k], clipVals[4][k], clipVals[5][k], clipVals[6][k], clipVals[7][k] );
+          vclip[k] = _mm512_permutexvar_epi16( vhalfs, _mm512_castsi128_si512( vclip8 ) );
+        }
+
+        for( int ii = 0; ii < clsSizeY; ii++ )
+        {
+          xAlfFilterRow_AVX512<filtType>( img[ii], j, rec + ii * dstStride + j, vcoefLo, vcoefHi, vclip, vshift[ii], clpRng );
+        }
+      }
+    }
+#endif
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; j + 16 <= blk.width; j += 16 )
+      {
+        getBlockCoeffs( pClass + j, 4 );
+
+        __m256i vcoefLo[6], vcoefHi[6], vclip[12];
+        for( int p = 0; p < numPairs; p++ )
+        {
+          vcoefLo[p] = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_set1_epi32( coefPairs[0][p] ) ), _mm_set1_epi32( coefPairs[2][p] ), 1 );
+          vcoefHi[p] = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_set1_epi32( coefPairs[1][p] ) ), _mm_set1_epi32( coefPairs[3][p] ), 1 );
+        }
+        for( int k = 0; k < numTaps; k++ )
+        {
+          const __m128i vclip01 = _mm_unpacklo_epi64( _mm_set1_epi16( clipVals[0][k] ), _mm_set1_epi16( clipVals[1][k] ) );
+          const __m128i vclip23 = _mm_unpacklo_epi64( _mm_set1_epi16( clipVals[2][k] ), _mm_set1_epi16( clipVals[3][k] ) );
+          vclip[k] = _mm256_inserti128_si256( _mm256_castsi128_si256( vclip01 ), vclip23, 1 );
+        }
+
+        for( int ii = 0; ii < clsSizeY; ii++ )
+        {
+          xAlfFilterRow_AVX2<filtType>( img[ii], j, rec + ii * dstStride + j, vcoefLo, vcoefHi, vclip, vshift[ii], clpRng );
+        }
+      }
+    }
+#endif
+
+    for( ; j < blk.width; j += 8 )
+    {
+      const bool full = j + 8 <= blk.width;
+      getBlockCoeffs( pClass + j, full ? 2 : 1 );
+
+      __m128i vcoefLo[6], vcoefHi[6], vclip[12];
+      for( int p = 0; p < numPairs; p++ )
+      {
+        vcoefLo[p] = _mm_set1_epi32( coefPairs[0][p] );
+        vcoefHi[p] = _mm_set1_epi32( coefPairs[1][p] );
+      }
+      for( int k = 0; k < numTaps; k++ )
+      {
+        vclip[k] = _mm_unpacklo_epi64( _mm_set1_epi16( clipVals[0][k] ), _mm_set1_epi16( clipVals[1][k] ) );
+      }
+
+      for( int ii = 0; ii < clsSizeY; ii++ )
+      {
+        if( full )
+        {
+          xAlfFilterRow_SSE<filtType, true >( img[ii], j, rec + ii * dstStride + j, vcoefLo, vcoefHi, vclip, vshift[ii], clpRng );
+        }
+        else
+        {
+          xAlfFilterRow_SSE<filtType, false>( img[ii], j, rec + ii * dstStride + j, vcoefLo, vcoefHi, vclip, vshift[ii], clpRng );
+        }
+      }
+    }
+  }
+}
+
+#if JVET_Q0795_CCALF
+// --------------------------------------------------------------------------------------------------------------------
+// cross component filtering
+// --------------------------------------------------------------------------------------------------------------------
+
+// The luma taps of AdaptiveLoopFilter::filterBlkCcAlf are: 0 above, 1 left, 2 right, 3 below left, 4 below,
+// 5 below right and 6 two rows below, all relative to the collocated luma sample in row p0. Coefficient pairs
+// (0, 1), (2, 3), (4, 5) and (6, 0) are interleaved for _mm_madd_epi16.
+
+// rounding, clipping of the correction and adding it to the chroma samples, 32 bit
+static ALWAYS_INLINE __m128i xCcAlfApply_SSE( const __m128i vsum, const __m128i vself, const int offset, const ClpRng& clpRng )
+{
+  const __m128i voffset = _mm_set1_epi32( offset );
+  const __m128i vmin    = _mm_set1_epi32( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi32( clpRng.max );
+
+  __m128i v = _mm_srai_epi32( _mm_add_epi32( vsum, _mm_set1_epi32( ( 1 << AdaptiveLoopFilter::m_scaleBits ) >> 1 ) ), AdaptiveLoopFilter::m_scaleBits );
+  v = _mm_sub_epi32( _mm_min_epi32( vmax, _mm_max_epi32( vmin, _mm_add_epi32( v, voffset ) ) ), voffset );
+  return _mm_min_epi32( vmax, _mm_max_epi32( vmin, _mm_add_epi32( v, vself ) ) );
+}
+
+// horizontally subsampled luma (4:2:0, 4:2:2): the collocated samples are the even 16 bit lanes, so a madd of a
+// pair of differences blended into the even and odd lanes yields one sum per chroma sample
+static ALWAYS_INLINE __m128i xCcAlfSumX2_SSE( const Pel* p0, const Pel* p1, const Pel* p2, const Pel* p3, const __m128i* vcoef )
+{
+  const __m128i vcur   = _mm_loadu_si128( ( const __m128i* ) p0 );
+  const __m128i vcurL  = _mm_loadu_si128( ( const __m128i* ) ( p0 - 1 ) );
+  const __m128i vbelow = _mm_loadu_si128( ( const __m128i* ) p1 );
+  const __m128i vbelL  = _mm_loadu_si128( ( const __m128i* ) ( p1 - 1 ) );
+
+  const __m128i vd0 = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* ) p2 ), vcur );
+  const __m128i vd1 = _mm_sub_epi16( vcurL, vcur );
+  const __m128i vd2 = _mm_sub_epi16( _mm_srli_epi32( vcur, 16 ), vcur );
+  const __m128i vd3 = _mm_sub_epi16( vbelL, vcur );
+  const __m128i vd4 = _mm_sub_epi16( vbelow, vcur );
+  const __m128i vd5 = _mm_sub_epi16( _mm_srli_epi32( vbelow, 16 ), vcur );
+  const __m128i vd6 = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* ) p3 ), vcur );
+
+  __m128i vsum = _mm_madd_epi16( _mm_blend_epi16( vd0, _mm_slli_epi32( vd1, 16 ), 0xaa ), vcoef[0] );
+  vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_blend_epi16( vd2, _mm_slli_epi32( vd3, 16 ), 0xaa ), vcoef[1] ) );
+  vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_blend_epi16( vd4, _mm_slli_epi32( vd5, 16 ), 0xaa ), vcoef[2] ) );
+  vsum = _mm_add_epi32( vsum, _mm_madd_epi16( vd6, vcoef[3] ) );
+  return vsum;
+}
+
+// full resolution luma (4:4:4), 8 samples (4 if !full) with the sums of the lower and upper half in vsumLo and vsumHi
+template<bool full>
+static ALWAYS_INLINE void xCcAlfSum_SSE( const Pel* p0, const Pel* p1, const Pel* p2, const Pel* p3, const __m128i* vcoef, __m128i& vsumLo, __m128i& vsumHi )
+{
+#define CCALF_LOAD( p ) ( full ? _mm_loadu_si128( ( const __m128i* ) ( p ) ) : _mm_loadl_epi64( ( const __m128i* ) ( p ) ) )
+
+  const __m128i vcur = CCALF_LOAD( p0 );
+
+  const __m128i vd[8] =
+  {
+    _mm_sub_epi16( CCALF_LOAD( p2 ),     vcur ),
+    _mm_sub_epi16( CCALF_LOAD( p0 - 1 ), vcur ),
+    _mm_sub_epi16( CCALF_LOAD( p0 + 1 ), vcur ),
+    _mm_sub_epi16( CCALF_LOAD( p1 - 1 ), vcur ),
+    _mm_sub_epi16( CCALF_LOAD( p1 ),     vcur ),
+    _mm_sub_epi16( CCALF_LOAD( p1 + 1 ), vcur ),
+    _mm_sub_epi16( CCALF_LOAD( p3 ),     vcur ),
+    _mm_setzero_si128()
+  };
+
+#undef CCALF_LOAD
+
+  vsumLo = _mm_setzero_si128();
+  vsumHi = _mm_setzero_si128();
+  for( int k = 0; k < 4; k++ )
+  {
+    vsumLo = _mm_add_epi32( vsumLo, _mm_madd_epi16( _mm_unpacklo_epi16( vd[2 * k], vd[2 * k + 1] ), vcoef[k] ) );
+    if( full )
+    {
+      vsumHi = _mm_add_epi32( vsumHi, _mm_madd_epi16( _mm_unpackhi_epi16( vd[2 * k], vd[2 * k + 1] ), vcoef[k] ) );
+    }
+  }
+}
+
+#ifdef USE_AVX2
+static ALWAYS_INLINE __m256i xCcAlfApply_AVX2( const __m256i vsum, const __m256i vself, const int offset, const ClpRng& clpRng )
+{
+  const __m256i voffset = _mm256_set1_epi32( offset );
+  const __m256i vmin    = _mm256_set1_epi32( clpRng.min );
+  const __m256i vmax    = _mm256_set1_epi32( clpRng.max );
+
+  __m256i v = _mm256_srai_epi32( _mm256_add_epi32( vsum, _mm256_set1_epi32( ( 1 << AdaptiveLoopFilter::m_scaleBits ) >> 1 ) ), AdaptiveLoopFilter::m_scaleBits );
+  v = _mm256_sub_epi32( _mm256_min_epi32( vmax, _mm256_max_epi32( vmin, _mm256_add_epi32( v, voffset ) ) ), voffset );
+  return _mm256_min_epi32( vmax, _mm256_max_epi32( vmin, _mm256_add_epi32( v, vself ) ) );
+}
+
+static ALWAYS_INLINE __m256i xCcAlfSumX2_AVX2( const Pel* p0, const Pel* p1, const Pel* p2, const Pel* p3, const __m256i* vcoef )
+{
+  const __m256i vcur   = _mm256_loadu_si256( ( const __m256i* ) p0 );
+  const __m256i vcurL  = _mm256_loadu_si256( ( const __m256i* ) ( p0 - 1 ) );
+  const __m256i vbelow = _mm256_loadu_si256( ( const __m256i* ) p1 );
+  const __m256i vbelL  = _mm256_loadu_si256( ( const __m256i* ) ( p1 - 1 ) );
+
+  const __m256i vd0 = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) p2 ), vcur );
+  const __m256i vd1 = _mm256_sub_epi16( vcurL, vcur );
+  const __m256i vd2 = _mm256_sub_epi16( _mm256_srli_epi32( vcur, 16 ), vcur );
+  const __m256i vd3 = _mm256_sub_epi16( vbelL, vcur );
+  const __m256i vd4 = _mm256_sub_epi16( vbelow, vcur );
+  const __m256i vd5 = _mm256_sub_epi16( _mm256_srli_epi32( vbelow, 16 ), vcur );
+  const __m256i vd6 = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) p3 ), vcur );
+
+  __m256i vsum = _mm256_madd_epi16( _mm256_blend_epi16( vd0, _mm256_slli_epi32( vd1, 16 ), 0xaa ), vcoef[0] );
+  vsum = _mm256_add_epi32( vsum, _mm256_madd_epi16( _mm256_blend_epi16( vd2, _mm256_slli_epi32( vd3, 16 ), 0xaa ), vcoef[1] ) );
+  vsum = _mm256_add_epi32( vsum, _mm256_madd_epi16( _mm256_blend_epi16( vd4, _mm256_slli_epi32( vd5, 16 ), 0xaa ), vcoef[2] ) );
+  vsum = _mm256_add_epi32( vsum, _mm256_madd_epi16( vd6, vcoef[3] ) );
+  return vsum;
+}
+
+static ALWAYS_INLINE void xCcAlfSum_AVX2( const Pel* p0, const Pel* p1, const Pel* p2, const Pel* p3, const __m256i* vcoef, __m256i& vsumLo, __m256i& vsumHi )
+{
+  const __m256i vcur = _mm256_loadu_si256( ( const __m256i* ) p0 );
+
+  const __m256i vd[8] =
+  {
+    _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) p2 ),         vcur ),
+    _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) ( p0 - 1 ) ), vcur ),
+    _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) ( p0 + 1 ) ), vcur ),
+    _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) ( p1 - 1 ) ), vcur ),
+    _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) p1 ),         vcur ),
+    _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) ( p1 + 1 ) ), vcur ),
+    _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) p3 ),         vcur ),
+    _mm256_setzero_si256()
+  };
+
+  vsumLo = _mm256_setzero_si256();
+  vsumHi = _mm256_setzero_si256();
+  for( int k = 0; k < 4; k++ )
+  {
+    vsumLo = _mm256_add_epi32( vsumLo, _mm256_madd_epi16( _mm256_unpacklo_epi16( vd[2 * k], vd[2 * k + 1] ), vcoef[k] ) );
+    vsumHi = _mm256_add_epi32( vsumHi, _mm256_madd_epi16( _mm256_unpackhi_epi16( vd[2 * k], vd[2 * k + 1] ), vcoef[k] ) );
+  }
+}
+#endif
+
+template<X86_VEXT vext, bool subX>
+static void xCcAlfFilterRow( const Pel* p0, const Pel* p1, const Pel* p2, const Pel* p3, Pel* self, const int width, const int16_t *filterCoeff, const ClpRng& clpRng )
+{
+  const int offset = 1 << clpRng.bd >> 1;
+  const int step   = subX ? 2 : 1;
+
+  __m128i vcoef[4];
+  for( int k = 0; k < 4; k++ )
+  {
+    vcoef[k] = _mm_set1_epi32( ( filterCoeff[2 * k] & 0xffff ) | ( k < 3 ? int( filterCoeff[2 * k + 1] ) << 16 : 0 ) );
+  }
+
+  int x = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    __m256i vcoef256[4];
+    for( int k = 0; k < 4; k++ )
+    {
+      vcoef256[k] = _mm256_broadcastsi128_si256( vcoef[k] );
+    }
+
+    if( subX )
+    {
+      for( ; x + 8 <= width; x += 8 )
+      {
+        const int     xl   = x * step;
+        const __m256i vsum = xCcAlfSumX2_AVX2( p0 + xl, p1 + xl, p2 + xl, p3 + xl, vcoef256 );
+        __m256i vres = xCcAlfApply_AVX2( vsum, _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &self[x] ) ), offset, clpRng );
+        vres = _mm256_permute4x64_epi64( _mm256_packs_epi32( vres, vres ), 0x08 );
+        _mm_storeu_si128( ( __m128i* ) &self[x], _mm256_castsi256_si128( vres ) );
+      }
+    }
+    else
+    {
+      for( ; x + 16 <= width; x += 16 )
+      {
+        __m256i vsumLo, vsumHi;
+        xCcAlfSum_AVX2( p0 + x, p1 + x, p2 + x, p3 + x, vcoef256, vsumLo, vsumHi );
+        const __m256i vself = _mm256_loadu_si256( ( const __m256i* ) &self[x] );
+        const __m256i vlo   = xCcAlfApply_AVX2( vsumLo, _mm256_srai_epi32( _mm256_unpacklo_epi16( vself, vself ), 16 ), offset, clpRng );
+        const __m256i vhi   = xCcAlfApply_AVX2( vsumHi, _mm256_srai_epi32( _mm256_unpackhi_epi16( vself, vself ), 16 ), offset, clpRng );
+        _mm256_storeu_si256( ( __m256i* ) &self[x], _mm256_packs_epi32( vlo, vhi ) );
+      }
+    }
+  }
+#endif
+
+  if( subX )
+  {
+    for( ; x < width; x += 4 )
+    {
+      const int     xl   = x * step;
+      const __m128i vsum = xCcAlfSumX2_SSE( p0 + xl, p1 + xl, p2 + xl, p3 + xl, vcoef );
+      const __m128i vres = xCcAlfApply_SSE( vsum, _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &self[x] ) ), offset, clpRng );
+      _mm_storel_epi64( ( __m128i* ) &self[x], _mm_packs_epi32( vres, vres ) );
+    }
+  }
+  else
+  {
+    for( ; x + 8 <= width; x += 8 )
+    {
+      __m128i vsumLo, vsumHi;
+      xCcAlfSum_SSE<true>( p0 + x, p1 + x, p2 + x, p3 + x, vcoef, vsumLo, vsumHi );
+      const __m128i vself = _mm_loadu_si128( ( const __m128i* ) &self[x] );
+      const __m128i vlo   = xCcAlfApply_SSE( vsumLo, _mm_cvtepi16_epi32( vself ), offset, clpRng );
+      const __m128i vhi   = xCcAlfApply_SSE( vsumHi, _mm_cvtepi16_epi32( _mm_unpackhi_epi64( vself, vself ) ), offset, clpRng );
+      _mm_storeu_si128( ( __m128i* ) &self[x], _mm_packs_epi32( vlo, vhi ) );
+    }
+    if( x < width )
+    {
+      __m128i vsumLo, vsumHi;
+      xCcAlfSum_SSE<false>( p0 + x, p1 + x, p2 + x, p3 + x, vcoef, vsumLo, vsumHi );
+      const __m128i vres = xCcAlfApply_SSE( vsumLo, _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &self[x] ) ), offset, clpRng );
+      _mm_storel_epi64( ( __m128i* ) &self[x], _mm_packs_epi32( vres, vres ) );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void simdFilterBlkCcAlf( const PelBuf &dstBuf, const CPelUnitBuf &recSrc, const Area &blkDst, const Area &blkSrc, const ComponentID compId, const int16_t *filterCoeff, const ClpRngs &clpRngs, CodingStructure &cs, int vbCTUHeight, int vbPos )
+{
+  CHECK( 1 << floorLog2( vbCTUHeight ) != vbCTUHeight, "Not a power of 2" );
+  CHECK( !isChroma( compId ), "Must be chroma" );
+
+  // the luma differences are computed with 16 bits
+  if( clpRngs.comp[COMPONENT_Y].bd > 14 )
+  {
+    AdaptiveLoopFilter::filterBlkCcAlf<CC_ALF>( dstBuf, recSrc, blkDst, blkSrc, compId, filterCoeff, clpRngs, cs, vbCTUHeight, vbPos );
+    return;
+  }
+
+  const ChromaFormat nChromaFormat = cs.slice->getSPS()->getChromaFormatIdc();
+  const int scaleX = getComponentScaleX( compId, nChromaFormat );
+  const int scaleY = getComponentScaleY( compId, nChromaFormat );
+
+  CHECK( blkDst.y % 4, "Wrong startHeight in filtering" );
+  CHECK( blkDst.x % 4, "Wrong startWidth in filtering" );
+  CHECK( blkDst.height % 4, "Wrong endHeight in filtering" );
+  CHECK( blkDst.width % 4, "Wrong endWidth in filtering" );
+
+  CPelBuf     srcBuf     = recSrc.get( COMPONENT_Y );
+  const int   lumaStride = srcBuf.stride;
+  const Pel * lumaPtr    = srcBuf.buf + blkSrc.y * lumaStride + blkSrc.x;
+
+  const int   chromaStride = dstBuf.stride;
+  Pel *       chromaPtr    = dstBuf.buf + blkDst.y * chromaStride + blkDst.x;
+
+  for( int i = 0; i < blkDst.height; i++ )
+  {
+    int offset1 = lumaStride;
+    int offset2 = -lumaStride;
+    int offset3 = 2 * lumaStride;
+
+    const int pos = ( ( blkDst.y + i ) << scaleY ) & ( vbCTUHeight - 1 );
+    if( pos == ( vbPos - 2 ) || pos == ( vbPos + 1 ) )
+    {
+      offset3 = offset1;
+    }
+    else if( pos == ( vbPos - 1 ) || pos == vbPos )
+    {
+      offset1 = 0;
+      offset2 = 0;
+      offset3 = 0;
+    }
+
+    const Pel* p0 = lumaPtr + ( i << scaleY ) * lumaStride;
+    Pel* self     = chromaPtr + i * chromaStride;
+
+    if( scaleX )
+    {
+      xCcAlfFilterRow<vext, true >( p0, p0 + offset1, p0 + offset2, p0 + offset3, self, blkDst.width, filterCoeff, clpRngs.comp[compId] );
+    }
+    else
+    {
+      xCcAlfFilterRow<vext, false>( p0, p0 + offset1, p0 + offset2, p0 + offset3, self, blkDst.width, filterCoeff, clpRngs.comp[compId] );
+    }
+  }
+}
+#endif
+
+// --------------------------------------------------------------------------------------------------------------------
+// encoder statistics
+// --------------------------------------------------------------------------------------------------------------------
+
+// the features of two samples are interleaved to 32 bit pairs, a madd of the broadcast pair of feature m with the pairs
+// of the columns n adds the products f[m] * f[n] of both samples, up to 8 pairs are added per load and store of the sums
+template<X86_VEXT vext>
+static void simdAccumulateCovariance( const int16_t* features, const int numSamples, const int numFeatures, const int groupSize, int* sums )
+{
+  constexpr int stride   = AdaptiveLoopFilter::MaxAlfCovFeatures;
+  constexpr int maxPairs = 8;
+  const int     numCols  = ( numFeatures + 7 ) & ~7;
+
+  ALIGN_DATA( 32, int32_t pairs[maxPairs][stride] );
+
+  for( int s = 0; s < numSamples; s += 2 * maxPairs )
+  {
+    const int numPairs = ( std::min( numSamples - s, 2 * maxPairs ) + 1 ) >> 1;
+
+    for( int p = 0; p < numPairs; p++ )
+    {
+      const int16_t* f0  = features + 2 * p * stride;
+      const int16_t* f1  = f0 + stride;
+      const bool     odd = s + 2 * p + 1 == numSamples;
+
+      for( int n = 0; n < numCols; n += 8 )
+      {
+        const __m128i v0 = _mm_loadu_si128( ( const __m128i* ) ( f0 + n ) );
+        const __m128i v1 = odd ? _mm_setzero_si128() : _mm_loadu_si128( ( const __m128i* ) ( f1 + n ) );
+        _mm_store_si128( ( __m128i* ) ( pairs[p] + n ),     _mm_unpacklo_epi16( v0, v1 ) );
+        _mm_store_si128( ( __m128i* ) ( pairs[p] + n + 4 ), _mm_unpackhi_epi16( v0, v1 ) );
+      }
+    }
+
+    for( int m = 0; m < numFeatures; m++ )
+    {
+      int*      sumsRow = sums + m * stride;
+      const int col0    = m - m % groupSize;
+
+#ifdef USE_AVX2
+      if( vext >= AVX2 )
+      {
+        for( int n = col0 & ~7; n < numCols; n += 8 )
+        {
+          __m256i acc = _mm256_loadu_si256( ( const __m256i* ) ( sumsRow + n ) );
+          for( int p = 0; p < numPairs; p++ )
+          {
+            acc = _mm256_add_epi32( acc, _mm256_madd_epi16( _mm256_set1_epi32( pairs[p][m] ), _mm256_load_si256( ( const __m256i* ) ( pairs[p] + n ) ) ) );
+          }
+          _mm256_storeu_si256( ( __m256i* ) ( sumsRow + n ), acc );
+        }
+      }
+      else
+#endif
+      {
+        for( int n = col0 & ~3; n < numCols; n += 4 )
+        {
+          __m128i acc = _mm_loadu_si128( ( const __m128i* ) ( sumsRow + n ) );
+          for( int p = 0; p < numPairs; p++ )
+          {
+            acc = _mm_add_epi32( acc, _mm_madd_epi16( _mm_set1_epi32( pairs[p][m] ), _mm_load_si128( ( const __m128i* ) ( pairs[p] + n ) ) ) );
+          }
+          _mm_storeu_si128( ( __m128i* ) ( sumsRow + n ), acc );
+        }
+      }
+    }
+
+    features += 2 * maxPairs * stride;
+  }
+}
+
+template <X86_VEXT vext>
+void AdaptiveLoopFilter::_initAdaptiveLoopFilterX86()
+{
+  m_deriveClassificationBlk = simdDeriveClassificationBlk<vext>;
+  m_filter5x5Blk            = simdFilterBlk<vext, ALF_FILTER_5>;
+  m_filter7x7Blk            = simdFilterBlk<vext, ALF_FILTER_7>;
+  m_accumulateCovariance    = simdAccumulateCovariance<vext>;
+#if JVET_Q0795_CCALF
+  m_filterCcAlf             = simdFilterBlkCcAlf<vext>;
+#endif
+}
+
+template void AdaptiveLoopFilter::_initAdaptiveLoopFilterX86<SIMDX86>();
+
+//! \}
+
+#endif //TARGET_SIMD_X86
+#endif //ENABLE_SIMD_OPT_ALF
@@ -0,0 +1,317 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     AffineGradientSearchX86.h
+    \brief    affine gradient search class, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../AffineGradientSearch.h"
+
+#if ENABLE_SIMD_OPT_AFFINE_ME
+#ifdef TARGET_SIMD_X86
+
+//! \ingroup CommonLib
+//! \{
+
+static_assert( sizeof( Pel ) == 2, "The SIMD affine gradient search expects 16 bit samples" );
+
+// --------------------------------------------------------------------------------------------------------------------
+// Sobel filters
+// --------------------------------------------------------------------------------------------------------------------
+
+// The filter sums of clipped prediction samples are at most 4 * ( 2^bitDepth - 1 ) in magnitude and fit into 16 bits.
+// The inner samples are computed in vectors of 8 (or 4 for blocks of width 8) with the last vector of a row shifted
+// left to end at width - 2, the border samples are replicated afterwards as in the C code.
+
+template<X86_VEXT vext>
+static ALWAYS_INLINE void xStoreDerivate( int* dst, const __m128i sum )
+{
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    _mm256_storeu_si256( ( __m256i* ) dst, _mm256_cvtepi16_epi32( sum ) );
+    return;
+  }
+#endif
+  _mm_storeu_si128( ( __m128i* ) dst,       _mm_cvtepi16_epi32( sum ) );
+  _mm_storeu_si128( ( __m128i* ) ( dst + 4 ), _mm_cvtepi16_epi32( _mm_srli_si128( sum, 8 ) ) );
+}
+
+template<bool isVertical, bool is8>
+static ALWAYS_INLINE __m128i xSobel( const Pel* src, const int stride )
+{
+  // src points to the center sample of the first output
+  auto load = [&]( const Pel* p ) { return is8 ? _mm_loadu_si128( ( const __m128i* ) p ) : _mm_loadl_epi64( ( const __m128i* ) p ); };
+
+  if( isVertical )
+  {
+    const __m128i dl = _mm_sub_epi16( load( src + stride - 1 ), load( src - stride - 1 ) );
+    const __m128i dc = _mm_sub_epi16( load( src + stride     ), load( src - stride     ) );
+    const __m128i dr = _mm_sub_epi16( load( src + stride + 1 ), load( src - stride + 1 ) );
+    return _mm_add_epi16( _mm_add_epi16( dl, dr ), _mm_slli_epi16( dc, 1 ) );
+  }
+  else
+  {
+    const __m128i da = _mm_sub_epi16( load( src - stride + 1 ), load( src - stride - 1 ) );
+    const __m128i dc = _mm_sub_epi16( load( src          + 1 ), load( src          - 1 ) );
+    const __m128i db = _mm_sub_epi16( load( src + stride + 1 ), load( src + stride - 1 ) );
+    return _mm_add_epi16( _mm_add_epi16( da, db ), _mm_slli_epi16( dc, 1 ) );
+  }
+}
+
+static void xSobelFillBorder( int* const pDerivate, const int derivateBufStride, const int width, const int height )
+{
+  for( int j = 1; j < height - 1; j++ )
+  {
+    pDerivate[j * derivateBufStride]             = pDerivate[j * derivateBufStride + 1];
+    pDerivate[j * derivateBufStride + width - 1] = pDerivate[j * derivateBufStride + width - 2];
+  }
+
+  pDerivate[0]                                            = pDerivate[derivateBufStride + 1];
+  pDerivate[width - 1]                                    = pDerivate[derivateBufStride + width - 2];
+  pDerivate[( height - 1 ) * derivateBufStride]             = pDerivate[( height - 2 ) * derivateBufStride + 1];
+  pDerivate[( height - 1 ) * derivateBufStride + width - 1] = pDerivate[( height - 2 ) * derivateBufStride + ( width - 2 )];
+
+  for( int j = 1; j < width - 1; j++ )
+  {
+    pDerivate[j]                                    = pDerivate[derivateBufStride + j];
+    pDerivate[( height - 1 ) * derivateBufStride + j] = pDerivate[( height - 2 ) * derivateBufStride + j];
+  }
+}
+
+template<X86_VEXT vext, bool isVertical>
+static void sobelFilter_SSE( Pel* const pPred, const int predStride, int* const pDerivate, const int derivateBufStride, const int width, const int height )
+{
+  if( width < 6 || height < 3 )
+  {
+    if( isVertical )
+    {
+      AffineGradientSearch::xVerticalSobelFilter( pPred, predStride, pDerivate, derivateBufStride, width, height );
+    }
+    else
+    {
+      AffineGradientSearch::xHorizontalSobelFilter( pPred, predStride, pDerivate, derivateBufStride, width, height );
+    }
+    return;
+  }
+
+  const int lastX = width - 2;
+
+  for( int j = 1; j < height - 1; j++ )
+  {
+    const Pel* src = pPred + j * predStride;
+    int*       dst = pDerivate + j * derivateBufStride;
+
+    if( lastX >= 8 )
+    {
+      for( int k = 1; k <= lastX; k += 8 )
+      {
+        const int x = std::min( k, lastX - 7 );
+        xStoreDerivate<vext>( dst + x, xSobel<isVertical, true>( src + x, predStride ) );
+      }
+    }
+    else
+    {
+      const __m128i lo = xSobel<isVertical, false>( src + 1, predStride );
+      const __m128i hi = xSobel<isVertical, false>( src + lastX - 3, predStride );
+      _mm_storeu_si128( ( __m128i* ) ( dst + 1 ),         _mm_cvtepi16_epi32( lo ) );
+      _mm_storeu_si128( ( __m128i* ) ( dst + lastX - 3 ), _mm_cvtepi16_epi32( hi ) );
+    }
+  }
+
+  xSobelFillBorder( pDerivate, derivateBufStride, width, height );
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Normal equation
+// --------------------------------------------------------------------------------------------------------------------
+
+// The coefficients iC fit into 32 bits, their products are accumulated in 64 bit lanes: _mm_mul_epi32 multiplies
+// the even 32 bit elements, the odd ones are shifted down first. The matrix is symmetric, only the lower triangle
+// is accumulated. ( sum a ) << 3 equals sum ( a << 3 ) for the residue column.
+
+static ALWAYS_INLINE void xAccMul( __m128i& acc, const __m128i a, const __m128i b )
+{
+  acc = _mm_add_epi64( acc, _mm_mul_epi32( a, b ) );
+  acc = _mm_add_epi64( acc, _mm_mul_epi32( _mm_srli_epi64( a, 32 ), _mm_srli_epi64( b, 32 ) ) );
+}
+
+static ALWAYS_INLINE int64_t xHsum64( const __m128i acc ) { return _mm_hsum_epi64( acc ); }
+
+static ALWAYS_INLINE __m128i xLoadDerivate( const int* p, __m128i ) { return _mm_loadu_si128( ( const __m128i* ) p ); }
+static ALWAYS_INLINE __m128i xLoadResidue ( const Pel* p, __m128i ) { return _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) p ) ); }
+static ALWAYS_INLINE __m128i xAdd32( const __m128i a, const __m128i b ) { return _mm_add_epi32  ( a, b ); }
+static ALWAYS_INLINE __m128i xSub32( const __m128i a, const __m128i b ) { return _mm_sub_epi32  ( a, b ); }
+static ALWAYS_INLINE __m128i xMul32( const __m128i a, const __m128i b ) { return _mm_mullo_epi32( a, b ); }
+static ALWAYS_INLINE __m128i xSet32( const int v, __m128i ) { return _mm_set1_epi32( v ); }
+// cx for the 4 samples starting at k
+static ALWAYS_INLINE __m128i xCx( const int k, __m128i ) { return _mm_set1_epi32( k + 2 ); }
+
+#ifdef USE_AVX2
+static ALWAYS_INLINE void xAccMul( __m256i& acc, const __m256i a, const __m256i b )
+{
+  acc = _mm256_add_epi64( acc, _mm256_mul_epi32( a, b ) );
+  acc = _mm256_add_epi64( acc, _mm256_mul_epi32( _mm256_srli_epi64( a, 32 ), _mm256_srli_epi64( b, 32 ) ) );
+}
+
+static ALWAYS_INLINE int64_t xHsum64( const __m256i acc ) { return _mm256_hsum_epi64( acc ); }
+
+static ALWAYS_INLINE __m256i xLoadDerivate( const int* p, __m256i ) { return _mm256_loadu_si256( ( const __m256i* ) p ); }
+static ALWAYS_INLINE __m256i xLoadResidue ( const Pel* p, __m256i ) { return _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) p ) ); }
+static ALWAYS_INLINE __m256i xAdd32( const __m256i a, const __m256i b ) { return _mm256_add_epi32  ( a, b ); }
+static ALWAYS_INLINE __m256i xSub32( const __m256i a, const __m256i b ) { return _mm256_sub_epi32  ( a, b ); }
+static ALWAYS_INLINE __m256i xMul32( const __m256i a, const __m256i b ) { return _mm256_mullo_epi32( a, b ); }
+static ALWAYS_INLINE __m256i xSet32( const int v, __m256i ) { return _mm256_set1_epi32( v ); }
+// cx for the 8 samples starting at k, which covers two groups of 4
+static ALWAYS_INLINE __m256i xCx( const int k, __m256i ) { return _mm256_setr_epi32( k + 2, k + 2, k + 2, k + 2, k + 6, k + 6, k + 6, k + 6 ); }
+#endif
+
+template<typename T, int numParam>
+static void xEqualCoeffComputerT( Pel* pResidue, int** ppDerivate, int derivateBufStride, int64_t( *pEqualCoeff )[7], int width, int height )
+{
+  const int step = sizeof( T ) / sizeof( int );
+  const T   zero = T();
+
+  T acc[numParam][numParam + 1];
+  for( int col = 0; col < numParam; col++ )
+  {
+    for( int row = 0; row <= numParam; row++ )
+    {
+      acc[col][row] = xSet32( 0, zero );
+    }
+  }
+
+  for( int j = 0; j != height; j++ )
+  {
+    const T cy = xSet32( ( ( j >> 2 ) << 2 ) + 2, zero );
+
+    for( int k = 0; k != width; k += step )
+    {
+      const int idx = j * derivateBufStride + k;
+      const T   cx  = xCx( k, zero );
+      const T   d0  = xLoadDerivate( &ppDerivate[0][idx], zero );
+      const T   d1  = xLoadDerivate( &ppDerivate[1][idx], zero );
+      const T   res = xLoadResidue( &pResidue[idx], zero );
+      T iC[6];
+
+      if( numParam == 4 )
+      {
+        iC[0] = d0;
+        iC[1] = xAdd32( xMul32( cx, d0 ), xMul32( cy, d1 ) );
+        iC[2] = d1;
+        iC[3] = xSub32( xMul32( cy, d0 ), xMul32( cx, d1 ) );
+      }
+      else
+      {
+        iC[0] = d0;
+        iC[1] = xMul32( cx, d0 );
+        iC[2] = d1;
+        iC[3] = xMul32( cx, d1 );
+        iC[4] = xMul32( cy, d0 );
+        iC[5] = xMul32( cy, d1 );
+      }
+
+      for( int col = 0; col < numParam; col++ )
+      {
+        for( int row = 0; row <= col; row++ )
+        {
+          xAccMul( acc[col][row], iC[col], iC[row] );
+        }
+        xAccMul( acc[col][numParam], iC[col], res );
+      }
+    }
+  }
+
+  for( int col = 0; col < numParam; col++ )
+  {
+    for( int row = 0; row <= col; row++ )
+    {
+      const int64_t sum = xHsum64( acc[col][row] );
+      pEqualCoeff[col + 1][row] += sum;
+      if( row != col )
+      {
+        pEqualCoeff[row + 1][col] += sum;
+      }
+    }
+    pEqualCoeff[col + 1][numParam] += xHsum64( acc[col][numParam] ) << 3;
+  }
+}
+
+template<X86_VEXT vext>
+static void equalCoeffComputer_SSE( Pel* pResidue, int residueStride, int** ppDerivate, int derivateBufStride, int64_t( *pEqualCoeff )[7], int width, int height, bool b6Param )
+{
+#ifdef USE_AVX2
+  if( vext >= AVX2 && ( width & 7 ) == 0 )
+  {
+    if( b6Param )
+    {
+      xEqualCoeffComputerT<__m256i, 6>( pResidue, ppDerivate, derivateBufStride, pEqualCoeff, width, height );
+    }
+    else
+    {
+      xEqualCoeffComputerT<__m256i, 4>( pResidue, ppDerivate, derivateBufStride, pEqualCoeff, width, height );
+    }
+    return;
+  }
+#endif
+  if( ( width & 3 ) == 0 )
+  {
+    if( b6Param )
+    {
+      xEqualCoeffComputerT<__m128i, 6>( pResidue, ppDerivate, derivateBufStride, pEqualCoeff, width, height );
+    }
+    else
+    {
+      xEqualCoeffComputerT<__m128i, 4>( pResidue, ppDerivate, derivateBufStride, pEqualCoeff, width, height );
+    }
+    return;
+  }
+
+  AffineGradientSearch::xEqualCoeffComputer( pResidue, residueStride, ppDerivate, derivateBufStride, pEqualCoeff, width, height, b6Param );
+}
+
+template <X86_VEXT vext>
+void AffineGradientSearch::_initAffineGradientSearchX86()
+{
+  m_HorizontalSobelFilter = sobelFilter_SSE<vext, false>;
+  m_VerticalSobelFilter   = sobelFilter_SSE<vext, true>;
+  m_EqualCoeffComputer    = equalCoeffComputer_SSE<vext>;
+}
+
+template void AffineGradientSearch::_initAffineGradientSearchX86<SIMDX86>();
+
+//! \}
+
+#endif //TARGET_SIMD_X86
+#endif //ENABLE_SIMD_OPT_AFFINE_ME
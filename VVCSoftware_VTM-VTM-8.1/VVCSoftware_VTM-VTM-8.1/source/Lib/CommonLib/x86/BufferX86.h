@@ -0,0 +1,1291 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     BufferX86.h
+    \brief    SIMD averaging, reconstruction, BDOF/PROF and padding kernels of PelBufferOps
+*/
+
+#include "CommonDefX86.h"
+#include "../Unit.h"
+#include "../Buffer.h"
+#include "../InterpolationFilter.h"
+
+#if ENABLE_SIMD_OPT_BUFFER
+#ifdef TARGET_SIMD_X86
+
+//! \ingroup CommonLib
+//! \{
+
+// keep the lower 16 bit of each 32 bit lane, sign extended, so that packing truncates like a cast to Pel
+static inline __m128i xTruncEpi32ToEpi16( const __m128i v )
+{
+  return _mm_srai_epi32( _mm_slli_epi32( v, 16 ), 16 );
+}
+
+#ifdef USE_AVX2
+static inline __m256i xTruncEpi32ToEpi16( const __m256i v )
+{
+  return _mm256_srai_epi32( _mm256_slli_epi32( v, 16 ), 16 );
+}
+#endif
+
+// --------------------------------------------------------------------------------------------------------------------
+// bi-prediction average, reconstruction, linear transform
+// --------------------------------------------------------------------------------------------------------------------
+
+template<X86_VEXT vext, int W>
+void addAvg_SSE( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height, int shift, int offset, const ClpRng& clpRng )
+{
+  const __m128i vone    = _mm_set1_epi16( 1 );
+  const __m128i voffset = _mm_set1_epi32( offset );
+  const __m128i vshift  = _mm_cvtsi32_si128( shift );
+  const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+
+#ifdef USE_AVX2
+  if( W == 8 && vext >= AVX2 && ( width & 15 ) == 0 )
+  {
+    const __m256i vone256    = _mm256_set1_epi16( 1 );
+    const __m256i voffset256 = _mm256_set1_epi32( offset );
+    const __m256i vmin256    = _mm256_set1_epi16( clpRng.min );
+    const __m256i vmax256    = _mm256_set1_epi16( clpRng.max );
+
+    for( int row = 0; row < height; row++, src0 += src0Stride, src1 += src1Stride, dst += dstStride )
+    {
+      for( int col = 0; col < width; col += 16 )
+      {
+        const __m256i va  = _mm256_loadu_si256( ( const __m256i* ) &src0[col] );
+        const __m256i vb  = _mm256_loadu_si256( ( const __m256i* ) &src1[col] );
+        __m256i       vlo = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( va, vb ), vone256 ), voffset256 );
+        __m256i       vhi = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( va, vb ), vone256 ), voffset256 );
+        vlo = _mm256_sra_epi32( vlo, vshift );
+        vhi = _mm256_sra_epi32( vhi, vshift );
+        const __m256i vres = _mm256_min_epi16( vmax256, _mm256_max_epi16( vmin256, _mm256_packs_epi32( vlo, vhi ) ) );
+        _mm256_storeu_si256( ( __m256i* ) &dst[col], vres );
+      }
+    }
+    return;
+  }
+#endif
+
+  for( int row = 0; row < height; row++, src0 += src0Stride, src1 += src1Stride, dst += dstStride )
+  {
+    for( int col = 0; col < width; col += W )
+    {
+      if( W == 8 )
+      {
+        const __m128i va  = _mm_loadu_si128( ( const __m128i* ) &src0[col] );
+        const __m128i vb  = _mm_loadu_si128( ( const __m128i* ) &src1[col] );
+        __m128i       vlo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( va, vb ), vone ), voffset );
+        __m128i       vhi = _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( va, vb ), vone ), voffset );
+        vlo = _mm_sra_epi32( vlo, vshift );
+        vhi = _mm_sra_epi32( vhi, vshift );
+        _mm_storeu_si128( ( __m128i* ) &dst[col], _mm_min_epi16( vmax, _mm_max_epi16( vmin, _mm_packs_epi32( vlo, vhi ) ) ) );
+      }
+      else
+      {
+        const __m128i va  = _mm_loadl_epi64( ( const __m128i* ) &src0[col] );
+        const __m128i vb  = _mm_loadl_epi64( ( const __m128i* ) &src1[col] );
+        __m128i       vlo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( va, vb ), vone ), voffset );
+        vlo = _mm_sra_epi32( vlo, vshift );
+        _mm_storel_epi64( ( __m128i* ) &dst[col], _mm_min_epi16( vmax, _mm_max_epi16( vmin, _mm_packs_epi32( vlo, vlo ) ) ) );
+      }
+    }
+  }
+}
+
+// the saturating add gives the same result as the 32 bit sum after clipping to the sample range
+template<X86_VEXT vext, int W>
+void reco_SSE( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height, const ClpRng& clpRng )
+{
+  const __m128i vmin = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax = _mm_set1_epi16( clpRng.max );
+
+#ifdef USE_AVX2
+  if( W == 8 && vext >= AVX2 && ( width & 15 ) == 0 )
+  {
+    const __m256i vmin256 = _mm256_set1_epi16( clpRng.min );
+    const __m256i vmax256 = _mm256_set1_epi16( clpRng.max );
+
+    for( int row = 0; row < height; row++, src0 += src0Stride, src1 += src1Stride, dst += dstStride )
+    {
+      for( int col = 0; col < width; col += 16 )
+      {
+        const __m256i vsum = _mm256_adds_epi16( _mm256_loadu_si256( ( const __m256i* ) &src0[col] ), _mm256_loadu_si256( ( const __m256i* ) &src1[col] ) );
+        _mm256_storeu_si256( ( __m256i* ) &dst[col], _mm256_min_epi16( vmax256, _mm256_max_epi16( vmin256, vsum ) ) );
+      }
+    }
+    return;
+  }
+#endif
+
+  for( int row = 0; row < height; row++, src0 += src0Stride, src1 += src1Stride, dst += dstStride )
+  {
+    for( int col = 0; col < width; col += W )
+    {
+      if( W == 8 )
+      {
+        const __m128i vsum = _mm_adds_epi16( _mm_loadu_si128( ( const __m128i* ) &src0[col] ), _mm_loadu_si128( ( const __m128i* ) &src1[col] ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[col], _mm_min_epi16( vmax, _mm_max_epi16( vmin, vsum ) ) );
+      }
+      else
+      {
+        const __m128i vsum = _mm_adds_epi16( _mm_loadl_epi64( ( const __m128i* ) &src0[col] ), _mm_loadl_epi64( ( const __m128i* ) &src1[col] ) );
+        _mm_storel_epi64( ( __m128i* ) &dst[col], _mm_min_epi16( vmax, _mm_max_epi16( vmin, vsum ) ) );
+      }
+    }
+  }
+}
+
+template<bool bClip>
+static ALWAYS_INLINE __m128i xLinTf4( const __m128i vsrc, const __m128i vscale, const __m128i vshift, const bool shiftLeft, const __m128i voffset, const __m128i vmin, const __m128i vmax )
+{
+  __m128i v = _mm_mullo_epi32( _mm_cvtepi16_epi32( vsrc ), vscale );
+  v = shiftLeft ? _mm_sll_epi32( v, vshift ) : _mm_sra_epi32( v, vshift );
+  v = _mm_add_epi32( v, voffset );
+  return bClip ? _mm_min_epi32( vmax, _mm_max_epi32( vmin, v ) ) : xTruncEpi32ToEpi16( v );
+}
+
+template<X86_VEXT vext, int W, bool bClip>
+static void xLinTf_SSE( const Pel* src, int srcStride, Pel *dst, int dstStride, int width, int height, int scale, int shift, int offset, const ClpRng& clpRng )
+{
+  // rightShift() shifts to the left for negative shifts
+  const bool    shiftLeft = shift < 0;
+  const __m128i vshift    = _mm_cvtsi32_si128( shiftLeft ? -shift : shift );
+  const __m128i vscale    = _mm_set1_epi32( scale );
+  const __m128i voffset   = _mm_set1_epi32( offset );
+  const __m128i vmin      = _mm_set1_epi32( clpRng.min );
+  const __m128i vmax      = _mm_set1_epi32( clpRng.max );
+
+#ifdef USE_AVX2
+  if( W == 8 && vext >= AVX2 )
+  {
+    const __m256i vscale256  = _mm256_set1_epi32( scale );
+    const __m256i voffset256 = _mm256_set1_epi32( offset );
+    const __m256i vmin256    = _mm256_set1_epi32( clpRng.min );
+    const __m256i vmax256    = _mm256_set1_epi32( clpRng.max );
+
+    for( int row = 0; row < height; row++, src += srcStride, dst += dstStride )
+    {
+      for( int col = 0; col < width; col += 8 )
+      {
+        __m256i v = _mm256_mullo_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &src[col] ) ), vscale256 );
+        v = shiftLeft ? _mm256_sll_epi32( v, vshift ) : _mm256_sra_epi32( v, vshift );
+        v = _mm256_add_epi32( v, voffset256 );
+        v = bClip ? _mm256_min_epi32( vmax256, _mm256_max_epi32( vmin256, v ) ) : xTruncEpi32ToEpi16( v );
+        v = _mm256_permute4x64_epi64( _mm256_packs_epi32( v, v ), 0x08 );
+        _mm_storeu_si128( ( __m128i* ) &dst[col], _mm256_castsi256_si128( v ) );
+      }
+    }
+    return;
+  }
+#endif
+
+  for( int row = 0; row < height; row++, src += srcStride, dst += dstStride )
+  {
+    for( int col = 0; col < width; col += W )
+    {
+      if( W == 8 )
+      {
+        const __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &src[col] );
+        const __m128i vlo  = xLinTf4<bClip>( vsrc, vscale, vshift, shiftLeft, voffset, vmin, vmax );
+        const __m128i vhi  = xLinTf4<bClip>( _mm_unpackhi_epi64( vsrc, vsrc ), vscale, vshift, shiftLeft, voffset, vmin, vmax );
+        _mm_storeu_si128( ( __m128i* ) &dst[col], _mm_packs_epi32( vlo, vhi ) );
+      }
+      else
+      {
+        const __m128i vlo = xLinTf4<bClip>( _mm_loadl_epi64( ( const __m128i* ) &src[col] ), vscale, vshift, shiftLeft, voffset, vmin, vmax );
+        _mm_storel_epi64( ( __m128i* ) &dst[col], _mm_packs_epi32( vlo, vlo ) );
+      }
+    }
+  }
+}
+
+template<X86_VEXT vext, int W>
+void linTf_SSE( const Pel* src, int srcStride, Pel *dst, int dstStride, int width, int height, int scale, int shift, int offset, const ClpRng& clpRng, bool bClip )
+{
+  if( bClip )
+  {
+    xLinTf_SSE<vext, W, true >( src, srcStride, dst, dstStride, width, height, scale, shift, offset, clpRng );
+  }
+  else
+  {
+    xLinTf_SSE<vext, W, false>( src, srcStride, dst, dstStride, width, height, scale, shift, offset, clpRng );
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Explicit weighted prediction
+// --------------------------------------------------------------------------------------------------------------------
+
+// The weights (-128..255) and the 14 bit intermediate samples are multiplied with madd, the IF_INTERNAL_OFFS terms
+// are folded into a single 32 bit constant, so the result is exact for all bit depths up to 12.
+template<X86_VEXT vext, int W>
+void wghtBi_SSE( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height, int w0, int w1, int round, int shift, int offset, const ClpRng& clpRng )
+{
+  const int     addend  = ( w0 + w1 ) * IF_INTERNAL_OFFS + round + ( offset << ( shift - 1 ) );
+  const __m128i vw      = _mm_set1_epi32( ( w0 & 0xffff ) | ( w1 << 16 ) );
+  const __m128i vaddend = _mm_set1_epi32( addend );
+  const __m128i vshift  = _mm_cvtsi32_si128( shift );
+  const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+
+#ifdef USE_AVX2
+  const __m256i vw256      = _mm256_set1_epi32( ( w0 & 0xffff ) | ( w1 << 16 ) );
+  const __m256i vaddend256 = _mm256_set1_epi32( addend );
+  const __m256i vmin256    = _mm256_set1_epi16( clpRng.min );
+  const __m256i vmax256    = _mm256_set1_epi16( clpRng.max );
+#endif
+
+  for( int row = 0; row < height; row++, src0 += src0Stride, src1 += src1Stride, dst += dstStride )
+  {
+    int col = 0;
+#ifdef USE_AVX2
+    if( W == 8 && vext >= AVX2 )
+    {
+      for( ; col + 16 <= width; col += 16 )
+      {
+        const __m256i vsrc0 = _mm256_loadu_si256( ( const __m256i* ) &src0[col] );
+        const __m256i vsrc1 = _mm256_loadu_si256( ( const __m256i* ) &src1[col] );
+        __m256i vlo = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( vsrc0, vsrc1 ), vw256 ), vaddend256 );
+        __m256i vhi = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( vsrc0, vsrc1 ), vw256 ), vaddend256 );
+        vlo = _mm256_sra_epi32( vlo, vshift );
+        vhi = _mm256_sra_epi32( vhi, vshift );
+        _mm256_storeu_si256( ( __m256i* ) &dst[col], _mm256_min_epi16( vmax256, _mm256_max_epi16( vmin256, _mm256_packs_epi32( vlo, vhi ) ) ) );
+      }
+    }
+#endif
+    for( ; col < width; col += W )
+    {
+      if( W == 8 )
+      {
+        const __m128i vsrc0 = _mm_loadu_si128( ( const __m128i* ) &src0[col] );
+        const __m128i vsrc1 = _mm_loadu_si128( ( const __m128i* ) &src1[col] );
+        __m128i vlo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vsrc0, vsrc1 ), vw ), vaddend );
+        __m128i vhi = _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vsrc0, vsrc1 ), vw ), vaddend );
+        vlo = _mm_sra_epi32( vlo, vshift );
+        vhi = _mm_sra_epi32( vhi, vshift );
+        _mm_storeu_si128( ( __m128i* ) &dst[col], _mm_min_epi16( vmax, _mm_max_epi16( vmin, _mm_packs_epi32( vlo, vhi ) ) ) );
+      }
+      else
+      {
+        const __m128i vsrc = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) &src0[col] ), _mm_loadl_epi64( ( const __m128i* ) &src1[col] ) );
+        __m128i vsum = _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( vsrc, vw ), vaddend ), vshift );
+        vsum = _mm_packs_epi32( vsum, vsum );
+        _mm_storel_epi64( ( __m128i* ) &dst[col], _mm_min_epi16( vmax, _mm_max_epi16( vmin, vsum ) ) );
+      }
+    }
+  }
+}
+
+template<X86_VEXT vext, int W>
+void wghtUni_SSE( const Pel* src0, int src0Stride, Pel *dst, int dstStride, int width, int height, int w0, int round, int shift, int offset, const ClpRng& clpRng )
+{
+  const __m128i vw      = _mm_set1_epi32( w0 & 0xffff );
+  const __m128i vaddend = _mm_set1_epi32( w0 * IF_INTERNAL_OFFS + round );
+  const __m128i voffset = _mm_set1_epi32( offset );
+  const __m128i vshift  = _mm_cvtsi32_si128( shift );
+  const __m128i vzero   = _mm_setzero_si128();
+  const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+
+#ifdef USE_AVX2
+  const __m256i vw256      = _mm256_set1_epi32( w0 & 0xffff );
+  const __m256i vaddend256 = _mm256_set1_epi32( w0 * IF_INTERNAL_OFFS + round );
+  const __m256i voffset256 = _mm256_set1_epi32( offset );
+  const __m256i vzero256   = _mm256_setzero_si256();
+  const __m256i vmin256    = _mm256_set1_epi16( clpRng.min );
+  const __m256i vmax256    = _mm256_set1_epi16( clpRng.max );
+#endif
+
+  for( int row = 0; row < height; row++, src0 += src0Stride, dst += dstStride )
+  {
+    int col = 0;
+#ifdef USE_AVX2
+    if( W == 8 && vext >= AVX2 )
+    {
+      for( ; col + 16 <= width; col += 16 )
+      {
+        const __m256i vsrc = _mm256_loadu_si256( ( const __m256i* ) &src0[col] );
+        __m256i vlo = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( vsrc, vzero256 ), vw256 ), vaddend256 );
+        __m256i vhi = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( vsrc, vzero256 ), vw256 ), vaddend256 );
+        vlo = _mm256_add_epi32( _mm256_sra_epi32( vlo, vshift ), voffset256 );
+        vhi = _mm256_add_epi32( _mm256_sra_epi32( vhi, vshift ), voffset256 );
+        _mm256_storeu_si256( ( __m256i* ) &dst[col], _mm256_min_epi16( vmax256, _mm256_max_epi16( vmin256, _mm256_packs_epi32( vlo, vhi ) ) ) );
+      }
+    }
+#endif
+    for( ; col < width; col += W )
+    {
+      if( W == 8 )
+      {
+        const __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &src0[col] );
+        __m128i vlo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vsrc, vzero ), vw ), vaddend );
+        __m128i vhi = _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vsrc, vzero ), vw ), vaddend );
+        vlo = _mm_add_epi32( _mm_sra_epi32( vlo, vshift ), voffset );
+        vhi = _mm_add_epi32( _mm_sra_epi32( vhi, vshift ), voffset );
+        _mm_storeu_si128( ( __m128i* ) &dst[col], _mm_min_epi16( vmax, _mm_max_epi16( vmin, _mm_packs_epi32( vlo, vhi ) ) ) );
+      }
+      else
+      {
+        const __m128i vsrc = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) &src0[col] ), vzero );
+        __m128i vsum = _mm_add_epi32( _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( vsrc, vw ), vaddend ), vshift ), voffset );
+        vsum = _mm_packs_epi32( vsum, vsum );
+        _mm_storel_epi64( ( __m128i* ) &dst[col], _mm_min_epi16( vmax, _mm_max_epi16( vmin, vsum ) ) );
+      }
+    }
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// LMCS luma mapping and chroma residual scaling
+// --------------------------------------------------------------------------------------------------------------------
+
+#ifdef USE_AVX2
+// The LUT has 1 << bitDepth entries, so the aligned 32 bit pair holding an entry is gathered and the entry selected by
+// the lowest index bit. This never reads past the end of the LUT.
+template<X86_VEXT vext>
+void applyLut_SIMD( Pel* ptr, int stride, int width, int height, const Pel* lut )
+{
+  const int*    lut32 = ( const int* ) lut;
+  const __m256i vone  = _mm256_set1_epi32( 1 );
+  const __m256i vmask = _mm256_set1_epi32( 0xffff );
+
+  for( int row = 0; row < height; row++, ptr += stride )
+  {
+    int col = 0;
+    // two independent gathers per iteration hide most of the gather latency
+    for( ; col + 16 <= width; col += 16 )
+    {
+      const __m256i vsrc  = _mm256_loadu_si256( ( const __m256i* ) &ptr[col] );
+      const __m256i vidx0 = _mm256_cvtepu16_epi32( _mm256_castsi256_si128( vsrc ) );
+      const __m256i vidx1 = _mm256_cvtepu16_epi32( _mm256_extracti128_si256( vsrc, 1 ) );
+      __m256i vval0 = _mm256_i32gather_epi32( lut32, _mm256_srli_epi32( vidx0, 1 ), 4 );
+      __m256i vval1 = _mm256_i32gather_epi32( lut32, _mm256_srli_epi32( vidx1, 1 ), 4 );
+      vval0 = _mm256_and_si256( _mm256_srlv_epi32( vval0, _mm256_slli_epi32( _mm256_and_si256( vidx0, vone ), 4 ) ), vmask );
+      vval1 = _mm256_and_si256( _mm256_srlv_epi32( vval1, _mm256_slli_epi32( _mm256_and_si256( vidx1, vone ), 4 ) ), vmask );
+      _mm256_storeu_si256( ( __m256i* ) &ptr[col], _mm256_permute4x64_epi64( _mm256_packus_epi32( vval0, vval1 ), 0xd8 ) );
+    }
+    for( ; col + 8 <= width; col += 8 )
+    {
+      const __m256i vidx  = _mm256_cvtepu16_epi32( _mm_loadu_si128( ( const __m128i* ) &ptr[col] ) );
+      const __m256i vpair = _mm256_i32gather_epi32( lut32, _mm256_srli_epi32( vidx, 1 ), 4 );
+      __m256i vval = _mm256_and_si256( _mm256_srlv_epi32( vpair, _mm256_slli_epi32( _mm256_and_si256( vidx, vone ), 4 ) ), vmask );
+      vval = _mm256_permute4x64_epi64( _mm256_packus_epi32( vval, vval ), 0x08 );
+      _mm_storeu_si128( ( __m128i* ) &ptr[col], _mm256_castsi256_si128( vval ) );
+    }
+    for( ; col < width; col++ )
+    {
+      ptr[col] = lut[ptr[col]];
+    }
+  }
+}
+#endif
+
+// sign * ( ( |v| << CSCALE_FP_PREC ) + ( scale >> 1 ) ) / scale, the numerator is below 2^27 and the divisor below 2^26,
+// so the truncated double precision quotient equals the integer division
+static inline __m128i xScaleFwd4( const __m128i v, const __m128d vscale, const __m128i vhalf )
+{
+  const __m128i vnum = _mm_add_epi32( _mm_slli_epi32( _mm_abs_epi32( v ), CSCALE_FP_PREC ), vhalf );
+  const __m128i vlo  = _mm_cvttpd_epi32( _mm_div_pd( _mm_cvtepi32_pd( vnum ), vscale ) );
+  const __m128i vhi  = _mm_cvttpd_epi32( _mm_div_pd( _mm_cvtepi32_pd( _mm_srli_si128( vnum, 8 ) ), vscale ) );
+  return _mm_sign_epi32( _mm_unpacklo_epi64( vlo, vhi ), v );
+}
+
+// width has to be a multiple of 4
+template<X86_VEXT vext>
+void scaleSignalFwd_SSE( Pel* ptr, int stride, int width, int height, int scale, const ClpRng& clpRng )
+{
+  const int     maxAbsclipBD = ( 1 << clpRng.bd ) - 1;
+  const __m128d vscale       = _mm_set1_pd( scale );
+  const __m128i vhalf        = _mm_set1_epi32( scale >> 1 );
+  const __m128i vmin         = _mm_set1_epi16( -maxAbsclipBD );
+  const __m128i vmax         = _mm_set1_epi16( maxAbsclipBD );
+
+#ifdef USE_AVX2
+  const __m256d vscale256 = _mm256_set1_pd( scale );
+  const __m256i vhalf256  = _mm256_set1_epi32( scale >> 1 );
+  const __m256i vmin256   = _mm256_set1_epi32( -maxAbsclipBD );
+  const __m256i vmax256   = _mm256_set1_epi32( maxAbsclipBD );
+#endif
+
+  for( int row = 0; row < height; row++, ptr += stride )
+  {
+    int col = 0;
+#ifdef USE_AVX2
+    for( ; vext >= AVX2 && col + 8 <= width; col += 8 )
+    {
+      const __m256i v    = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &ptr[col] ) );
+      const __m256i vnum = _mm256_add_epi32( _mm256_slli_epi32( _mm256_abs_epi32( v ), CSCALE_FP_PREC ), vhalf256 );
+      const __m128i vlo  = _mm256_cvttpd_epi32( _mm256_div_pd( _mm256_cvtepi32_pd( _mm256_castsi256_si128( vnum ) ), vscale256 ) );
+      const __m128i vhi  = _mm256_cvttpd_epi32( _mm256_div_pd( _mm256_cvtepi32_pd( _mm256_extracti128_si256( vnum, 1 ) ), vscale256 ) );
+      __m256i vres = _mm256_sign_epi32( _mm256_inserti128_si256( _mm256_castsi128_si256( vlo ), vhi, 1 ), v );
+      vres = _mm256_min_epi32( vmax256, _mm256_max_epi32( vmin256, vres ) );
+      vres = _mm256_permute4x64_epi64( _mm256_packs_epi32( vres, vres ), 0x08 );
+      _mm_storeu_si128( ( __m128i* ) &ptr[col], _mm256_castsi256_si128( vres ) );
+    }
+#endif
+    for( ; col < width; col += 4 )
+    {
+      __m128i vres = xScaleFwd4( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &ptr[col] ) ), vscale, vhalf );
+      vres = _mm_packs_epi32( vres, vres );
+      _mm_storel_epi64( ( __m128i* ) &ptr[col], _mm_min_epi16( vmax, _mm_max_epi16( vmin, vres ) ) );
+    }
+  }
+}
+
+// width has to be a multiple of 4, the final pack saturates to the Pel range like the scalar code
+template<X86_VEXT vext>
+void scaleSignalInv_SSE( Pel* ptr, int stride, int width, int height, int scale, const ClpRng& clpRng )
+{
+  const int     maxAbsclipBD = ( 1 << clpRng.bd ) - 1;
+  const __m128i vscale       = _mm_set1_epi32( scale );
+  const __m128i vround       = _mm_set1_epi32( 1 << ( CSCALE_FP_PREC - 1 ) );
+  const __m128i vmin         = _mm_set1_epi16( -maxAbsclipBD - 1 );
+  const __m128i vmax         = _mm_set1_epi16( maxAbsclipBD );
+
+#ifdef USE_AVX2
+  const __m256i vscale256 = _mm256_set1_epi32( scale );
+  const __m256i vround256 = _mm256_set1_epi32( 1 << ( CSCALE_FP_PREC - 1 ) );
+  const __m256i vmin256   = _mm256_set1_epi16( -maxAbsclipBD - 1 );
+  const __m256i vmax256   = _mm256_set1_epi16( maxAbsclipBD );
+#endif
+
+  for( int row = 0; row < height; row++, ptr += stride )
+  {
+    int col = 0;
+#ifdef USE_AVX2
+    for( ; vext >= AVX2 && col + 16 <= width; col += 16 )
+    {
+      const __m256i vsrc = _mm256_min_epi16( vmax256, _mm256_max_epi16( vmin256, _mm256_loadu_si256( ( const __m256i* ) &ptr[col] ) ) );
+      const __m256i vlo  = _mm256_cvtepi16_epi32( _mm256_castsi256_si128( vsrc ) );
+      const __m256i vhi  = _mm256_cvtepi16_epi32( _mm256_extracti128_si256( vsrc, 1 ) );
+      const __m256i vrlo = _mm256_sign_epi32( _mm256_srai_epi32( _mm256_add_epi32( _mm256_mullo_epi32( _mm256_abs_epi32( vlo ), vscale256 ), vround256 ), CSCALE_FP_PREC ), vlo );
+      const __m256i vrhi = _mm256_sign_epi32( _mm256_srai_epi32( _mm256_add_epi32( _mm256_mullo_epi32( _mm256_abs_epi32( vhi ), vscale256 ), vround256 ), CSCALE_FP_PREC ), vhi );
+      _mm256_storeu_si256( ( __m256i* ) &ptr[col], _mm256_permute4x64_epi64( _mm256_packs_epi32( vrlo, vrhi ), 0xd8 ) );
+    }
+#endif
+    for( ; col < width; col += 4 )
+    {
+      const __m128i vsrc = _mm_cvtepi16_epi32( _mm_min_epi16( vmax, _mm_max_epi16( vmin, _mm_loadl_epi64( ( const __m128i* ) &ptr[col] ) ) ) );
+      __m128i vres = _mm_sign_epi32( _mm_srai_epi32( _mm_add_epi32( _mm_mullo_epi32( _mm_abs_epi32( vsrc ), vscale ), vround ), CSCALE_FP_PREC ), vsrc );
+      _mm_storel_epi64( ( __m128i* ) &ptr[col], _mm_packs_epi32( vres, vres ) );
+    }
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// YUV file sample conversion
+// --------------------------------------------------------------------------------------------------------------------
+
+// dst[x] = src[( x << sxDown ) >> sxUp], the chroma format conversion of the file reader only needs factors of 1 and 2
+template<X86_VEXT vext>
+void unpackSamples_SSE( const uint8_t* src, Pel* dst, int width, bool is16bit, int sxDown, int sxUp )
+{
+  if( sxDown > 1 || sxUp > 1 )
+  {
+    unpackSamplesCore( src, dst, width, is16bit, sxDown, sxUp );
+    return;
+  }
+
+  int x = 0;
+
+  if( !is16bit )
+  {
+    if( sxDown )
+    {
+      // the even bytes zero extended to 16 bit
+      const __m128i vmask = _mm_set1_epi16( 0xff );
+      for( ; x + 8 <= width; x += 8 )
+      {
+        _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_and_si128( _mm_loadu_si128( ( const __m128i* ) &src[2 * x] ), vmask ) );
+      }
+    }
+    else if( sxUp )
+    {
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m128i v = _mm_cvtepu8_epi16( _mm_loadl_epi64( ( const __m128i* ) &src[x >> 1] ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[x    ], _mm_unpacklo_epi16( v, v ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[x + 8], _mm_unpackhi_epi16( v, v ) );
+      }
+    }
+    else
+    {
+#ifdef USE_AVX2
+      for( ; vext >= AVX2 && x + 16 <= width; x += 16 )
+      {
+        _mm256_storeu_si256( ( __m256i* ) &dst[x], _mm256_cvtepu8_epi16( _mm_loadu_si128( ( const __m128i* ) &src[x] ) ) );
+      }
+#endif
+      for( ; x + 8 <= width; x += 8 )
+      {
+        _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_cvtepu8_epi16( _mm_loadl_epi64( ( const __m128i* ) &src[x] ) ) );
+      }
+    }
+  }
+  else
+  {
+    // little-endian 16 bit file samples have the layout of Pel
+    const Pel* src16 = ( const Pel* ) src;
+
+    if( sxDown )
+    {
+      const __m128i vshuf = _mm_setr_epi8( 0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1 );
+      for( ; x + 8 <= width; x += 8 )
+      {
+        const __m128i vlo = _mm_shuffle_epi8( _mm_loadu_si128( ( const __m128i* ) &src16[2 * x    ] ), vshuf );
+        const __m128i vhi = _mm_shuffle_epi8( _mm_loadu_si128( ( const __m128i* ) &src16[2 * x + 8] ), vshuf );
+        _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_unpacklo_epi64( vlo, vhi ) );
+      }
+    }
+    else if( sxUp )
+    {
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m128i v = _mm_loadu_si128( ( const __m128i* ) &src16[x >> 1] );
+        _mm_storeu_si128( ( __m128i* ) &dst[x    ], _mm_unpacklo_epi16( v, v ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[x + 8], _mm_unpackhi_epi16( v, v ) );
+      }
+    }
+    else
+    {
+#ifdef USE_AVX2
+      for( ; vext >= AVX2 && x + 16 <= width; x += 16 )
+      {
+        _mm256_storeu_si256( ( __m256i* ) &dst[x], _mm256_loadu_si256( ( const __m256i* ) &src16[x] ) );
+      }
+#endif
+      for( ; x + 8 <= width; x += 8 )
+      {
+        _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_loadu_si128( ( const __m128i* ) &src16[x] ) );
+      }
+    }
+  }
+
+  if( x < width )
+  {
+    unpackSamplesCore( src + ( ( x << sxDown ) >> sxUp ) * ( is16bit ? 2 : 1 ), dst + x, width - x, is16bit, sxDown, sxUp );
+  }
+}
+
+// bit depth scaling of eight samples, see scaleSample() in Buffer.cpp. The rounding is done in 32 bit like the scalar code.
+static inline __m128i xScaleSamples8( const __m128i v, const int shiftbits, const __m128i vshift, const __m128i vround, const __m128i vmin, const __m128i vmax )
+{
+  if( shiftbits > 0 )
+  {
+    return _mm_sll_epi16( v, vshift );
+  }
+  else if( shiftbits < 0 )
+  {
+    const __m128i vlo = _mm_sra_epi32( _mm_add_epi32( _mm_cvtepi16_epi32( v ), vround ), vshift );
+    const __m128i vhi = _mm_sra_epi32( _mm_add_epi32( _mm_cvtepi16_epi32( _mm_srli_si128( v, 8 ) ), vround ), vshift );
+    return _mm_min_epi16( vmax, _mm_max_epi16( vmin, _mm_packs_epi32( vlo, vhi ) ) );
+  }
+  return v;
+}
+
+// the scaling is fused into the conversion, so the writer does not need a scaled copy of the picture
+template<X86_VEXT vext>
+void packSamples_SSE( const Pel* src, uint8_t* dst, int width, bool is16bit, int shiftbits, Pel minval, Pel maxval )
+{
+  const __m128i vshift = _mm_cvtsi32_si128( abs( shiftbits ) );
+  const __m128i vround = _mm_set1_epi32( shiftbits < 0 ? 1 << ( -shiftbits - 1 ) : 0 );
+  const __m128i vmin   = _mm_set1_epi16( minval );
+  const __m128i vmax   = _mm_set1_epi16( maxval );
+  const __m128i vmask  = _mm_set1_epi16( 0xff );
+
+  int x = 0;
+  if( !is16bit )
+  {
+    for( ; x + 16 <= width; x += 16 )
+    {
+      const __m128i vlo = _mm_and_si128( xScaleSamples8( _mm_loadu_si128( ( const __m128i* ) &src[x    ] ), shiftbits, vshift, vround, vmin, vmax ), vmask );
+      const __m128i vhi = _mm_and_si128( xScaleSamples8( _mm_loadu_si128( ( const __m128i* ) &src[x + 8] ), shiftbits, vshift, vround, vmin, vmax ), vmask );
+      _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_packus_epi16( vlo, vhi ) );
+    }
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i v = _mm_and_si128( xScaleSamples8( _mm_loadu_si128( ( const __m128i* ) &src[x] ), shiftbits, vshift, vround, vmin, vmax ), vmask );
+      _mm_storel_epi64( ( __m128i* ) &dst[x], _mm_packus_epi16( v, v ) );
+    }
+  }
+  else
+  {
+    Pel* dst16 = ( Pel* ) dst;
+    for( ; x + 8 <= width; x += 8 )
+    {
+      _mm_storeu_si128( ( __m128i* ) &dst16[x], xScaleSamples8( _mm_loadu_si128( ( const __m128i* ) &src[x] ), shiftbits, vshift, vround, vmin, vmax ) );
+    }
+  }
+
+  if( x < width )
+  {
+    packSamplesCore( src + x, dst + ( is16bit ? 2 * x : x ), width - x, is16bit, shiftbits, minval, maxval );
+  }
+}
+
+template<X86_VEXT vext>
+void scaleSamples_SSE( Pel* ptr, int stride, int width, int height, int shiftbits, Pel minval, Pel maxval )
+{
+  if( shiftbits == 0 )
+  {
+    return;
+  }
+
+  const __m128i vshift = _mm_cvtsi32_si128( abs( shiftbits ) );
+  const __m128i vround = _mm_set1_epi32( shiftbits < 0 ? 1 << ( -shiftbits - 1 ) : 0 );
+  const __m128i vmin   = _mm_set1_epi16( minval );
+  const __m128i vmax   = _mm_set1_epi16( maxval );
+
+  for( int y = 0; y < height; y++, ptr += stride )
+  {
+    int x = 0;
+    for( ; x + 8 <= width; x += 8 )
+    {
+      _mm_storeu_si128( ( __m128i* ) &ptr[x], xScaleSamples8( _mm_loadu_si128( ( const __m128i* ) &ptr[x] ), shiftbits, vshift, vround, vmin, vmax ) );
+    }
+    if( x < width )
+    {
+      scaleSamplesCore( ptr + x, stride, width - x, 1, shiftbits, minval, maxval );
+    }
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// BDOF
+// --------------------------------------------------------------------------------------------------------------------
+
+template<X86_VEXT vext>
+void addBIOAvg4_SSE( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, const Pel *gradX0, const Pel *gradX1, const Pel *gradY0, const Pel*gradY1, int gradStride, int width, int height, int tmpx, int tmpy, int shift, int offset, const ClpRng& clpRng )
+{
+  const __m128i vone    = _mm_set1_epi16( 1 );
+  const __m128i vtmp    = _mm_unpacklo_epi16( _mm_set1_epi16( tmpx ), _mm_set1_epi16( tmpy ) );
+  const __m128i voffset = _mm_set1_epi32( offset );
+  const __m128i vshift  = _mm_cvtsi32_si128( shift );
+  const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x += 4 )
+    {
+      const __m128i vsrc = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) &src0[x] ), _mm_loadl_epi64( ( const __m128i* ) &src1[x] ) );
+      const __m128i vgx  = _mm_sub_epi16( _mm_loadl_epi64( ( const __m128i* ) &gradX0[x] ), _mm_loadl_epi64( ( const __m128i* ) &gradX1[x] ) );
+      const __m128i vgy  = _mm_sub_epi16( _mm_loadl_epi64( ( const __m128i* ) &gradY0[x] ), _mm_loadl_epi64( ( const __m128i* ) &gradY1[x] ) );
+
+      // src0 + src1 + tmpx * ( gradX0 - gradX1 ) + tmpy * ( gradY0 - gradY1 ) + offset
+      __m128i vsum = _mm_add_epi32( _mm_madd_epi16( vsrc, vone ), _mm_madd_epi16( _mm_unpacklo_epi16( vgx, vgy ), vtmp ) );
+      vsum = xTruncEpi32ToEpi16( _mm_sra_epi32( _mm_add_epi32( vsum, voffset ), vshift ) );
+      vsum = _mm_packs_epi32( vsum, vsum );
+      _mm_storel_epi64( ( __m128i* ) &dst[x], _mm_min_epi16( vmax, _mm_max_epi16( vmin, vsum ) ) );
+    }
+    dst += dstStride;       src0 += src0Stride;     src1 += src1Stride;
+    gradX0 += gradStride; gradX1 += gradStride; gradY0 += gradStride; gradY1 += gradStride;
+  }
+}
+
+template<X86_VEXT vext, bool PAD>
+void gradFilter_SSE( Pel* pSrc, int srcStride, int width, int height, int gradStride, Pel* gradX, Pel* gradY, const int bitDepth )
+{
+  const int innerWidth  = width  - 2 * BIO_EXTEND_SIZE;
+  const int innerHeight = height - 2 * BIO_EXTEND_SIZE;
+  const int shift1      = 6;
+
+  Pel* srcTmp   = pSrc  + srcStride  + 1;
+  Pel* gradXTmp = gradX + gradStride + 1;
+  Pel* gradYTmp = gradY + gradStride + 1;
+
+  for( int y = 0; y < innerHeight; y++ )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 16 <= innerWidth; x += 16 )
+      {
+        const __m256i vabove = _mm256_srai_epi16( _mm256_loadu_si256( ( const __m256i* ) &srcTmp[x - srcStride] ), shift1 );
+        const __m256i vbelow = _mm256_srai_epi16( _mm256_loadu_si256( ( const __m256i* ) &srcTmp[x + srcStride] ), shift1 );
+        const __m256i vleft  = _mm256_srai_epi16( _mm256_loadu_si256( ( const __m256i* ) &srcTmp[x - 1] ), shift1 );
+        const __m256i vright = _mm256_srai_epi16( _mm256_loadu_si256( ( const __m256i* ) &srcTmp[x + 1] ), shift1 );
+        _mm256_storeu_si256( ( __m256i* ) &gradYTmp[x], _mm256_sub_epi16( vbelow, vabove ) );
+        _mm256_storeu_si256( ( __m256i* ) &gradXTmp[x], _mm256_sub_epi16( vright, vleft ) );
+      }
+    }
+#endif
+    for( ; x + 8 <= innerWidth; x += 8 )
+    {
+      const __m128i vabove = _mm_srai_epi16( _mm_loadu_si128( ( const __m128i* ) &srcTmp[x - srcStride] ), shift1 );
+      const __m128i vbelow = _mm_srai_epi16( _mm_loadu_si128( ( const __m128i* ) &srcTmp[x + srcStride] ), shift1 );
+      const __m128i vleft  = _mm_srai_epi16( _mm_loadu_si128( ( const __m128i* ) &srcTmp[x - 1] ), shift1 );
+      const __m128i vright = _mm_srai_epi16( _mm_loadu_si128( ( const __m128i* ) &srcTmp[x + 1] ), shift1 );
+      _mm_storeu_si128( ( __m128i* ) &gradYTmp[x], _mm_sub_epi16( vbelow, vabove ) );
+      _mm_storeu_si128( ( __m128i* ) &gradXTmp[x], _mm_sub_epi16( vright, vleft ) );
+    }
+    for( ; x + 4 <= innerWidth; x += 4 )
+    {
+      const __m128i vabove = _mm_srai_epi16( _mm_loadl_epi64( ( const __m128i* ) &srcTmp[x - srcStride] ), shift1 );
+      const __m128i vbelow = _mm_srai_epi16( _mm_loadl_epi64( ( const __m128i* ) &srcTmp[x + srcStride] ), shift1 );
+      const __m128i vleft  = _mm_srai_epi16( _mm_loadl_epi64( ( const __m128i* ) &srcTmp[x - 1] ), shift1 );
+      const __m128i vright = _mm_srai_epi16( _mm_loadl_epi64( ( const __m128i* ) &srcTmp[x + 1] ), shift1 );
+      _mm_storel_epi64( ( __m128i* ) &gradYTmp[x], _mm_sub_epi16( vbelow, vabove ) );
+      _mm_storel_epi64( ( __m128i* ) &gradXTmp[x], _mm_sub_epi16( vright, vleft ) );
+    }
+    for( ; x < innerWidth; x++ )
+    {
+      gradYTmp[x] = ( srcTmp[x + srcStride] >> shift1 ) - ( srcTmp[x - srcStride] >> shift1 );
+      gradXTmp[x] = ( srcTmp[x + 1] >> shift1 ) - ( srcTmp[x - 1] >> shift1 );
+    }
+    gradXTmp += gradStride;
+    gradYTmp += gradStride;
+    srcTmp   += srcStride;
+  }
+
+  if( PAD )
+  {
+    gradXTmp = gradX + gradStride + 1;
+    gradYTmp = gradY + gradStride + 1;
+    for( int y = 0; y < innerHeight; y++ )
+    {
+      gradXTmp[-1]         = gradXTmp[0];
+      gradXTmp[innerWidth] = gradXTmp[innerWidth - 1];
+      gradXTmp += gradStride;
+
+      gradYTmp[-1]         = gradYTmp[0];
+      gradYTmp[innerWidth] = gradYTmp[innerWidth - 1];
+      gradYTmp += gradStride;
+    }
+
+    gradXTmp = gradX + gradStride;
+    gradYTmp = gradY + gradStride;
+    ::memcpy( gradXTmp - gradStride, gradXTmp, sizeof( Pel ) * width );
+    ::memcpy( gradXTmp + innerHeight * gradStride, gradXTmp + ( innerHeight - 1 ) * gradStride, sizeof( Pel ) * width );
+    ::memcpy( gradYTmp - gradStride, gradYTmp, sizeof( Pel ) * width );
+    ::memcpy( gradYTmp + innerHeight * gradStride, gradYTmp + ( innerHeight - 1 ) * gradStride, sizeof( Pel ) * width );
+  }
+}
+
+// six samples of a row in the lower lanes, the upper two lanes are zero
+static inline __m128i xLoad6_epi16( const Pel* src )
+{
+  int32_t tail;
+  memcpy( &tail, &src[4], sizeof( tail ) );
+  return _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* ) src ), _mm_cvtsi32_si128( tail ) );
+}
+
+template<X86_VEXT vext>
+void calcBIOSums_SSE( const Pel* srcY0Tmp, const Pel* srcY1Tmp, Pel* gradX0, Pel* gradX1, Pel* gradY0, Pel* gradY1, int xu, int yu, const int src0Stride, const int src1Stride, const int widthG, const int bitDepth, int* sumAbsGX, int* sumAbsGY, int* sumDIX, int* sumDIY, int* sumSignGY_GX )
+{
+  const int shift4 = 4;
+  const int shift5 = 1;
+
+  const __m128i vone = _mm_set1_epi16( 1 );
+  __m128i vsumAbsGX = _mm_setzero_si128();
+  __m128i vsumAbsGY = _mm_setzero_si128();
+  __m128i vsumDIX   = _mm_setzero_si128();
+  __m128i vsumDIY   = _mm_setzero_si128();
+  __m128i vsumSign  = _mm_setzero_si128();
+
+  for( int y = 0; y < 6; y++ )
+  {
+    const __m128i vgx = _mm_srai_epi16( _mm_add_epi16( xLoad6_epi16( gradX0 ), xLoad6_epi16( gradX1 ) ), shift5 );
+    const __m128i vgy = _mm_srai_epi16( _mm_add_epi16( xLoad6_epi16( gradY0 ), xLoad6_epi16( gradY1 ) ), shift5 );
+    const __m128i vdI = _mm_sub_epi16( _mm_srai_epi16( xLoad6_epi16( srcY1Tmp ), shift4 ), _mm_srai_epi16( xLoad6_epi16( srcY0Tmp ), shift4 ) );
+
+    // _mm_sign_epi16 negates for negative, zeroes for zero and keeps positive signs, as the scalar code does
+    vsumAbsGX = _mm_add_epi32( vsumAbsGX, _mm_madd_epi16( _mm_abs_epi16( vgx ), vone ) );
+    vsumAbsGY = _mm_add_epi32( vsumAbsGY, _mm_madd_epi16( _mm_abs_epi16( vgy ), vone ) );
+    vsumDIX   = _mm_add_epi32( vsumDIX,   _mm_madd_epi16( _mm_sign_epi16( vdI, vgx ), vone ) );
+    vsumDIY   = _mm_add_epi32( vsumDIY,   _mm_madd_epi16( _mm_sign_epi16( vdI, vgy ), vone ) );
+    vsumSign  = _mm_add_epi32( vsumSign,  _mm_madd_epi16( _mm_sign_epi16( vgx, vgy ), vone ) );
+
+    srcY1Tmp += src1Stride;
+    srcY0Tmp += src0Stride;
+    gradX0 += widthG;
+    gradX1 += widthG;
+    gradY0 += widthG;
+    gradY1 += widthG;
+  }
+
+  *sumAbsGX     += _mm_hsum_epi32( vsumAbsGX );
+  *sumAbsGY     += _mm_hsum_epi32( vsumAbsGY );
+  *sumDIX       += _mm_hsum_epi32( vsumDIX );
+  *sumDIY       += _mm_hsum_epi32( vsumDIY );
+  *sumSignGY_GX += _mm_hsum_epi32( vsumSign );
+}
+
+template<X86_VEXT vext>
+void calcBlkGradient_SSE( int sx, int sy, int *arraysGx2, int *arraysGxGy, int *arraysGxdI, int *arraysGy2, int *arraysGydI, int &sGx2, int &sGy2, int &sGxGy, int &sGxdI, int &sGydI, int width, int height, int unitSize )
+{
+  int* const arrays[5] = { arraysGx2, arraysGy2, arraysGxGy, arraysGxdI, arraysGydI };
+  __m128i    vsum[5];
+
+  for( int k = 0; k < 5; k++ )
+  {
+    // set to the above row due to JVET_K0485_BIO_EXTEND_SIZE
+    const int* src = arrays[k] - BIO_EXTEND_SIZE * width - BIO_EXTEND_SIZE;
+    const int  w   = unitSize + 2 * BIO_EXTEND_SIZE;
+
+    vsum[k] = _mm_setzero_si128();
+    int tail = 0;
+
+    for( int y = 0; y < unitSize + 2 * BIO_EXTEND_SIZE; y++, src += width )
+    {
+      int x = 0;
+      for( ; x + 4 <= w; x += 4 )
+      {
+        vsum[k] = _mm_add_epi32( vsum[k], _mm_loadu_si128( ( const __m128i* ) &src[x] ) );
+      }
+      for( ; x < w; x++ )
+      {
+        tail += src[x];
+      }
+    }
+    vsum[k] = _mm_add_epi32( vsum[k], _mm_cvtsi32_si128( tail ) );
+  }
+
+  sGx2  += _mm_hsum_epi32( vsum[0] );
+  sGy2  += _mm_hsum_epi32( vsum[1] );
+  sGxGy += _mm_hsum_epi32( vsum[2] );
+  sGxdI += _mm_hsum_epi32( vsum[3] );
+  sGydI += _mm_hsum_epi32( vsum[4] );
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// PROF
+// --------------------------------------------------------------------------------------------------------------------
+
+template<X86_VEXT vext>
+void applyPROF_SSE( Pel* dst, int dstStride, const Pel* src, int srcStride, int width, int height, const Pel* gradX, const Pel* gradY, int gradStride, const int* dMvX, const int* dMvY, int dMvStride, const bool& bi, int shiftNum, Pel offset, const ClpRng& clpRng )
+{
+  CHECK( width & 3, "Unsupported width" );
+
+  const int dILimit = 1 << std::max<int>( clpRng.bd + 1, 13 );
+
+  const __m128i vdImin   = _mm_set1_epi32( -dILimit );
+  const __m128i vdImax   = _mm_set1_epi32( dILimit - 1 );
+  const __m128i voffset  = _mm_set1_epi32( offset );
+  const __m128i vshift   = _mm_cvtsi32_si128( shiftNum );
+  const __m128i vmin     = _mm_set1_epi32( clpRng.min );
+  const __m128i vmax     = _mm_set1_epi32( clpRng.max );
+
+  // the motion vector offsets are read contiguously, as in applyPROFCore
+  int idx = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && width == 4 )
+  {
+    // two rows of four samples per iteration
+    const __m256i vdImin256  = _mm256_set1_epi32( -dILimit );
+    const __m256i vdImax256  = _mm256_set1_epi32( dILimit - 1 );
+    const __m256i voffset256 = _mm256_set1_epi32( offset );
+    const __m256i vmin256    = _mm256_set1_epi32( clpRng.min );
+    const __m256i vmax256    = _mm256_set1_epi32( clpRng.max );
+
+    for( int h = 0; h + 2 <= height; h += 2, idx += 8 )
+    {
+      const __m256i vgx  = _mm256_cvtepi16_epi32( _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* ) gradX ), _mm_loadl_epi64( ( const __m128i* ) &gradX[gradStride] ) ) );
+      const __m256i vgy  = _mm256_cvtepi16_epi32( _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* ) gradY ), _mm_loadl_epi64( ( const __m128i* ) &gradY[gradStride] ) ) );
+      const __m256i vsrc = _mm256_cvtepi16_epi32( _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* ) src ), _mm_loadl_epi64( ( const __m128i* ) &src[srcStride] ) ) );
+
+      __m256i vdI = _mm256_add_epi32( _mm256_mullo_epi32( _mm256_loadu_si256( ( const __m256i* ) &dMvX[idx] ), vgx ),
+                                      _mm256_mullo_epi32( _mm256_loadu_si256( ( const __m256i* ) &dMvY[idx] ), vgy ) );
+      vdI = _mm256_min_epi32( vdImax256, _mm256_max_epi32( vdImin256, vdI ) );
+
+      __m256i vres = xTruncEpi32ToEpi16( _mm256_add_epi32( vsrc, vdI ) );
+      if( !bi )
+      {
+        vres = xTruncEpi32ToEpi16( _mm256_sra_epi32( _mm256_add_epi32( vres, voffset256 ), vshift ) );
+        vres = _mm256_min_epi32( vmax256, _mm256_max_epi32( vmin256, vres ) );
+      }
+      vres = _mm256_packs_epi32( vres, vres );
+      _mm_storel_epi64( ( __m128i* ) dst,               _mm256_castsi256_si128( vres ) );
+      _mm_storel_epi64( ( __m128i* ) &dst[dstStride], _mm256_extracti128_si256( vres, 1 ) );
+
+      gradX += 2 * gradStride;
+      gradY += 2 * gradStride;
+      dst   += 2 * dstStride;
+      src   += 2 * srcStride;
+    }
+    height &= 1;
+  }
+#endif
+
+  for( int h = 0; h < height; h++ )
+  {
+    for( int w = 0; w < width; w += 4, idx += 4 )
+    {
+      const __m128i vgx  = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &gradX[w] ) );
+      const __m128i vgy  = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &gradY[w] ) );
+      const __m128i vsrc = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &src[w] ) );
+
+      __m128i vdI = _mm_add_epi32( _mm_mullo_epi32( _mm_loadu_si128( ( const __m128i* ) &dMvX[idx] ), vgx ),
+                                   _mm_mullo_epi32( _mm_loadu_si128( ( const __m128i* ) &dMvY[idx] ), vgy ) );
+      vdI = _mm_min_epi32( vdImax, _mm_max_epi32( vdImin, vdI ) );
+
+      // both intermediate results are stored as samples before the final clipping
+      __m128i vres = xTruncEpi32ToEpi16( _mm_add_epi32( vsrc, vdI ) );
+      if( !bi )
+      {
+        vres = xTruncEpi32ToEpi16( _mm_sra_epi32( _mm_add_epi32( vres, voffset ), vshift ) );
+        vres = _mm_min_epi32( vmax, _mm_max_epi32( vmin, vres ) );
+      }
+      _mm_storel_epi64( ( __m128i* ) &dst[w], _mm_packs_epi32( vres, vres ) );
+    }
+    gradX += gradStride;
+    gradY += gradStride;
+    dst   += dstStride;
+    src   += srcStride;
+  }
+}
+
+// rounding as in roundAffineMv() followed by clipping to +-dmvLimit, size has to be a multiple of 4
+template<X86_VEXT vext>
+void roundIntVector_SIMD( int* v, int size, unsigned int nShift, const int dmvLimit )
+{
+  CHECK( size & 3, "Unsupported size" );
+
+  const int     nOffset = 1 << ( nShift - 1 );
+  const __m128i vshift  = _mm_cvtsi32_si128( nShift );
+  int i = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i voffset = _mm256_set1_epi32( nOffset );
+    const __m256i vmin    = _mm256_set1_epi32( -dmvLimit );
+    const __m256i vmax    = _mm256_set1_epi32( dmvLimit );
+    const __m256i vminus1 = _mm256_set1_epi32( -1 );
+
+    for( ; i + 8 <= size; i += 8 )
+    {
+      __m256i vv = _mm256_loadu_si256( ( const __m256i* ) &v[i] );
+      // the all-ones mask of non-negative values subtracts one
+      vv = _mm256_add_epi32( _mm256_add_epi32( vv, voffset ), _mm256_cmpgt_epi32( vv, vminus1 ) );
+      vv = _mm256_sra_epi32( vv, vshift );
+      _mm256_storeu_si256( ( __m256i* ) &v[i], _mm256_min_epi32( vmax, _mm256_max_epi32( vmin, vv ) ) );
+    }
+  }
+#endif
+
+  const __m128i voffset = _mm_set1_epi32( nOffset );
+  const __m128i vmin    = _mm_set1_epi32( -dmvLimit );
+  const __m128i vmax    = _mm_set1_epi32( dmvLimit );
+  const __m128i vminus1 = _mm_set1_epi32( -1 );
+
+  for( ; i < size; i += 4 )
+  {
+    __m128i vv = _mm_loadu_si128( ( const __m128i* ) &v[i] );
+    vv = _mm_add_epi32( _mm_add_epi32( vv, voffset ), _mm_cmpgt_epi32( vv, vminus1 ) );
+    vv = _mm_sra_epi32( vv, vshift );
+    _mm_storeu_si128( ( __m128i* ) &v[i], _mm_min_epi32( vmax, _mm_max_epi32( vmin, vv ) ) );
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// copy and padding
+// --------------------------------------------------------------------------------------------------------------------
+
+template<X86_VEXT vext>
+static ALWAYS_INLINE void xCopyRow( const Pel* src, Pel* dst, const int width )
+{
+  int x = 0;
+#ifdef USE_AVX512
+  if( vext >= AVX512 )
+  {
+    for( ; x + 32 <= width; x += 32 )
+    {
+      _mm512_storeu_si512( ( void* ) &dst[x], _mm512_loadu_si512( ( const void* ) &src[x] ) );
+    }
+    // the masked load does not touch the samples beyond the row
+    if( x < width )
+    {
+      const __mmask32 mask = ( __mmask32 ) ( ( 1u << ( width - x ) ) - 1 );
+      _mm512_mask_storeu_epi16( &dst[x], mask, _mm512_maskz_loadu_epi16( mask, &src[x] ) );
+    }
+    return;
+  }
+#endif
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    for( ; x + 16 <= width; x += 16 )
+    {
+      _mm256_storeu_si256( ( __m256i* ) &dst[x], _mm256_loadu_si256( ( const __m256i* ) &src[x] ) );
+    }
+  }
+#endif
+  for( ; x + 8 <= width; x += 8 )
+  {
+    _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_loadu_si128( ( const __m128i* ) &src[x] ) );
+  }
+  for( ; x + 4 <= width; x += 4 )
+  {
+    _mm_storel_epi64( ( __m128i* ) &dst[x], _mm_loadl_epi64( ( const __m128i* ) &src[x] ) );
+  }
+  for( ; x < width; x++ )
+  {
+    dst[x] = src[x];
+  }
+}
+
+template<X86_VEXT vext>
+void copyBuffer_SSE( Pel *src, int srcStride, Pel *dst, int dstStride, int width, int height )
+{
+  for( int i = 0; i < height; i++, src += srcStride, dst += dstStride )
+  {
+    xCopyRow<vext>( src, dst, width );
+  }
+}
+
+// fill n samples with the value broadcast in vval
+template<X86_VEXT vext>
+static ALWAYS_INLINE void xFillRow( Pel* dst, const __m128i vval, const int n )
+{
+  int j = 0;
+#ifdef USE_AVX512
+  if( vext >= AVX512 )
+  {
+    const __m512i vval512 = _mm512_broadcastw_epi16( vval );
+    for( ; j + 32 <= n; j += 32 )
+    {
+      _mm512_storeu_si512( ( void* ) &dst[j], vval512 );
+    }
+    if( j < n )
+    {
+      _mm512_mask_storeu_epi16( &dst[j], ( __mmask32 ) ( ( 1u << ( n - j ) ) - 1 ), vval512 );
+    }
+    return;
+  }
+#endif
+  for( ; j + 8 <= n; j += 8 )
+  {
+    _mm_storeu_si128( ( __m128i* ) &dst[j], vval );
+  }
+  for( ; j + 4 <= n; j += 4 )
+  {
+    _mm_storel_epi64( ( __m128i* ) &dst[j], vval );
+  }
+  for( ; j < n; j++ )
+  {
+    dst[j] = ( Pel ) _mm_extract_epi16( vval, 0 );
+  }
+}
+
+template<X86_VEXT vext>
+void padding_SSE( Pel *ptr, int stride, int width, int height, int padSize )
+{
+  // left and right padding
+  Pel* row = ptr;
+  for( int i = 0; i < height; i++, row += stride )
+  {
+    xFillRow<vext>( row - padSize, _mm_set1_epi16( row[0] ),         padSize );
+    xFillRow<vext>( row + width,   _mm_set1_epi16( row[width - 1] ), padSize );
+  }
+
+  // top and bottom padding
+  const int numPels = width + padSize + padSize;
+  Pel* const top    = ptr - padSize;
+  Pel* const bottom = ptr + stride * ( height - 1 ) - padSize;
+  for( int i = 1; i <= padSize; i++ )
+  {
+    xCopyRow<vext>( top,    top    - i * stride, numPels );
+    xCopyRow<vext>( bottom, bottom + i * stride, numPels );
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// BCW high frequency removal
+// --------------------------------------------------------------------------------------------------------------------
+
+#if ENABLE_SIMD_OPT_BCW
+// 32 bit products wrap around exactly like the int arithmetic of removeWeightHighFreq()
+static ALWAYS_INLINE __m128i xRemoveWeightHighFreq4( const __m128i vdst, const __m128i vsrc, const __m128i vw0, const __m128i vw1, const __m128i vround )
+{
+  __m128i v = _mm_sub_epi32( _mm_mullo_epi32( _mm_cvtepi16_epi32( vdst ), vw0 ), _mm_mullo_epi32( _mm_cvtepi16_epi32( vsrc ), vw1 ) );
+  v = _mm_srai_epi32( _mm_add_epi32( v, vround ), 16 );
+  return xTruncEpi32ToEpi16( v );
+}
+
+template<X86_VEXT vext, int W>
+void removeWeightHighFreq_SSE( Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int shift, int bcwWeight )
+{
+  const int normalizer = ( ( 1 << 16 ) + ( bcwWeight > 0 ? ( bcwWeight >> 1 ) : -( bcwWeight >> 1 ) ) ) / bcwWeight;
+  const int weight0    = normalizer << g_BcwLog2WeightBase;
+  const int weight1    = ( g_BcwWeightBase - bcwWeight ) * normalizer;
+
+  const __m128i vw0    = _mm_set1_epi32( weight0 );
+  const __m128i vw1    = _mm_set1_epi32( weight1 );
+  const __m128i vround = _mm_set1_epi32( 1 << 15 );
+
+#ifdef USE_AVX2
+  if( W == 8 && vext >= AVX2 )
+  {
+    const __m256i vw0256    = _mm256_set1_epi32( weight0 );
+    const __m256i vw1256    = _mm256_set1_epi32( weight1 );
+    const __m256i vround256 = _mm256_set1_epi32( 1 << 15 );
+
+    for( int row = 0; row < height; row++, src0 += src0Stride, src1 += src1Stride )
+    {
+      for( int col = 0; col < width; col += 8 )
+      {
+        const __m256i vdst = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &src0[col] ) );
+        const __m256i vsrc = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &src1[col] ) );
+        __m256i v = _mm256_sub_epi32( _mm256_mullo_epi32( vdst, vw0256 ), _mm256_mullo_epi32( vsrc, vw1256 ) );
+        v = xTruncEpi32ToEpi16( _mm256_srai_epi32( _mm256_add_epi32( v, vround256 ), 16 ) );
+        v = _mm256_permute4x64_epi64( _mm256_packs_epi32( v, v ), 0x08 );
+        _mm_storeu_si128( ( __m128i* ) &src0[col], _mm256_castsi256_si128( v ) );
+      }
+    }
+    return;
+  }
+#endif
+
+  for( int row = 0; row < height; row++, src0 += src0Stride, src1 += src1Stride )
+  {
+    for( int col = 0; col < width; col += W )
+    {
+      if( W == 8 )
+      {
+        const __m128i vdst = _mm_loadu_si128( ( const __m128i* ) &src0[col] );
+        const __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &src1[col] );
+        const __m128i vlo  = xRemoveWeightHighFreq4( vdst, vsrc, vw0, vw1, vround );
+        const __m128i vhi  = xRemoveWeightHighFreq4( _mm_unpackhi_epi64( vdst, vdst ), _mm_unpackhi_epi64( vsrc, vsrc ), vw0, vw1, vround );
+        _mm_storeu_si128( ( __m128i* ) &src0[col], _mm_packs_epi32( vlo, vhi ) );
+      }
+      else
+      {
+        const __m128i vlo = xRemoveWeightHighFreq4( _mm_loadl_epi64( ( const __m128i* ) &src0[col] ), _mm_loadl_epi64( ( const __m128i* ) &src1[col] ), vw0, vw1, vround );
+        _mm_storel_epi64( ( __m128i* ) &src0[col], _mm_packs_epi32( vlo, vlo ) );
+      }
+    }
+  }
+}
+
+// 16 bit wrap around equals the truncation of 2 * dst - src to a sample
+template<X86_VEXT vext, int W>
+void removeHighFreq_SSE( Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height )
+{
+#ifdef USE_AVX2
+  if( W == 8 && vext >= AVX2 && ( width & 15 ) == 0 )
+  {
+    for( int row = 0; row < height; row++, src0 += src0Stride, src1 += src1Stride )
+    {
+      for( int col = 0; col < width; col += 16 )
+      {
+        const __m256i vdst = _mm256_loadu_si256( ( const __m256i* ) &src0[col] );
+        const __m256i vsrc = _mm256_loadu_si256( ( const __m256i* ) &src1[col] );
+        _mm256_storeu_si256( ( __m256i* ) &src0[col], _mm256_sub_epi16( _mm256_add_epi16( vdst, vdst ), vsrc ) );
+      }
+    }
+    return;
+  }
+#endif
+
+  for( int row = 0; row < height; row++, src0 += src0Stride, src1 += src1Stride )
+  {
+    for( int col = 0; col < width; col += W )
+    {
+      if( W == 8 )
+      {
+        const __m128i vdst = _mm_loadu_si128( ( const __m128i* ) &src0[col] );
+        const __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &src1[col] );
+        _mm_storeu_si128( ( __m128i* ) &src0[col], _mm_sub_epi16( _mm_add_epi16( vdst, vdst ), vsrc ) );
+      }
+      else
+      {
+        const __m128i vdst = _mm_loadl_epi64( ( const __m128i* ) &src0[col] );
+        const __m128i vsrc = _mm_loadl_epi64( ( const __m128i* ) &src1[col] );
+        _mm_storel_epi64( ( __m128i* ) &src0[col], _mm_sub_epi16( _mm_add_epi16( vdst, vdst ), vsrc ) );
+      }
+    }
+  }
+}
+#endif
+
+template<X86_VEXT vext>
+void PelBufferOps::_initPelBufOpsX86()
+{
+  addAvg8 = addAvg_SSE<vext, 8>;
+  addAvg4 = addAvg_SSE<vext, 4>;
+
+  reco8 = reco_SSE<vext, 8>;
+  reco4 = reco_SSE<vext, 4>;
+
+  linTf8 = linTf_SSE<vext, 8>;
+  linTf4 = linTf_SSE<vext, 4>;
+
+  wghtBi8  = wghtBi_SSE<vext, 8>;
+  wghtBi4  = wghtBi_SSE<vext, 4>;
+  wghtUni8 = wghtUni_SSE<vext, 8>;
+  wghtUni4 = wghtUni_SSE<vext, 4>;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    applyLut = applyLut_SIMD<vext>;
+  }
+#endif
+  scaleSignalFwd = scaleSignalFwd_SSE<vext>;
+  scaleSignalInv = scaleSignalInv_SSE<vext>;
+
+  unpackSamples = unpackSamples_SSE<vext>;
+  packSamples   = packSamples_SSE<vext>;
+  scaleSamples  = scaleSamples_SSE<vext>;
+
+  addBIOAvg4      = addBIOAvg4_SSE<vext>;
+  bioGradFilter   = gradFilter_SSE<vext, true>;
+  calcBIOSums     = calcBIOSums_SSE<vext>;
+  calcBlkGradient = calcBlkGradient_SSE<vext>;
+
+  copyBuffer = copyBuffer_SSE<vext>;
+  padding    = padding_SSE<vext>;
+
+#if ENABLE_SIMD_OPT_BCW
+  removeWeightHighFreq8 = removeWeightHighFreq_SSE<vext, 8>;
+  removeWeightHighFreq4 = removeWeightHighFreq_SSE<vext, 4>;
+  removeHighFreq8       = removeHighFreq_SSE<vext, 8>;
+  removeHighFreq4       = removeHighFreq_SSE<vext, 4>;
+#endif
+
+  profGradFilter = gradFilter_SSE<vext, false>;
+  applyPROF      = applyPROF_SSE<vext>;
+  roundIntVector = roundIntVector_SIMD<vext>;
+}
+
+template void PelBufferOps::_initPelBufOpsX86<SIMDX86>();
+
+//! \}
+
+#endif //TARGET_SIMD_X86
+#endif //ENABLE_SIMD_OPT_BUFFER
@@ -0,0 +1,232 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     CommonDefX86.cpp
+    \brief    detection of the x86 vector extensions available at runtime and selection of the one to use
+*/
+
+#include "CommonDefX86.h"
+
+#include <cstdlib>
+
+#if ENABLE_SIMD_OPT
+#ifdef TARGET_SIMD_X86
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+static const char* const x86_vext_names[] = { "SCALAR", "SSE41", "SSE42", "AVX", "AVX2", "AVX512" };
+
+const char* x86_vext_to_string( X86_VEXT vext )
+{
+  CHECK( vext < SCALAR || vext > AVX512, "Unknown x86 vector extension" );
+  return x86_vext_names[vext];
+}
+
+static void x86_cpuid( int regs[4], int leaf, int subLeaf = 0 )
+{
+#ifdef _MSC_VER
+  __cpuidex( regs, leaf, subLeaf );
+#else
+  unsigned int a = 0, b = 0, c = 0, d = 0;
+  __cpuid_count( leaf, subLeaf, a, b, c, d );
+  regs[0] = a; regs[1] = b; regs[2] = c; regs[3] = d;
+#endif
+}
+
+static uint64_t x86_xgetbv()
+{
+#ifdef _MSC_VER
+  return _xgetbv( 0 );
+#else
+  unsigned int eax = 0, edx = 0;
+  __asm__ volatile( "xgetbv" : "=a"( eax ), "=d"( edx ) : "c"( 0 ) );
+  return ( uint64_t( edx ) << 32 ) | eax;
+#endif
+}
+
+static X86_VEXT x86_detect_extension()
+{
+  int regs[4];
+
+  x86_cpuid( regs, 0 );
+  const int maxLeaf = regs[0];
+
+  if( maxLeaf < 1 )
+  {
+    return SCALAR;
+  }
+
+  x86_cpuid( regs, 1 );
+
+  const bool sse41   = ( regs[2] & ( 1 << 19 ) ) != 0;
+  const bool sse42   = ( regs[2] & ( 1 << 20 ) ) != 0;
+  const bool osxsave = ( regs[2] & ( 1 << 27 ) ) != 0;
+  const bool avx     = ( regs[2] & ( 1 << 28 ) ) != 0;
+
+  if( !sse41 )
+  {
+    return SCALAR;
+  }
+  if( !sse42 )
+  {
+    return SSE41;
+  }
+
+  // the OS has to save the YMM (and ZMM) state on context switches
+  const uint64_t xcr0 = osxsave ? x86_xgetbv() : 0;
+
+  if( !avx || ( xcr0 & 0x6 ) != 0x6 )
+  {
+    return SSE42;
+  }
+
+  bool avx2 = false, avx512 = false;
+
+  if( maxLeaf >= 7 )
+  {
+    x86_cpuid( regs, 7, 0 );
+    avx2   = ( regs[1] & ( 1 <<  5 ) ) != 0;
+    // AVX-512 F and BW, ZMM and opmask state enabled
+    avx512 = ( regs[1] & ( 1 << 16 ) ) != 0 && ( regs[1] & ( 1 << 30 ) ) != 0 && ( xcr0 & 0xe6 ) == 0xe6;
+  }
+
+  if( !avx2 )
+  {
+    return AVX;
+  }
+
+  return avx512 ? AVX512 : AVX2;
+}
+
+static unsigned x86_detect_features()
+{
+  int regs[4];
+
+  x86_cpuid( regs, 0 );
+
+  if( regs[0] < 1 )
+  {
+    return 0;
+  }
+
+  x86_cpuid( regs, 1 );
+
+  unsigned features = 0;
+
+  if( regs[2] & ( 1 << 1 ) )
+  {
+    features |= X86_FEATURE_PCLMUL;
+  }
+
+  return features;
+}
+
+static bool x86_parse_extension( const std::string &extStrId, X86_VEXT &vext )
+{
+  for( int i = SCALAR; i <= AVX512; i++ )
+  {
+    if( extStrId == x86_vext_names[i] )
+    {
+      vext = X86_VEXT( i );
+      return true;
+    }
+  }
+  return false;
+}
+
+static X86_VEXT x86_limit_extension( X86_VEXT request, const X86_VEXT maxSupported )
+{
+  if( request > maxSupported )
+  {
+    msg( WARNING, "\nWARNING: requested SIMD extension %s is not supported by this CPU, using %s\n", x86_vext_names[request], x86_vext_names[maxSupported] );
+    request = maxSupported;
+  }
+  return request;
+}
+
+// the extension set by the environment variable VTM_SIMD, otherwise the highest one supported by the CPU
+static X86_VEXT x86_default_extension( const X86_VEXT maxSupported )
+{
+  const char* envStrId = getenv( "VTM_SIMD" );
+
+  if( envStrId == nullptr || envStrId[0] == 0 )
+  {
+    return maxSupported;
+  }
+
+  X86_VEXT request = SCALAR;
+
+  if( !x86_parse_extension( envStrId, request ) )
+  {
+    msg( WARNING, "\nWARNING: unknown SIMD extension '%s' in VTM_SIMD, using %s\n", envStrId, x86_vext_names[maxSupported] );
+    return maxSupported;
+  }
+
+  return x86_limit_extension( request, maxSupported );
+}
+
+X86_VEXT read_x86_extension_flags( const std::string &extStrId )
+{
+  static const X86_VEXT maxSupported = x86_detect_extension();
+  static X86_VEXT ext_flags = x86_default_extension( maxSupported );
+
+  if( !extStrId.empty() )
+  {
+    X86_VEXT request = SCALAR;
+
+    CHECK( !x86_parse_extension( extStrId, request ), "Unknown SIMD extension '" << extStrId << "' (SCALAR, SSE41, SSE42, AVX, AVX2, AVX512)" );
+
+    ext_flags = x86_limit_extension( request, maxSupported );
+  }
+
+  return ext_flags;
+}
+
+unsigned read_x86_feature_flags()
+{
+  static const unsigned features = x86_detect_features();
+
+  return features;
+}
+
+const char* read_x86_extension( const std::string &extStrId )
+{
+  return x86_vext_to_string( read_x86_extension_flags( extStrId ) );
+}
+
+#endif //TARGET_SIMD_X86
+#endif //ENABLE_SIMD_OPT
@@ -0,0 +1,223 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     CommonDefX86.h
+    \brief    common definitions and helpers for the x86 SIMD kernels
+*/
+
+#ifndef __COMMONDEFX86__
+#define __COMMONDEFX86__
+
+#include "CommonDef.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+// SIMDX86 is the extension a kernel translation unit in x86/<ext>/ is compiled for,
+// USE_<ext> is set by CommonLib/CMakeLists.txt together with the matching compiler flags
+#if defined( USE_AVX512 ) && !defined( USE_AVX2 )
+// the AVX-512 kernels extend the AVX2 ones, which are compiled into the same translation units
+#define USE_AVX2
+#endif
+
+#if defined( USE_AVX512 )
+#define SIMDX86 AVX512
+#if defined( __GNUC__ ) && !defined( __clang__ ) && __GNUC__ == 12
+// the 512 bit intrinsics of GCC 12 with undefined upper or pass-through parts raise false -Wuninitialized warnings,
+// the -Wmaybe-uninitialized ones at the inlined call sites are disabled for the AVX-512 sources in CMakeLists.txt
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#else
+#include <immintrin.h>
+#endif
+#elif defined( USE_AVX2 )
+#define SIMDX86 AVX2
+#include <immintrin.h>
+#elif defined( USE_AVX )
+#define SIMDX86 AVX
+#include <immintrin.h>
+#elif defined( USE_SSE42 )
+#define SIMDX86 SSE42
+#include <nmmintrin.h>
+#elif defined( USE_SSE41 )
+#define SIMDX86 SSE41
+#include <smmintrin.h>
+#endif
+
+const char* x86_vext_to_string( X86_VEXT vext );
+
+#if defined( USE_SSE41 ) || defined( USE_SSE42 ) || defined( USE_AVX ) || defined( USE_AVX2 ) || defined( USE_AVX512 )
+
+// all helpers below have internal linkage: they are compiled once per extension
+// and must never be merged across translation units built with different flags
+
+// horizontal sums
+static inline int _mm_hsum_epi32( __m128i v )
+{
+  v = _mm_add_epi32( v, _mm_shuffle_epi32( v, 0x4e ) );
+  v = _mm_add_epi32( v, _mm_shuffle_epi32( v, 0xb1 ) );
+  return _mm_cvtsi128_si32( v );
+}
+
+static inline int64_t _mm_hsum_epi64( __m128i v )
+{
+  v = _mm_add_epi64( v, _mm_shuffle_epi32( v, 0x4e ) );
+#if defined( _MSC_VER ) && !defined( _WIN64 )
+  int64_t res;
+  _mm_storel_epi64( ( __m128i* ) &res, v );
+  return res;
+#else
+  return _mm_cvtsi128_si64( v );
+#endif
+}
+
+// 4x4 transpose of 32 bit elements
+static inline void _mm_transpose4x4_epi32( __m128i& r0, __m128i& r1, __m128i& r2, __m128i& r3 )
+{
+  const __m128i t0 = _mm_unpacklo_epi32( r0, r1 );
+  const __m128i t1 = _mm_unpacklo_epi32( r2, r3 );
+  const __m128i t2 = _mm_unpackhi_epi32( r0, r1 );
+  const __m128i t3 = _mm_unpackhi_epi32( r2, r3 );
+
+  r0 = _mm_unpacklo_epi64( t0, t1 );
+  r1 = _mm_unpackhi_epi64( t0, t1 );
+  r2 = _mm_unpacklo_epi64( t2, t3 );
+  r3 = _mm_unpackhi_epi64( t2, t3 );
+}
+
+// 8x8 transpose of 16 bit elements
+static inline void _mm_transpose8x8_epi16( __m128i* r )
+{
+  __m128i t[8], u[8];
+
+  for( int i = 0; i < 4; i++ )
+  {
+    t[i    ] = _mm_unpacklo_epi16( r[2 * i], r[2 * i + 1] );
+    t[i + 4] = _mm_unpackhi_epi16( r[2 * i], r[2 * i + 1] );
+  }
+  for( int i = 0; i < 8; i += 4 )
+  {
+    u[i    ] = _mm_unpacklo_epi32( t[i    ], t[i + 1] );
+    u[i + 1] = _mm_unpackhi_epi32( t[i    ], t[i + 1] );
+    u[i + 2] = _mm_unpacklo_epi32( t[i + 2], t[i + 3] );
+    u[i + 3] = _mm_unpackhi_epi32( t[i + 2], t[i + 3] );
+  }
+  for( int i = 0; i < 2; i++ )
+  {
+    r[2 * i    ] = _mm_unpacklo_epi64( u[i    ], u[i + 2] );
+    r[2 * i + 1] = _mm_unpackhi_epi64( u[i    ], u[i + 2] );
+    r[2 * i + 4] = _mm_unpacklo_epi64( u[i + 4], u[i + 6] );
+    r[2 * i + 5] = _mm_unpackhi_epi64( u[i + 4], u[i + 6] );
+  }
+}
+
+#endif
+
+#if defined( USE_AVX2 ) || defined( USE_AVX512 )
+
+static inline int _mm256_hsum_epi32( __m256i v )
+{
+  return _mm_hsum_epi32( _mm_add_epi32( _mm256_castsi256_si128( v ), _mm256_extracti128_si256( v, 1 ) ) );
+}
+
+static inline int64_t _mm256_hsum_epi64( __m256i v )
+{
+  return _mm_hsum_epi64( _mm_add_epi64( _mm256_castsi256_si128( v ), _mm256_extracti128_si256( v, 1 ) ) );
+}
+
+// 8x8 transpose of 32 bit elements
+static inline void _mm256_transpose8x8_epi32( __m256i* r )
+{
+  __m256i t[8], u[8];
+
+  for( int i = 0; i < 8; i += 2 )
+  {
+    t[i  ] = _mm256_unpacklo_epi32( r[i], r[i + 1] );
+    t[i+1] = _mm256_unpackhi_epi32( r[i], r[i + 1] );
+  }
+  for( int i = 0; i < 8; i += 4 )
+  {
+    u[i  ] = _mm256_unpacklo_epi64( t[i  ], t[i + 2] );
+    u[i+1] = _mm256_unpackhi_epi64( t[i  ], t[i + 2] );
+    u[i+2] = _mm256_unpacklo_epi64( t[i+1], t[i + 3] );
+    u[i+3] = _mm256_unpackhi_epi64( t[i+1], t[i + 3] );
+  }
+  for( int i = 0; i < 4; i++ )
+  {
+    r[i    ] = _mm256_permute2x128_si256( u[i], u[i + 4], 0x20 );
+    r[i + 4] = _mm256_permute2x128_si256( u[i], u[i + 4], 0x31 );
+  }
+}
+
+#endif
+
+#if defined( USE_AVX512 )
+
+// 8x8 transposes of 16 bit elements in each of the four 128 bit lanes
+static inline void _mm512_transpose8x8_epi16( __m512i* r )
+{
+  __m512i t[8], u[8];
+
+  for( int i = 0; i < 4; i++ )
+  {
+    t[i    ] = _mm512_unpacklo_epi16( r[2 * i], r[2 * i + 1] );
+    t[i + 4] = _mm512_unpackhi_epi16( r[2 * i], r[2 * i + 1] );
+  }
+  for( int i = 0; i < 8; i += 4 )
+  {
+    u[i    ] = _mm512_unpacklo_epi32( t[i    ], t[i + 1] );
+    u[i + 1] = _mm512_unpackhi_epi32( t[i    ], t[i + 1] );
+    u[i + 2] = _mm512_unpacklo_epi32( t[i + 2], t[i + 3] );
+    u[i + 3] = _mm512_unpackhi_epi32( t[i + 2], t[i + 3] );
+  }
+  for( int i = 0; i < 2; i++ )
+  {
+    r[2 * i    ] = _mm512_unpacklo_epi64( u[i    ], u[i + 2] );
+    r[2 * i + 1] = _mm512_unpackhi_epi64( u[i    ], u[i + 2] );
+    r[2 * i + 4] = _mm512_unpacklo_epi64( u[i + 4], u[i + 6] );
+    r[2 * i + 5] = _mm512_unpackhi_epi64( u[i + 4], u[i + 6] );
+  }
+}
+
+#endif
+
+#endif //TARGET_SIMD_X86
+
+//! \}
+
+#endif // __COMMONDEFX86__
@@ -0,0 +1,151 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     HashX86.h
+    \brief    block hashing for hash ME, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../Unit.h"
+#include "../Hash.h"
+
+#if ENABLE_SIMD_OPT_IBC
+#ifdef TARGET_SIMD_X86
+
+#include <wmmintrin.h>
+
+//! \ingroup CommonLib
+//! \{
+
+// The block hashes are 24 bit CRCs (MSB first, no initial value or final xor) over at most 16 bytes, i.e.
+// crc = M(x) * x^24 mod P(x) for the message polynomial M. The message is folded into 64 bits with carry-less
+// multiplications and then reduced with a Barrett reduction, which is exact for polynomials over GF(2).
+// PCLMULQDQ is not implied by the SIMD extension level, these kernels are only used if the CPU reports it.
+
+struct Crc24Consts
+{
+  __m128i fold;      // lo: x^88 mod P, hi: x^64 mod P
+  __m128i barrett;   // lo: x^64 / P, hi: P
+};
+
+static uint64_t xCrc24PolyMod( const int n, const uint32_t truncPoly )
+{
+  uint64_t r = 1;
+  for( int i = 0; i < n; i++ )
+  {
+    r <<= 1;
+    if( r & ( 1 << 24 ) )
+    {
+      r ^= ( 1 << 24 ) | truncPoly;
+    }
+  }
+  return r;
+}
+
+static uint64_t xCrc24PolyDivX64( const uint32_t truncPoly )
+{
+  // long division of x^64 by P, the quotient has degree 40
+  uint64_t q = 0;
+  uint32_t r = 0;
+  for( int d = 64; d >= 0; d-- )
+  {
+    r = ( r << 1 ) | ( d == 64 ? 1 : 0 );
+    if( r & ( 1 << 24 ) )
+    {
+      r ^= ( 1 << 24 ) | truncPoly;
+      q |= uint64_t( 1 ) << d;
+    }
+  }
+  return q;
+}
+
+static Crc24Consts xCrc24InitConsts( const uint32_t truncPoly )
+{
+  Crc24Consts k;
+  k.fold    = _mm_set_epi64x( xCrc24PolyMod( 64, truncPoly ), xCrc24PolyMod( 88, truncPoly ) );
+  k.barrett = _mm_set_epi64x( ( 1 << 24 ) | truncPoly, xCrc24PolyDivX64( truncPoly ) );
+  return k;
+}
+
+static ALWAYS_INLINE uint32_t xCrc24( const unsigned char* p, const int length, const Crc24Consts& k )
+{
+  __m128i m;
+  switch( length )
+  {
+  case  4: m = _mm_cvtsi32_si128( *( const int32_t* ) p ); break;
+  case  8: m = _mm_loadl_epi64( ( const __m128i* ) p ); break;
+  case 12: m = _mm_insert_epi32( _mm_loadl_epi64( ( const __m128i* ) p ), *( const int32_t* ) ( p + 8 ), 2 ); break;
+  default: m = _mm_loadu_si128( ( const __m128i* ) p ); break;
+  }
+
+  // byte reversal, the first byte holds the highest coefficients of M
+  m = _mm_shuffle_epi8( m, _mm_sub_epi8( _mm_set1_epi8( length - 1 ), _mm_setr_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 ) ) );
+
+  // M * x^24 = H * x^88 + L * x^24, with a degree below 88 after folding H
+  const __m128i t = _mm_xor_si128( _mm_clmulepi64_si128( m, k.fold, 0x01 ), _mm_slli_si128( _mm_move_epi64( m ), 3 ) );
+  // T = Th * x^64 + Tl, with a degree below 64 after folding Th
+  const __m128i u = _mm_xor_si128( _mm_clmulepi64_si128( t, k.fold, 0x11 ), _mm_move_epi64( t ) );
+
+  // Barrett reduction: q = ( ( U / x^24 ) * ( x^64 / P ) ) / x^40, crc = U - q * P
+  const __m128i q = _mm_srli_si128( _mm_clmulepi64_si128( _mm_srli_epi64( u, 24 ), k.barrett, 0x00 ), 5 );
+  const __m128i r = _mm_xor_si128( u, _mm_clmulepi64_si128( q, k.barrett, 0x10 ) );
+
+  return _mm_cvtsi128_si32( r ) & 0xffffff;
+}
+
+template<X86_VEXT vext, uint32_t truncPoly, uint32_t( *getCRCValueCore )( unsigned char*, int )>
+static uint32_t getCRCValue_CLMUL( unsigned char* p, int length )
+{
+  static const Crc24Consts k = xCrc24InitConsts( truncPoly );
+
+  if( length < 4 || length > 16 || ( length & 3 ) )
+  {
+    return getCRCValueCore( p, length );
+  }
+
+  return xCrc24( p, length, k );
+}
+
+template <X86_VEXT vext>
+void TComHash::_initTComHashX86()
+{
+  m_getCRCValue1 = getCRCValue_CLMUL<vext, m_crcPoly1, getCRCValue1Core>;
+  m_getCRCValue2 = getCRCValue_CLMUL<vext, m_crcPoly2, getCRCValue2Core>;
+}
+
+template void TComHash::_initTComHashX86<SIMDX86>();
+
+//! \}
+
+#endif //TARGET_SIMD_X86
+#endif //ENABLE_SIMD_OPT_IBC
@@ -0,0 +1,107 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     IbcHashMapX86.h
+    \brief    IBC hash map class, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../IbcHashMap.h"
+
+#if ENABLE_SIMD_OPT_IBC
+#ifdef TARGET_SIMD_X86
+
+//! \ingroup CommonLib
+//! \{
+
+static_assert( sizeof( Pel ) == 2, "The CRC32C of a sample is computed over two bytes" );
+
+// the crc32 instruction computes the same CRC32C as the table of the C code, over the little endian bytes of the samples
+
+static ALWAYS_INLINE uint32_t xCrc32cLine( uint32_t crc, const Pel* pel, const int width )
+{
+  int x = 0;
+  for( ; x + 4 <= width; x += 4 )
+  {
+    uint64_t data;
+    memcpy( &data, &pel[x], sizeof( data ) );
+#if defined( _M_X64 ) || defined( __x86_64__ )
+    crc = ( uint32_t ) _mm_crc32_u64( crc, data );
+#else
+    crc = _mm_crc32_u32( crc, ( uint32_t ) data );
+    crc = _mm_crc32_u32( crc, ( uint32_t ) ( data >> 32 ) );
+#endif
+  }
+  if( x + 2 <= width )
+  {
+    uint32_t data;
+    memcpy( &data, &pel[x], sizeof( data ) );
+    crc = _mm_crc32_u32( crc, data );
+    x += 2;
+  }
+  if( x < width )
+  {
+    crc = _mm_crc32_u16( crc, ( uint16_t ) pel[x] );
+  }
+  return crc;
+}
+
+template<X86_VEXT vext>
+static void calcBlockHashRow_SSE( const Pel* pel, const int stride, const int width, const int height, const int posShift, const int numPos, unsigned int* crc )
+{
+  for( int i = 0; i < numPos; i++ )
+  {
+    const Pel* blk      = pel + ( i >> posShift );
+    uint32_t hashValue  = crc[i];
+
+    for( int y = 0; y < height; y++ )
+    {
+      hashValue = xCrc32cLine( hashValue, blk, width );
+      blk      += stride;
+    }
+    crc[i] = hashValue;
+  }
+}
+
+template <X86_VEXT vext>
+void IbcHashMap::_initIbcHashMapX86()
+{
+  m_calcBlockHashRow = calcBlockHashRow_SSE<vext>;
+}
+
+template void IbcHashMap::_initIbcHashMapX86<SIMDX86>();
+
+//! \}
+
+#endif //TARGET_SIMD_X86
+#endif //ENABLE_SIMD_OPT_IBC
@@ -0,0 +1,370 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     InitX86.cpp
+    \brief    initialize the function pointers of the SIMD optimized kernels
+*/
+
+#include "CommonDefX86.h"
+
+#include "RdCost.h"
+#include "InterpolationFilter.h"
+#include "Buffer.h"
+#include "AdaptiveLoopFilter.h"
+#include "TrQuant.h"
+#include "LoopFilter.h"
+#include "AffineGradientSearch.h"
+#include "SampleAdaptiveOffset.h"
+#include "IbcHashMap.h"
+#include "Hash.h"
+#include "IntraPrediction.h"
+#include "MatrixIntraPrediction.h"
+#include "TemporalFilterOps.h"
+
+#if ENABLE_SIMD_OPT
+#ifdef TARGET_SIMD_X86
+
+// --------------------------------------------------------------------------------------------------------------------
+// kernel families
+// --------------------------------------------------------------------------------------------------------------------
+
+enum X86KernelFamilyId
+{
+  X86_KERNELS_RDCOST,
+  X86_KERNELS_MCIF,
+  X86_KERNELS_BUFFER,
+  X86_KERNELS_INTRA,
+  X86_KERNELS_MIP,
+  X86_KERNELS_MCTF,
+  X86_KERNELS_AFFINE_ME,
+  X86_KERNELS_ALF,
+  X86_KERNELS_TRAFO,
+  X86_KERNELS_DBLF,
+  X86_KERNELS_SAO,
+  X86_KERNELS_IBC,
+  X86_KERNELS_HASH,
+  NUM_X86_KERNEL_FAMILIES
+};
+
+// the extensions a family is implemented for, highest first, each family uses the highest implementation that does not
+// exceed the extension selected by --SIMD or VTM_SIMD and the scalar code below its lowest one. A family that needs
+// instructions beyond its extension level lists them as X86_FEATURE flags and uses the scalar code if one is missing.
+struct X86KernelFamily
+{
+  const char* name;
+  bool        enabled;
+  X86_VEXT    impl[3];
+  unsigned    features;
+};
+
+static const X86KernelFamily x86KernelFamilies[NUM_X86_KERNEL_FAMILIES] =
+{
+  { "RdCost",                ENABLE_SIMD_OPT_DIST,      { AVX512, AVX2,   SSE41  }, 0 },
+  { "InterpolationFilter",   ENABLE_SIMD_OPT_MCIF,      { AVX512, AVX2,   SSE41  }, 0 },
+  { "PelBufferOps",          ENABLE_SIMD_OPT_BUFFER,    { AVX512, AVX2,   SSE41  }, 0 },
+  { "IntraPredOps",          ENABLE_SIMD_OPT_INTRA,     { AVX2,   SSE41,  SCALAR }, 0 },
+  { "MatrixIntraPrediction", ENABLE_SIMD_OPT_MIP,       { AVX2,   SCALAR, SCALAR }, 0 },
+  { "TemporalFilterOps",     ENABLE_SIMD_OPT_MCTF,      { AVX2,   SSE41,  SCALAR }, 0 },
+  { "AffineGradientSearch",  ENABLE_SIMD_OPT_AFFINE_ME, { AVX2,   SSE41,  SCALAR }, 0 },
+  { "AdaptiveLoopFilter",    ENABLE_SIMD_OPT_ALF,       { AVX512, AVX2,   SSE41  }, 0 },
+  { "TrQuant",               ENABLE_SIMD_OPT_TRAFO,     { AVX512, AVX2,   SSE41  }, 0 },
+  { "LoopFilter",            ENABLE_SIMD_OPT_DBLF,      { AVX2,   SSE41,  SCALAR }, 0 },
+  { "SampleAdaptiveOffset",  ENABLE_SIMD_OPT_SAO,       { AVX2,   SSE41,  SCALAR }, 0 },
+  { "IbcHashMap",            ENABLE_SIMD_OPT_IBC,       { SSE42,  SCALAR, SCALAR }, 0 },
+  { "TComHash",              ENABLE_SIMD_OPT_IBC,       { AVX,    SCALAR, SCALAR }, X86_FEATURE_PCLMUL },
+};
+
+static X86_VEXT x86_kernel_tier( const X86KernelFamilyId id )
+{
+  const X86_VEXT vext = read_x86_extension_flags();
+
+  if( x86KernelFamilies[id].features & ~read_x86_feature_flags() )
+  {
+    return SCALAR;
+  }
+
+  for( const X86_VEXT impl : x86KernelFamilies[id].impl )
+  {
+    if( impl != SCALAR && impl <= vext )
+    {
+      return impl;
+    }
+  }
+  return SCALAR;
+}
+
+std::string read_x86_kernel_tiers()
+{
+  std::string tiers;
+
+  for( int id = 0; id < NUM_X86_KERNEL_FAMILIES; id++ )
+  {
+    if( x86KernelFamilies[id].enabled )
+    {
+      tiers += std::string( tiers.empty() ? "" : " " ) + x86KernelFamilies[id].name + "=" + x86_vext_to_string( x86_kernel_tier( X86KernelFamilyId( id ) ) );
+    }
+  }
+  return tiers;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// initialization of the function pointers
+// --------------------------------------------------------------------------------------------------------------------
+
+#if ENABLE_SIMD_OPT_DIST
+void RdCost::initRdCostX86()
+{
+  switch( x86_kernel_tier( X86_KERNELS_RDCOST ) )
+  {
+  case AVX512:
+    _initRdCostX86<AVX512>();
+    break;
+  case AVX2:
+    _initRdCostX86<AVX2>();
+    break;
+  case SSE41:
+    _initRdCostX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_MCIF
+void InterpolationFilter::initInterpolationFilterX86()
+{
+  switch( x86_kernel_tier( X86_KERNELS_MCIF ) )
+  {
+  case AVX512:
+    _initInterpolationFilterX86<AVX512>();
+    break;
+  case AVX2:
+    _initInterpolationFilterX86<AVX2>();
+    break;
+  case SSE41:
+    _initInterpolationFilterX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_BUFFER
+void PelBufferOps::initPelBufOpsX86()
+{
+  switch( x86_kernel_tier( X86_KERNELS_BUFFER ) )
+  {
+  case AVX512:
+    _initPelBufOpsX86<AVX512>();
+    break;
+  case AVX2:
+    _initPelBufOpsX86<AVX2>();
+    break;
+  case SSE41:
+    _initPelBufOpsX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_INTRA
+void IntraPredOps::initIntraPredOpsX86()
+{
+  switch( x86_kernel_tier( X86_KERNELS_INTRA ) )
+  {
+  case AVX2:
+    _initIntraPredOpsX86<AVX2>();
+    break;
+  case SSE41:
+    _initIntraPredOpsX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_MIP
+void MatrixIntraPrediction::initMatrixIntraPredictionX86()
+{
+  switch( x86_kernel_tier( X86_KERNELS_MIP ) )
+  {
+  case AVX2:
+    _initMatrixIntraPredictionX86<AVX2>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_MCTF
+void TemporalFilterOps::initTemporalFilterOpsX86()
+{
+  switch( x86_kernel_tier( X86_KERNELS_MCTF ) )
+  {
+  case AVX2:
+    _initTemporalFilterOpsX86<AVX2>();
+    break;
+  case SSE41:
+    _initTemporalFilterOpsX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_AFFINE_ME
+void AffineGradientSearch::initAffineGradientSearchX86()
+{
+  switch( x86_kernel_tier( X86_KERNELS_AFFINE_ME ) )
+  {
+  case AVX2:
+    _initAffineGradientSearchX86<AVX2>();
+    break;
+  case SSE41:
+    _initAffineGradientSearchX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_ALF
+void AdaptiveLoopFilter::initAdaptiveLoopFilterX86()
+{
+  switch( x86_kernel_tier( X86_KERNELS_ALF ) )
+  {
+  case AVX512:
+    _initAdaptiveLoopFilterX86<AVX512>();
+    break;
+  case AVX2:
+    _initAdaptiveLoopFilterX86<AVX2>();
+    break;
+  case SSE41:
+    _initAdaptiveLoopFilterX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_TRAFO
+void TrQuant::initTrQuantX86()
+{
+  switch( x86_kernel_tier( X86_KERNELS_TRAFO ) )
+  {
+  case AVX512:
+    _initTrQuantX86<AVX512>();
+    break;
+  case AVX2:
+    _initTrQuantX86<AVX2>();
+    break;
+  case SSE41:
+    _initTrQuantX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_DBLF
+void LoopFilter::initLoopFilterX86()
+{
+  switch( x86_kernel_tier( X86_KERNELS_DBLF ) )
+  {
+  case AVX2:
+    _initLoopFilterX86<AVX2>();
+    break;
+  case SSE41:
+    _initLoopFilterX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_SAO
+void SampleAdaptiveOffset::initSampleAdaptiveOffsetX86()
+{
+  switch( x86_kernel_tier( X86_KERNELS_SAO ) )
+  {
+  case AVX2:
+    _initSampleAdaptiveOffsetX86<AVX2>();
+    break;
+  case SSE41:
+    _initSampleAdaptiveOffsetX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_IBC
+void IbcHashMap::initIbcHashMapX86()
+{
+  switch( x86_kernel_tier( X86_KERNELS_IBC ) )
+  {
+  case SSE42:
+    _initIbcHashMapX86<SSE42>();
+    break;
+  default:
+    break;
+  }
+}
+
+void TComHash::initTComHashX86()
+{
+  switch( x86_kernel_tier( X86_KERNELS_HASH ) )
+  {
+  case AVX:
+    _initTComHashX86<AVX>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#endif //TARGET_SIMD_X86
+#endif //ENABLE_SIMD_OPT
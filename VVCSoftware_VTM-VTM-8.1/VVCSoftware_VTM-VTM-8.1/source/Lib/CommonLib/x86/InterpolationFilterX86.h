@@ -0,0 +1,802 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     InterpolationFilterX86.h
+    \brief    interpolation filter class, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../InterpolationFilter.h"
+
+#ifdef TARGET_SIMD_X86
+
+//! \ingroup CommonLib
+//! \{
+
+// shift and offset of one filtering stage, derived as in InterpolationFilter::filter
+static inline void xFilterShiftOffset( const ClpRng& clpRng, const bool isFirst, const bool isLast, const bool biMCForDMVR, int& shift, int& offset )
+{
+  const int headRoom = std::max<int>( 2, ( IF_INTERNAL_PREC - clpRng.bd ) );
+
+  shift = IF_FILTER_PREC;
+
+  if( isLast )
+  {
+    shift  += isFirst ? 0 : headRoom;
+    offset  = 1 << ( shift - 1 );
+    offset += isFirst ? 0 : IF_INTERNAL_OFFS << IF_FILTER_PREC;
+  }
+  else
+  {
+    shift  -= isFirst ? headRoom : 0;
+    offset  = isFirst ? -IF_INTERNAL_OFFS << shift : 0;
+  }
+
+  if( biMCForDMVR )
+  {
+    shift  = isFirst ? IF_FILTER_PREC_BILINEAR - ( IF_INTERNAL_PREC_BILINEAR - clpRng.bd ) : 4;
+    offset = 1 << ( shift - 1 );
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// FIR kernels: N taps (N even) applied to 4, 8 or 16 consecutive outputs, the taps are step samples apart.
+// Neighbouring taps are interleaved and multiplied pairwise with madd, the coefficients are passed as
+// (c[k], c[k+1]) pairs.
+// --------------------------------------------------------------------------------------------------------------------
+
+template<int N>
+static ALWAYS_INLINE __m128i xFilter8_SSE( const Pel* src, const ptrdiff_t step, const __m128i* vcoeff, const __m128i voffset, const __m128i vshift )
+{
+  __m128i vlo = voffset;
+  __m128i vhi = voffset;
+
+  for( int k = 0; k < N; k += 2 )
+  {
+    const __m128i va = _mm_loadu_si128( ( const __m128i* ) &src[ k      * step] );
+    const __m128i vb = _mm_loadu_si128( ( const __m128i* ) &src[( k + 1 ) * step] );
+    vlo = _mm_add_epi32( vlo, _mm_madd_epi16( _mm_unpacklo_epi16( va, vb ), vcoeff[k >> 1] ) );
+    vhi = _mm_add_epi32( vhi, _mm_madd_epi16( _mm_unpackhi_epi16( va, vb ), vcoeff[k >> 1] ) );
+  }
+
+  return _mm_packs_epi32( _mm_sra_epi32( vlo, vshift ), _mm_sra_epi32( vhi, vshift ) );
+}
+
+// result in the lower 64 bits
+template<int N>
+static ALWAYS_INLINE __m128i xFilter4_SSE( const Pel* src, const ptrdiff_t step, const __m128i* vcoeff, const __m128i voffset, const __m128i vshift )
+{
+  __m128i vsum = voffset;
+
+  for( int k = 0; k < N; k += 2 )
+  {
+    const __m128i va = _mm_loadl_epi64( ( const __m128i* ) &src[ k      * step] );
+    const __m128i vb = _mm_loadl_epi64( ( const __m128i* ) &src[( k + 1 ) * step] );
+    vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_unpacklo_epi16( va, vb ), vcoeff[k >> 1] ) );
+  }
+
+  vsum = _mm_sra_epi32( vsum, vshift );
+  return _mm_packs_epi32( vsum, vsum );
+}
+
+// vertical filtering of N rows already held in registers
+template<int N>
+static ALWAYS_INLINE __m128i xFilterRows8_SSE( const __m128i* vrow, const __m128i* vcoeff, const __m128i voffset, const __m128i vshift )
+{
+  __m128i vlo = voffset;
+  __m128i vhi = voffset;
+
+  for( int k = 0; k < N; k += 2 )
+  {
+    vlo = _mm_add_epi32( vlo, _mm_madd_epi16( _mm_unpacklo_epi16( vrow[k], vrow[k + 1] ), vcoeff[k >> 1] ) );
+    vhi = _mm_add_epi32( vhi, _mm_madd_epi16( _mm_unpackhi_epi16( vrow[k], vrow[k + 1] ), vcoeff[k >> 1] ) );
+  }
+
+  return _mm_packs_epi32( _mm_sra_epi32( vlo, vshift ), _mm_sra_epi32( vhi, vshift ) );
+}
+
+#ifdef USE_AVX2
+template<int N>
+static ALWAYS_INLINE __m256i xFilter16_AVX2( const Pel* src, const ptrdiff_t step, const __m256i* vcoeff, const __m256i voffset, const __m128i vshift )
+{
+  __m256i vlo = voffset;
+  __m256i vhi = voffset;
+
+  for( int k = 0; k < N; k += 2 )
+  {
+    const __m256i va = _mm256_loadu_si256( ( const __m256i* ) &src[ k      * step] );
+    const __m256i vb = _mm256_loadu_si256( ( const __m256i* ) &src[( k + 1 ) * step] );
+    vlo = _mm256_add_epi32( vlo, _mm256_madd_epi16( _mm256_unpacklo_epi16( va, vb ), vcoeff[k >> 1] ) );
+    vhi = _mm256_add_epi32( vhi, _mm256_madd_epi16( _mm256_unpackhi_epi16( va, vb ), vcoeff[k >> 1] ) );
+  }
+
+  // unpack and pack both work per 128 bit lane, so the output order is preserved
+  return _mm256_packs_epi32( _mm256_sra_epi32( vlo, vshift ), _mm256_sra_epi32( vhi, vshift ) );
+}
+
+template<int N>
+static ALWAYS_INLINE __m256i xFilterRows16_AVX2( const __m256i* vrow, const __m256i* vcoeff, const __m256i voffset, const __m128i vshift )
+{
+  __m256i vlo = voffset;
+  __m256i vhi = voffset;
+
+  for( int k = 0; k < N; k += 2 )
+  {
+    vlo = _mm256_add_epi32( vlo, _mm256_madd_epi16( _mm256_unpacklo_epi16( vrow[k], vrow[k + 1] ), vcoeff[k >> 1] ) );
+    vhi = _mm256_add_epi32( vhi, _mm256_madd_epi16( _mm256_unpackhi_epi16( vrow[k], vrow[k + 1] ), vcoeff[k >> 1] ) );
+  }
+
+  return _mm256_packs_epi32( _mm256_sra_epi32( vlo, vshift ), _mm256_sra_epi32( vhi, vshift ) );
+}
+#endif
+
+#ifdef USE_AVX512
+template<int N>
+static ALWAYS_INLINE __m512i xFilter32_AVX512( const Pel* src, const ptrdiff_t step, const __m512i* vcoeff, const __m512i voffset, const __m128i vshift )
+{
+  __m512i vlo = voffset;
+  __m512i vhi = voffset;
+
+  for( int k = 0; k < N; k += 2 )
+  {
+    const __m512i va = _mm512_loadu_si512( ( const void* ) &src[ k      * step] );
+    const __m512i vb = _mm512_loadu_si512( ( const void* ) &src[( k + 1 ) * step] );
+    vlo = _mm512_add_epi32( vlo, _mm512_madd_epi16( _mm512_unpacklo_epi16( va, vb ), vcoeff[k >> 1] ) );
+    vhi = _mm512_add_epi32( vhi, _mm512_madd_epi16( _mm512_unpackhi_epi16( va, vb ), vcoeff[k >> 1] ) );
+  }
+
+  return _mm512_packs_epi32( _mm512_sra_epi32( vlo, vshift ), _mm512_sra_epi32( vhi, vshift ) );
+}
+
+template<int N>
+static ALWAYS_INLINE __m512i xFilterRows32_AVX512( const __m512i* vrow, const __m512i* vcoeff, const __m512i voffset, const __m128i vshift )
+{
+  __m512i vlo = voffset;
+  __m512i vhi = voffset;
+
+  for( int k = 0; k < N; k += 2 )
+  {
+    vlo = _mm512_add_epi32( vlo, _mm512_madd_epi16( _mm512_unpacklo_epi16( vrow[k], vrow[k + 1] ), vcoeff[k >> 1] ) );
+    vhi = _mm512_add_epi32( vhi, _mm512_madd_epi16( _mm512_unpackhi_epi16( vrow[k], vrow[k + 1] ), vcoeff[k >> 1] ) );
+  }
+
+  return _mm512_packs_epi32( _mm512_sra_epi32( vlo, vshift ), _mm512_sra_epi32( vhi, vshift ) );
+}
+#endif
+
+template<int N>
+static ALWAYS_INLINE void xFilterCoeffPairs( const TFilterCoeff* coeff, __m128i* vcoeff )
+{
+  for( int k = 0; k < N; k += 2 )
+  {
+    vcoeff[k >> 1] = _mm_unpacklo_epi16( _mm_set1_epi16( coeff[k] ), _mm_set1_epi16( coeff[k + 1] ) );
+  }
+}
+
+// scalar filtering of a single output sample, used for the columns left over by the vector loops
+template<int N>
+static ALWAYS_INLINE Pel xFilterScalar( const Pel* src, const ptrdiff_t step, const TFilterCoeff* coeff, const int offset, const int shift )
+{
+  int sum = 0;
+  for( int k = 0; k < N; k++ )
+  {
+    sum += src[k * step] * coeff[k];
+  }
+  return ( sum + offset ) >> shift;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// 1D filtering
+// --------------------------------------------------------------------------------------------------------------------
+
+// src points to the first tap of the first output sample
+template<X86_VEXT vext, int N, bool isVertical, bool isFirst, bool isLast>
+static void simdFilterN( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR )
+{
+  int shift, offset;
+  xFilterShiftOffset( clpRng, isFirst, isLast, biMCForDMVR, shift, offset );
+
+  const ptrdiff_t step    = isVertical ? srcStride : 1;
+  const __m128i   voffset = _mm_set1_epi32( offset );
+  const __m128i   vshift  = _mm_cvtsi32_si128( shift );
+  const __m128i   vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i   vmax    = _mm_set1_epi16( clpRng.max );
+
+  __m128i vcoeff[N / 2];
+  xFilterCoeffPairs<N>( coeff, vcoeff );
+
+#ifdef USE_AVX2
+  __m256i vcoeff256[N / 2];
+  for( int k = 0; k < N / 2; k++ )
+  {
+    vcoeff256[k] = _mm256_broadcastsi128_si256( vcoeff[k] );
+  }
+  const __m256i voffset256 = _mm256_set1_epi32( offset );
+  const __m256i vmin256    = _mm256_set1_epi16( clpRng.min );
+  const __m256i vmax256    = _mm256_set1_epi16( clpRng.max );
+#endif
+#ifdef USE_AVX512
+  __m512i vcoeff512[N / 2];
+  for( int k = 0; k < N / 2; k++ )
+  {
+    vcoeff512[k] = _mm512_broadcast_i32x4( vcoeff[k] );
+  }
+  const __m512i voffset512 = _mm512_set1_epi32( offset );
+  const __m512i vmin512    = _mm512_set1_epi16( clpRng.min );
+  const __m512i vmax512    = _mm512_set1_epi16( clpRng.max );
+#endif
+
+  for( int row = 0; row < height; row++ )
+  {
+    int col = 0;
+
+#ifdef USE_AVX512
+    if( vext >= AVX512 )
+    {
+      for( ; col + 32 <= width; col += 32 )
+      {
+        __m512i vres = xFilter32_AVX512<N>( &src[col], step, vcoeff512, voffset512, vshift );
+        if( isLast )
+        {
+          vres = _mm512_min_epi16( vmax512, _mm512_max_epi16( vmin512, vres ) );
+        }
+        _mm512_storeu_si512( ( void* ) &dst[col], vres );
+      }
+    }
+#endif
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; col + 16 <= width; col += 16 )
+      {
+        __m256i vres = xFilter16_AVX2<N>( &src[col], step, vcoeff256, voffset256, vshift );
+        if( isLast )
+        {
+          vres = _mm256_min_epi16( vmax256, _mm256_max_epi16( vmin256, vres ) );
+        }
+        _mm256_storeu_si256( ( __m256i* ) &dst[col], vres );
+      }
+    }
+#endif
+    for( ; col + 8 <= width; col += 8 )
+    {
+      __m128i vres = xFilter8_SSE<N>( &src[col], step, vcoeff, voffset, vshift );
+      if( isLast )
+      {
+        vres = _mm_min_epi16( vmax, _mm_max_epi16( vmin, vres ) );
+      }
+      _mm_storeu_si128( ( __m128i* ) &dst[col], vres );
+    }
+    for( ; col + 4 <= width; col += 4 )
+    {
+      __m128i vres = xFilter4_SSE<N>( &src[col], step, vcoeff, voffset, vshift );
+      if( isLast )
+      {
+        vres = _mm_min_epi16( vmax, _mm_max_epi16( vmin, vres ) );
+      }
+      _mm_storel_epi64( ( __m128i* ) &dst[col], vres );
+    }
+    for( ; col < width; col++ )
+    {
+      const Pel val = xFilterScalar<N>( &src[col], step, coeff, offset, shift );
+      dst[col] = isLast ? ClipPel( val, clpRng ) : val;
+    }
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+template<X86_VEXT vext, int N, bool isVertical, bool isFirst, bool isLast>
+static void simdFilter( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR )
+{
+  const int cStride = isVertical ? srcStride : 1;
+
+  // the 6-tap filters of affine and 4x4 blocks are stored as 8-tap filters with zero outer taps
+  if( N == 8 && coeff[0] == 0 && coeff[7] == 0 )
+  {
+    simdFilterN<vext, 6, isVertical, isFirst, isLast>( clpRng, src - 2 * cStride, srcStride, dst, dstStride, width, height, coeff + 1, biMCForDMVR );
+  }
+  else
+  {
+    simdFilterN<vext, N, isVertical, isFirst, isLast>( clpRng, src - ( N / 2 - 1 ) * cStride, srcStride, dst, dstStride, width, height, coeff, biMCForDMVR );
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// 2D filtering: the horizontally filtered rows of a column strip are kept in registers and
+// consumed by the vertical filter directly, without an intermediate buffer
+// --------------------------------------------------------------------------------------------------------------------
+
+// src points to the first tap of the first output sample in both directions
+template<X86_VEXT vext, int N, bool isLast>
+static void simdFilter2DN( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeffH, TFilterCoeff const *coeffV, bool biMCForDMVR )
+{
+  int shiftH, offsetH, shiftV, offsetV;
+  xFilterShiftOffset( clpRng, true,  false,  biMCForDMVR, shiftH, offsetH );
+  xFilterShiftOffset( clpRng, false, isLast, biMCForDMVR, shiftV, offsetV );
+
+  const __m128i voffsetH = _mm_set1_epi32( offsetH );
+  const __m128i vshiftH  = _mm_cvtsi32_si128( shiftH );
+  const __m128i voffsetV = _mm_set1_epi32( offsetV );
+  const __m128i vshiftV  = _mm_cvtsi32_si128( shiftV );
+  const __m128i vmin     = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax     = _mm_set1_epi16( clpRng.max );
+
+  __m128i vcoeffH[N / 2], vcoeffV[N / 2];
+  xFilterCoeffPairs<N>( coeffH, vcoeffH );
+  xFilterCoeffPairs<N>( coeffV, vcoeffV );
+
+  int col = 0;
+
+#ifdef USE_AVX512
+  if( vext >= AVX512 )
+  {
+    __m512i vcoeffH512[N / 2], vcoeffV512[N / 2];
+    for( int k = 0; k < N / 2; k++ )
+    {
+      vcoeffH512[k] = _mm512_broadcast_i32x4( vcoeffH[k] );
+      vcoeffV512[k] = _mm512_broadcast_i32x4( vcoeffV[k] );
+    }
+    const __m512i voffsetH512 = _mm512_set1_epi32( offsetH );
+    const __m512i voffsetV512 = _mm512_set1_epi32( offsetV );
+    const __m512i vmin512     = _mm512_set1_epi16( clpRng.min );
+    const __m512i vmax512     = _mm512_set1_epi16( clpRng.max );
+
+    for( ; col + 32 <= width; col += 32 )
+    {
+      const Pel* s = src + col;
+      Pel*       d = dst + col;
+      __m512i    vrow[N];
+
+      for( int k = 0; k < N - 1; k++, s += srcStride )
+      {
+        vrow[k] = xFilter32_AVX512<N>( s, 1, vcoeffH512, voffsetH512, vshiftH );
+      }
+      for( int row = 0; row < height; row++, s += srcStride, d += dstStride )
+      {
+        vrow[N - 1] = xFilter32_AVX512<N>( s, 1, vcoeffH512, voffsetH512, vshiftH );
+
+        __m512i vres = xFilterRows32_AVX512<N>( vrow, vcoeffV512, voffsetV512, vshiftV );
+        if( isLast )
+        {
+          vres = _mm512_min_epi16( vmax512, _mm512_max_epi16( vmin512, vres ) );
+        }
+        _mm512_storeu_si512( ( void* ) d, vres );
+
+        for( int k = 0; k < N - 1; k++ )
+        {
+          vrow[k] = vrow[k + 1];
+        }
+      }
+    }
+  }
+#endif
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    __m256i vcoeffH256[N / 2], vcoeffV256[N / 2];
+    for( int k = 0; k < N / 2; k++ )
+    {
+      vcoeffH256[k] = _mm256_broadcastsi128_si256( vcoeffH[k] );
+      vcoeffV256[k] = _mm256_broadcastsi128_si256( vcoeffV[k] );
+    }
+    const __m256i voffsetH256 = _mm256_set1_epi32( offsetH );
+    const __m256i voffsetV256 = _mm256_set1_epi32( offsetV );
+    const __m256i vmin256     = _mm256_set1_epi16( clpRng.min );
+    const __m256i vmax256     = _mm256_set1_epi16( clpRng.max );
+
+    for( ; col + 16 <= width; col += 16 )
+    {
+      const Pel* s = src + col;
+      Pel*       d = dst + col;
+      __m256i    vrow[N];
+
+      for( int k = 0; k < N - 1; k++, s += srcStride )
+      {
+        vrow[k] = xFilter16_AVX2<N>( s, 1, vcoeffH256, voffsetH256, vshiftH );
+      }
+      for( int row = 0; row < height; row++, s += srcStride, d += dstStride )
+      {
+        vrow[N - 1] = xFilter16_AVX2<N>( s, 1, vcoeffH256, voffsetH256, vshiftH );
+
+        __m256i vres = xFilterRows16_AVX2<N>( vrow, vcoeffV256, voffsetV256, vshiftV );
+        if( isLast )
+        {
+          vres = _mm256_min_epi16( vmax256, _mm256_max_epi16( vmin256, vres ) );
+        }
+        _mm256_storeu_si256( ( __m256i* ) d, vres );
+
+        for( int k = 0; k < N - 1; k++ )
+        {
+          vrow[k] = vrow[k + 1];
+        }
+      }
+    }
+  }
+#endif
+
+  for( ; col + 4 <= width; col += ( width - col >= 8 ? 8 : 4 ) )
+  {
+    const bool  full = width - col >= 8;
+    const Pel*  s    = src + col;
+    Pel*        d    = dst + col;
+    __m128i     vrow[N];
+
+    for( int k = 0; k < N - 1; k++, s += srcStride )
+    {
+      vrow[k] = full ? xFilter8_SSE<N>( s, 1, vcoeffH, voffsetH, vshiftH ) : xFilter4_SSE<N>( s, 1, vcoeffH, voffsetH, vshiftH );
+    }
+    for( int row = 0; row < height; row++, s += srcStride, d += dstStride )
+    {
+      vrow[N - 1] = full ? xFilter8_SSE<N>( s, 1, vcoeffH, voffsetH, vshiftH ) : xFilter4_SSE<N>( s, 1, vcoeffH, voffsetH, vshiftH );
+
+      __m128i vres = xFilterRows8_SSE<N>( vrow, vcoeffV, voffsetV, vshiftV );
+      if( isLast )
+      {
+        vres = _mm_min_epi16( vmax, _mm_max_epi16( vmin, vres ) );
+      }
+      if( full )
+      {
+        _mm_storeu_si128( ( __m128i* ) d, vres );
+      }
+      else
+      {
+        _mm_storel_epi64( ( __m128i* ) d, vres );
+      }
+
+      for( int k = 0; k < N - 1; k++ )
+      {
+        vrow[k] = vrow[k + 1];
+      }
+    }
+  }
+
+  for( ; col < width; col++ )
+  {
+    Pel tmp[MAX_CU_SIZE + N - 1];
+
+    for( int row = 0; row < height + N - 1; row++ )
+    {
+      tmp[row] = xFilterScalar<N>( src + row * srcStride + col, 1, coeffH, offsetH, shiftH );
+    }
+    for( int row = 0; row < height; row++ )
+    {
+      const Pel val = xFilterScalar<N>( tmp + row, 1, coeffV, offsetV, shiftV );
+      dst[row * dstStride + col] = isLast ? ClipPel( val, clpRng ) : val;
+    }
+  }
+}
+
+template<X86_VEXT vext, int N, bool isLast>
+static void simdFilter2D( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeffH, TFilterCoeff const *coeffV, bool biMCForDMVR )
+{
+  CHECK( height > MAX_CU_SIZE, "Unsupported block size" );
+
+  if( N == 8 && coeffH[0] == 0 && coeffH[7] == 0 && coeffV[0] == 0 && coeffV[7] == 0 )
+  {
+    simdFilter2DN<vext, 6, isLast>( clpRng, src - 2 * srcStride - 2, srcStride, dst, dstStride, width, height, coeffH + 1, coeffV + 1, biMCForDMVR );
+  }
+  else
+  {
+    simdFilter2DN<vext, N, isLast>( clpRng, src - ( N / 2 - 1 ) * ( srcStride + 1 ), srcStride, dst, dstStride, width, height, coeffH, coeffV, biMCForDMVR );
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// integer positions
+// --------------------------------------------------------------------------------------------------------------------
+
+template<X86_VEXT vext, bool isFirst, bool isLast>
+static void simdFilterCopy( const ClpRng& clpRng, const Pel *src, int srcStride, Pel *dst, int dstStride, int width, int height, bool biMCForDMVR )
+{
+  if( isFirst == isLast )
+  {
+    for( int row = 0; row < height; row++, src += srcStride, dst += dstStride )
+    {
+      memcpy( dst, src, width * sizeof( Pel ) );
+    }
+    return;
+  }
+
+  const int shift = std::max<int>( 2, ( IF_INTERNAL_PREC - clpRng.bd ) );
+
+  if( biMCForDMVR )
+  {
+    // samples are rounded down to / scaled up to 10 bit, in 16 bit precision (up to 14 bit input)
+    const bool    down    = clpRng.bd > IF_INTERNAL_PREC_BILINEAR;
+    const int     sh      = down ? clpRng.bd - IF_INTERNAL_PREC_BILINEAR : IF_INTERNAL_PREC_BILINEAR - clpRng.bd;
+    const __m128i vsh     = _mm_cvtsi32_si128( sh );
+    const __m128i voffset = _mm_set1_epi16( down ? 1 << ( sh - 1 ) : 0 );
+
+    for( int row = 0; row < height; row++, src += srcStride, dst += dstStride )
+    {
+      int col = 0;
+      for( ; col + 8 <= width; col += 8 )
+      {
+        const __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &src[col] );
+        _mm_storeu_si128( ( __m128i* ) &dst[col], down ? _mm_sra_epi16( _mm_add_epi16( vsrc, voffset ), vsh ) : _mm_sll_epi16( vsrc, vsh ) );
+      }
+      for( ; col < width; col++ )
+      {
+        dst[col] = down ? ( src[col] + ( 1 << ( sh - 1 ) ) ) >> sh : src[col] << sh;
+      }
+    }
+  }
+  else if( isFirst )
+  {
+    const __m128i vshift  = _mm_cvtsi32_si128( shift );
+    const __m128i voffset = _mm_set1_epi16( IF_INTERNAL_OFFS );
+
+    for( int row = 0; row < height; row++, src += srcStride, dst += dstStride )
+    {
+      int col = 0;
+      for( ; col + 8 <= width; col += 8 )
+      {
+        const __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &src[col] );
+        _mm_storeu_si128( ( __m128i* ) &dst[col], _mm_sub_epi16( _mm_sll_epi16( vsrc, vshift ), voffset ) );
+      }
+      for( ; col + 4 <= width; col += 4 )
+      {
+        const __m128i vsrc = _mm_loadl_epi64( ( const __m128i* ) &src[col] );
+        _mm_storel_epi64( ( __m128i* ) &dst[col], _mm_sub_epi16( _mm_sll_epi16( vsrc, vshift ), voffset ) );
+      }
+      for( ; col < width; col++ )
+      {
+        const Pel val = leftShift_round( src[col], shift );
+        dst[col] = val - ( Pel ) IF_INTERNAL_OFFS;
+      }
+    }
+  }
+  else
+  {
+    // the rounding is done in 32 bit as the offset may exceed the 16 bit range
+    const __m128i vshift  = _mm_cvtsi32_si128( shift );
+    const __m128i voffset = _mm_set1_epi32( IF_INTERNAL_OFFS + ( 1 << ( shift - 1 ) ) );
+    const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+    const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+
+    for( int row = 0; row < height; row++, src += srcStride, dst += dstStride )
+    {
+      int col = 0;
+      for( ; col + 8 <= width; col += 8 )
+      {
+        const __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &src[col] );
+        const __m128i vlo  = _mm_sra_epi32( _mm_add_epi32( _mm_cvtepi16_epi32( vsrc ), voffset ), vshift );
+        const __m128i vhi  = _mm_sra_epi32( _mm_add_epi32( _mm_cvtepi16_epi32( _mm_unpackhi_epi64( vsrc, vsrc ) ), voffset ), vshift );
+        _mm_storeu_si128( ( __m128i* ) &dst[col], _mm_min_epi16( vmax, _mm_max_epi16( vmin, _mm_packs_epi32( vlo, vhi ) ) ) );
+      }
+      for( ; col + 4 <= width; col += 4 )
+      {
+        const __m128i vsrc = _mm_loadl_epi64( ( const __m128i* ) &src[col] );
+        const __m128i vlo  = _mm_sra_epi32( _mm_add_epi32( _mm_cvtepi16_epi32( vsrc ), voffset ), vshift );
+        _mm_storel_epi64( ( __m128i* ) &dst[col], _mm_min_epi16( vmax, _mm_max_epi16( vmin, _mm_packs_epi32( vlo, vlo ) ) ) );
+      }
+      for( ; col < width; col++ )
+      {
+        const Pel val = rightShift_round( ( src[col] + IF_INTERNAL_OFFS ), shift );
+        dst[col] = ClipPel( val, clpRng );
+      }
+    }
+  }
+}
+
+#if JVET_Q0806
+// GEO weights of eight (or four) neighbouring samples of a row, read from the prestored mask with a horizontal step of
+// +-1 (luma and 4:4:4 chroma) or +-2 (subsampled chroma); mirrored masks are read backwards and reversed in register
+static inline __m128i xGeoWeights8( const int16_t* w, const int stepX )
+{
+  const __m128i vrev = _mm_setr_epi8( 14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1 );
+  const __m128i vlo  = _mm_set1_epi32( 0xffff );
+
+  switch( stepX )
+  {
+  case 1:
+    return _mm_loadu_si128( ( const __m128i* ) w );
+  case -1:
+    return _mm_shuffle_epi8( _mm_loadu_si128( ( const __m128i* ) &w[-7] ), vrev );
+  case 2:
+    return _mm_packus_epi32( _mm_and_si128( _mm_loadu_si128( ( const __m128i* ) w ), vlo ), _mm_and_si128( _mm_loadu_si128( ( const __m128i* ) &w[8] ), vlo ) );
+  default:
+    return _mm_shuffle_epi8( _mm_packus_epi32( _mm_srli_epi32( _mm_loadu_si128( ( const __m128i* ) &w[-15] ), 16 ), _mm_srli_epi32( _mm_loadu_si128( ( const __m128i* ) &w[-7] ), 16 ) ), vrev );
+  }
+}
+
+static inline __m128i xGeoWeights4( const int16_t* w, const int stepX )
+{
+  const __m128i vrev = _mm_setr_epi8( 6, 7, 4, 5, 2, 3, 0, 1, 6, 7, 4, 5, 2, 3, 0, 1 );
+
+  switch( stepX )
+  {
+  case 1:
+    return _mm_loadl_epi64( ( const __m128i* ) w );
+  case -1:
+    return _mm_shuffle_epi8( _mm_loadl_epi64( ( const __m128i* ) &w[-3] ), vrev );
+  case 2:
+  {
+    const __m128i v = _mm_and_si128( _mm_loadu_si128( ( const __m128i* ) w ), _mm_set1_epi32( 0xffff ) );
+    return _mm_packus_epi32( v, v );
+  }
+  default:
+  {
+    const __m128i v = _mm_srli_epi32( _mm_loadu_si128( ( const __m128i* ) &w[-7] ), 16 );
+    return _mm_shuffle_epi8( _mm_packus_epi32( v, v ), vrev );
+  }
+  }
+}
+
+// ( w * src0 + ( 8 - w ) * src1 + offset ) >> shift for the low and high half of the vectors
+template<X86_VEXT vext>
+static inline __m128i xGeoBlend( const __m128i& vsrc0, const __m128i& vsrc1, const __m128i& vw, const __m128i& voffset, const int shift )
+{
+  const __m128i vw1 = _mm_sub_epi16( _mm_set1_epi16( 8 ), vw );
+  __m128i vlo = _mm_madd_epi16( _mm_unpacklo_epi16( vsrc0, vsrc1 ), _mm_unpacklo_epi16( vw, vw1 ) );
+  __m128i vhi = _mm_madd_epi16( _mm_unpackhi_epi16( vsrc0, vsrc1 ), _mm_unpackhi_epi16( vw, vw1 ) );
+  vlo = _mm_srai_epi32( _mm_add_epi32( vlo, voffset ), shift );
+  vhi = _mm_srai_epi32( _mm_add_epi32( vhi, voffset ), shift );
+  return _mm_packs_epi32( vlo, vhi );
+}
+
+template<X86_VEXT vext>
+static void xWeightedGeoBlk_SSE( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel* dst, int dstStride, int width, int height,
+                                 const int16_t* weight, const int stepX, const int stepY, const int shift, const int offset, const ClpRng& clpRng )
+{
+  const __m128i voffset = _mm_set1_epi32( offset );
+  const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+  const int     rowStep = stepX * width + stepY;
+#ifdef USE_AVX2
+  const __m256i voffset256 = _mm256_set1_epi32( offset );
+  const __m256i veight256  = _mm256_set1_epi16( 8 );
+  const __m256i vmin256    = _mm256_set1_epi16( clpRng.min );
+  const __m256i vmax256    = _mm256_set1_epi16( clpRng.max );
+#endif
+
+  for( int y = 0; y < height; y++ )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i vsrc0 = _mm256_loadu_si256( ( const __m256i* ) &src0[x] );
+        const __m256i vsrc1 = _mm256_loadu_si256( ( const __m256i* ) &src1[x] );
+        const __m256i vw    = _mm256_inserti128_si256( _mm256_castsi128_si256( xGeoWeights8( &weight[x * stepX], stepX ) ), xGeoWeights8( &weight[( x + 8 ) * stepX], stepX ), 1 );
+        const __m256i vw1   = _mm256_sub_epi16( veight256, vw );
+        __m256i vlo = _mm256_madd_epi16( _mm256_unpacklo_epi16( vsrc0, vsrc1 ), _mm256_unpacklo_epi16( vw, vw1 ) );
+        __m256i vhi = _mm256_madd_epi16( _mm256_unpackhi_epi16( vsrc0, vsrc1 ), _mm256_unpackhi_epi16( vw, vw1 ) );
+        vlo = _mm256_srai_epi32( _mm256_add_epi32( vlo, voffset256 ), shift );
+        vhi = _mm256_srai_epi32( _mm256_add_epi32( vhi, voffset256 ), shift );
+        _mm256_storeu_si256( ( __m256i* ) &dst[x], _mm256_min_epi16( vmax256, _mm256_max_epi16( vmin256, _mm256_packs_epi32( vlo, vhi ) ) ) );
+      }
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i vres = xGeoBlend<vext>( _mm_loadu_si128( ( const __m128i* ) &src0[x] ), _mm_loadu_si128( ( const __m128i* ) &src1[x] ), xGeoWeights8( &weight[x * stepX], stepX ), voffset, shift );
+      _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_min_epi16( vmax, _mm_max_epi16( vmin, vres ) ) );
+    }
+    if( x < width )
+    {
+      const __m128i vres = xGeoBlend<vext>( _mm_loadl_epi64( ( const __m128i* ) &src0[x] ), _mm_loadl_epi64( ( const __m128i* ) &src1[x] ), xGeoWeights4( &weight[x * stepX], stepX ), voffset, shift );
+      _mm_storel_epi64( ( __m128i* ) &dst[x], _mm_min_epi16( vmax, _mm_max_epi16( vmin, vres ) ) );
+    }
+    src0   += src0Stride;
+    src1   += src1Stride;
+    dst    += dstStride;
+    weight += rowStep;
+  }
+}
+
+template<X86_VEXT vext>
+static void simdWeightedGeoBlk( const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1 )
+{
+  if( ( width & 3 ) != 0 )
+  {
+    InterpolationFilter::xWeightedGeoBlk( pu, width, height, compIdx, splitDir, predDst, predSrc0, predSrc1 );
+    return;
+  }
+
+  const ClpRng& clpRng = pu.cu->slice->clpRngs().comp[compIdx];
+  const int     shift  = std::max<int>( 2, ( IF_INTERNAL_PREC - clpRng.bd ) ) + 3;
+  const int     offset = ( 1 << ( shift - 1 ) ) + ( IF_INTERNAL_OFFS << 3 );
+
+  int stepX = 0;
+  int stepY = 0;
+  const int16_t* weight = InterpolationFilter::xGetGeoWeights( pu, compIdx, splitDir, stepX, stepY );
+
+  const PelBuf dst  = predDst .get( compIdx );
+  const PelBuf src0 = predSrc0.get( compIdx );
+  const PelBuf src1 = predSrc1.get( compIdx );
+
+  xWeightedGeoBlk_SSE<vext>( src0.buf, src0.stride, src1.buf, src1.stride, dst.buf, dst.stride, width, height, weight, stepX, stepY, shift, offset, clpRng );
+}
+#endif
+
+template <X86_VEXT vext>
+void InterpolationFilter::_initInterpolationFilterX86()
+{
+  m_filterHor[0][0][0] = simdFilter<vext, 8, false, false, false>;
+  m_filterHor[0][0][1] = simdFilter<vext, 8, false, false, true>;
+  m_filterHor[0][1][0] = simdFilter<vext, 8, false, true, false>;
+  m_filterHor[0][1][1] = simdFilter<vext, 8, false, true, true>;
+
+  m_filterHor[1][0][0] = simdFilter<vext, 4, false, false, false>;
+  m_filterHor[1][0][1] = simdFilter<vext, 4, false, false, true>;
+  m_filterHor[1][1][0] = simdFilter<vext, 4, false, true, false>;
+  m_filterHor[1][1][1] = simdFilter<vext, 4, false, true, true>;
+
+  m_filterHor[2][0][0] = simdFilter<vext, 2, false, false, false>;
+  m_filterHor[2][0][1] = simdFilter<vext, 2, false, false, true>;
+  m_filterHor[2][1][0] = simdFilter<vext, 2, false, true, false>;
+  m_filterHor[2][1][1] = simdFilter<vext, 2, false, true, true>;
+
+  m_filterVer[0][0][0] = simdFilter<vext, 8, true, false, false>;
+  m_filterVer[0][0][1] = simdFilter<vext, 8, true, false, true>;
+  m_filterVer[0][1][0] = simdFilter<vext, 8, true, true, false>;
+  m_filterVer[0][1][1] = simdFilter<vext, 8, true, true, true>;
+
+  m_filterVer[1][0][0] = simdFilter<vext, 4, true, false, false>;
+  m_filterVer[1][0][1] = simdFilter<vext, 4, true, false, true>;
+  m_filterVer[1][1][0] = simdFilter<vext, 4, true, true, false>;
+  m_filterVer[1][1][1] = simdFilter<vext, 4, true, true, true>;
+
+  m_filterVer[2][0][0] = simdFilter<vext, 2, true, false, false>;
+  m_filterVer[2][0][1] = simdFilter<vext, 2, true, false, true>;
+  m_filterVer[2][1][0] = simdFilter<vext, 2, true, true, false>;
+  m_filterVer[2][1][1] = simdFilter<vext, 2, true, true, true>;
+
+  m_filterCopy[0][0]   = simdFilterCopy<vext, false, false>;
+  m_filterCopy[0][1]   = simdFilterCopy<vext, false, true>;
+  m_filterCopy[1][0]   = simdFilterCopy<vext, true, false>;
+  m_filterCopy[1][1]   = simdFilterCopy<vext, true, true>;
+
+  m_filter2D[0][0]     = simdFilter2D<vext, 8, false>;
+  m_filter2D[0][1]     = simdFilter2D<vext, 8, true>;
+  m_filter2D[1][0]     = simdFilter2D<vext, 4, false>;
+  m_filter2D[1][1]     = simdFilter2D<vext, 4, true>;
+  m_filter2D[2][0]     = simdFilter2D<vext, 2, false>;
+  m_filter2D[2][1]     = simdFilter2D<vext, 2, true>;
+
+#if JVET_Q0806
+  m_weightedGeoBlk     = simdWeightedGeoBlk<vext>;
+#endif
+}
+
+template void InterpolationFilter::_initInterpolationFilterX86<SIMDX86>();
+
+//! \}
+
+#endif //TARGET_SIMD_X86
@@ -0,0 +1,634 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     IntraPredictionX86.h
+    \brief    planar, angular and PDPC kernels of IntraPredOps, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../IntraPrediction.h"
+#include "../InterpolationFilter.h"
+
+#if ENABLE_SIMD_OPT_INTRA
+#ifdef TARGET_SIMD_X86
+
+//! \ingroup CommonLib
+//! \{
+
+static_assert( sizeof( Pel ) == 2, "The SIMD intra prediction expects 16 bit samples" );
+
+// All kernels work on power of two rows of at least 4 samples; blocks with 1 or 2 sample rows (transposed Nx2 chroma
+// and ISP sub-partitions) are handed to the C code.
+// The PDPC weights are at most 32, so (w * d + 32) >> 6 is evaluated exactly as _mm_mulhrs_epi16( d, w << 9 ).
+
+static ALWAYS_INLINE __m128i xIntraClip( __m128i v, const __m128i& vMin, const __m128i& vMax )
+{
+  return _mm_min_epi16( vMax, _mm_max_epi16( vMin, v ) );
+}
+
+static ALWAYS_INLINE __m128i xIntraCoeffPair( int c0, int c1 )
+{
+  return _mm_set1_epi32( ( c0 & 0xffff ) | ( c1 << 16 ) );
+}
+
+template<X86_VEXT vext>
+static void intraPredPlanar_SSE( const Pel* top, const Pel* left, Pel* dst, int dstStride, int width, int height )
+{
+  if( width & 3 )
+  {
+    intraPredPlanarCore( top, left, dst, dstStride, width, height );
+    return;
+  }
+
+  const int log2W      = floorLog2( width );
+  const int log2H      = floorLog2( height );
+  const int finalShift = 1 + log2W + log2H;
+  const int topRight   = top[width];
+  const int bottomLeft = left[height];
+
+  // the vertical and horizontal interpolations are kept pre-shifted, the sum of both is the C code's numerator
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int vertPred[MAX_CU_SIZE] );
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int vertStep[MAX_CU_SIZE] );
+
+  for( int x = 0; x < width; x++ )
+  {
+    vertStep[x] = ( bottomLeft - top[x] ) << log2W;
+    vertPred[x] = ( top[x] << ( log2H + log2W ) ) + vertStep[x];
+  }
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && width >= 16 )
+  {
+    const __m256i vOffset = _mm256_set1_epi32( 1 << ( log2W + log2H ) );
+    const __m256i vIdx    = _mm256_setr_epi32( 1, 2, 3, 4, 5, 6, 7, 8 );
+
+    for( int y = 0; y < height; y++, dst += dstStride )
+    {
+      const __m256i vStep = _mm256_set1_epi32( ( topRight - left[y] ) << log2H );
+      const __m256i vStep8 = _mm256_slli_epi32( vStep, 3 );
+      __m256i       vHor  = _mm256_add_epi32( _mm256_set1_epi32( left[y] << ( log2W + log2H ) ), _mm256_mullo_epi32( vIdx, vStep ) );
+
+      for( int x = 0; x < width; x += 16 )
+      {
+        __m256i vVer0 = _mm256_load_si256( ( const __m256i* ) &vertPred[x] );
+        __m256i vVer1 = _mm256_load_si256( ( const __m256i* ) &vertPred[x + 8] );
+
+        __m256i vSum0 = _mm256_srai_epi32( _mm256_add_epi32( _mm256_add_epi32( vHor, vVer0 ), vOffset ), finalShift );
+        vHor          = _mm256_add_epi32( vHor, vStep8 );
+        __m256i vSum1 = _mm256_srai_epi32( _mm256_add_epi32( _mm256_add_epi32( vHor, vVer1 ), vOffset ), finalShift );
+        vHor          = _mm256_add_epi32( vHor, vStep8 );
+
+        _mm256_storeu_si256( ( __m256i* ) &dst[x], _mm256_permute4x64_epi64( _mm256_packs_epi32( vSum0, vSum1 ), 0xd8 ) );
+
+        _mm256_store_si256( ( __m256i* ) &vertPred[x],     _mm256_add_epi32( vVer0, _mm256_load_si256( ( const __m256i* ) &vertStep[x] ) ) );
+        _mm256_store_si256( ( __m256i* ) &vertPred[x + 8], _mm256_add_epi32( vVer1, _mm256_load_si256( ( const __m256i* ) &vertStep[x + 8] ) ) );
+      }
+    }
+    return;
+  }
+#endif
+
+  const __m128i vOffset = _mm_set1_epi32( 1 << ( log2W + log2H ) );
+  const __m128i vIdx    = _mm_setr_epi32( 1, 2, 3, 4 );
+
+  for( int y = 0; y < height; y++, dst += dstStride )
+  {
+    const __m128i vStep  = _mm_set1_epi32( ( topRight - left[y] ) << log2H );
+    const __m128i vStep4 = _mm_slli_epi32( vStep, 2 );
+    __m128i       vHor   = _mm_add_epi32( _mm_set1_epi32( left[y] << ( log2W + log2H ) ), _mm_mullo_epi32( vIdx, vStep ) );
+
+    for( int x = 0; x < width; x += 4 )
+    {
+      __m128i vVer = _mm_load_si128( ( const __m128i* ) &vertPred[x] );
+      __m128i vSum = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( vHor, vVer ), vOffset ), finalShift );
+      vHor         = _mm_add_epi32( vHor, vStep4 );
+
+      _mm_storel_epi64( ( __m128i* ) &dst[x], _mm_packs_epi32( vSum, vSum ) );
+      _mm_store_si128( ( __m128i* ) &vertPred[x], _mm_add_epi32( vVer, _mm_load_si128( ( const __m128i* ) &vertStep[x] ) ) );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void intraPdpcPlanarDc_SSE( const Pel* top, const Pel* left, Pel* dst, int dstStride, int width, int height, int scale )
+{
+  if( width & 3 )
+  {
+    intraPdpcPlanarDcCore( top, left, dst, dstStride, width, height, scale );
+    return;
+  }
+
+  // the left weights vanish from x = 3 << scale on, the rows below y = 3 << scale only need the first columns
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, Pel wL[MAX_CU_SIZE] );
+
+  for( int x = 0; x < width; x++ )
+  {
+    wL[x] = 32 >> std::min( 31, ( ( x << 1 ) >> scale ) );
+  }
+
+  const int numLeftCols = std::min( width, ( ( 3 << scale ) + 7 ) & ~7 );
+  const __m128i v32     = _mm_set1_epi32( 32 );
+
+  for( int y = 0; y < height; y++, dst += dstStride )
+  {
+    const int     wT    = 32 >> std::min( 31, ( ( y << 1 ) >> scale ) );
+    const int     xEnd  = wT ? width : numLeftCols;
+    const __m128i vWT   = _mm_set1_epi16( wT );
+    const __m128i vLeft = _mm_set1_epi16( left[y] );
+
+    if( xEnd == 4 )
+    {
+      __m128i vVal = _mm_loadl_epi64( ( const __m128i* ) dst );
+      __m128i vTop = _mm_loadl_epi64( ( const __m128i* ) top );
+      __m128i vW   = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) wL ), vWT );
+      __m128i vD   = _mm_unpacklo_epi16( _mm_sub_epi16( vLeft, vVal ), _mm_sub_epi16( vTop, vVal ) );
+      __m128i vRes = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( vD, vW ), v32 ), 6 );
+
+      _mm_storel_epi64( ( __m128i* ) dst, _mm_add_epi16( vVal, _mm_packs_epi32( vRes, vRes ) ) );
+      continue;
+    }
+
+    for( int x = 0; x < xEnd; x += 8 )
+    {
+      __m128i vVal = _mm_loadu_si128( ( const __m128i* ) &dst[x] );
+      __m128i vTop = _mm_loadu_si128( ( const __m128i* ) &top[x] );
+      __m128i vWgt = _mm_load_si128( ( const __m128i* ) &wL[x] );
+      __m128i vDL  = _mm_sub_epi16( vLeft, vVal );
+      __m128i vDT  = _mm_sub_epi16( vTop, vVal );
+
+      __m128i vLo = _mm_madd_epi16( _mm_unpacklo_epi16( vDL, vDT ), _mm_unpacklo_epi16( vWgt, vWT ) );
+      __m128i vHi = _mm_madd_epi16( _mm_unpackhi_epi16( vDL, vDT ), _mm_unpackhi_epi16( vWgt, vWT ) );
+      vLo         = _mm_srai_epi32( _mm_add_epi32( vLo, v32 ), 6 );
+      vHi         = _mm_srai_epi32( _mm_add_epi32( vHi, v32 ), 6 );
+
+      _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_add_epi16( vVal, _mm_packs_epi32( vLo, vHi ) ) );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void intraPredAngLuma_SSE( const Pel* refMain, Pel* dst, int dstStride, int width, int height, int deltaPos, int intraPredAngle, bool useCubicFilter, const ClpRng& clpRng )
+{
+  if( width & 3 )
+  {
+    intraPredAngLumaCore( refMain, dst, dstStride, width, height, deltaPos, intraPredAngle, useCubicFilter, clpRng );
+    return;
+  }
+
+  const __m128i vMin = _mm_set1_epi16( clpRng.min );
+  const __m128i vMax = _mm_set1_epi16( clpRng.max );
+  const __m128i v32  = _mm_set1_epi32( 32 );
+
+  for( int y = 0; y < height; y++, deltaPos += intraPredAngle, dst += dstStride )
+  {
+    const int deltaInt   = deltaPos >> 5;
+    const int deltaFract = deltaPos & 31;
+
+    const TFilterCoeff        intraSmoothingFilter[4] = { TFilterCoeff( 16 - ( deltaFract >> 1 ) ), TFilterCoeff( 32 - ( deltaFract >> 1 ) ), TFilterCoeff( 16 + ( deltaFract >> 1 ) ), TFilterCoeff( deltaFract >> 1 ) };
+    const TFilterCoeff* const f                       = useCubicFilter ? InterpolationFilter::getChromaFilterTable( deltaFract ) : intraSmoothingFilter;
+
+    const __m128i vC01 = xIntraCoeffPair( f[0], f[1] );
+    const __m128i vC23 = xIntraCoeffPair( f[2], f[3] );
+    const Pel*    ref  = refMain + deltaInt;
+
+    if( width == 4 )
+    {
+      __m128i vP01 = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) &ref[0] ), _mm_loadl_epi64( ( const __m128i* ) &ref[1] ) );
+      __m128i vP23 = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) &ref[2] ), _mm_loadl_epi64( ( const __m128i* ) &ref[3] ) );
+      __m128i vSum = _mm_add_epi32( _mm_madd_epi16( vP01, vC01 ), _mm_madd_epi16( vP23, vC23 ) );
+      vSum         = _mm_srai_epi32( _mm_add_epi32( vSum, v32 ), 6 );
+
+      _mm_storel_epi64( ( __m128i* ) dst, xIntraClip( _mm_packs_epi32( vSum, vSum ), vMin, vMax ) );
+      continue;
+    }
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 && width >= 16 )
+    {
+      const __m256i vC01w = _mm256_broadcastsi128_si256( vC01 );
+      const __m256i vC23w = _mm256_broadcastsi128_si256( vC23 );
+      const __m256i v32w  = _mm256_set1_epi32( 32 );
+      const __m256i vMinw = _mm256_set1_epi16( clpRng.min );
+      const __m256i vMaxw = _mm256_set1_epi16( clpRng.max );
+
+      for( int x = 0; x < width; x += 16 )
+      {
+        __m256i vP0 = _mm256_loadu_si256( ( const __m256i* ) &ref[x] );
+        __m256i vP1 = _mm256_loadu_si256( ( const __m256i* ) &ref[x + 1] );
+        __m256i vP2 = _mm256_loadu_si256( ( const __m256i* ) &ref[x + 2] );
+        __m256i vP3 = _mm256_loadu_si256( ( const __m256i* ) &ref[x + 3] );
+
+        __m256i vLo = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( vP0, vP1 ), vC01w ), _mm256_madd_epi16( _mm256_unpacklo_epi16( vP2, vP3 ), vC23w ) );
+        __m256i vHi = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( vP0, vP1 ), vC01w ), _mm256_madd_epi16( _mm256_unpackhi_epi16( vP2, vP3 ), vC23w ) );
+        vLo         = _mm256_srai_epi32( _mm256_add_epi32( vLo, v32w ), 6 );
+        vHi         = _mm256_srai_epi32( _mm256_add_epi32( vHi, v32w ), 6 );
+
+        __m256i vRes = _mm256_min_epi16( vMaxw, _mm256_max_epi16( vMinw, _mm256_packs_epi32( vLo, vHi ) ) );
+        _mm256_storeu_si256( ( __m256i* ) &dst[x], vRes );
+      }
+      continue;
+    }
+#endif
+
+    for( int x = 0; x < width; x += 8 )
+    {
+      __m128i vP0 = _mm_loadu_si128( ( const __m128i* ) &ref[x] );
+      __m128i vP1 = _mm_loadu_si128( ( const __m128i* ) &ref[x + 1] );
+      __m128i vP2 = _mm_loadu_si128( ( const __m128i* ) &ref[x + 2] );
+      __m128i vP3 = _mm_loadu_si128( ( const __m128i* ) &ref[x + 3] );
+
+      __m128i vLo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vP0, vP1 ), vC01 ), _mm_madd_epi16( _mm_unpacklo_epi16( vP2, vP3 ), vC23 ) );
+      __m128i vHi = _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vP0, vP1 ), vC01 ), _mm_madd_epi16( _mm_unpackhi_epi16( vP2, vP3 ), vC23 ) );
+      vLo         = _mm_srai_epi32( _mm_add_epi32( vLo, v32 ), 6 );
+      vHi         = _mm_srai_epi32( _mm_add_epi32( vHi, v32 ), 6 );
+
+      _mm_storeu_si128( ( __m128i* ) &dst[x], xIntraClip( _mm_packs_epi32( vLo, vHi ), vMin, vMax ) );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void intraPredAngChroma_SSE( const Pel* refMain, Pel* dst, int dstStride, int width, int height, int deltaPos, int intraPredAngle )
+{
+  if( width & 3 )
+  {
+    intraPredAngChromaCore( refMain, dst, dstStride, width, height, deltaPos, intraPredAngle );
+    return;
+  }
+
+  // p0 + ( ( f * ( p1 - p0 ) + 16 ) >> 5 ) == ( ( 32 - f ) * p0 + f * p1 + 16 ) >> 5, evaluated in 32 bit
+  const __m128i v16 = _mm_set1_epi32( 16 );
+
+  for( int y = 0; y < height; y++, deltaPos += intraPredAngle, dst += dstStride )
+  {
+    const int     deltaInt   = deltaPos >> 5;
+    const int     deltaFract = deltaPos & 31;
+    const __m128i vC         = xIntraCoeffPair( 32 - deltaFract, deltaFract );
+    const Pel*    ref        = refMain + deltaInt + 1;
+
+    if( width == 4 )
+    {
+      __m128i vP   = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) &ref[0] ), _mm_loadl_epi64( ( const __m128i* ) &ref[1] ) );
+      __m128i vSum = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( vP, vC ), v16 ), 5 );
+
+      _mm_storel_epi64( ( __m128i* ) dst, _mm_packs_epi32( vSum, vSum ) );
+      continue;
+    }
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 && width >= 16 )
+    {
+      const __m256i vCw  = _mm256_broadcastsi128_si256( vC );
+      const __m256i v16w = _mm256_set1_epi32( 16 );
+
+      for( int x = 0; x < width; x += 16 )
+      {
+        __m256i vP0 = _mm256_loadu_si256( ( const __m256i* ) &ref[x] );
+        __m256i vP1 = _mm256_loadu_si256( ( const __m256i* ) &ref[x + 1] );
+
+        __m256i vLo = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( vP0, vP1 ), vCw ), v16w ), 5 );
+        __m256i vHi = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( vP0, vP1 ), vCw ), v16w ), 5 );
+
+        _mm256_storeu_si256( ( __m256i* ) &dst[x], _mm256_packs_epi32( vLo, vHi ) );
+      }
+      continue;
+    }
+#endif
+
+    for( int x = 0; x < width; x += 8 )
+    {
+      __m128i vP0 = _mm_loadu_si128( ( const __m128i* ) &ref[x] );
+      __m128i vP1 = _mm_loadu_si128( ( const __m128i* ) &ref[x + 1] );
+
+      __m128i vLo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vP0, vP1 ), vC ), v16 ), 5 );
+      __m128i vHi = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vP0, vP1 ), vC ), v16 ), 5 );
+
+      _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_packs_epi32( vLo, vHi ) );
+    }
+  }
+}
+
+// PDPC weights ( 32 >> ( 2 * x >> scale ) ) << 9 for x < min( 3 << scale, width ), zero up to the returned column count,
+// the callers load whole vectors of w and zero-initialise it beyond that
+static int xIntraPdpcAngWeights( Pel* w, int width, int scale )
+{
+  const int numCols = std::min( 3 << scale, width );
+  const int numVec  = width == 4 ? 4 : std::min( width, ( numCols + 7 ) & ~7 );
+
+  for( int x = 0; x < numVec; x++ )
+  {
+    w[x] = x < numCols ? ( 32 >> ( 2 * x >> scale ) ) << 9 : 0;
+  }
+  return numVec;
+}
+
+template<X86_VEXT vext>
+static void intraPdpcHorVer_SSE( const Pel* refSide, Pel topLeft, Pel* dst, int dstStride, int width, int height, int scale, const ClpRng& clpRng )
+{
+  if( ( width & 3 ) || std::min( 3 << scale, width ) > 16 )
+  {
+    intraPdpcHorVerCore( refSide, topLeft, dst, dstStride, width, height, scale, clpRng );
+    return;
+  }
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, Pel w[16] ) = { 0 };
+  const int numVec = xIntraPdpcAngWeights( w, width, scale );
+
+  const __m128i vMin = _mm_set1_epi16( clpRng.min );
+  const __m128i vMax = _mm_set1_epi16( clpRng.max );
+  const __m128i vW0  = _mm_load_si128( ( const __m128i* ) &w[0] );
+  const __m128i vW1  = _mm_load_si128( ( const __m128i* ) &w[8] );
+
+  for( int y = 0; y < height; y++, dst += dstStride )
+  {
+    const __m128i vD = _mm_set1_epi16( refSide[1 + y] - topLeft );
+
+    if( numVec == 4 )
+    {
+      __m128i vVal = _mm_add_epi16( _mm_loadl_epi64( ( const __m128i* ) dst ), _mm_mulhrs_epi16( vD, vW0 ) );
+      _mm_storel_epi64( ( __m128i* ) dst, xIntraClip( vVal, vMin, vMax ) );
+      continue;
+    }
+
+    __m128i vVal = _mm_add_epi16( _mm_loadu_si128( ( const __m128i* ) dst ), _mm_mulhrs_epi16( vD, vW0 ) );
+    _mm_storeu_si128( ( __m128i* ) dst, xIntraClip( vVal, vMin, vMax ) );
+
+    if( numVec == 16 )
+    {
+      vVal = _mm_add_epi16( _mm_loadu_si128( ( const __m128i* ) &dst[8] ), _mm_mulhrs_epi16( vD, vW1 ) );
+      _mm_storeu_si128( ( __m128i* ) &dst[8], xIntraClip( vVal, vMin, vMax ) );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void intraPdpcAng_SSE( const Pel* refSide, Pel* dst, int dstStride, int width, int height, int scale, int invAngle )
+{
+  if( ( width & 3 ) || std::min( 3 << scale, width ) > 16 )
+  {
+    intraPdpcAngCore( refSide, dst, dstStride, width, height, scale, invAngle );
+    return;
+  }
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, Pel w[16] )    = { 0 };
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, Pel left[16] ) = { 0 };
+  int       leftIdx[16];
+  const int numVec  = xIntraPdpcAngWeights( w, width, scale );
+  const int numCols = std::min( 3 << scale, width );
+
+  for( int x = 0, invAngleSum = 256; x < numCols; x++ )
+  {
+    invAngleSum += invAngle;
+    leftIdx[x] = ( invAngleSum >> 9 ) + 1;
+  }
+
+  const __m128i vW0 = _mm_load_si128( ( const __m128i* ) &w[0] );
+  const __m128i vW1 = _mm_load_si128( ( const __m128i* ) &w[8] );
+
+  for( int y = 0; y < height; y++, dst += dstStride )
+  {
+    // the projected left samples are not contiguous, gather them first
+    for( int x = 0; x < numCols; x++ )
+    {
+      left[x] = refSide[y + leftIdx[x]];
+    }
+
+    if( numVec == 4 )
+    {
+      __m128i vVal = _mm_loadl_epi64( ( const __m128i* ) dst );
+      __m128i vD   = _mm_sub_epi16( _mm_loadl_epi64( ( const __m128i* ) left ), vVal );
+      _mm_storel_epi64( ( __m128i* ) dst, _mm_add_epi16( vVal, _mm_mulhrs_epi16( vD, vW0 ) ) );
+      continue;
+    }
+
+    __m128i vVal = _mm_loadu_si128( ( const __m128i* ) dst );
+    __m128i vD   = _mm_sub_epi16( _mm_load_si128( ( const __m128i* ) &left[0] ), vVal );
+    _mm_storeu_si128( ( __m128i* ) dst, _mm_add_epi16( vVal, _mm_mulhrs_epi16( vD, vW0 ) ) );
+
+    if( numVec == 16 )
+    {
+      vVal = _mm_loadu_si128( ( const __m128i* ) &dst[8] );
+      vD   = _mm_sub_epi16( _mm_load_si128( ( const __m128i* ) &left[8] ), vVal );
+      _mm_storeu_si128( ( __m128i* ) &dst[8], _mm_add_epi16( vVal, _mm_mulhrs_epi16( vD, vW1 ) ) );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void intraTranspose_SSE( const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height )
+{
+  if( ( width & 7 ) == 0 && ( height & 7 ) == 0 )
+  {
+    __m128i r[8];
+
+    for( int y = 0; y < height; y += 8 )
+    {
+      for( int x = 0; x < width; x += 8 )
+      {
+        for( int i = 0; i < 8; i++ )
+        {
+          r[i] = _mm_loadu_si128( ( const __m128i* ) &src[( y + i ) * srcStride + x] );
+        }
+        _mm_transpose8x8_epi16( r );
+        for( int i = 0; i < 8; i++ )
+        {
+          _mm_storeu_si128( ( __m128i* ) &dst[( x + i ) * dstStride + y], r[i] );
+        }
+      }
+    }
+  }
+  else if( ( width & 3 ) == 0 && ( height & 3 ) == 0 )
+  {
+    for( int y = 0; y < height; y += 4 )
+    {
+      for( int x = 0; x < width; x += 4 )
+      {
+        const Pel* s  = &src[y * srcStride + x];
+        __m128i    t0 = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) s ),                   _mm_loadl_epi64( ( const __m128i* ) &s[srcStride] ) );
+        __m128i    t1 = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) &s[2 * srcStride] ), _mm_loadl_epi64( ( const __m128i* ) &s[3 * srcStride] ) );
+        __m128i    u0 = _mm_unpacklo_epi32( t0, t1 );
+        __m128i    u1 = _mm_unpackhi_epi32( t0, t1 );
+        Pel*       d  = &dst[x * dstStride + y];
+
+        _mm_storel_epi64( ( __m128i* ) d,                   u0 );
+        _mm_storel_epi64( ( __m128i* ) &d[dstStride],     _mm_unpackhi_epi64( u0, u0 ) );
+        _mm_storel_epi64( ( __m128i* ) &d[2 * dstStride], u1 );
+        _mm_storel_epi64( ( __m128i* ) &d[3 * dstStride], _mm_unpackhi_epi64( u1, u1 ) );
+      }
+    }
+  }
+  else
+  {
+    intraTransposeCore( src, srcStride, dst, dstStride, width, height );
+  }
+}
+
+// CCLM luma downsampling for 4:2:0 (6-tap, or 5-tap for collocated chroma) and 4:2:2 (horizontal 3-tap, or the even
+// samples for collocated chroma). Each output sample is the sum of a (c, 1) weighted pair starting at the co-located
+// luma sample and a (1, 0) weighted pair starting one sample to the left, the two 4:2:0 luma rows are added up front.
+template<X86_VEXT vext, bool is420, bool collocated>
+static void xIntraLumaDownsample_SSE( const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height )
+{
+  const int     shift   = is420 ? 3 : ( collocated ? 0 : 2 );
+  const int     srcStep = is420 ? 2 * srcStride : srcStride;
+  const __m128i vCentre = xIntraCoeffPair( is420 && collocated ? 4 : ( collocated ? 1 : 2 ), is420 || !collocated ? 1 : 0 );
+  const __m128i vLeft   = xIntraCoeffPair( is420 || !collocated ? 1 : 0, 0 );
+  const __m128i vVert   = xIntraCoeffPair( 1, 0 );
+  const __m128i vOffset = _mm_set1_epi32( ( 1 << shift ) >> 1 );
+  const int     width4  = width & ~3;
+
+  // sum of the taps for the four output samples of a vector of eight luma samples
+  auto xFilter = [&]( const Pel* p )
+  {
+    __m128i vC = _mm_loadu_si128( ( const __m128i* ) p );
+    __m128i vL = _mm_loadu_si128( ( const __m128i* ) &p[-1] );
+    if( is420 && !collocated )
+    {
+      vC = _mm_add_epi16( vC, _mm_loadu_si128( ( const __m128i* ) &p[srcStride] ) );
+      vL = _mm_add_epi16( vL, _mm_loadu_si128( ( const __m128i* ) &p[srcStride - 1] ) );
+    }
+    __m128i vSum = _mm_add_epi32( _mm_madd_epi16( vC, vCentre ), _mm_madd_epi16( vL, vLeft ) );
+    if( is420 && collocated )
+    {
+      const __m128i vV = _mm_add_epi16( _mm_loadu_si128( ( const __m128i* ) &p[-srcStride] ), _mm_loadu_si128( ( const __m128i* ) &p[srcStride] ) );
+      vSum = _mm_add_epi32( vSum, _mm_madd_epi16( vV, vVert ) );
+    }
+    return _mm_srai_epi32( _mm_add_epi32( vSum, vOffset ), shift );
+  };
+
+  for( int y = 0; y < height; y++ )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vCentre256 = _mm256_broadcastsi128_si256( vCentre );
+      const __m256i vLeft256   = _mm256_broadcastsi128_si256( vLeft );
+      const __m256i vVert256   = _mm256_broadcastsi128_si256( vVert );
+      const __m256i vOffset256 = _mm256_broadcastsi128_si256( vOffset );
+
+      auto xFilter256 = [&]( const Pel* p )
+      {
+        __m256i vC = _mm256_loadu_si256( ( const __m256i* ) p );
+        __m256i vL = _mm256_loadu_si256( ( const __m256i* ) &p[-1] );
+        if( is420 && !collocated )
+        {
+          vC = _mm256_add_epi16( vC, _mm256_loadu_si256( ( const __m256i* ) &p[srcStride] ) );
+          vL = _mm256_add_epi16( vL, _mm256_loadu_si256( ( const __m256i* ) &p[srcStride - 1] ) );
+        }
+        __m256i vSum = _mm256_add_epi32( _mm256_madd_epi16( vC, vCentre256 ), _mm256_madd_epi16( vL, vLeft256 ) );
+        if( is420 && collocated )
+        {
+          const __m256i vV = _mm256_add_epi16( _mm256_loadu_si256( ( const __m256i* ) &p[-srcStride] ), _mm256_loadu_si256( ( const __m256i* ) &p[srcStride] ) );
+          vSum = _mm256_add_epi32( vSum, _mm256_madd_epi16( vV, vVert256 ) );
+        }
+        return _mm256_srai_epi32( _mm256_add_epi32( vSum, vOffset256 ), shift );
+      };
+
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i vRes = _mm256_packs_epi32( xFilter256( &src[2 * x] ), xFilter256( &src[2 * x + 16] ) );
+        _mm256_storeu_si256( ( __m256i* ) &dst[x], _mm256_permute4x64_epi64( vRes, 0xd8 ) );
+      }
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_packs_epi32( xFilter( &src[2 * x] ), xFilter( &src[2 * x + 8] ) ) );
+    }
+    if( x < width4 )
+    {
+      const __m128i vRes = xFilter( &src[2 * x] );
+      _mm_storel_epi64( ( __m128i* ) &dst[x], _mm_packs_epi32( vRes, vRes ) );
+    }
+    src += srcStep;
+    dst += dstStride;
+  }
+
+  if( width4 < width )
+  {
+    intraLumaDownsampleCore( src - height * srcStep + 2 * width4, srcStride, dst - height * dstStride + width4, dstStride, width - width4, height, is420 ? CHROMA_420 : CHROMA_422, collocated );
+  }
+}
+
+template<X86_VEXT vext>
+static void intraLumaDownsample_SSE( const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height, const ChromaFormat chFmt, const bool collocated )
+{
+  if( chFmt == CHROMA_420 )
+  {
+    if( collocated )
+    {
+      xIntraLumaDownsample_SSE<vext, true, true >( src, srcStride, dst, dstStride, width, height );
+    }
+    else
+    {
+      xIntraLumaDownsample_SSE<vext, true, false>( src, srcStride, dst, dstStride, width, height );
+    }
+  }
+  else if( chFmt == CHROMA_422 )
+  {
+    if( collocated )
+    {
+      xIntraLumaDownsample_SSE<vext, false, true >( src, srcStride, dst, dstStride, width, height );
+    }
+    else
+    {
+      xIntraLumaDownsample_SSE<vext, false, false>( src, srcStride, dst, dstStride, width, height );
+    }
+  }
+  else
+  {
+    // 4:4:4 is a plain copy
+    intraLumaDownsampleCore( src, srcStride, dst, dstStride, width, height, chFmt, collocated );
+  }
+}
+
+template<X86_VEXT vext>
+void IntraPredOps::_initIntraPredOpsX86()
+{
+  predPlanar     = intraPredPlanar_SSE<vext>;
+  pdpcPlanarDc   = intraPdpcPlanarDc_SSE<vext>;
+  predAngLuma    = intraPredAngLuma_SSE<vext>;
+  predAngChroma  = intraPredAngChroma_SSE<vext>;
+  pdpcHorVer     = intraPdpcHorVer_SSE<vext>;
+  pdpcAng        = intraPdpcAng_SSE<vext>;
+  transpose      = intraTranspose_SSE<vext>;
+  lumaDownsample = intraLumaDownsample_SSE<vext>;
+}
+
+template void IntraPredOps::_initIntraPredOpsX86<SIMDX86>();
+
+//! \}
+
+#endif //TARGET_SIMD_X86
+#endif //ENABLE_SIMD_OPT_INTRA
@@ -0,0 +1,809 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     LoopFilterX86.h
+    \brief    deblocking filter class, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../LoopFilter.h"
+
+#if ENABLE_SIMD_OPT_DBLF
+#ifdef TARGET_SIMD_X86
+
+//! \ingroup CommonLib
+//! \{
+
+static_assert( sizeof( Pel ) == 2, "The SIMD deblocking expects 16 bit samples" );
+
+// The vector lanes are the lines across an edge: a luma segment occupies 4 lanes, a chroma segment 2 or 4 lanes.
+// P[k] and Q[k] hold the k-th sample away from the edge of all lines. For bit depths up to 10 all intermediate
+// values of the filter decisions and the filters fit into 16 bits.
+
+// --------------------------------------------------------------------------------------------------------------------
+// 16 bit lane operations, overloaded for 128 and 256 bit vectors so the filters are written once
+// --------------------------------------------------------------------------------------------------------------------
+
+static ALWAYS_INLINE __m128i vAdd   ( __m128i a, __m128i b )            { return _mm_add_epi16   ( a, b ); }
+static ALWAYS_INLINE __m128i vSub   ( __m128i a, __m128i b )            { return _mm_sub_epi16   ( a, b ); }
+static ALWAYS_INLINE __m128i vMul   ( __m128i a, __m128i b )            { return _mm_mullo_epi16 ( a, b ); }
+static ALWAYS_INLINE __m128i vMulhrs( __m128i a, __m128i b )            { return _mm_mulhrs_epi16( a, b ); }
+static ALWAYS_INLINE __m128i vMin   ( __m128i a, __m128i b )            { return _mm_min_epi16   ( a, b ); }
+static ALWAYS_INLINE __m128i vMax   ( __m128i a, __m128i b )            { return _mm_max_epi16   ( a, b ); }
+static ALWAYS_INLINE __m128i vAvg   ( __m128i a, __m128i b )            { return _mm_avg_epu16   ( a, b ); }
+static ALWAYS_INLINE __m128i vAbs   ( __m128i a )                       { return _mm_abs_epi16   ( a ); }
+static ALWAYS_INLINE __m128i vAnd   ( __m128i a, __m128i b )            { return _mm_and_si128   ( a, b ); }
+static ALWAYS_INLINE __m128i vOr    ( __m128i a, __m128i b )            { return _mm_or_si128    ( a, b ); }
+static ALWAYS_INLINE __m128i vAndNot( __m128i a, __m128i b )            { return _mm_andnot_si128( a, b ); }
+static ALWAYS_INLINE __m128i vGt    ( __m128i a, __m128i b )            { return _mm_cmpgt_epi16 ( a, b ); }
+static ALWAYS_INLINE __m128i vEq    ( __m128i a, __m128i b )            { return _mm_cmpeq_epi16 ( a, b ); }
+static ALWAYS_INLINE __m128i vBlend ( __m128i a, __m128i b, __m128i m ) { return _mm_blendv_epi8 ( a, b, m ); }
+static ALWAYS_INLINE bool    vAny   ( __m128i m )                       { return _mm_movemask_epi8( m ) != 0; }
+template<int n> static ALWAYS_INLINE __m128i vSll( __m128i a )          { return _mm_slli_epi16  ( a, n ); }
+template<int n> static ALWAYS_INLINE __m128i vSra( __m128i a )          { return _mm_srai_epi16  ( a, n ); }
+template<int m> static ALWAYS_INLINE __m128i vShuf( __m128i a )         { return _mm_shufflehi_epi16( _mm_shufflelo_epi16( a, m ), m ); }
+
+template<typename T> static ALWAYS_INLINE T vSet1( int v );
+template<typename T> static ALWAYS_INLINE T vLoad( const int16_t* p );
+
+template<> ALWAYS_INLINE __m128i vSet1<__m128i>( int v )              { return _mm_set1_epi16( v ); }
+template<> ALWAYS_INLINE __m128i vLoad<__m128i>( const int16_t* p )   { return _mm_loadu_si128( ( const __m128i* ) p ); }
+
+#ifdef USE_AVX2
+static ALWAYS_INLINE __m256i vAdd   ( __m256i a, __m256i b )            { return _mm256_add_epi16   ( a, b ); }
+static ALWAYS_INLINE __m256i vSub   ( __m256i a, __m256i b )            { return _mm256_sub_epi16   ( a, b ); }
+static ALWAYS_INLINE __m256i vMul   ( __m256i a, __m256i b )            { return _mm256_mullo_epi16 ( a, b ); }
+static ALWAYS_INLINE __m256i vMulhrs( __m256i a, __m256i b )            { return _mm256_mulhrs_epi16( a, b ); }
+static ALWAYS_INLINE __m256i vMin   ( __m256i a, __m256i b )            { return _mm256_min_epi16   ( a, b ); }
+static ALWAYS_INLINE __m256i vMax   ( __m256i a, __m256i b )            { return _mm256_max_epi16   ( a, b ); }
+static ALWAYS_INLINE __m256i vAvg   ( __m256i a, __m256i b )            { return _mm256_avg_epu16   ( a, b ); }
+static ALWAYS_INLINE __m256i vAbs   ( __m256i a )                       { return _mm256_abs_epi16   ( a ); }
+static ALWAYS_INLINE __m256i vAnd   ( __m256i a, __m256i b )            { return _mm256_and_si256   ( a, b ); }
+static ALWAYS_INLINE __m256i vOr    ( __m256i a, __m256i b )            { return _mm256_or_si256    ( a, b ); }
+static ALWAYS_INLINE __m256i vAndNot( __m256i a, __m256i b )            { return _mm256_andnot_si256( a, b ); }
+static ALWAYS_INLINE __m256i vGt    ( __m256i a, __m256i b )            { return _mm256_cmpgt_epi16 ( a, b ); }
+static ALWAYS_INLINE __m256i vEq    ( __m256i a, __m256i b )            { return _mm256_cmpeq_epi16 ( a, b ); }
+static ALWAYS_INLINE __m256i vBlend ( __m256i a, __m256i b, __m256i m ) { return _mm256_blendv_epi8 ( a, b, m ); }
+static ALWAYS_INLINE bool    vAny   ( __m256i m )                       { return _mm256_movemask_epi8( m ) != 0; }
+template<int n> static ALWAYS_INLINE __m256i vSll( __m256i a )          { return _mm256_slli_epi16  ( a, n ); }
+template<int n> static ALWAYS_INLINE __m256i vSra( __m256i a )          { return _mm256_srai_epi16  ( a, n ); }
+template<int m> static ALWAYS_INLINE __m256i vShuf( __m256i a )         { return _mm256_shufflehi_epi16( _mm256_shufflelo_epi16( a, m ), m ); }
+
+template<> ALWAYS_INLINE __m256i vSet1<__m256i>( int v )              { return _mm256_set1_epi16( v ); }
+template<> ALWAYS_INLINE __m256i vLoad<__m256i>( const int16_t* p )   { return _mm256_loadu_si256( ( const __m256i* ) p ); }
+#endif
+
+template<typename T> static ALWAYS_INLINE T vClip( T v, T lo, T hi )  { return vMin( vMax( v, lo ), hi ); }
+
+// broadcast the first/last line of each segment to all lines of the segment
+template<typename T> static ALWAYS_INLINE T vFirstLine( T a, const int segLength ) { return segLength == 2 ? vShuf<0xa0>( a ) : vShuf<0x00>( a ); }
+template<typename T> static ALWAYS_INLINE T vLastLine ( T a, const int segLength ) { return segLength == 2 ? vShuf<0xf5>( a ) : vShuf<0xff>( a ); }
+
+// set the lanes of one segment of a per-lane parameter
+static ALWAYS_INLINE void xSetSegLanes( int16_t* dst, const int val, const int segLength )
+{
+  if( segLength == 4 )
+  {
+    const uint64_t v = uint64_t( uint16_t( val ) ) * 0x0001000100010001ull;
+    memcpy( dst, &v, sizeof( v ) );
+  }
+  else
+  {
+    const uint32_t v = uint32_t( uint16_t( val ) ) * 0x00010001u;
+    memcpy( dst, &v, sizeof( v ) );
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// loading and storing the samples of numLines lines across the edge
+// --------------------------------------------------------------------------------------------------------------------
+
+// samples of one row of a horizontal edge
+static ALWAYS_INLINE void vLoadRow( const Pel* src, const int numLines, __m128i& v )
+{
+  v = numLines == 8 ? _mm_loadu_si128( ( const __m128i* ) src ) : _mm_loadl_epi64( ( const __m128i* ) src );
+}
+
+static ALWAYS_INLINE void vStoreRow( Pel* dst, const int numLines, const __m128i& v )
+{
+  if( numLines == 8 )
+  {
+    _mm_storeu_si128( ( __m128i* ) dst, v );
+  }
+  else
+  {
+    _mm_storel_epi64( ( __m128i* ) dst, v );
+  }
+}
+
+// the 8 columns starting at src of the lines (rows) of a vertical edge
+static ALWAYS_INLINE void vLoadCols( const Pel* src, const int stride, const int numLines, __m128i* col )
+{
+  for( int i = 0; i < 8; i++ )
+  {
+    col[i] = i < numLines ? _mm_loadu_si128( ( const __m128i* ) ( src + i * stride ) ) : _mm_setzero_si128();
+  }
+  _mm_transpose8x8_epi16( col );
+}
+
+static ALWAYS_INLINE void vStoreCols( Pel* dst, const int stride, const int numLines, __m128i* col )
+{
+  _mm_transpose8x8_epi16( col );
+  for( int i = 0; i < numLines; i++ )
+  {
+    _mm_storeu_si128( ( __m128i* ) ( dst + i * stride ), col[i] );
+  }
+}
+
+#ifdef USE_AVX2
+static ALWAYS_INLINE void vLoadRow( const Pel* src, const int numLines, __m256i& v )
+{
+  v = _mm256_loadu_si256( ( const __m256i* ) src );
+}
+
+static ALWAYS_INLINE void vStoreRow( Pel* dst, const int numLines, const __m256i& v )
+{
+  _mm256_storeu_si256( ( __m256i* ) dst, v );
+}
+
+static ALWAYS_INLINE void vLoadCols( const Pel* src, const int stride, const int numLines, __m256i* col )
+{
+  __m128i lo[8], hi[8];
+
+  vLoadCols( src,              stride, 8, lo );
+  vLoadCols( src + 8 * stride, stride, 8, hi );
+
+  for( int i = 0; i < 8; i++ )
+  {
+    col[i] = _mm256_inserti128_si256( _mm256_castsi128_si256( lo[i] ), hi[i], 1 );
+  }
+}
+
+static ALWAYS_INLINE void vStoreCols( Pel* dst, const int stride, const int numLines, __m256i* col )
+{
+  __m128i lo[8], hi[8];
+
+  for( int i = 0; i < 8; i++ )
+  {
+    lo[i] = _mm256_castsi256_si128( col[i] );
+    hi[i] = _mm256_extracti128_si256( col[i], 1 );
+  }
+
+  vStoreCols( dst,              stride, 8, lo );
+  vStoreCols( dst + 8 * stride, stride, 8, hi );
+}
+#endif
+
+// P[0..3] and Q[0..3] are always loaded, P[4..7] and Q[4..7] only when the long filters may be used on that side
+template<typename T>
+static ALWAYS_INLINE void xLoadEdge( const Pel* src, const int stride, const DeblockEdgeDir edgeDir, const int numLines, const bool longP, const bool longQ, T* P, T* Q )
+{
+  const int numP = longP ? 8 : 4;
+  const int numQ = longQ ? 8 : 4;
+
+  for( int k = 4; k < 8; k++ )
+  {
+    P[k] = Q[k] = vSet1<T>( 0 );
+  }
+
+  if( edgeDir == EDGE_HOR )
+  {
+    for( int k = 0; k < numP; k++ )
+    {
+      vLoadRow( src - ( k + 1 ) * stride, numLines, P[k] );
+    }
+    for( int k = 0; k < numQ; k++ )
+    {
+      vLoadRow( src + k * stride, numLines, Q[k] );
+    }
+  }
+  else
+  {
+    T col[8];
+
+    vLoadCols( src - 4, stride, numLines, col );
+    for( int k = 0; k < 4; k++ )
+    {
+      P[k] = col[3 - k];
+      Q[k] = col[4 + k];
+    }
+    if( longP )
+    {
+      vLoadCols( src - 8, stride, numLines, col );
+      for( int k = 4; k < 8; k++ )
+      {
+        P[k] = col[7 - k];
+      }
+    }
+    if( longQ )
+    {
+      vLoadCols( src, stride, numLines, col );
+      for( int k = 4; k < 8; k++ )
+      {
+        Q[k] = col[k];
+      }
+    }
+  }
+}
+
+// P[0..2] and Q[0..2] are always stored, P[3..6] and Q[3..6] only when the long filters were used on that side
+template<typename T>
+static ALWAYS_INLINE void xStoreEdge( Pel* src, const int stride, const DeblockEdgeDir edgeDir, const int numLines, const bool longP, const bool longQ, const T* P, const T* Q )
+{
+  if( edgeDir == EDGE_HOR )
+  {
+    const int numP = longP ? 7 : 3;
+    const int numQ = longQ ? 7 : 3;
+
+    for( int k = 0; k < numP; k++ )
+    {
+      vStoreRow( src - ( k + 1 ) * stride, numLines, P[k] );
+    }
+    for( int k = 0; k < numQ; k++ )
+    {
+      vStoreRow( src + k * stride, numLines, Q[k] );
+    }
+  }
+  else
+  {
+    T col[8];
+
+    if( longP )
+    {
+      for( int k = 0; k < 8; k++ )
+      {
+        col[7 - k] = P[k];
+      }
+      vStoreCols( src - 8, stride, numLines, col );
+    }
+    if( longQ )
+    {
+      for( int k = 0; k < 8; k++ )
+      {
+        col[k] = Q[k];
+      }
+      vStoreCols( src, stride, numLines, col );
+    }
+    for( int k = 0; k < 4; k++ )
+    {
+      col[3 - k] = P[k];
+      col[4 + k] = Q[k];
+    }
+    vStoreCols( src - 4, stride, numLines, col );
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// luma
+// --------------------------------------------------------------------------------------------------------------------
+
+enum LumaLaneParam
+{
+  LL_ON = 0,      // segment is filtered
+  LL_TC,
+  LL_BETA,
+  LL_SIDE_P,      // long filters may be used on the P side
+  LL_SIDE_Q,
+  LL_LEN_P,       // length of the long filter on the P side, 3 if the side is not large
+  LL_LEN_Q,
+  LL_SECOND,      // the second samples may be modified by the weak filter
+  LL_STRONG,      // the normal strong filter may be used
+  LL_NO_P,        // the P side must not be modified
+  LL_NO_Q,
+  NUM_LL_PARAMS
+};
+
+// bilinear long filter of one side, X are the samples of the side and len is the filter length of each line
+template<typename T>
+static ALWAYS_INLINE void xLongFilterSide( const T* X, T* out, const T ref, const T refMiddle, const T tc, const T len, const T on )
+{
+  static const int16_t coef7[7] = { 59, 50, 41, 32, 23, 14, 5 };
+  static const int16_t coef5[5] = { 58, 45, 32, 19, 6 };
+  static const int16_t coef3[3] = { 53, 32, 11 };
+  static const int16_t tc7  [7] = { 6, 5, 4, 3, 2, 1, 1 };
+  static const int16_t tc3  [3] = { 6, 4, 2 };
+
+  const T is7  = vEq( len, vSet1<T>( 7 ) );
+  const T is5  = vEq( len, vSet1<T>( 5 ) );
+  const T is3  = vEq( len, vSet1<T>( 3 ) );
+  const T diff = vSub( refMiddle, ref );
+
+  for( int k = 0; k < 7; k++ )
+  {
+    T coef, tcMul, mask;
+
+    if( k < 3 )
+    {
+      coef  = vBlend( vBlend( vSet1<T>( coef3[k] ), vSet1<T>( coef5[k] ), is5 ), vSet1<T>( coef7[k] ), is7 );
+      tcMul = vBlend( vSet1<T>( tc7[k] ), vSet1<T>( tc3[k] ), is3 );
+      mask  = on;
+    }
+    else if( k < 5 )
+    {
+      coef  = vBlend( vSet1<T>( coef5[k] ), vSet1<T>( coef7[k] ), is7 );
+      tcMul = vSet1<T>( tc7[k] );
+      mask  = vAndNot( is3, on );
+    }
+    else
+    {
+      coef  = vSet1<T>( coef7[k] );
+      tcMul = vSet1<T>( tc7[k] );
+      mask  = vAnd( is7, on );
+    }
+
+    // ( refMiddle * c + ref * ( 64 - c ) + 32 ) >> 6 == ref + ( ( refMiddle - ref ) * c * 2^9 + 2^14 ) >> 15
+    const T val = vAdd( ref, vMulhrs( diff, vSll<9>( coef ) ) );
+    const T clp = vSra<1>( vMul( tc, tcMul ) );
+
+    out[k] = vBlend( out[k], vClip( val, vSub( X[k], clp ), vAdd( X[k], clp ) ), mask );
+  }
+}
+
+template<typename T>
+static void xFilterLumaLines( Pel* src, const int stride, const DeblockEdgeDir edgeDir, const LFEdgeSegment* seg, const int numLines, const ClpRng& clpRng )
+{
+  const int numLanes = sizeof( T ) / sizeof( int16_t );
+  const int numSeg   = numLines >> 2;
+
+  bool anyOn = false;
+
+  for( int i = 0; i < numSeg; i++ )
+  {
+    anyOn |= seg[i].filter;
+  }
+
+  if( !anyOn )
+  {
+    return;
+  }
+
+  int16_t prm[NUM_LL_PARAMS][16];
+  bool    anyLongP = false;
+  bool    anyLongQ = false;
+
+  for( int i = 0; i < numLanes >> 2; i++ )
+  {
+    const LFEdgeSegment& s = seg[std::min( i, numSeg - 1 )];
+    const bool on          = i < numSeg && s.filter;
+    const int  l           = i << 2;
+
+    xSetSegLanes( &prm[LL_ON    ][l], on ? -1 : 0, 4 );
+    xSetSegLanes( &prm[LL_TC    ][l], on ? s.tc   : 0, 4 );
+    xSetSegLanes( &prm[LL_BETA  ][l], on ? s.beta : 0, 4 );
+    xSetSegLanes( &prm[LL_SIDE_P][l], on && s.sidePisLarge ? -1 : 0, 4 );
+    xSetSegLanes( &prm[LL_SIDE_Q][l], on && s.sideQisLarge ? -1 : 0, 4 );
+    xSetSegLanes( &prm[LL_LEN_P ][l], on && s.sidePisLarge ? s.maxFilterLengthP : 3, 4 );
+    xSetSegLanes( &prm[LL_LEN_Q ][l], on && s.sideQisLarge ? s.maxFilterLengthQ : 3, 4 );
+    xSetSegLanes( &prm[LL_SECOND][l], on && s.maxFilterLengthP > 1 && s.maxFilterLengthQ > 1 ? -1 : 0, 4 );
+    xSetSegLanes( &prm[LL_STRONG][l], on && s.maxFilterLengthP > 2 && s.maxFilterLengthQ > 2 ? -1 : 0, 4 );
+    xSetSegLanes( &prm[LL_NO_P  ][l], on && s.partPNoFilter ? -1 : 0, 4 );
+    xSetSegLanes( &prm[LL_NO_Q  ][l], on && s.partQNoFilter ? -1 : 0, 4 );
+
+    anyLongP |= on && s.sidePisLarge;
+    anyLongQ |= on && s.sideQisLarge;
+  }
+
+  T P[8], Q[8], outP[7], outQ[7];
+
+  xLoadEdge( src, stride, edgeDir, numLines, anyLongP, anyLongQ, P, Q );
+
+  for( int k = 0; k < 7; k++ )
+  {
+    outP[k] = P[k];
+    outQ[k] = Q[k];
+  }
+
+  const T on    = vLoad<T>( prm[LL_ON  ] );
+  const T tc    = vLoad<T>( prm[LL_TC  ] );
+  const T beta  = vLoad<T>( prm[LL_BETA] );
+  const T one   = vSet1<T>( 1 );
+  const T dp    = vAbs( vSub( vAdd( P[2], P[0] ), vSll<1>( P[1] ) ) );
+  const T dq    = vAbs( vSub( vAdd( Q[2], Q[0] ), vSll<1>( Q[1] ) ) );
+  const T absPQ = vAbs( vSub( P[0], Q[0] ) );
+  const T tc25  = vSra<1>( vAdd( vMul( tc, vSet1<T>( 5 ) ), one ) );
+  const T sp    = vAbs( vSub( P[3], P[0] ) );
+  const T sq    = vAbs( vSub( Q[3], Q[0] ) );
+
+  // long filter decision
+  T longOn = vSet1<T>( 0 );
+
+  if( anyLongP || anyLongQ )
+  {
+    const T sideP = vLoad<T>( prm[LL_SIDE_P] );
+    const T sideQ = vLoad<T>( prm[LL_SIDE_Q] );
+    const T lenP  = vLoad<T>( prm[LL_LEN_P ] );
+    const T lenQ  = vLoad<T>( prm[LL_LEN_Q ] );
+
+    T dpL = dp, dqL = dq, spL = sp, sqL = sq;
+
+    if( anyLongP )
+    {
+      const T sp7 = vAdd( sp, vAbs( vAdd( vSub( vSub( P[4], P[5] ), P[6] ), P[7] ) ) );
+
+      dpL = vBlend( dp, vSra<1>( vAdd( vAdd( dp, vAbs( vSub( vAdd( P[5], P[3] ), vSll<1>( P[4] ) ) ) ), one ) ), sideP );
+      spL = vBlend( vSra<1>( vAdd( vAdd( sp,  vAbs( vSub( P[3], P[5] ) ) ), one ) ),
+                    vSra<1>( vAdd( vAdd( sp7, vAbs( vSub( P[3], P[7] ) ) ), one ) ), vEq( lenP, vSet1<T>( 7 ) ) );
+      spL = vBlend( sp, spL, sideP );
+    }
+    if( anyLongQ )
+    {
+      const T sq7 = vAdd( sq, vAbs( vAdd( vSub( vSub( Q[4], Q[5] ), Q[6] ), Q[7] ) ) );
+
+      dqL = vBlend( dq, vSra<1>( vAdd( vAdd( dq, vAbs( vSub( vAdd( Q[5], Q[3] ), vSll<1>( Q[4] ) ) ) ), one ) ), sideQ );
+      sqL = vBlend( vSra<1>( vAdd( vAdd( sq,  vAbs( vSub( Q[3], Q[5] ) ) ), one ) ),
+                    vSra<1>( vAdd( vAdd( sq7, vAbs( vSub( Q[3], Q[7] ) ) ), one ) ), vEq( lenQ, vSet1<T>( 7 ) ) );
+      sqL = vBlend( sq, sqL, sideQ );
+    }
+
+    const T dL      = vAdd( dpL, dqL );
+    const T strongL = vAnd( vAnd( vGt( vSra<5>( vMul( beta, vSet1<T>( 3 ) ) ), vAdd( spL, sqL ) ),
+                                  vGt( vSra<4>( beta ), vSll<1>( dL ) ) ),
+                            vGt( tc25, absPQ ) );
+
+    longOn = vAnd( vAnd( on, vOr( sideP, sideQ ) ), vGt( beta, vAdd( vFirstLine( dL, 4 ), vLastLine( dL, 4 ) ) ) );
+    longOn = vAnd( longOn, vAnd( vFirstLine( strongL, 4 ), vLastLine( strongL, 4 ) ) );
+
+    if( vAny( longOn ) )
+    {
+      T S[7];
+      for( int k = 0; k < 7; k++ )
+      {
+        S[k] = vAdd( P[k], Q[k] );
+      }
+
+      const T is7P = vEq( lenP, vSet1<T>( 7 ) ), is5P = vEq( lenP, vSet1<T>( 5 ) ), is3P = vEq( lenP, vSet1<T>( 3 ) );
+      const T is7Q = vEq( lenQ, vSet1<T>( 7 ) ), is5Q = vEq( lenQ, vSet1<T>( 5 ) ), is3Q = vEq( lenQ, vSet1<T>( 3 ) );
+      const T r8   = vSet1<T>( 8 );
+
+      const T m77 = vSra<4>( vAdd( vAdd( vAdd( vSll<1>( S[0] ), vAdd( S[1], S[2] ) ), vAdd( vAdd( S[3], S[4] ), vAdd( S[5], S[6] ) ) ), r8 ) );
+      const T m55 = vSra<4>( vAdd( vAdd( vSll<1>( vAdd( vAdd( S[0], S[1] ), S[2] ) ), vAdd( S[3], S[4] ) ), r8 ) );
+      const T m75 = vSra<4>( vAdd( vAdd( vSll<1>( vAdd( S[0], S[1] ) ), vAdd( vAdd( S[2], S[3] ), vAdd( S[4], S[5] ) ) ), r8 ) );
+      const T m53 = vSra<3>( vAdd( vAdd( vAdd( S[0], S[1] ), vAdd( S[2], S[3] ) ), vSet1<T>( 4 ) ) );
+      const T sP  = vAdd( vAdd( vAdd( P[1], P[2] ), vAdd( P[3], P[4] ) ), vAdd( P[5], P[6] ) );
+      const T sQ  = vAdd( vAdd( vAdd( Q[1], Q[2] ), vAdd( Q[3], Q[4] ) ), vAdd( Q[5], Q[6] ) );
+      const T q3  = vAdd( vSll<1>( vAdd( Q[0], Q[1] ) ), vAdd( Q[0], Q[1] ) );
+      const T p3  = vAdd( vSll<1>( vAdd( P[0], P[1] ) ), vAdd( P[0], P[1] ) );
+      const T m73 = vSra<4>( vAdd( vAdd( vAdd( vSll<1>( vAdd( P[0], Q[2] ) ), q3 ), sP ), r8 ) );
+      const T m37 = vSra<4>( vAdd( vAdd( vAdd( vSll<1>( vAdd( Q[0], P[2] ) ), p3 ), sQ ), r8 ) );
+
+      T refMiddle = m53;
+      refMiddle   = vBlend( refMiddle, m75, vOr( vAnd( is7P, is5Q ), vAnd( is5P, is7Q ) ) );
+      refMiddle   = vBlend( refMiddle, m77, vAnd( is7P, is7Q ) );
+      refMiddle   = vBlend( refMiddle, m55, vAnd( is5P, is5Q ) );
+      refMiddle   = vBlend( refMiddle, m73, vAnd( is7P, is3Q ) );
+      refMiddle   = vBlend( refMiddle, m37, vAnd( is3P, is7Q ) );
+
+      const T refP = vBlend( vBlend( vAvg( P[2], P[3] ), vAvg( P[4], P[5] ), is5P ), vAvg( P[6], P[7] ), is7P );
+      const T refQ = vBlend( vBlend( vAvg( Q[2], Q[3] ), vAvg( Q[4], Q[5] ), is5Q ), vAvg( Q[6], Q[7] ), is7Q );
+
+      xLongFilterSide( P, outP, refP, refMiddle, tc, lenP, longOn );
+      xLongFilterSide( Q, outQ, refQ, refMiddle, tc, lenQ, longOn );
+    }
+  }
+
+  // normal filter decisions
+  const T d0      = vAdd( dp, dq );
+  const T shortOn = vAndNot( longOn, vAnd( on, vGt( beta, vAdd( vFirstLine( d0, 4 ), vLastLine( d0, 4 ) ) ) ) );
+
+  if( vAny( shortOn ) )
+  {
+    const T strongS = vAnd( vAnd( vGt( vSra<3>( beta ), vAdd( sp, sq ) ), vGt( vSra<2>( beta ), vSll<1>( d0 ) ) ), vGt( tc25, absPQ ) );
+    const T sw      = vAnd( vAnd( shortOn, vLoad<T>( prm[LL_STRONG] ) ), vAnd( vFirstLine( strongS, 4 ), vLastLine( strongS, 4 ) ) );
+
+    if( vAny( sw ) )
+    {
+      const T tc2 = vSll<1>( tc );
+      const T tc3 = vAdd( tc2, tc );
+      const T r4  = vSet1<T>( 4 );
+      const T p0q0 = vAdd( P[0], Q[0] );
+
+      const T p0 = vSra<3>( vAdd( vAdd( vAdd( P[2], Q[1] ), vSll<1>( vAdd( vAdd( P[1], P[0] ), Q[0] ) ) ), r4 ) );
+      const T q0 = vSra<3>( vAdd( vAdd( vAdd( P[1], Q[2] ), vSll<1>( vAdd( vAdd( P[0], Q[0] ), Q[1] ) ) ), r4 ) );
+      const T p1 = vSra<2>( vAdd( vAdd( vAdd( P[2], P[1] ), p0q0 ), vSet1<T>( 2 ) ) );
+      const T q1 = vSra<2>( vAdd( vAdd( vAdd( Q[2], Q[1] ), p0q0 ), vSet1<T>( 2 ) ) );
+      const T p2 = vSra<3>( vAdd( vAdd( vAdd( vSll<1>( P[3] ), vAdd( vSll<1>( P[2] ), P[2] ) ), vAdd( P[1], p0q0 ) ), r4 ) );
+      const T q2 = vSra<3>( vAdd( vAdd( vAdd( vSll<1>( Q[3] ), vAdd( vSll<1>( Q[2] ), Q[2] ) ), vAdd( Q[1], p0q0 ) ), r4 ) );
+
+      outP[0] = vBlend( outP[0], vClip( p0, vSub( P[0], tc3 ), vAdd( P[0], tc3 ) ), sw );
+      outQ[0] = vBlend( outQ[0], vClip( q0, vSub( Q[0], tc3 ), vAdd( Q[0], tc3 ) ), sw );
+      outP[1] = vBlend( outP[1], vClip( p1, vSub( P[1], tc2 ), vAdd( P[1], tc2 ) ), sw );
+      outQ[1] = vBlend( outQ[1], vClip( q1, vSub( Q[1], tc2 ), vAdd( Q[1], tc2 ) ), sw );
+      outP[2] = vBlend( outP[2], vClip( p2, vSub( P[2], tc  ), vAdd( P[2], tc  ) ), sw );
+      outQ[2] = vBlend( outQ[2], vClip( q2, vSub( Q[2], tc  ), vAdd( Q[2], tc  ) ), sw );
+    }
+
+    // weak filter
+    T delta = vSub( vMul( vSub( Q[0], P[0] ), vSet1<T>( 9 ) ), vMul( vSub( Q[1], P[1] ), vSet1<T>( 3 ) ) );
+    delta   = vSra<4>( vAdd( delta, vSet1<T>( 8 ) ) );
+
+    const T weakOn = vAndNot( sw, vAnd( shortOn, vGt( vMul( tc, vSet1<T>( 10 ) ), vAbs( delta ) ) ) );
+
+    if( vAny( weakOn ) )
+    {
+      const T minPel = vSet1<T>( clpRng.min );
+      const T maxPel = vSet1<T>( clpRng.max );
+      const T tcH    = vSra<1>( tc );
+      const T second = vLoad<T>( prm[LL_SECOND] );
+      const T sideThr = vSra<3>( vAdd( beta, vSra<1>( beta ) ) );
+      const T filterP = vAnd( second, vGt( sideThr, vAdd( vFirstLine( dp, 4 ), vLastLine( dp, 4 ) ) ) );
+      const T filterQ = vAnd( second, vGt( sideThr, vAdd( vFirstLine( dq, 4 ), vLastLine( dq, 4 ) ) ) );
+
+      delta = vClip( delta, vSub( vSet1<T>( 0 ), tc ), tc );
+
+      const T delta1 = vClip( vSra<1>( vAdd( vSub( vAvg( P[2], P[0] ), P[1] ), delta ) ), vSub( vSet1<T>( 0 ), tcH ), tcH );
+      const T delta2 = vClip( vSra<1>( vSub( vSub( vAvg( Q[2], Q[0] ), Q[1] ), delta ) ), vSub( vSet1<T>( 0 ), tcH ), tcH );
+
+      outP[0] = vBlend( outP[0], vClip( vAdd( P[0], delta  ), minPel, maxPel ), weakOn );
+      outQ[0] = vBlend( outQ[0], vClip( vSub( Q[0], delta  ), minPel, maxPel ), weakOn );
+      outP[1] = vBlend( outP[1], vClip( vAdd( P[1], delta1 ), minPel, maxPel ), vAnd( weakOn, filterP ) );
+      outQ[1] = vBlend( outQ[1], vClip( vAdd( Q[1], delta2 ), minPel, maxPel ), vAnd( weakOn, filterQ ) );
+    }
+  }
+
+  const T noP = vLoad<T>( prm[LL_NO_P] );
+  const T noQ = vLoad<T>( prm[LL_NO_Q] );
+
+  for( int k = 0; k < 7; k++ )
+  {
+    P[k] = vBlend( outP[k], P[k], noP );
+    Q[k] = vBlend( outQ[k], Q[k], noQ );
+  }
+
+  const bool anyLongOn = vAny( longOn );
+
+  xStoreEdge( src, stride, edgeDir, numLines, anyLongP && anyLongOn, anyLongQ && anyLongOn, P, Q );
+}
+
+template<X86_VEXT vext>
+static void filterLumaEdge_SSE( Pel* src, const int stride, const DeblockEdgeDir edgeDir, const LFEdgeSegment* seg, const int numSeg, const ClpRng& clpRng )
+{
+  if( clpRng.bd > 10 )
+  {
+    LoopFilter::filterLumaEdgeCore( src, stride, edgeDir, seg, numSeg, clpRng );
+    return;
+  }
+
+  const int lineStep = edgeDir == EDGE_VER ? stride : 1;
+  int       iSeg     = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    for( ; iSeg + 4 <= numSeg; iSeg += 4 )
+    {
+      xFilterLumaLines<__m256i>( src + iSeg * 4 * lineStep, stride, edgeDir, seg + iSeg, 16, clpRng );
+    }
+  }
+#endif
+  for( ; iSeg + 2 <= numSeg; iSeg += 2 )
+  {
+    xFilterLumaLines<__m128i>( src + iSeg * 4 * lineStep, stride, edgeDir, seg + iSeg, 8, clpRng );
+  }
+  if( iSeg < numSeg )
+  {
+    xFilterLumaLines<__m128i>( src + iSeg * 4 * lineStep, stride, edgeDir, seg + iSeg, 4, clpRng );
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// chroma
+// --------------------------------------------------------------------------------------------------------------------
+
+enum ChromaLaneParam
+{
+  CL_ON = 0,      // segment is filtered
+  CL_TC,
+  CL_BETA,
+  CL_LARGE,       // strong filters may be used
+  CL_CTB,         // horizontal edge on a CTU boundary
+  CL_NO_P,        // the P side must not be modified
+  CL_NO_Q,
+  NUM_CL_PARAMS
+};
+
+template<typename T>
+static void xFilterChromaLines( Pel* src, const int stride, const DeblockEdgeDir edgeDir, const LFEdgeSegment* seg, const int numLines, const int segLength, const ClpRng& clpRng )
+{
+  const int numLanes = sizeof( T ) / sizeof( int16_t );
+  const int numSeg   = numLines / segLength;
+
+  bool anyOn = false;
+
+  for( int i = 0; i < numSeg; i++ )
+  {
+    anyOn |= seg[i].filter;
+  }
+
+  if( !anyOn )
+  {
+    return;
+  }
+
+  int16_t prm[NUM_CL_PARAMS][16];
+  bool    anyLarge = false;
+
+  for( int i = 0; i < numLanes / segLength; i++ )
+  {
+    const LFEdgeSegment& s = seg[std::min( i, numSeg - 1 )];
+    const bool on          = i < numSeg && s.filter;
+    const int  l           = i * segLength;
+
+    xSetSegLanes( &prm[CL_ON   ][l], on ? -1 : 0, segLength );
+    xSetSegLanes( &prm[CL_TC   ][l], on ? s.tc   : 0, segLength );
+    xSetSegLanes( &prm[CL_BETA ][l], on ? s.beta : 0, segLength );
+    xSetSegLanes( &prm[CL_LARGE][l], on && s.largeBoundary ? -1 : 0, segLength );
+    xSetSegLanes( &prm[CL_CTB  ][l], on && s.isChromaHorCTBBoundary ? -1 : 0, segLength );
+    xSetSegLanes( &prm[CL_NO_P ][l], on && s.partPNoFilter ? -1 : 0, segLength );
+    xSetSegLanes( &prm[CL_NO_Q ][l], on && s.partQNoFilter ? -1 : 0, segLength );
+
+    anyLarge |= on && s.largeBoundary;
+  }
+
+  T P[8], Q[8], outP[3], outQ[3];
+
+  xLoadEdge( src, stride, edgeDir, numLines, false, false, P, Q );
+
+  for( int k = 0; k < 3; k++ )
+  {
+    outP[k] = P[k];
+    outQ[k] = Q[k];
+  }
+
+  const T on  = vLoad<T>( prm[CL_ON] );
+  const T tc  = vLoad<T>( prm[CL_TC] );
+  const T r4  = vSet1<T>( 4 );
+
+  T sw = vSet1<T>( 0 );
+
+  if( anyLarge )
+  {
+    const T beta  = vLoad<T>( prm[CL_BETA] );
+    const T ctb   = vLoad<T>( prm[CL_CTB ] );
+    const T large = vAnd( on, vLoad<T>( prm[CL_LARGE] ) );
+    const T dp    = vBlend( vAbs( vSub( vAdd( P[2], P[0] ), vSll<1>( P[1] ) ) ), vAbs( vSub( P[0], P[1] ) ), ctb );
+    const T dq    = vAbs( vSub( vAdd( Q[2], Q[0] ), vSll<1>( Q[1] ) ) );
+    const T d0    = vAdd( dp, dq );
+    const T sp    = vBlend( vAbs( vSub( P[3], P[0] ) ), vAbs( vSub( P[1], P[0] ) ), ctb );
+    const T sq    = vAbs( vSub( Q[3], Q[0] ) );
+    const T tc25  = vSra<1>( vAdd( vMul( tc, vSet1<T>( 5 ) ), vSet1<T>( 1 ) ) );
+
+    const T strong = vAnd( vAnd( vGt( vSra<3>( beta ), vAdd( sp, sq ) ), vGt( vSra<2>( beta ), vSll<1>( d0 ) ) ), vGt( tc25, vAbs( vSub( P[0], Q[0] ) ) ) );
+    const T largeOn = vAnd( large, vGt( beta, vAdd( vFirstLine( d0, segLength ), vLastLine( d0, segLength ) ) ) );
+
+    sw = vAnd( largeOn, vAnd( vFirstLine( strong, segLength ), vLastLine( strong, segLength ) ) );
+
+    if( vAny( sw ) )
+    {
+      const T swN = vAndNot( ctb, sw );
+
+      // lines with the full strong filter
+      const T p0q0 = vAdd( P[0], Q[0] );
+      const T p2 = vSra<3>( vAdd( vAdd( vAdd( vSll<1>( P[3] ), P[3] ), vAdd( vSll<1>( P[2] ), P[1] ) ), vAdd( p0q0, r4 ) ) );
+      const T p1 = vSra<3>( vAdd( vAdd( vSll<1>( vAdd( P[3], P[1] ) ), vAdd( P[2], Q[1] ) ), vAdd( p0q0, r4 ) ) );
+      const T p0 = vSra<3>( vAdd( vAdd( vAdd( vAdd( P[3], P[2] ), vAdd( P[1], P[0] ) ), vAdd( Q[1], Q[2] ) ), vAdd( p0q0, r4 ) ) );
+      const T q0 = vSra<3>( vAdd( vAdd( vAdd( vAdd( P[2], P[1] ), vAdd( Q[0], Q[3] ) ), vAdd( Q[1], Q[2] ) ), vAdd( p0q0, r4 ) ) );
+
+      // lines restricted to one sample on the P side
+      const T p0C = vSra<3>( vAdd( vAdd( vAdd( vSll<1>( P[1] ), P[1] ), vAdd( P[0], Q[1] ) ), vAdd( vAdd( p0q0, Q[2] ), r4 ) ) );
+      const T q0C = vSra<3>( vAdd( vAdd( vAdd( vSll<1>( P[1] ), Q[0] ), vAdd( Q[1], Q[2] ) ), vAdd( vAdd( p0q0, Q[3] ), r4 ) ) );
+
+      // both
+      const T q1 = vSra<3>( vAdd( vAdd( vAdd( P[1], Q[2] ), vSll<1>( vAdd( Q[1], Q[3] ) ) ), vAdd( p0q0, r4 ) ) );
+      const T q2 = vSra<3>( vAdd( vAdd( vAdd( vSll<1>( Q[2] ), Q[1] ), vAdd( vSll<1>( Q[3] ), Q[3] ) ), vAdd( p0q0, r4 ) ) );
+
+      outP[2] = vBlend( outP[2], vClip( p2, vSub( P[2], tc ), vAdd( P[2], tc ) ), swN );
+      outP[1] = vBlend( outP[1], vClip( p1, vSub( P[1], tc ), vAdd( P[1], tc ) ), swN );
+      outP[0] = vBlend( outP[0], vClip( vBlend( p0, p0C, ctb ), vSub( P[0], tc ), vAdd( P[0], tc ) ), sw );
+      outQ[0] = vBlend( outQ[0], vClip( vBlend( q0, q0C, ctb ), vSub( Q[0], tc ), vAdd( Q[0], tc ) ), sw );
+      outQ[1] = vBlend( outQ[1], vClip( q1, vSub( Q[1], tc ), vAdd( Q[1], tc ) ), sw );
+      outQ[2] = vBlend( outQ[2], vClip( q2, vSub( Q[2], tc ), vAdd( Q[2], tc ) ), sw );
+    }
+  }
+
+  // weak filter
+  const T weakOn = vAndNot( sw, on );
+
+  if( vAny( weakOn ) )
+  {
+    T delta = vSra<3>( vAdd( vAdd( vSll<2>( vSub( Q[0], P[0] ) ), vSub( P[1], Q[1] ) ), r4 ) );
+    delta   = vClip( delta, vSub( vSet1<T>( 0 ), tc ), tc );
+
+    const T minPel = vSet1<T>( clpRng.min );
+    const T maxPel = vSet1<T>( clpRng.max );
+
+    outP[0] = vBlend( outP[0], vClip( vAdd( P[0], delta ), minPel, maxPel ), weakOn );
+    outQ[0] = vBlend( outQ[0], vClip( vSub( Q[0], delta ), minPel, maxPel ), weakOn );
+  }
+
+  const T noP = vLoad<T>( prm[CL_NO_P] );
+  const T noQ = vLoad<T>( prm[CL_NO_Q] );
+
+  for( int k = 0; k < 3; k++ )
+  {
+    P[k] = vBlend( outP[k], P[k], noP );
+    Q[k] = vBlend( outQ[k], Q[k], noQ );
+  }
+
+  xStoreEdge( src, stride, edgeDir, numLines, false, false, P, Q );
+}
+
+template<X86_VEXT vext>
+static void filterChromaEdge_SSE( Pel* src, const int stride, const DeblockEdgeDir edgeDir, const LFEdgeSegment* seg, const int numSeg, const int segLength, const ClpRng& clpRng )
+{
+  if( clpRng.bd > 10 || ( segLength != 2 && segLength != 4 ) )
+  {
+    LoopFilter::filterChromaEdgeCore( src, stride, edgeDir, seg, numSeg, segLength, clpRng );
+    return;
+  }
+
+  const int lineStep = edgeDir == EDGE_VER ? stride : 1;
+  const int numLines = numSeg * segLength;
+  int       line     = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    for( ; line + 16 <= numLines; line += 16 )
+    {
+      xFilterChromaLines<__m256i>( src + line * lineStep, stride, edgeDir, seg + line / segLength, 16, segLength, clpRng );
+    }
+  }
+#endif
+  for( ; line + 8 <= numLines; line += 8 )
+  {
+    xFilterChromaLines<__m128i>( src + line * lineStep, stride, edgeDir, seg + line / segLength, 8, segLength, clpRng );
+  }
+  if( line + 4 <= numLines )
+  {
+    xFilterChromaLines<__m128i>( src + line * lineStep, stride, edgeDir, seg + line / segLength, 4, segLength, clpRng );
+    line += 4;
+  }
+  if( line < numLines )
+  {
+    LoopFilter::filterChromaEdgeCore( src + line * lineStep, stride, edgeDir, seg + line / segLength, numSeg - line / segLength, segLength, clpRng );
+  }
+}
+
+template <X86_VEXT vext>
+void LoopFilter::_initLoopFilterX86()
+{
+  m_filterLumaEdge   = filterLumaEdge_SSE<vext>;
+  m_filterChromaEdge = filterChromaEdge_SSE<vext>;
+}
+
+template void LoopFilter::_initLoopFilterX86<SIMDX86>();
+
+//! \}
+
+#endif //TARGET_SIMD_X86
+#endif //ENABLE_SIMD_OPT_DBLF
@@ -0,0 +1,385 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     MatrixIntraPredictionX86.h
+    \brief    matrix intra prediction class, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../MatrixIntraPrediction.h"
+#include "../MipData.h"
+
+#if ENABLE_SIMD_OPT_MIP
+#ifdef TARGET_SIMD_X86
+
+//! \ingroup CommonLib
+//! \{
+
+// The reduced prediction multiplies the 8 bit weights with the 16 bit reduced boundary using _mm256_madd_epi16, two
+// matrix rows of 8 (or four rows of 4) weights per register. The 7 column matrices of the large blocks are expanded
+// with a byte shuffle, the unused first column is zero.
+
+static ALWAYS_INLINE __m256i xMipRowPairWeights( const uint8_t* matrix, const int row, const int sizeId )
+{
+  if( sizeId != 2 )
+  {
+    return _mm256_cvtepu8_epi16( _mm_loadu_si128( ( const __m128i* ) ( matrix + row * 8 ) ) );
+  }
+
+  // the last row pair is loaded two bytes early to stay inside the matrix
+  if( row == MIP_MAX_REDUCED_OUTPUT_SAMPLES - 2 )
+  {
+    const __m128i vRows = _mm_loadu_si128( ( const __m128i* ) ( matrix + row * 7 - 2 ) );
+    return _mm256_cvtepu8_epi16( _mm_shuffle_epi8( vRows, _mm_setr_epi8( -128, 2, 3, 4, 5, 6, 7, 8, -128, 9, 10, 11, 12, 13, 14, 15 ) ) );
+  }
+
+  const __m128i vRows = _mm_loadu_si128( ( const __m128i* ) ( matrix + row * 7 ) );
+  return _mm256_cvtepu8_epi16( _mm_shuffle_epi8( vRows, _mm_setr_epi8( -128, 0, 1, 2, 3, 4, 5, 6, -128, 7, 8, 9, 10, 11, 12, 13 ) ) );
+}
+
+static ALWAYS_INLINE __m256i xMipInputVector( const int* const input, const int sizeId )
+{
+  if( sizeId == 0 )
+  {
+    const __m128i vIn4 = _mm_loadu_si128( ( const __m128i* ) input );
+    return _mm256_broadcastsi128_si256( _mm_packs_epi32( vIn4, vIn4 ) );
+  }
+
+  const __m128i vIn0 = _mm_loadu_si128( ( const __m128i* ) input );
+  const __m128i vIn1 = _mm_loadu_si128( ( const __m128i* ) ( input + 4 ) );
+  return _mm256_broadcastsi128_si256( _mm_packs_epi32( vIn0, vIn1 ) );
+}
+
+static ALWAYS_INLINE __m256i xMipOffsetVector( const int* const input, const int sizeId )
+{
+  const int inputSize = ( sizeId == 0 ) ? 4 : 8;
+
+  int sum = 0;
+  for( int i = 0; i < inputSize; i++ )
+  {
+    sum += input[i];
+  }
+  return _mm256_set1_epi32( ( 1 << ( MIP_SHIFT_MATRIX - 1 ) ) - MIP_OFFSET_MATRIX * sum );
+}
+
+// the clipped reduced predictions of one matrix for N boundaries, the weights are expanded once for all of them
+template<int N>
+static ALWAYS_INLINE void xMipReducedPred( int res[][MIP_MAX_REDUCED_OUTPUT_SAMPLES], const uint8_t* matrix, const __m256i* vInput,
+                                          const __m256i* vOffset, const __m256i* vInputOffset, const __m256i vMax, const int sizeId )
+{
+  const int     numOutputs = ( sizeId < 2 ) ? 16 : 64;
+  const __m256i vZero      = _mm256_setzero_si256();
+
+  if( sizeId == 0 )
+  {
+    const __m256i vPerm = _mm256_setr_epi32( 0, 1, 4, 5, 2, 3, 6, 7 );
+
+    for( int row = 0; row < numOutputs; row += 8 )
+    {
+      const __m256i vW0 = _mm256_cvtepu8_epi16( _mm_loadu_si128( ( const __m128i* ) ( matrix + row * 4 ) ) );
+      const __m256i vW1 = _mm256_cvtepu8_epi16( _mm_loadu_si128( ( const __m128i* ) ( matrix + row * 4 + 16 ) ) );
+
+      for( int n = 0; n < N; n++ )
+      {
+        __m256i vRes = _mm256_hadd_epi32( _mm256_madd_epi16( vW0, vInput[n] ), _mm256_madd_epi16( vW1, vInput[n] ) );
+        vRes         = _mm256_permutevar8x32_epi32( vRes, vPerm );
+        vRes         = _mm256_add_epi32( _mm256_srai_epi32( _mm256_add_epi32( vRes, vOffset[n] ), MIP_SHIFT_MATRIX ), vInputOffset[n] );
+        _mm256_store_si256( ( __m256i* ) &res[n][row], _mm256_min_epi32( vMax, _mm256_max_epi32( vZero, vRes ) ) );
+      }
+    }
+  }
+  else
+  {
+    const __m256i vPerm = _mm256_setr_epi32( 0, 4, 1, 5, 2, 6, 3, 7 );
+
+    for( int row = 0; row < numOutputs; row += 8 )
+    {
+      const __m256i vW0 = xMipRowPairWeights( matrix, row,     sizeId );
+      const __m256i vW1 = xMipRowPairWeights( matrix, row + 2, sizeId );
+      const __m256i vW2 = xMipRowPairWeights( matrix, row + 4, sizeId );
+      const __m256i vW3 = xMipRowPairWeights( matrix, row + 6, sizeId );
+
+      for( int n = 0; n < N; n++ )
+      {
+        const __m256i vSum0 = _mm256_madd_epi16( vW0, vInput[n] );
+        const __m256i vSum1 = _mm256_madd_epi16( vW1, vInput[n] );
+        const __m256i vSum2 = _mm256_madd_epi16( vW2, vInput[n] );
+        const __m256i vSum3 = _mm256_madd_epi16( vW3, vInput[n] );
+
+        __m256i vRes = _mm256_hadd_epi32( _mm256_hadd_epi32( vSum0, vSum1 ), _mm256_hadd_epi32( vSum2, vSum3 ) );
+        vRes         = _mm256_permutevar8x32_epi32( vRes, vPerm );
+        vRes         = _mm256_add_epi32( _mm256_srai_epi32( _mm256_add_epi32( vRes, vOffset[n] ), MIP_SHIFT_MATRIX ), vInputOffset[n] );
+        _mm256_store_si256( ( __m256i* ) &res[n][row], _mm256_min_epi32( vMax, _mm256_max_epi32( vZero, vRes ) ) );
+      }
+    }
+  }
+}
+
+static ALWAYS_INLINE void xMipStoreReducedPred( int* const result, const int* const res, const bool transpose, const int reducedPredSize )
+{
+  if( !transpose )
+  {
+    for( int i = 0; i < reducedPredSize * reducedPredSize; i += 8 )
+    {
+      _mm256_storeu_si256( ( __m256i* ) &result[i], _mm256_load_si256( ( const __m256i* ) &res[i] ) );
+    }
+  }
+  else if( reducedPredSize == 4 )
+  {
+    __m128i r0 = _mm_load_si128( ( const __m128i* ) &res[0] );
+    __m128i r1 = _mm_load_si128( ( const __m128i* ) &res[4] );
+    __m128i r2 = _mm_load_si128( ( const __m128i* ) &res[8] );
+    __m128i r3 = _mm_load_si128( ( const __m128i* ) &res[12] );
+
+    _mm_transpose4x4_epi32( r0, r1, r2, r3 );
+
+    _mm_storeu_si128( ( __m128i* ) &result[0],  r0 );
+    _mm_storeu_si128( ( __m128i* ) &result[4],  r1 );
+    _mm_storeu_si128( ( __m128i* ) &result[8],  r2 );
+    _mm_storeu_si128( ( __m128i* ) &result[12], r3 );
+  }
+  else
+  {
+    __m256i r[8];
+    for( int i = 0; i < 8; i++ )
+    {
+      r[i] = _mm256_load_si256( ( const __m256i* ) &res[i * 8] );
+    }
+    _mm256_transpose8x8_epi32( r );
+    for( int i = 0; i < 8; i++ )
+    {
+      _mm256_storeu_si256( ( __m256i* ) &result[i * 8], r[i] );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void computeReducedPred_SIMD( int* const result, const int* const input, const uint8_t* matrix,
+                                     const int sizeId, const int inputOffset, const bool transpose, const int bitDepth )
+{
+  const __m256i vInput       = xMipInputVector( input, sizeId );
+  const __m256i vOffset      = xMipOffsetVector( input, sizeId );
+  const __m256i vInputOffset = _mm256_set1_epi32( inputOffset );
+  const __m256i vMax         = _mm256_set1_epi32( ( 1 << bitDepth ) - 1 );
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int res[1][MIP_MAX_REDUCED_OUTPUT_SAMPLES] );
+
+  xMipReducedPred<1>( res, matrix, &vInput, &vOffset, &vInputOffset, vMax, sizeId );
+  xMipStoreReducedPred( result, res[0], transpose, ( sizeId < 2 ) ? 4 : 8 );
+}
+
+// the boundary vectors are set up once for all modes and each matrix is expanded once for both boundaries
+template<X86_VEXT vext>
+static void computeReducedPredAllModes_SIMD( int* const result, const int* const input, const int* const inputTransp,
+                                             const uint8_t* matrices, const int numModes, const int sizeId,
+                                             const int inputOffset, const int inputOffsetTransp, const int bitDepth )
+{
+  const int reducedPredSize = ( sizeId < 2 ) ? 4 : 8;
+  const int numOutputs      = reducedPredSize * reducedPredSize;
+  const int matrixSize      = numOutputs * ( ( sizeId == 0 ) ? 4 : ( sizeId == 1 ) ? 8 : 7 );
+
+  const __m256i vInput[2]       = { xMipInputVector( input, sizeId ), xMipInputVector( inputTransp, sizeId ) };
+  const __m256i vOffset[2]      = { xMipOffsetVector( input, sizeId ), xMipOffsetVector( inputTransp, sizeId ) };
+  const __m256i vInputOffset[2] = { _mm256_set1_epi32( inputOffset ), _mm256_set1_epi32( inputOffsetTransp ) };
+  const __m256i vMax            = _mm256_set1_epi32( ( 1 << bitDepth ) - 1 );
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int res[2][MIP_MAX_REDUCED_OUTPUT_SAMPLES] );
+
+  for( int mode = 0; mode < numModes; mode++ )
+  {
+    xMipReducedPred<2>( res, matrices + mode * matrixSize, vInput, vOffset, vInputOffset, vMax, sizeId );
+    xMipStoreReducedPred( result + mode * numOutputs,                res[0], false, reducedPredSize );
+    xMipStoreReducedPred( result + ( numModes + mode ) * numOutputs, res[1], true,  reducedPredSize );
+  }
+}
+
+template<X86_VEXT vext>
+static void predictionUpsampling1D_SIMD( int* const dst, const int* const src, const int* const bndry,
+                                         const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
+                                         const SizeType srcStep, const SizeType srcStride,
+                                         const SizeType dstStep, const SizeType dstStride,
+                                         const SizeType bndryStep,
+                                         const unsigned int upsmpFactor )
+{
+  const int log2UpsmpFactor = floorLog2( upsmpFactor );
+  const int roundingOffset  = 1 << ( log2UpsmpFactor - 1 );
+
+  if( srcStride == 1 && dstStride == 1 && bndryStep == 1 && srcSizeOrthDim == 4 )
+  {
+    // vertical upsampling of 4 wide blocks
+    const __m128i vRound  = _mm_set1_epi32( roundingOffset );
+    __m128i       vBefore = _mm_loadu_si128( ( const __m128i* ) bndry );
+    int*          currDst = dst;
+
+    for( int idx = 0; idx < srcSizeUpsmpDim; idx++ )
+    {
+      const __m128i vBehind = _mm_loadu_si128( ( const __m128i* ) &src[idx * srcStep] );
+      const __m128i vDelta  = _mm_sub_epi32( vBehind, vBefore );
+      __m128i       vScaled = _mm_slli_epi32( vBefore, log2UpsmpFactor );
+
+      for( int pos = 0; pos < int( upsmpFactor ); pos++, currDst += dstStep )
+      {
+        vScaled = _mm_add_epi32( vScaled, vDelta );
+        _mm_storeu_si128( ( __m128i* ) currDst, _mm_srai_epi32( _mm_add_epi32( vScaled, vRound ), log2UpsmpFactor ) );
+      }
+      vBefore = vBehind;
+    }
+  }
+  else if( srcStride == 1 && dstStride == 1 && bndryStep == 1 && ( srcSizeOrthDim & 7 ) == 0 )
+  {
+    // vertical upsampling, the lines are processed 8 columns at a time
+    const __m256i vRound = _mm256_set1_epi32( roundingOffset );
+
+    for( int x = 0; x < srcSizeOrthDim; x += 8 )
+    {
+      __m256i vBefore = _mm256_loadu_si256( ( const __m256i* ) &bndry[x] );
+      int*    currDst = dst + x;
+
+      for( int idx = 0; idx < srcSizeUpsmpDim; idx++ )
+      {
+        const __m256i vBehind = _mm256_loadu_si256( ( const __m256i* ) &src[idx * srcStep + x] );
+        const __m256i vDelta  = _mm256_sub_epi32( vBehind, vBefore );
+        __m256i       vScaled = _mm256_slli_epi32( vBefore, log2UpsmpFactor );
+
+        for( int pos = 0; pos < int( upsmpFactor ); pos++, currDst += dstStep )
+        {
+          vScaled = _mm256_add_epi32( vScaled, vDelta );
+          _mm256_storeu_si256( ( __m256i* ) currDst, _mm256_srai_epi32( _mm256_add_epi32( vScaled, vRound ), log2UpsmpFactor ) );
+        }
+        vBefore = vBehind;
+      }
+    }
+  }
+  else if( srcStep == 1 && dstStep == 1 && srcSizeUpsmpDim <= 8 )
+  {
+    // horizontal upsampling, the source position and the weights of each output column are gathered once
+    const int     numOut = srcSizeUpsmpDim << log2UpsmpFactor;
+    const __m256i vRound = _mm256_set1_epi32( roundingOffset );
+    const __m256i vFact  = _mm256_set1_epi32( upsmpFactor );
+    const __m256i vMask  = _mm256_set1_epi32( upsmpFactor - 1 );
+    const __m256i vOne   = _mm256_set1_epi32( 1 );
+
+    ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int line[16] ) = { 0 };
+
+    for( int y = 0; y < srcSizeOrthDim; y++ )
+    {
+      const int* srcLine = src + y * srcStride;
+      int*       dstLine = dst + y * dstStride;
+
+      line[0] = bndry[bndryStep - 1 + y * bndryStep];
+      for( int i = 0; i < srcSizeUpsmpDim; i++ )
+      {
+        line[i + 1] = srcLine[i];
+      }
+
+      const __m256i vBefore = _mm256_load_si256 ( ( const __m256i* ) &line[0] );
+      const __m256i vBehind = _mm256_loadu_si256( ( const __m256i* ) &line[1] );
+
+      for( int k = 0; k < numOut; k += 8 )
+      {
+        const __m256i vK    = _mm256_add_epi32( _mm256_set1_epi32( k ), _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ) );
+        const __m256i vIdx  = _mm256_srli_epi32( vK, log2UpsmpFactor );
+        const __m256i vPos  = _mm256_add_epi32( _mm256_and_si256( vK, vMask ), vOne );
+        const __m256i vSumA = _mm256_mullo_epi32( _mm256_permutevar8x32_epi32( vBefore, vIdx ), _mm256_sub_epi32( vFact, vPos ) );
+        const __m256i vSumB = _mm256_mullo_epi32( _mm256_permutevar8x32_epi32( vBehind, vIdx ), vPos );
+
+        _mm256_storeu_si256( ( __m256i* ) &dstLine[k], _mm256_srai_epi32( _mm256_add_epi32( _mm256_add_epi32( vSumA, vSumB ), vRound ), log2UpsmpFactor ) );
+      }
+    }
+  }
+  else
+  {
+    MatrixIntraPrediction::predictionUpsampling1DCore( dst, src, bndry, srcSizeUpsmpDim, srcSizeOrthDim, srcStep, srcStride, dstStep, dstStride, bndryStep, upsmpFactor );
+  }
+}
+
+template<X86_VEXT vext>
+static void boundaryDownsampling1D_SIMD( int* reducedDst, const int* const fullSrc, const SizeType srcLen, const SizeType dstLen )
+{
+  if( dstLen >= srcLen || ( srcLen & 3 ) )
+  {
+    MatrixIntraPrediction::boundaryDownsampling1DCore( reducedDst, fullSrc, srcLen, dstLen );
+    return;
+  }
+
+  // one level of pairwise horizontal additions per power of two of the downsampling factor
+  const int log2DownsmpFactor = floorLog2( srcLen / dstLen );
+
+  __m128i v[MIP_MAX_WIDTH / 4];
+  int     numVec = srcLen >> 2;
+
+  for( int i = 0; i < numVec; i++ )
+  {
+    v[i] = _mm_loadu_si128( ( const __m128i* ) &fullSrc[i * 4] );
+  }
+  for( int l = 0; l < log2DownsmpFactor; l++ )
+  {
+    if( numVec == 1 )
+    {
+      v[0] = _mm_hadd_epi32( v[0], v[0] );
+      continue;
+    }
+    numVec >>= 1;
+    for( int i = 0; i < numVec; i++ )
+    {
+      v[i] = _mm_hadd_epi32( v[2 * i], v[2 * i + 1] );
+    }
+  }
+
+  const __m128i vRes = _mm_srai_epi32( _mm_add_epi32( v[0], _mm_set1_epi32( 1 << ( log2DownsmpFactor - 1 ) ) ), log2DownsmpFactor );
+
+  if( dstLen == 4 )
+  {
+    _mm_storeu_si128( ( __m128i* ) reducedDst, vRes );
+  }
+  else
+  {
+    _mm_storel_epi64( ( __m128i* ) reducedDst, vRes );
+  }
+}
+
+template <X86_VEXT vext>
+void MatrixIntraPrediction::_initMatrixIntraPredictionX86()
+{
+  m_boundaryDownsampling1D     = boundaryDownsampling1D_SIMD<vext>;
+  m_predictionUpsampling1D     = predictionUpsampling1D_SIMD<vext>;
+  m_computeReducedPred         = computeReducedPred_SIMD<vext>;
+  m_computeReducedPredAllModes = computeReducedPredAllModes_SIMD<vext>;
+}
+
+template void MatrixIntraPrediction::_initMatrixIntraPredictionX86<SIMDX86>();
+
+//! \}
+
+#endif //TARGET_SIMD_X86
+#endif //ENABLE_SIMD_OPT_MIP
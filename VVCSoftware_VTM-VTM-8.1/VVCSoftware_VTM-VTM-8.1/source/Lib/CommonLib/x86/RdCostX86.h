@@ -0,0 +1,1337 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     RdCostX86.h
+    \brief    RD cost computation class, SIMD version
+*/
+
+#include <math.h>
+
+#include "CommonDefX86.h"
+#include "../RdCost.h"
+
+#ifdef TARGET_SIMD_X86
+
+//! \ingroup CommonLib
+//! \{
+
+// --------------------------------------------------------------------------------------------------------------------
+// SAD
+// --------------------------------------------------------------------------------------------------------------------
+
+// sum of absolute differences over 'rows' rows of 'width' samples, width has to be a multiple of 4
+template<X86_VEXT vext>
+static ALWAYS_INLINE uint32_t xSADRows_SIMD( const Pel* pOrg, const Pel* pCur, const int strideOrg, const int strideCur, const int width, int rows )
+{
+  const __m128i vone = _mm_set1_epi16( 1 );
+  __m128i vsum = _mm_setzero_si128();
+#ifdef USE_AVX2
+  const __m256i vone256 = _mm256_set1_epi16( 1 );
+  __m256i vsum256 = _mm256_setzero_si256();
+#endif
+#ifdef USE_AVX512
+  const __m512i vone512 = _mm512_set1_epi16( 1 );
+  __m512i vsum512 = _mm512_setzero_si512();
+#endif
+
+  for( ; rows != 0; rows-- )
+  {
+    int x = 0;
+#ifdef USE_AVX512
+    if( vext >= AVX512 )
+    {
+      for( ; x + 32 <= width; x += 32 )
+      {
+        const __m512i vorg = _mm512_loadu_si512( ( const void* ) &pOrg[x] );
+        const __m512i vcur = _mm512_loadu_si512( ( const void* ) &pCur[x] );
+        vsum512 = _mm512_add_epi32( vsum512, _mm512_madd_epi16( _mm512_abs_epi16( _mm512_sub_epi16( vorg, vcur ) ), vone512 ) );
+      }
+    }
+#endif
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i vorg = _mm256_loadu_si256( ( const __m256i* ) &pOrg[x] );
+        const __m256i vcur = _mm256_loadu_si256( ( const __m256i* ) &pCur[x] );
+        vsum256 = _mm256_add_epi32( vsum256, _mm256_madd_epi16( _mm256_abs_epi16( _mm256_sub_epi16( vorg, vcur ) ), vone256 ) );
+      }
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i vorg = _mm_loadu_si128( ( const __m128i* ) &pOrg[x] );
+      const __m128i vcur = _mm_loadu_si128( ( const __m128i* ) &pCur[x] );
+      vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_abs_epi16( _mm_sub_epi16( vorg, vcur ) ), vone ) );
+    }
+    if( x < width )
+    {
+      const __m128i vorg = _mm_loadl_epi64( ( const __m128i* ) &pOrg[x] );
+      const __m128i vcur = _mm_loadl_epi64( ( const __m128i* ) &pCur[x] );
+      vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_abs_epi16( _mm_sub_epi16( vorg, vcur ) ), vone ) );
+    }
+    pOrg += strideOrg;
+    pCur += strideCur;
+  }
+
+#ifdef USE_AVX512
+  if( vext >= AVX512 )
+  {
+    vsum256 = _mm256_add_epi32( vsum256, _mm256_add_epi32( _mm512_castsi512_si256( vsum512 ), _mm512_extracti64x4_epi64( vsum512, 1 ) ) );
+  }
+#endif
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    vsum = _mm_add_epi32( vsum, _mm_add_epi32( _mm256_castsi256_si128( vsum256 ), _mm256_extracti128_si256( vsum256, 1 ) ) );
+  }
+#endif
+  return ( uint32_t ) _mm_hsum_epi32( vsum );
+}
+
+template<X86_VEXT vext>
+Distortion RdCost::xGetSAD_SIMD( const DistParam &rcDtParam )
+{
+  const int width = rcDtParam.org.width;
+
+  if( width < 4 || ( width & 3 ) != 0 || rcDtParam.applyWeight )
+  {
+    return RdCost::xGetSAD( rcDtParam );
+  }
+
+  const int subShift  = rcDtParam.subShift;
+  const int subStep   = 1 << subShift;
+  const int strideOrg = rcDtParam.org.stride * subStep;
+  const int strideCur = rcDtParam.cur.stride * subStep;
+
+  Distortion sum = xSADRows_SIMD<vext>( rcDtParam.org.buf, rcDtParam.cur.buf, strideOrg, strideCur, width, rcDtParam.org.height >> subShift );
+
+  sum <<= subShift;
+  return sum >> DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth );
+}
+
+template<int iWidth, X86_VEXT vext>
+Distortion RdCost::xGetSAD_NxN_SIMD( const DistParam &rcDtParam )
+{
+  // the scalar 16N (128xM) kernel does not support weighted prediction either
+  if( iWidth != 128 && rcDtParam.applyWeight )
+  {
+    return RdCostWeightPrediction::xGetSADw( rcDtParam );
+  }
+
+  const int subShift  = rcDtParam.subShift;
+  const int subStep   = 1 << subShift;
+  const int strideOrg = rcDtParam.org.stride * subStep;
+  const int strideCur = rcDtParam.cur.stride * subStep;
+  const int width     = iWidth == 128 ? rcDtParam.org.width : iWidth;
+
+  Distortion sum = xSADRows_SIMD<vext>( rcDtParam.org.buf, rcDtParam.cur.buf, strideOrg, strideCur, width, rcDtParam.org.height >> subShift );
+
+  sum <<= subShift;
+  return sum >> DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth );
+}
+
+// SAD of intermediate (high bit depth) samples, differences do not fit into 16 bit
+template<X86_VEXT vext>
+Distortion RdCost::xGetSAD_IBD_SIMD( const DistParam &rcDtParam )
+{
+  const int width = rcDtParam.org.width;
+
+  if( width < 4 || ( width & 3 ) != 0 || rcDtParam.applyWeight )
+  {
+    return RdCost::xGetSAD( rcDtParam );
+  }
+
+  const int  subShift  = rcDtParam.subShift;
+  const int  subStep   = 1 << subShift;
+  const int  strideOrg = rcDtParam.org.stride * subStep;
+  const int  strideCur = rcDtParam.cur.stride * subStep;
+  const Pel* pOrg      = rcDtParam.org.buf;
+  const Pel* pCur      = rcDtParam.cur.buf;
+
+  __m128i vsum = _mm_setzero_si128();
+#ifdef USE_AVX2
+  __m256i vsum256 = _mm256_setzero_si256();
+#endif
+
+  for( int rows = rcDtParam.org.height >> subShift; rows != 0; rows-- )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 8 <= width; x += 8 )
+      {
+        const __m256i vorg = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &pOrg[x] ) );
+        const __m256i vcur = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &pCur[x] ) );
+        vsum256 = _mm256_add_epi32( vsum256, _mm256_abs_epi32( _mm256_sub_epi32( vorg, vcur ) ) );
+      }
+    }
+#endif
+    for( ; x < width; x += 4 )
+    {
+      const __m128i vorg = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pOrg[x] ) );
+      const __m128i vcur = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pCur[x] ) );
+      vsum = _mm_add_epi32( vsum, _mm_abs_epi32( _mm_sub_epi32( vorg, vcur ) ) );
+    }
+    pOrg += strideOrg;
+    pCur += strideCur;
+  }
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    vsum = _mm_add_epi32( vsum, _mm_add_epi32( _mm256_castsi256_si128( vsum256 ), _mm256_extracti128_si256( vsum256, 1 ) ) );
+  }
+#endif
+
+  Distortion sum = ( uint32_t ) _mm_hsum_epi32( vsum );
+  sum <<= subShift;
+  return sum >> DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth );
+}
+
+// DMVR costs of the integer search grid, all horizontal offsets of a vertical offset are accumulated in one pass over
+// the rows. The bilinear DMVR samples have 10 bit, so the differences fit into 16 bit.
+template<X86_VEXT vext>
+void RdCost::xGetDmvrCosts_SIMD( const Pel* pRefL0, const Pel* pRefL1, int stride, int width, int height, int bitDepth, Distortion* pCosts )
+{
+  if( ( width & 7 ) != 0 )
+  {
+    RdCost::xGetDmvrCosts( pRefL0, pRefL1, stride, width, height, bitDepth, pCosts );
+    return;
+  }
+
+  const int range   = DMVR_NUM_ITERATION;
+  const int numPos  = 2 * range + 1;
+  const int rowStep = stride << 1;
+
+  for( int offY = -range; offY <= range; offY++ )
+  {
+    // position i of the row corresponds to the horizontal offset i - range, L1 is displaced in the opposite direction
+    const Pel* pL0 = pRefL0 + offY * stride - range;
+    const Pel* pL1 = pRefL1 - offY * stride + range;
+    uint32_t   sum[numPos];
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 && ( ( width & 15 ) == 0 || ( height & 3 ) == 0 ) )
+    {
+      const __m256i vone = _mm256_set1_epi16( 1 );
+      __m256i       vsum[numPos];
+
+      for( int i = 0; i < numPos; i++ )
+      {
+        vsum[i] = _mm256_setzero_si256();
+      }
+
+      if( ( width & 15 ) == 0 )
+      {
+        for( int y = 0; y < height; y += 2, pL0 += rowStep, pL1 += rowStep )
+        {
+          for( int x = 0; x < width; x += 16 )
+          {
+            for( int i = 0; i < numPos; i++ )
+            {
+              const __m256i vl0 = _mm256_loadu_si256( ( const __m256i* ) &pL0[x + i] );
+              const __m256i vl1 = _mm256_loadu_si256( ( const __m256i* ) &pL1[x - i] );
+              vsum[i] = _mm256_add_epi32( vsum[i], _mm256_madd_epi16( _mm256_abs_epi16( _mm256_sub_epi16( vl0, vl1 ) ), vone ) );
+            }
+          }
+        }
+      }
+      else
+      {
+        // two of the used rows in one register
+        for( int y = 0; y < height; y += 4, pL0 += 2 * rowStep, pL1 += 2 * rowStep )
+        {
+          for( int x = 0; x < width; x += 8 )
+          {
+            for( int i = 0; i < numPos; i++ )
+            {
+              const __m256i vl0 = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* ) &pL0[x + i] ) ), _mm_loadu_si128( ( const __m128i* ) &pL0[rowStep + x + i] ), 1 );
+              const __m256i vl1 = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* ) &pL1[x - i] ) ), _mm_loadu_si128( ( const __m128i* ) &pL1[rowStep + x - i] ), 1 );
+              vsum[i] = _mm256_add_epi32( vsum[i], _mm256_madd_epi16( _mm256_abs_epi16( _mm256_sub_epi16( vl0, vl1 ) ), vone ) );
+            }
+          }
+        }
+      }
+
+      for( int i = 0; i < numPos; i++ )
+      {
+        sum[i] = ( uint32_t ) _mm256_hsum_epi32( vsum[i] );
+      }
+    }
+    else
+#endif
+    {
+      const __m128i vone = _mm_set1_epi16( 1 );
+      __m128i       vsum[numPos];
+
+      for( int i = 0; i < numPos; i++ )
+      {
+        vsum[i] = _mm_setzero_si128();
+      }
+
+      for( int y = 0; y < height; y += 2, pL0 += rowStep, pL1 += rowStep )
+      {
+        for( int x = 0; x < width; x += 8 )
+        {
+          for( int i = 0; i < numPos; i++ )
+          {
+            const __m128i vl0 = _mm_loadu_si128( ( const __m128i* ) &pL0[x + i] );
+            const __m128i vl1 = _mm_loadu_si128( ( const __m128i* ) &pL1[x - i] );
+            vsum[i] = _mm_add_epi32( vsum[i], _mm_madd_epi16( _mm_abs_epi16( _mm_sub_epi16( vl0, vl1 ) ), vone ) );
+          }
+        }
+      }
+
+      for( int i = 0; i < numPos; i++ )
+      {
+        sum[i] = ( uint32_t ) _mm_hsum_epi32( vsum[i] );
+      }
+    }
+
+    for( int i = 0; i < numPos; i++ )
+    {
+      *pCosts++ = ( Distortion( sum[i] ) << 1 ) >> DISTORTION_PRECISION_ADJUSTMENT( bitDepth );
+    }
+  }
+}
+
+// mean-removed SAD, the offset is derived exactly as in the scalar version
+template<X86_VEXT vext>
+Distortion RdCost::xGetMRSAD_SIMD( const DistParam &rcDtParam )
+{
+  const int width = rcDtParam.org.width;
+
+  if( width < 4 || ( width & 3 ) != 0 )
+  {
+    return RdCost::xGetMRSAD( rcDtParam );
+  }
+
+  const int  subShift  = rcDtParam.subShift;
+  const int  subStep   = 1 << subShift;
+  const int  strideOrg = rcDtParam.org.stride * subStep;
+  const int  strideCur = rcDtParam.cur.stride * subStep;
+  const int  rows      = rcDtParam.org.height >> subShift;
+  const __m128i vone   = _mm_set1_epi16( 1 );
+
+  const Pel* pOrg = rcDtParam.org.buf;
+  const Pel* pCur = rcDtParam.cur.buf;
+  __m128i vdelta = _mm_setzero_si128();
+
+  for( int y = 0; y < rows; y++, pOrg += strideOrg, pCur += strideCur )
+  {
+    int x = 0;
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i vorg = _mm_loadu_si128( ( const __m128i* ) &pOrg[x] );
+      const __m128i vcur = _mm_loadu_si128( ( const __m128i* ) &pCur[x] );
+      vdelta = _mm_add_epi32( vdelta, _mm_madd_epi16( _mm_sub_epi16( vorg, vcur ), vone ) );
+    }
+    if( x < width )
+    {
+      const __m128i vorg = _mm_loadl_epi64( ( const __m128i* ) &pOrg[x] );
+      const __m128i vcur = _mm_loadl_epi64( ( const __m128i* ) &pCur[x] );
+      vdelta = _mm_add_epi32( vdelta, _mm_madd_epi16( _mm_sub_epi16( vorg, vcur ), vone ) );
+    }
+  }
+
+  const Pel     offset  = Pel( _mm_hsum_epi32( vdelta ) / ( width * rows ) );
+  const __m128i voffset = _mm_set1_epi16( offset );
+  __m128i vsum = _mm_setzero_si128();
+#ifdef USE_AVX2
+  const __m256i vone256    = _mm256_set1_epi16( 1 );
+  const __m256i voffset256 = _mm256_set1_epi16( offset );
+  __m256i vsum256 = _mm256_setzero_si256();
+#endif
+
+  pOrg = rcDtParam.org.buf;
+  pCur = rcDtParam.cur.buf;
+
+  for( int y = 0; y < rows; y++, pOrg += strideOrg, pCur += strideCur )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i vorg = _mm256_loadu_si256( ( const __m256i* ) &pOrg[x] );
+        const __m256i vcur = _mm256_loadu_si256( ( const __m256i* ) &pCur[x] );
+        const __m256i vdif = _mm256_sub_epi16( _mm256_sub_epi16( vorg, vcur ), voffset256 );
+        vsum256 = _mm256_add_epi32( vsum256, _mm256_madd_epi16( _mm256_abs_epi16( vdif ), vone256 ) );
+      }
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i vorg = _mm_loadu_si128( ( const __m128i* ) &pOrg[x] );
+      const __m128i vcur = _mm_loadu_si128( ( const __m128i* ) &pCur[x] );
+      const __m128i vdif = _mm_sub_epi16( _mm_sub_epi16( vorg, vcur ), voffset );
+      vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_abs_epi16( vdif ), vone ) );
+    }
+    if( x < width )
+    {
+      const __m128i vorg = _mm_loadl_epi64( ( const __m128i* ) &pOrg[x] );
+      const __m128i vcur = _mm_loadl_epi64( ( const __m128i* ) &pCur[x] );
+      // keep the unused upper half from adding |offset|
+      const __m128i vdif = _mm_unpacklo_epi64( _mm_sub_epi16( _mm_sub_epi16( vorg, vcur ), voffset ), _mm_setzero_si128() );
+      vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_abs_epi16( vdif ), vone ) );
+    }
+  }
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    vsum = _mm_add_epi32( vsum, _mm_add_epi32( _mm256_castsi256_si128( vsum256 ), _mm256_extracti128_si256( vsum256, 1 ) ) );
+  }
+#endif
+
+  Distortion sum = ( uint32_t ) _mm_hsum_epi32( vsum );
+  sum <<= subShift;
+  return sum >> DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth );
+}
+
+#if JVET_Q0806
+template<X86_VEXT vext>
+Distortion RdCost::xGetSADwMask_SIMD( const DistParam &rcDtParam )
+{
+  const int cols = rcDtParam.org.width;
+
+  if( ( cols & 7 ) != 0 || rcDtParam.applyWeight )
+  {
+    return RdCost::xGetSADwMask( rcDtParam );
+  }
+
+  const Pel* org        = rcDtParam.org.buf;
+  const Pel* cur        = rcDtParam.cur.buf;
+  const Pel* mask       = rcDtParam.mask;
+  const int  subShift   = rcDtParam.subShift;
+  const int  subStep    = 1 << subShift;
+  const int  strideCur  = rcDtParam.cur.stride * subStep;
+  const int  strideOrg  = rcDtParam.org.stride * subStep;
+  const int  strideMask = rcDtParam.maskStride * subStep + rcDtParam.maskStride2;
+  const int  stepX      = rcDtParam.stepX;
+
+  // mirrored masks (stepX == -1) are read backwards and reversed in register
+  const __m128i vrev = _mm_setr_epi8( 14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1 );
+  __m128i vsum = _mm_setzero_si128();
+#ifdef USE_AVX2
+  const __m256i vrev256 = _mm256_broadcastsi128_si256( vrev );
+  __m256i vsum256 = _mm256_setzero_si256();
+#endif
+
+  for( int rows = rcDtParam.org.height; rows > 0; rows -= subStep )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 16 <= cols; x += 16 )
+      {
+        const __m256i vorg = _mm256_loadu_si256( ( const __m256i* ) &org[x] );
+        const __m256i vcur = _mm256_loadu_si256( ( const __m256i* ) &cur[x] );
+        __m256i vmask;
+        if( stepX == 1 )
+        {
+          vmask = _mm256_loadu_si256( ( const __m256i* ) &mask[x] );
+        }
+        else
+        {
+          vmask = _mm256_loadu_si256( ( const __m256i* ) &mask[-x - 15] );
+          vmask = _mm256_permute4x64_epi64( _mm256_shuffle_epi8( vmask, vrev256 ), 0x4e );
+        }
+        vsum256 = _mm256_add_epi32( vsum256, _mm256_madd_epi16( _mm256_abs_epi16( _mm256_sub_epi16( vorg, vcur ) ), vmask ) );
+      }
+    }
+#endif
+    for( ; x < cols; x += 8 )
+    {
+      const __m128i vorg = _mm_loadu_si128( ( const __m128i* ) &org[x] );
+      const __m128i vcur = _mm_loadu_si128( ( const __m128i* ) &cur[x] );
+      __m128i vmask;
+      if( stepX == 1 )
+      {
+        vmask = _mm_loadu_si128( ( const __m128i* ) &mask[x] );
+      }
+      else
+      {
+        vmask = _mm_shuffle_epi8( _mm_loadu_si128( ( const __m128i* ) &mask[-x - 7] ), vrev );
+      }
+      vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_abs_epi16( _mm_sub_epi16( vorg, vcur ) ), vmask ) );
+    }
+    org  += strideOrg;
+    cur  += strideCur;
+    mask += stepX * cols + strideMask;
+  }
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    vsum = _mm_add_epi32( vsum, _mm_add_epi32( _mm256_castsi256_si128( vsum256 ), _mm256_extracti128_si256( vsum256, 1 ) ) );
+  }
+#endif
+
+  Distortion sum = ( uint32_t ) _mm_hsum_epi32( vsum );
+  sum <<= subShift;
+  return sum >> DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth );
+}
+#endif
+
+// --------------------------------------------------------------------------------------------------------------------
+// SSE
+// --------------------------------------------------------------------------------------------------------------------
+
+template<X86_VEXT vext>
+static ALWAYS_INLINE Distortion xSSERows_SIMD( const Pel* pOrg, const Pel* pCur, const int strideOrg, const int strideCur, const int width, int rows )
+{
+  // squared differences are accumulated in 64 bit to be safe for all bit depths
+  const __m128i vzero = _mm_setzero_si128();
+  __m128i vsum = _mm_setzero_si128();
+#ifdef USE_AVX2
+  const __m256i vzero256 = _mm256_setzero_si256();
+  __m256i vsum256 = _mm256_setzero_si256();
+#endif
+#ifdef USE_AVX512
+  const __m512i vzero512 = _mm512_setzero_si512();
+  __m512i vsum512 = _mm512_setzero_si512();
+#endif
+
+  for( ; rows != 0; rows-- )
+  {
+    int x = 0;
+#ifdef USE_AVX512
+    if( vext >= AVX512 )
+    {
+      for( ; x + 32 <= width; x += 32 )
+      {
+        const __m512i vorg = _mm512_loadu_si512( ( const void* ) &pOrg[x] );
+        const __m512i vcur = _mm512_loadu_si512( ( const void* ) &pCur[x] );
+        const __m512i vdif = _mm512_sub_epi16( vorg, vcur );
+        const __m512i vsqr = _mm512_madd_epi16( vdif, vdif );
+        vsum512 = _mm512_add_epi64( vsum512, _mm512_unpacklo_epi32( vsqr, vzero512 ) );
+        vsum512 = _mm512_add_epi64( vsum512, _mm512_unpackhi_epi32( vsqr, vzero512 ) );
+      }
+    }
+#endif
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i vorg = _mm256_loadu_si256( ( const __m256i* ) &pOrg[x] );
+        const __m256i vcur = _mm256_loadu_si256( ( const __m256i* ) &pCur[x] );
+        const __m256i vdif = _mm256_sub_epi16( vorg, vcur );
+        const __m256i vsqr = _mm256_madd_epi16( vdif, vdif );
+        vsum256 = _mm256_add_epi64( vsum256, _mm256_unpacklo_epi32( vsqr, vzero256 ) );
+        vsum256 = _mm256_add_epi64( vsum256, _mm256_unpackhi_epi32( vsqr, vzero256 ) );
+      }
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i vorg = _mm_loadu_si128( ( const __m128i* ) &pOrg[x] );
+      const __m128i vcur = _mm_loadu_si128( ( const __m128i* ) &pCur[x] );
+      const __m128i vdif = _mm_sub_epi16( vorg, vcur );
+      const __m128i vsqr = _mm_madd_epi16( vdif, vdif );
+      vsum = _mm_add_epi64( vsum, _mm_unpacklo_epi32( vsqr, vzero ) );
+      vsum = _mm_add_epi64( vsum, _mm_unpackhi_epi32( vsqr, vzero ) );
+    }
+    if( x < width )
+    {
+      const __m128i vorg = _mm_loadl_epi64( ( const __m128i* ) &pOrg[x] );
+      const __m128i vcur = _mm_loadl_epi64( ( const __m128i* ) &pCur[x] );
+      const __m128i vdif = _mm_sub_epi16( vorg, vcur );
+      vsum = _mm_add_epi64( vsum, _mm_unpacklo_epi32( _mm_madd_epi16( vdif, vdif ), vzero ) );
+    }
+    pOrg += strideOrg;
+    pCur += strideCur;
+  }
+
+#ifdef USE_AVX512
+  if( vext >= AVX512 )
+  {
+    vsum256 = _mm256_add_epi64( vsum256, _mm256_add_epi64( _mm512_castsi512_si256( vsum512 ), _mm512_extracti64x4_epi64( vsum512, 1 ) ) );
+  }
+#endif
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    vsum = _mm_add_epi64( vsum, _mm_add_epi64( _mm256_castsi256_si128( vsum256 ), _mm256_extracti128_si256( vsum256, 1 ) ) );
+  }
+#endif
+  return ( Distortion ) _mm_hsum_epi64( vsum );
+}
+
+template<X86_VEXT vext>
+Distortion RdCost::xGetSSE_SIMD( const DistParam &rcDtParam )
+{
+  const int width = rcDtParam.org.width;
+
+  if( width < 4 || ( width & 3 ) != 0 || rcDtParam.applyWeight || DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth ) != 0 )
+  {
+    return RdCost::xGetSSE( rcDtParam );
+  }
+
+  return xSSERows_SIMD<vext>( rcDtParam.org.buf, rcDtParam.cur.buf, rcDtParam.org.stride, rcDtParam.cur.stride, width, rcDtParam.org.height );
+}
+
+template<int iWidth, X86_VEXT vext>
+Distortion RdCost::xGetSSE_NxN_SIMD( const DistParam &rcDtParam )
+{
+  if( rcDtParam.applyWeight || DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth ) != 0 )
+  {
+    return RdCost::xGetSSE( rcDtParam );
+  }
+
+  const int width = iWidth == 128 ? rcDtParam.org.width : iWidth;
+
+  return xSSERows_SIMD<vext>( rcDtParam.org.buf, rcDtParam.cur.buf, rcDtParam.org.stride, rcDtParam.cur.stride, width, rcDtParam.org.height );
+}
+
+#if WCG_EXT
+// luma level weighted SSE, identical to summing up getWeightedMSE() per sample
+template<X86_VEXT vext>
+Distortion RdCost::xGetSSE_WTD_SIMD( const DistParam &rcDtParam )
+{
+  const int width = rcDtParam.org.width;
+
+  if( width < 4 || ( width & 3 ) != 0 || rcDtParam.applyWeight || DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth ) != 0
+      || rcDtParam.cShiftX < 0 || rcDtParam.cShiftX > 1 )
+  {
+    return RdCost::xGetSSE_WTD( rcDtParam );
+  }
+
+  const Pel*    pOrg        = rcDtParam.org.buf;
+  const Pel*    pCur        = rcDtParam.cur.buf;
+  const Pel*    pOrgLuma    = rcDtParam.orgLuma.buf;
+  const int     strideOrg   = rcDtParam.org.stride;
+  const int     strideCur   = rcDtParam.cur.stride;
+  const int     strideLuma  = rcDtParam.orgLuma.stride << rcDtParam.cShiftY;
+  const int     cShiftX     = rcDtParam.cShiftX;
+  const double* weightLUT   = m_reshapeLumaLevelToWeightPLUT.data();
+  const bool    constWeight = ( m_signalType == RESHAPE_SIGNAL_SDR || m_signalType == RESHAPE_SIGNAL_HLG ) && rcDtParam.compID != COMPONENT_Y;
+
+  // weights are converted to 16 bit fixed point exactly as the scalar version does,
+  // (int64_t)( w * 2^16 ) equals the truncating 32 bit conversion for all weights below 2^15
+  const __m128d vscale  = _mm_set1_pd( double( 1 << 16 ) );
+  const __m128i vconstW = _mm_cvttpd_epi32( _mm_mul_pd( _mm_set1_pd( m_chromaWeight ), vscale ) );
+  const __m128i vround  = _mm_set1_epi64x( 1 << 15 );
+  const __m128i vmaskLo = _mm_set1_epi32( 0xffff );
+  __m128i vsum = _mm_setzero_si128();
+
+  for( int y = 0; y < rcDtParam.org.height; y++ )
+  {
+    for( int x = 0; x < width; x += 4 )
+    {
+      const __m128i vorg = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pOrg[x] ) );
+      const __m128i vcur = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pCur[x] ) );
+      const __m128i vdif = _mm_sub_epi32( vorg, vcur );
+      const __m128i vsqr = _mm_mullo_epi32( vdif, vdif );
+
+      __m128i vwgt;
+      if( constWeight )
+      {
+        vwgt = _mm_shuffle_epi32( vconstW, 0 );
+      }
+      else
+      {
+        // luma levels of the (co-located) samples as 32 bit indices
+        const __m128i vidx = cShiftX ? _mm_and_si128( _mm_loadu_si128( ( const __m128i* ) &pOrgLuma[x << 1] ), vmaskLo )
+                                     : _mm_cvtepu16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pOrgLuma[x] ) );
+#ifdef USE_AVX2
+        if( vext >= AVX2 )
+        {
+          // masked gather with an explicit source, the plain one triggers false uninitialized warnings
+          const __m256d vlut = _mm256_mask_i32gather_pd( _mm256_setzero_pd(), weightLUT, vidx, _mm256_castsi256_pd( _mm256_set1_epi64x( -1 ) ), 8 );
+          vwgt = _mm256_cvttpd_epi32( _mm256_mul_pd( vlut, _mm256_set1_pd( double( 1 << 16 ) ) ) );
+        }
+        else
+#endif
+        {
+          const __m128i vw01 = _mm_cvttpd_epi32( _mm_mul_pd( _mm_setr_pd( weightLUT[_mm_extract_epi32( vidx, 0 )], weightLUT[_mm_extract_epi32( vidx, 1 )] ), vscale ) );
+          const __m128i vw23 = _mm_cvttpd_epi32( _mm_mul_pd( _mm_setr_pd( weightLUT[_mm_extract_epi32( vidx, 2 )], weightLUT[_mm_extract_epi32( vidx, 3 )] ), vscale ) );
+          vwgt = _mm_unpacklo_epi64( vw01, vw23 );
+        }
+      }
+
+      // 64 bit products: even lanes, then odd lanes
+      __m128i vmse0 = _mm_srli_epi64( _mm_add_epi64( _mm_mul_epi32( vwgt, vsqr ), vround ), 16 );
+      __m128i vmse1 = _mm_srli_epi64( _mm_add_epi64( _mm_mul_epi32( _mm_srli_epi64( vwgt, 32 ), _mm_srli_epi64( vsqr, 32 ) ), vround ), 16 );
+      // the scalar version truncates the weighted error to Intermediate_Int
+      vmse0 = _mm_cvtepi32_epi64( _mm_shuffle_epi32( vmse0, 0x08 ) );
+      vmse1 = _mm_cvtepi32_epi64( _mm_shuffle_epi32( vmse1, 0x08 ) );
+      vsum  = _mm_add_epi64( vsum, _mm_add_epi64( vmse0, vmse1 ) );
+    }
+    pOrg     += strideOrg;
+    pCur     += strideCur;
+    pOrgLuma += strideLuma;
+  }
+
+  return ( Distortion ) _mm_hsum_epi64( vsum );
+}
+#endif
+
+template<X86_VEXT vext>
+Distortion RdCost::xGetPlaneSSE_SIMD( const Pel* pSrc0, int stride0, const Pel* pSrc1, int stride1, int width, int height )
+{
+  // xSSERows_SIMD handles multiples of 4 samples, the remaining columns are done by the scalar version
+  const int widthSIMD = width & ~3;
+  Distortion uiSum = widthSIMD ? xSSERows_SIMD<vext>( pSrc0, pSrc1, stride0, stride1, widthSIMD, height ) : 0;
+
+  if( widthSIMD < width )
+  {
+    uiSum += xGetPlaneSSE( pSrc0 + widthSIMD, stride0, pSrc1 + widthSIMD, stride1, width - widthSIMD, height );
+  }
+
+  return uiSum;
+}
+
+#if WCG_WPSNR
+// the weighted squared errors are the same as in the scalar version, but they are summed up in a different order
+template<X86_VEXT vext>
+double RdCost::xGetPlaneWtdSSE_SIMD( const Pel* pSrc0, int stride0, const Pel* pSrc1, int stride1, const Pel* pLuma, int strideLuma, int csx, int csy, int width, int height, const double* weightLUT )
+{
+  if( csx > 1 )
+  {
+    return xGetPlaneWtdSSE( pSrc0, stride0, pSrc1, stride1, pLuma, strideLuma, csx, csy, width, height, weightLUT );
+  }
+
+  const int     widthSIMD = width & ~3;
+  const __m128i vmaskLo   = _mm_set1_epi32( 0xffff );
+  __m128d vsum0 = _mm_setzero_pd();
+  __m128d vsum1 = _mm_setzero_pd();
+#ifdef USE_AVX2
+  __m256d vsum256 = _mm256_setzero_pd();
+#endif
+  double dSum = 0;
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < widthSIMD; x += 4 )
+    {
+      const __m128i vdif = _mm_sub_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pSrc0[x] ) ),
+                                          _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pSrc1[x] ) ) );
+      // luma levels of the (co-located) samples as 32 bit indices
+      const __m128i vidx = csx ? _mm_and_si128( _mm_loadu_si128( ( const __m128i* ) &pLuma[x << 1] ), vmaskLo )
+                               : _mm_cvtepu16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pLuma[x] ) );
+#ifdef USE_AVX2
+      if( vext >= AVX2 )
+      {
+        const __m256d vdif256 = _mm256_cvtepi32_pd( vdif );
+        const __m256d vwgt256 = _mm256_mask_i32gather_pd( _mm256_setzero_pd(), weightLUT, vidx, _mm256_castsi256_pd( _mm256_set1_epi64x( -1 ) ), 8 );
+        vsum256 = _mm256_add_pd( vsum256, _mm256_mul_pd( _mm256_mul_pd( vwgt256, vdif256 ), vdif256 ) );
+      }
+      else
+#endif
+      {
+        const __m128d vdif01 = _mm_cvtepi32_pd( vdif );
+        const __m128d vdif23 = _mm_cvtepi32_pd( _mm_srli_si128( vdif, 8 ) );
+        const __m128d vwgt01 = _mm_setr_pd( weightLUT[_mm_extract_epi32( vidx, 0 )], weightLUT[_mm_extract_epi32( vidx, 1 )] );
+        const __m128d vwgt23 = _mm_setr_pd( weightLUT[_mm_extract_epi32( vidx, 2 )], weightLUT[_mm_extract_epi32( vidx, 3 )] );
+        vsum0 = _mm_add_pd( vsum0, _mm_mul_pd( _mm_mul_pd( vwgt01, vdif01 ), vdif01 ) );
+        vsum1 = _mm_add_pd( vsum1, _mm_mul_pd( _mm_mul_pd( vwgt23, vdif23 ), vdif23 ) );
+      }
+    }
+    for( int x = widthSIMD; x < width; x++ )
+    {
+      Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
+      dSum += weightLUT[pLuma[x << csx]] * ( double ) iTemp * ( double ) iTemp;
+    }
+    pSrc0 += stride0;
+    pSrc1 += stride1;
+    pLuma += strideLuma << csy;
+  }
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    vsum0 = _mm_add_pd( vsum0, _mm256_castpd256_pd128( vsum256 ) );
+    vsum1 = _mm_add_pd( vsum1, _mm256_extractf128_pd( vsum256, 1 ) );
+  }
+#endif
+  vsum0 = _mm_add_pd( vsum0, vsum1 );
+  return dSum + _mm_cvtsd_f64( vsum0 ) + _mm_cvtsd_f64( _mm_unpackhi_pd( vsum0, vsum0 ) );
+}
+#endif
+
+// --------------------------------------------------------------------------------------------------------------------
+// HADAMARD
+// --------------------------------------------------------------------------------------------------------------------
+
+// in-place N-point Walsh-Hadamard butterflies across N registers of 32 bit lanes
+template<int N>
+static ALWAYS_INLINE void xHadamard1D( __m128i* r )
+{
+  static_assert( N == 4 || N == 8 || N == 16, "Unsupported transform size" );
+  // constant trip counts so that the stages are fully unrolled
+  for( int s = 0; s < ( N == 16 ? 4 : N == 8 ? 3 : 2 ); s++ )
+  {
+    const int h = 1 << s;
+    for( int k = 0; k < N / 2; k++ )
+    {
+      const int j = ( ( k >> s ) << ( s + 1 ) ) + ( k & ( h - 1 ) );
+      const __m128i a = r[j];
+      const __m128i b = r[j + h];
+      r[j    ] = _mm_add_epi32( a, b );
+      r[j + h] = _mm_sub_epi32( a, b );
+    }
+  }
+}
+
+// sum of absolute 2D Hadamard coefficients of a H x W block of differences, using 4x4 transposes
+template<int W, int H>
+static ALWAYS_INLINE uint32_t xCalcHAD_SSE( const Pel* pOrg, const Pel* pCur, const int strideOrg, const int strideCur )
+{
+  static_assert( W % 4 == 0 && H % 4 == 0, "Unsupported block size" );
+  __m128i m[H][W / 4];
+  __m128i t[W][H / 4];
+  __m128i v[W > H ? W : H];
+
+  for( int y = 0; y < H; y++, pOrg += strideOrg, pCur += strideCur )
+  {
+    for( int k = 0; k < W / 4; k++ )
+    {
+      const __m128i vorg = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pOrg[k << 2] ) );
+      const __m128i vcur = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pCur[k << 2] ) );
+      m[y][k] = _mm_sub_epi32( vorg, vcur );
+    }
+  }
+
+  // vertical
+  for( int k = 0; k < W / 4; k++ )
+  {
+    for( int y = 0; y < H; y++ ) v[y] = m[y][k];
+    xHadamard1D<H>( v );
+    for( int y = 0; y < H; y++ ) m[y][k] = v[y];
+  }
+
+  // transpose
+  for( int j = 0; j < H / 4; j++ )
+  {
+    for( int k = 0; k < W / 4; k++ )
+    {
+      __m128i r0 = m[4 * j + 0][k], r1 = m[4 * j + 1][k], r2 = m[4 * j + 2][k], r3 = m[4 * j + 3][k];
+      _mm_transpose4x4_epi32( r0, r1, r2, r3 );
+      t[4 * k + 0][j] = r0;
+      t[4 * k + 1][j] = r1;
+      t[4 * k + 2][j] = r2;
+      t[4 * k + 3][j] = r3;
+    }
+  }
+
+  // horizontal
+  __m128i vsum = _mm_setzero_si128();
+  for( int j = 0; j < H / 4; j++ )
+  {
+    for( int x = 0; x < W; x++ ) v[x] = t[x][j];
+    xHadamard1D<W>( v );
+    for( int x = 0; x < W; x++ )
+    {
+      vsum = _mm_add_epi32( vsum, _mm_abs_epi32( v[x] ) );
+    }
+  }
+
+  return ( uint32_t ) _mm_hsum_epi32( vsum );
+}
+
+#ifdef USE_AVX2
+template<int N>
+static ALWAYS_INLINE void xHadamard1D( __m256i* r )
+{
+  for( int s = 0; s < ( N == 16 ? 4 : N == 8 ? 3 : 2 ); s++ )
+  {
+    const int h = 1 << s;
+    for( int k = 0; k < N / 2; k++ )
+    {
+      const int j = ( ( k >> s ) << ( s + 1 ) ) + ( k & ( h - 1 ) );
+      const __m256i a = r[j];
+      const __m256i b = r[j + h];
+      r[j    ] = _mm256_add_epi32( a, b );
+      r[j + h] = _mm256_sub_epi32( a, b );
+    }
+  }
+}
+
+// same as xCalcHAD_SSE using 8x8 transposes
+template<int W, int H>
+static ALWAYS_INLINE uint32_t xCalcHAD_AVX2( const Pel* pOrg, const Pel* pCur, const int strideOrg, const int strideCur )
+{
+  static_assert( W % 8 == 0 && H % 8 == 0, "Unsupported block size" );
+  __m256i m[H][W / 8];
+  __m256i t[W][H / 8];
+  __m256i v[W > H ? W : H];
+
+  for( int y = 0; y < H; y++, pOrg += strideOrg, pCur += strideCur )
+  {
+    for( int k = 0; k < W / 8; k++ )
+    {
+      const __m256i vorg = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &pOrg[k << 3] ) );
+      const __m256i vcur = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &pCur[k << 3] ) );
+      m[y][k] = _mm256_sub_epi32( vorg, vcur );
+    }
+  }
+
+  for( int k = 0; k < W / 8; k++ )
+  {
+    for( int y = 0; y < H; y++ ) v[y] = m[y][k];
+    xHadamard1D<H>( v );
+    for( int y = 0; y < H; y++ ) m[y][k] = v[y];
+  }
+
+  for( int j = 0; j < H / 8; j++ )
+  {
+    for( int k = 0; k < W / 8; k++ )
+    {
+      __m256i r[8];
+      for( int i = 0; i < 8; i++ ) r[i] = m[8 * j + i][k];
+      _mm256_transpose8x8_epi32( r );
+      for( int i = 0; i < 8; i++ ) t[8 * k + i][j] = r[i];
+    }
+  }
+
+  __m256i vsum = _mm256_setzero_si256();
+  for( int j = 0; j < H / 8; j++ )
+  {
+    for( int x = 0; x < W; x++ ) v[x] = t[x][j];
+    xHadamard1D<W>( v );
+    for( int x = 0; x < W; x++ )
+    {
+      vsum = _mm256_add_epi32( vsum, _mm256_abs_epi32( v[x] ) );
+    }
+  }
+
+  return ( uint32_t ) _mm256_hsum_epi32( vsum );
+}
+#endif
+
+template<int N>
+static ALWAYS_INLINE void xHadamard1D_16( __m128i* r )
+{
+  for( int s = 0; s < ( N == 16 ? 4 : N == 8 ? 3 : 2 ); s++ )
+  {
+    const int h = 1 << s;
+    for( int k = 0; k < N / 2; k++ )
+    {
+      const int j = ( ( k >> s ) << ( s + 1 ) ) + ( k & ( h - 1 ) );
+      const __m128i a = r[j];
+      const __m128i b = r[j + h];
+      r[j    ] = _mm_add_epi16( a, b );
+      r[j + h] = _mm_sub_epi16( a, b );
+    }
+  }
+}
+
+// H x W blocks with W a multiple of 8: the vertical pass runs on 16 bit lanes, which holds
+// for differences of up to 11 bits and H <= 16, the horizontal pass is widened to 32 bit
+template<int W, int H, X86_VEXT vext>
+static ALWAYS_INLINE uint32_t xCalcHAD_16bit( const Pel* pOrg, const Pel* pCur, const int strideOrg, const int strideCur )
+{
+  static_assert( W % 8 == 0 && H % 4 == 0 && H <= 16, "Unsupported block size" );
+  const int B = ( H + 7 ) / 8;
+  __m128i m[B * 8][W / 8];
+  __m128i v[H > 8 ? H : 8];
+
+  for( int y = 0; y < H; y++, pOrg += strideOrg, pCur += strideCur )
+  {
+    for( int k = 0; k < W / 8; k++ )
+    {
+      m[y][k] = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* ) &pOrg[k << 3] ), _mm_loadu_si128( ( const __m128i* ) &pCur[k << 3] ) );
+    }
+  }
+  for( int y = H; y < B * 8; y++ )
+  {
+    for( int k = 0; k < W / 8; k++ )
+    {
+      m[y][k] = _mm_setzero_si128();
+    }
+  }
+
+  // vertical, then transpose so that each register holds one column of 8 rows
+  __m128i t[W][B];
+  for( int k = 0; k < W / 8; k++ )
+  {
+    for( int y = 0; y < H; y++ ) v[y] = m[y][k];
+    xHadamard1D_16<H>( v );
+    for( int j = 0; j < B; j++ )
+    {
+      __m128i r[8];
+      for( int i = 0; i < 8; i++ ) r[i] = 8 * j + i < H ? v[8 * j + i] : _mm_setzero_si128();
+      _mm_transpose8x8_epi16( r );
+      for( int i = 0; i < 8; i++ ) t[8 * k + i][j] = r[i];
+    }
+  }
+
+  // horizontal
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    __m256i w[W];
+    __m256i vsum = _mm256_setzero_si256();
+    for( int j = 0; j < B; j++ )
+    {
+      for( int x = 0; x < W; x++ ) w[x] = _mm256_cvtepi16_epi32( t[x][j] );
+      xHadamard1D<W>( w );
+      for( int x = 0; x < W; x++ )
+      {
+        vsum = _mm256_add_epi32( vsum, _mm256_abs_epi32( w[x] ) );
+      }
+    }
+    return ( uint32_t ) _mm256_hsum_epi32( vsum );
+  }
+#endif
+  __m128i w[W];
+  __m128i vsum = _mm_setzero_si128();
+  for( int j = 0; j < B; j++ )
+  {
+    for( int half = 0; half < ( H < 8 ? 1 : 2 ); half++ )
+    {
+      for( int x = 0; x < W; x++ ) w[x] = _mm_cvtepi16_epi32( half ? _mm_unpackhi_epi64( t[x][j], t[x][j] ) : t[x][j] );
+      xHadamard1D<W>( w );
+      for( int x = 0; x < W; x++ )
+      {
+        vsum = _mm_add_epi32( vsum, _mm_abs_epi32( w[x] ) );
+      }
+    }
+  }
+  return ( uint32_t ) _mm_hsum_epi32( vsum );
+}
+
+template<int W, int H, X86_VEXT vext>
+static ALWAYS_INLINE uint32_t xCalcHAD_SIMD( const Pel* pOrg, const Pel* pCur, const int strideOrg, const int strideCur, const bool narrow )
+{
+  if( narrow && W % 8 == 0 )
+  {
+    return xCalcHAD_16bit<( W % 8 == 0 ? W : 8 ), H, vext>( pOrg, pCur, strideOrg, strideCur );
+  }
+#ifdef USE_AVX2
+  if( vext >= AVX2 && W % 8 == 0 && H % 8 == 0 )
+  {
+    return xCalcHAD_AVX2<( W % 8 == 0 ? W : 8 ), ( H % 8 == 0 ? H : 8 )>( pOrg, pCur, strideOrg, strideCur );
+  }
+#endif
+  return xCalcHAD_SSE<W, H>( pOrg, pCur, strideOrg, strideCur );
+}
+
+#ifdef USE_AVX512
+template<int N>
+static ALWAYS_INLINE void xHadamard1D( __m512i* r )
+{
+  for( int s = 0; s < ( N == 16 ? 4 : N == 8 ? 3 : 2 ); s++ )
+  {
+    const int h = 1 << s;
+    for( int k = 0; k < N / 2; k++ )
+    {
+      const int j = ( ( k >> s ) << ( s + 1 ) ) + ( k & ( h - 1 ) );
+      const __m512i a = r[j];
+      const __m512i b = r[j + h];
+      r[j    ] = _mm512_add_epi32( a, b );
+      r[j + h] = _mm512_sub_epi32( a, b );
+    }
+  }
+}
+
+template<int N>
+static ALWAYS_INLINE void xHadamard1D_16( __m512i* r )
+{
+  for( int s = 0; s < ( N == 16 ? 4 : N == 8 ? 3 : 2 ); s++ )
+  {
+    const int h = 1 << s;
+    for( int k = 0; k < N / 2; k++ )
+    {
+      const int j = ( ( k >> s ) << ( s + 1 ) ) + ( k & ( h - 1 ) );
+      const __m512i a = r[j];
+      const __m512i b = r[j + h];
+      r[j    ] = _mm512_add_epi16( a, b );
+      r[j + h] = _mm512_sub_epi16( a, b );
+    }
+  }
+}
+
+// the 32 x 8 area as 32 / W blocks of W x 8 (W = 8 or 16), which are normalized separately, with the 16 bit vertical
+// pass of xCalcHAD_16bit. After the transpose 128 bit lane l of register i holds the column 8 l + i.
+template<int W>
+static ALWAYS_INLINE void xCalcHAD32x8_AVX512( const Pel* pOrg, const Pel* pCur, const int strideOrg, const int strideCur, uint32_t* sad )
+{
+  static_assert( W == 8 || W == 16, "Unsupported block size" );
+  __m512i r[8];
+
+  for( int y = 0; y < 8; y++, pOrg += strideOrg, pCur += strideCur )
+  {
+    r[y] = _mm512_sub_epi16( _mm512_loadu_si512( ( const void* ) pOrg ), _mm512_loadu_si512( ( const void* ) pCur ) );
+  }
+
+  xHadamard1D_16<8>( r );
+  _mm512_transpose8x8_epi16( r );
+
+  // the blocks b and b + 1 are widened to the lower and upper half of the registers of the horizontal pass
+  for( int b = 0; b < 32 / W; b += 2 )
+  {
+    __m512i w[W];
+    for( int x = 0; x < W; x++ )
+    {
+      __m512i v;
+      if( W == 8 )
+      {
+        v = b ? _mm512_shuffle_i64x2( r[x], r[x], 0x0e ) : r[x];
+      }
+      else
+      {
+        v = x < 8 ? _mm512_shuffle_i64x2( r[x & 7], r[x & 7], 0x08 ) : _mm512_shuffle_i64x2( r[x & 7], r[x & 7], 0x0d );
+      }
+      w[x] = _mm512_cvtepi16_epi32( _mm512_castsi512_si256( v ) );
+    }
+
+    xHadamard1D<W>( w );
+
+    __m512i vsum = _mm512_setzero_si512();
+    for( int x = 0; x < W; x++ )
+    {
+      vsum = _mm512_add_epi32( vsum, _mm512_abs_epi32( w[x] ) );
+    }
+    sad[b    ] = ( uint32_t ) _mm256_hsum_epi32( _mm512_castsi512_si256( vsum ) );
+    sad[b + 1] = ( uint32_t ) _mm256_hsum_epi32( _mm512_extracti64x4_epi64( vsum, 1 ) );
+  }
+}
+#endif
+
+// block partitioning and normalization follow RdCost::xGetHADs
+template<X86_VEXT vext>
+Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
+{
+  if( rcDtParam.applyWeight )
+  {
+    return RdCostWeightPrediction::xGetHADsw( rcDtParam );
+  }
+
+  const Pel* pOrg      = rcDtParam.org.buf;
+  const Pel* pCur      = rcDtParam.cur.buf;
+  const int  rows      = rcDtParam.org.height;
+  const int  cols      = rcDtParam.org.width;
+  const int  strideCur = rcDtParam.cur.stride;
+  const int  strideOrg = rcDtParam.org.stride;
+
+  if( ( rows & 3 ) != 0 || ( cols & 3 ) != 0 || rcDtParam.step != 1 )
+  {
+    return RdCost::xGetHADs( rcDtParam );
+  }
+
+  // original and prediction samples of up to 10 bit allow a 16 bit first transform stage
+  const bool narrow = rcDtParam.bitDepth <= 10;
+
+  Distortion sum = 0;
+
+  if( cols > rows && ( rows & 7 ) == 0 && ( cols & 15 ) == 0 )
+  {
+    for( int y = 0; y < rows; y += 8, pOrg += strideOrg * 8, pCur += strideCur * 8 )
+    {
+      int x = 0;
+#ifdef USE_AVX512
+      if( vext >= AVX512 && narrow )
+      {
+        for( ; x + 32 <= cols; x += 32 )
+        {
+          uint32_t sad[2];
+          xCalcHAD32x8_AVX512<16>( &pOrg[x], &pCur[x], strideOrg, strideCur, sad );
+          sum += ( int ) ( sad[0] / sqrt( 16.0 * 8 ) * 2 );
+          sum += ( int ) ( sad[1] / sqrt( 16.0 * 8 ) * 2 );
+        }
+      }
+#endif
+      for( ; x < cols; x += 16 )
+      {
+        const int sad = xCalcHAD_SIMD<16, 8, vext>( &pOrg[x], &pCur[x], strideOrg, strideCur, narrow );
+        sum += ( int ) ( sad / sqrt( 16.0 * 8 ) * 2 );
+      }
+    }
+  }
+  else if( cols < rows && ( cols & 7 ) == 0 && ( rows & 15 ) == 0 )
+  {
+    for( int y = 0; y < rows; y += 16, pOrg += strideOrg * 16, pCur += strideCur * 16 )
+    {
+      for( int x = 0; x < cols; x += 8 )
+      {
+        const int sad = xCalcHAD_SIMD<8, 16, vext>( &pOrg[x], &pCur[x], strideOrg, strideCur, narrow );
+        sum += ( int ) ( sad / sqrt( 16.0 * 8 ) * 2 );
+      }
+    }
+  }
+  else if( cols > rows && ( rows & 3 ) == 0 && ( cols & 7 ) == 0 )
+  {
+    for( int y = 0; y < rows; y += 4, pOrg += strideOrg * 4, pCur += strideCur * 4 )
+    {
+      for( int x = 0; x < cols; x += 8 )
+      {
+        const int sad = xCalcHAD_SIMD<8, 4, vext>( &pOrg[x], &pCur[x], strideOrg, strideCur, narrow );
+        sum += ( int ) ( sad / sqrt( 4.0 * 8 ) * 2 );
+      }
+    }
+  }
+  else if( cols < rows && ( cols & 3 ) == 0 && ( rows & 7 ) == 0 )
+  {
+    for( int y = 0; y < rows; y += 8, pOrg += strideOrg * 8, pCur += strideCur * 8 )
+    {
+      for( int x = 0; x < cols; x += 4 )
+      {
+        const int sad = xCalcHAD_SIMD<4, 8, vext>( &pOrg[x], &pCur[x], strideOrg, strideCur, narrow );
+        sum += ( int ) ( sad / sqrt( 4.0 * 8 ) * 2 );
+      }
+    }
+  }
+  else if( ( rows & 7 ) == 0 && ( cols & 7 ) == 0 )
+  {
+    for( int y = 0; y < rows; y += 8, pOrg += strideOrg * 8, pCur += strideCur * 8 )
+    {
+      int x = 0;
+#ifdef USE_AVX512
+      if( vext >= AVX512 && narrow )
+      {
+        for( ; x + 32 <= cols; x += 32 )
+        {
+          uint32_t sad[4];
+          xCalcHAD32x8_AVX512<8>( &pOrg[x], &pCur[x], strideOrg, strideCur, sad );
+          sum += ( ( sad[0] + 2 ) >> 2 ) + ( ( sad[1] + 2 ) >> 2 ) + ( ( sad[2] + 2 ) >> 2 ) + ( ( sad[3] + 2 ) >> 2 );
+        }
+      }
+#endif
+      for( ; x < cols; x += 8 )
+      {
+        sum += ( xCalcHAD_SIMD<8, 8, vext>( &pOrg[x], &pCur[x], strideOrg, strideCur, narrow ) + 2 ) >> 2;
+      }
+    }
+  }
+  else
+  {
+    for( int y = 0; y < rows; y += 4, pOrg += strideOrg * 4, pCur += strideCur * 4 )
+    {
+      for( int x = 0; x < cols; x += 4 )
+      {
+        sum += ( xCalcHAD_SIMD<4, 4, vext>( &pOrg[x], &pCur[x], strideOrg, strideCur, narrow ) + 1 ) >> 1;
+      }
+    }
+  }
+
+  return sum >> DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth );
+}
+
+template <X86_VEXT vext>
+void RdCost::_initRdCostX86()
+{
+  m_afpDistortFunc[DF_SSE    ] = xGetSSE_SIMD<vext>;
+  m_afpDistortFunc[DF_SSE2   ] = xGetSSE_SIMD<vext>;
+  m_afpDistortFunc[DF_SSE4   ] = xGetSSE_NxN_SIMD<4,   vext>;
+  m_afpDistortFunc[DF_SSE8   ] = xGetSSE_NxN_SIMD<8,   vext>;
+  m_afpDistortFunc[DF_SSE16  ] = xGetSSE_NxN_SIMD<16,  vext>;
+  m_afpDistortFunc[DF_SSE32  ] = xGetSSE_NxN_SIMD<32,  vext>;
+  m_afpDistortFunc[DF_SSE64  ] = xGetSSE_NxN_SIMD<64,  vext>;
+  m_afpDistortFunc[DF_SSE16N ] = xGetSSE_NxN_SIMD<128, vext>;
+
+  m_afpDistortFunc[DF_SAD    ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD2   ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD4   ] = xGetSAD_NxN_SIMD<4,   vext>;
+  m_afpDistortFunc[DF_SAD8   ] = xGetSAD_NxN_SIMD<8,   vext>;
+  m_afpDistortFunc[DF_SAD16  ] = xGetSAD_NxN_SIMD<16,  vext>;
+  m_afpDistortFunc[DF_SAD32  ] = xGetSAD_NxN_SIMD<32,  vext>;
+  m_afpDistortFunc[DF_SAD64  ] = xGetSAD_NxN_SIMD<64,  vext>;
+  m_afpDistortFunc[DF_SAD16N ] = xGetSAD_NxN_SIMD<128, vext>;
+
+  m_afpDistortFunc[DF_SAD12  ] = xGetSAD_NxN_SIMD<12,  vext>;
+  m_afpDistortFunc[DF_SAD24  ] = xGetSAD_NxN_SIMD<24,  vext>;
+  m_afpDistortFunc[DF_SAD48  ] = xGetSAD_NxN_SIMD<48,  vext>;
+
+  m_afpDistortFunc[DF_HAD    ] = xGetHADs_SIMD<vext>;
+  m_afpDistortFunc[DF_HAD2   ] = xGetHADs_SIMD<vext>;
+  m_afpDistortFunc[DF_HAD4   ] = xGetHADs_SIMD<vext>;
+  m_afpDistortFunc[DF_HAD8   ] = xGetHADs_SIMD<vext>;
+  m_afpDistortFunc[DF_HAD16  ] = xGetHADs_SIMD<vext>;
+  m_afpDistortFunc[DF_HAD32  ] = xGetHADs_SIMD<vext>;
+  m_afpDistortFunc[DF_HAD64  ] = xGetHADs_SIMD<vext>;
+  m_afpDistortFunc[DF_HAD16N ] = xGetHADs_SIMD<vext>;
+
+  m_afpDistortFunc[DF_MRSAD    ] = xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD2   ] = xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD4   ] = xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD8   ] = xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD16  ] = xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD32  ] = xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD64  ] = xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD16N ] = xGetMRSAD_SIMD<vext>;
+
+  m_afpDistortFunc[DF_MRSAD12  ] = xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD24  ] = xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD48  ] = xGetMRSAD_SIMD<vext>;
+
+  // the MR Hadamard functions subtract the mean and call m_afpDistortFunc[DF_HAD]
+
+#if FULL_NBIT
+  // without a distortion precision adjustment the full bit SAD equals the regular one
+  m_afpDistortFunc[DF_SAD_FULL_NBIT   ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD_FULL_NBIT2  ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD_FULL_NBIT4  ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD_FULL_NBIT8  ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD_FULL_NBIT16 ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD_FULL_NBIT32 ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD_FULL_NBIT64 ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD_FULL_NBIT16N] = xGetSAD_SIMD<vext>;
+#endif
+
+#if WCG_EXT
+  m_afpDistortFunc[DF_SSE_WTD   ] = xGetSSE_WTD_SIMD<vext>;
+  m_afpDistortFunc[DF_SSE2_WTD  ] = xGetSSE_WTD_SIMD<vext>;
+  m_afpDistortFunc[DF_SSE4_WTD  ] = xGetSSE_WTD_SIMD<vext>;
+  m_afpDistortFunc[DF_SSE8_WTD  ] = xGetSSE_WTD_SIMD<vext>;
+  m_afpDistortFunc[DF_SSE16_WTD ] = xGetSSE_WTD_SIMD<vext>;
+  m_afpDistortFunc[DF_SSE32_WTD ] = xGetSSE_WTD_SIMD<vext>;
+  m_afpDistortFunc[DF_SSE64_WTD ] = xGetSSE_WTD_SIMD<vext>;
+  m_afpDistortFunc[DF_SSE16N_WTD] = xGetSSE_WTD_SIMD<vext>;
+#endif
+
+  m_afpDistortFunc[DF_SAD_INTERMEDIATE_BITDEPTH] = xGetSAD_IBD_SIMD<vext>;
+
+  m_fpDmvrCosts = xGetDmvrCosts_SIMD<vext>;
+  m_fpPlaneSSE  = xGetPlaneSSE_SIMD<vext>;
+#if WCG_WPSNR
+  m_fpPlaneWtdSSE = xGetPlaneWtdSSE_SIMD<vext>;
+#endif
+
+#if JVET_Q0806
+  m_afpDistortFunc[DF_SAD_WITH_MASK] = xGetSADwMask_SIMD<vext>;
+#endif
+}
+
+template void RdCost::_initRdCostX86<SIMDX86>();
+
+//! \}
+
+#endif //TARGET_SIMD_X86
@@ -0,0 +1,518 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     SampleAdaptiveOffsetX86.h
+    \brief    SAO class, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../SampleAdaptiveOffset.h"
+
+#if ENABLE_SIMD_OPT_SAO
+#ifdef TARGET_SIMD_X86
+
+//! \ingroup CommonLib
+//! \{
+
+static_assert( sizeof( Pel ) == 2, "The SIMD SAO expects 16 bit samples" );
+
+// The edge classes are evaluated directly per sample as offset[2 + sgn(s - a) + sgn(s - b)] with a and b the two
+// neighbours along the class direction, which gives the same result as the sign line buffers of the C code.
+// The offsets are looked up with a byte shuffle: the 16 bit table entry e is selected by the index pair 2e, 2e+1.
+
+struct SaoLookup
+{
+  __m128i eo;      // 16 bit edge offsets for the edge indices 0..4
+  __m128i bo[4];   // 16 bit band offsets, 8 bands per table
+  int     shiftBits;
+};
+
+static ALWAYS_INLINE __m128i xSaoTableIdx( __m128i e )
+{
+  return _mm_add_epi16( _mm_mullo_epi16( e, _mm_set1_epi16( 0x0202 ) ), _mm_set1_epi16( 0x0100 ) );
+}
+
+static ALWAYS_INLINE __m128i xSaoSign( __m128i s, __m128i a )
+{
+  return _mm_sub_epi16( _mm_cmpgt_epi16( a, s ), _mm_cmpgt_epi16( s, a ) );
+}
+
+static ALWAYS_INLINE __m128i xSaoEdgeOffset( const __m128i& tbl, __m128i s, __m128i a, __m128i b )
+{
+  const __m128i e = _mm_add_epi16( _mm_set1_epi16( 2 ), _mm_add_epi16( xSaoSign( s, a ), xSaoSign( s, b ) ) );
+  return _mm_shuffle_epi8( tbl, xSaoTableIdx( e ) );
+}
+
+static ALWAYS_INLINE __m128i xSaoBandOffset( const __m128i* tbl, __m128i s, const int shiftBits )
+{
+  const __m128i band = _mm_srl_epi16( s, _mm_cvtsi32_si128( shiftBits ) );
+  const __m128i idx  = xSaoTableIdx( _mm_and_si128( band, _mm_set1_epi16( 7 ) ) );
+  const __m128i m8   = _mm_srai_epi16( _mm_slli_epi16( band, 12 ), 15 );
+  const __m128i m16  = _mm_srai_epi16( _mm_slli_epi16( band, 11 ), 15 );
+  const __m128i o0   = _mm_blendv_epi8( _mm_shuffle_epi8( tbl[0], idx ), _mm_shuffle_epi8( tbl[1], idx ), m8 );
+  const __m128i o1   = _mm_blendv_epi8( _mm_shuffle_epi8( tbl[2], idx ), _mm_shuffle_epi8( tbl[3], idx ), m8 );
+  return _mm_blendv_epi8( o0, o1, m16 );
+}
+
+#ifdef USE_AVX2
+static ALWAYS_INLINE __m256i xSaoTableIdx( __m256i e )
+{
+  return _mm256_add_epi16( _mm256_mullo_epi16( e, _mm256_set1_epi16( 0x0202 ) ), _mm256_set1_epi16( 0x0100 ) );
+}
+
+static ALWAYS_INLINE __m256i xSaoSign( __m256i s, __m256i a )
+{
+  return _mm256_sub_epi16( _mm256_cmpgt_epi16( a, s ), _mm256_cmpgt_epi16( s, a ) );
+}
+
+static ALWAYS_INLINE __m256i xSaoEdgeOffset( const __m256i& tbl, __m256i s, __m256i a, __m256i b )
+{
+  const __m256i e = _mm256_add_epi16( _mm256_set1_epi16( 2 ), _mm256_add_epi16( xSaoSign( s, a ), xSaoSign( s, b ) ) );
+  return _mm256_shuffle_epi8( tbl, xSaoTableIdx( e ) );
+}
+
+static ALWAYS_INLINE __m256i xSaoBandOffset( const __m256i* tbl, __m256i s, const int shiftBits )
+{
+  const __m256i band = _mm256_srl_epi16( s, _mm_cvtsi32_si128( shiftBits ) );
+  const __m256i idx  = xSaoTableIdx( _mm256_and_si256( band, _mm256_set1_epi16( 7 ) ) );
+  const __m256i m8   = _mm256_srai_epi16( _mm256_slli_epi16( band, 12 ), 15 );
+  const __m256i m16  = _mm256_srai_epi16( _mm256_slli_epi16( band, 11 ), 15 );
+  const __m256i o0   = _mm256_blendv_epi8( _mm256_shuffle_epi8( tbl[0], idx ), _mm256_shuffle_epi8( tbl[1], idx ), m8 );
+  const __m256i o1   = _mm256_blendv_epi8( _mm256_shuffle_epi8( tbl[2], idx ), _mm256_shuffle_epi8( tbl[3], idx ), m8 );
+  return _mm256_blendv_epi8( o0, o1, m16 );
+}
+#endif
+
+// Applies the edge offsets to the samples [x, xEnd) of a line, offset points to the offset of edge index 2.
+// The neighbours are at src + offA and src + offB, only samples whose neighbours are read by the C code are loaded.
+template<X86_VEXT vext>
+static void xSaoEdgeLine( const Pel* src, Pel* res, const ptrdiff_t offA, const ptrdiff_t offB, int x, const int xEnd, const int* offset, const SaoLookup& lut, const ClpRng& clpRng )
+{
+#ifdef USE_AVX2
+  if( vext >= AVX2 && xEnd - x >= 16 )
+  {
+    const __m256i tbl  = _mm256_broadcastsi128_si256( lut.eo );
+    const __m256i vmin = _mm256_set1_epi16( clpRng.min );
+    const __m256i vmax = _mm256_set1_epi16( clpRng.max );
+
+    for( ; x + 16 <= xEnd; x += 16 )
+    {
+      const __m256i s = _mm256_loadu_si256( ( const __m256i* ) &src[x] );
+      const __m256i a = _mm256_loadu_si256( ( const __m256i* ) &src[x + offA] );
+      const __m256i b = _mm256_loadu_si256( ( const __m256i* ) &src[x + offB] );
+      const __m256i r = _mm256_adds_epi16( s, xSaoEdgeOffset( tbl, s, a, b ) );
+      _mm256_storeu_si256( ( __m256i* ) &res[x], _mm256_min_epi16( vmax, _mm256_max_epi16( vmin, r ) ) );
+    }
+  }
+#endif
+  if( xEnd - x >= 8 )
+  {
+    const __m128i vmin = _mm_set1_epi16( clpRng.min );
+    const __m128i vmax = _mm_set1_epi16( clpRng.max );
+
+    for( ; x + 8 <= xEnd; x += 8 )
+    {
+      const __m128i s = _mm_loadu_si128( ( const __m128i* ) &src[x] );
+      const __m128i a = _mm_loadu_si128( ( const __m128i* ) &src[x + offA] );
+      const __m128i b = _mm_loadu_si128( ( const __m128i* ) &src[x + offB] );
+      const __m128i r = _mm_adds_epi16( s, xSaoEdgeOffset( lut.eo, s, a, b ) );
+      _mm_storeu_si128( ( __m128i* ) &res[x], _mm_min_epi16( vmax, _mm_max_epi16( vmin, r ) ) );
+    }
+  }
+  for( ; x < xEnd; x++ )
+  {
+    res[x] = ClipPel<int>( src[x] + offset[sgn( src[x] - src[x + offA] ) + sgn( src[x] - src[x + offB] )], clpRng );
+  }
+}
+
+template<X86_VEXT vext>
+static void xSaoBandLine( const Pel* src, Pel* res, const int width, const int* offset, const SaoLookup& lut, const ClpRng& clpRng )
+{
+  int x = 0;
+#ifdef USE_AVX2
+  if( vext >= AVX2 && width >= 16 )
+  {
+    const __m256i tbl[4] = { _mm256_broadcastsi128_si256( lut.bo[0] ), _mm256_broadcastsi128_si256( lut.bo[1] ),
+                             _mm256_broadcastsi128_si256( lut.bo[2] ), _mm256_broadcastsi128_si256( lut.bo[3] ) };
+    const __m256i vmin   = _mm256_set1_epi16( clpRng.min );
+    const __m256i vmax   = _mm256_set1_epi16( clpRng.max );
+
+    for( ; x + 16 <= width; x += 16 )
+    {
+      const __m256i s = _mm256_loadu_si256( ( const __m256i* ) &src[x] );
+      const __m256i r = _mm256_adds_epi16( s, xSaoBandOffset( tbl, s, lut.shiftBits ) );
+      _mm256_storeu_si256( ( __m256i* ) &res[x], _mm256_min_epi16( vmax, _mm256_max_epi16( vmin, r ) ) );
+    }
+  }
+#endif
+  if( width - x >= 8 )
+  {
+    const __m128i vmin = _mm_set1_epi16( clpRng.min );
+    const __m128i vmax = _mm_set1_epi16( clpRng.max );
+
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i s = _mm_loadu_si128( ( const __m128i* ) &src[x] );
+      const __m128i r = _mm_adds_epi16( s, xSaoBandOffset( lut.bo, s, lut.shiftBits ) );
+      _mm_storeu_si128( ( __m128i* ) &res[x], _mm_min_epi16( vmax, _mm_max_epi16( vmin, r ) ) );
+    }
+  }
+  for( ; x < width; x++ )
+  {
+    res[x] = ClipPel<int>( src[x] + offset[src[x] >> lut.shiftBits], clpRng );
+  }
+}
+
+template<X86_VEXT vext>
+static void offsetBlock_SSE( const int channelBitDepth, const ClpRng& clpRng, int typeIdx, int* offset, const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride, int width, int height
+                           , bool isLeftAvail, bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail
+                           , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
+                           , std::vector<int8_t>& signLineBuf1, std::vector<int8_t>& signLineBuf2 )
+{
+  // the virtual boundaries disable single samples, the sign line buffers of the diagonal classes overlap for blocks
+  // of a single line or column
+  if( isCtuCrossedByVirtualBoundaries || ( ( width < 2 || height < 2 ) && ( typeIdx == SAO_TYPE_EO_135 || typeIdx == SAO_TYPE_EO_45 ) ) )
+  {
+    SampleAdaptiveOffset::offsetBlockCore( channelBitDepth, clpRng, typeIdx, offset, srcBlk, resBlk, srcStride, resStride, width, height
+                                         , isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail, isBelowLeftAvail, isBelowRightAvail
+                                         , isCtuCrossedByVirtualBoundaries, horVirBndryPos, verVirBndryPos, numHorVirBndry, numVerVirBndry
+                                         , signLineBuf1, signLineBuf2 );
+    return;
+  }
+
+  SaoLookup lut;
+  const int startX = isLeftAvail  ? 0 : 1;
+  const int endX   = isRightAvail ? width : ( width - 1 );
+
+  switch( typeIdx )
+  {
+  case SAO_TYPE_EO_0:
+  case SAO_TYPE_EO_90:
+  case SAO_TYPE_EO_135:
+  case SAO_TYPE_EO_45:
+    {
+      lut.eo = _mm_setr_epi16( offset[0], offset[1], offset[2], offset[3], offset[4], 0, 0, 0 );
+      offset += 2;
+    }
+    break;
+  case SAO_TYPE_BO:
+    {
+      ALIGN_DATA( 16, int16_t bandOffset[NUM_SAO_BO_CLASSES] );
+      for( int i = 0; i < NUM_SAO_BO_CLASSES; i++ )
+      {
+        bandOffset[i] = offset[i];
+      }
+      for( int i = 0; i < 4; i++ )
+      {
+        lut.bo[i] = _mm_load_si128( ( const __m128i* ) &bandOffset[i << 3] );
+      }
+      lut.shiftBits = channelBitDepth - NUM_SAO_BO_CLASSES_LOG2;
+    }
+    break;
+  default:
+    THROW( "Not a supported SAO types\n" );
+  }
+
+  const Pel* srcLine = srcBlk;
+        Pel* resLine = resBlk;
+
+  switch( typeIdx )
+  {
+  case SAO_TYPE_EO_0:
+    {
+      for( int y = 0; y < height; y++ )
+      {
+        xSaoEdgeLine<vext>( srcLine, resLine, -1, 1, startX, endX, offset, lut, clpRng );
+        srcLine += srcStride;
+        resLine += resStride;
+      }
+    }
+    break;
+  case SAO_TYPE_EO_90:
+    {
+      const int startY = isAboveAvail ? 0 : 1;
+      const int endY   = isBelowAvail ? height : height - 1;
+      srcLine += startY * srcStride;
+      resLine += startY * resStride;
+
+      for( int y = startY; y < endY; y++ )
+      {
+        xSaoEdgeLine<vext>( srcLine, resLine, -srcStride, srcStride, 0, width, offset, lut, clpRng );
+        srcLine += srcStride;
+        resLine += resStride;
+      }
+    }
+    break;
+  case SAO_TYPE_EO_135:
+  case SAO_TYPE_EO_45:
+    {
+      // neighbour offsets and sample ranges of the first and the last line as in the C code
+      const bool      is135   = typeIdx == SAO_TYPE_EO_135;
+      const ptrdiff_t offA    = is135 ? -srcStride - 1 : -srcStride + 1;
+      const ptrdiff_t offB    = is135 ?  srcStride + 1 :  srcStride - 1;
+      const int firstStartX   = is135 ? ( isAboveLeftAvail ? 0 : 1 ) : ( isAboveAvail ? startX : width - 1 );
+      const int firstEndX     = is135 ? ( isAboveAvail ? endX : 1 ) : ( isAboveRightAvail ? width : width - 1 );
+      const int lastStartX    = is135 ? ( isBelowAvail ? startX : width - 1 ) : ( isBelowLeftAvail ? 0 : 1 );
+      const int lastEndX      = is135 ? ( isBelowRightAvail ? width : width - 1 ) : ( isBelowAvail ? endX : 1 );
+
+      xSaoEdgeLine<vext>( srcLine, resLine, offA, offB, firstStartX, firstEndX, offset, lut, clpRng );
+      srcLine += srcStride;
+      resLine += resStride;
+
+      for( int y = 1; y < height - 1; y++ )
+      {
+        xSaoEdgeLine<vext>( srcLine, resLine, offA, offB, startX, endX, offset, lut, clpRng );
+        srcLine += srcStride;
+        resLine += resStride;
+      }
+
+      xSaoEdgeLine<vext>( srcLine, resLine, offA, offB, lastStartX, lastEndX, offset, lut, clpRng );
+    }
+    break;
+  case SAO_TYPE_BO:
+    {
+      for( int y = 0; y < height; y++ )
+      {
+        xSaoBandLine<vext>( srcLine, resLine, width, offset, lut, clpRng );
+        srcLine += srcStride;
+        resLine += resStride;
+      }
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+// The statistics are accumulated in 32 bit lanes, pairs of samples are added by madd. The lanes are moved to the
+// 64 bit statistics every SAO_STATS_FLUSH_LINES lines, which keeps them far from overflowing for any picture width.
+#define SAO_STATS_FLUSH_LINES 16
+
+static inline int64_t xSaoSumLanes( __m128i v )
+{
+  ALIGN_DATA( 16, int32_t lanes[4] );
+  _mm_store_si128( ( __m128i* ) lanes, v );
+  return ( int64_t ) lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+// The classes -2, -1, 1 and 2 are counted with compare masks, class 0 is derived from the sums over all samples.
+template<X86_VEXT vext>
+static void calcEdgeStats_SSE( const Pel* srcLine, int srcStride, const Pel* orgLine, int orgStride, int startX, int endX, int height
+                             , ptrdiff_t offA, ptrdiff_t offB, int64_t* diff, int64_t* count )
+{
+  static const int edgeTypes[4] = { -2, -1, 1, 2 };
+
+  const __m128i vone = _mm_set1_epi16( 1 );
+
+  for( int y0 = 0; y0 < height; y0 += SAO_STATS_FLUSH_LINES )
+  {
+    const int yEnd = std::min( height, y0 + SAO_STATS_FLUSH_LINES );
+
+    __m128i sumDiff [4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+    __m128i sumCount[4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+    __m128i sumAll      = _mm_setzero_si128();
+    int64_t numAll      = 0;
+#ifdef USE_AVX2
+    __m256i sumDiff256 [4] = { _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256() };
+    __m256i sumCount256[4] = { _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256() };
+    __m256i sumAll256      = _mm256_setzero_si256();
+#endif
+
+    for( int y = y0; y < yEnd; y++ )
+    {
+      int x = startX;
+#ifdef USE_AVX2
+      if( vext >= AVX2 )
+      {
+        const __m256i vone256 = _mm256_set1_epi16( 1 );
+
+        for( ; x + 16 <= endX; x += 16 )
+        {
+          const __m256i s = _mm256_loadu_si256( ( const __m256i* ) &srcLine[x] );
+          const __m256i a = _mm256_loadu_si256( ( const __m256i* ) &srcLine[x + offA] );
+          const __m256i b = _mm256_loadu_si256( ( const __m256i* ) &srcLine[x + offB] );
+          const __m256i o = _mm256_loadu_si256( ( const __m256i* ) &orgLine[x] );
+          const __m256i e = _mm256_add_epi16( xSaoSign( s, a ), xSaoSign( s, b ) );
+          const __m256i d = _mm256_sub_epi16( o, s );
+
+          sumAll256 = _mm256_add_epi32( sumAll256, _mm256_madd_epi16( d, vone256 ) );
+          for( int k = 0; k < 4; k++ )
+          {
+            const __m256i m = _mm256_cmpeq_epi16( e, _mm256_set1_epi16( edgeTypes[k] ) );
+            sumDiff256 [k]  = _mm256_add_epi32( sumDiff256[k], _mm256_madd_epi16( _mm256_and_si256( m, d ), vone256 ) );
+            sumCount256[k]  = _mm256_sub_epi32( sumCount256[k], _mm256_madd_epi16( m, vone256 ) );
+          }
+        }
+      }
+#endif
+      for( ; x + 8 <= endX; x += 8 )
+      {
+        const __m128i s = _mm_loadu_si128( ( const __m128i* ) &srcLine[x] );
+        const __m128i a = _mm_loadu_si128( ( const __m128i* ) &srcLine[x + offA] );
+        const __m128i b = _mm_loadu_si128( ( const __m128i* ) &srcLine[x + offB] );
+        const __m128i o = _mm_loadu_si128( ( const __m128i* ) &orgLine[x] );
+        const __m128i e = _mm_add_epi16( xSaoSign( s, a ), xSaoSign( s, b ) );
+        const __m128i d = _mm_sub_epi16( o, s );
+
+        sumAll = _mm_add_epi32( sumAll, _mm_madd_epi16( d, vone ) );
+        for( int k = 0; k < 4; k++ )
+        {
+          const __m128i m = _mm_cmpeq_epi16( e, _mm_set1_epi16( edgeTypes[k] ) );
+          sumDiff [k]     = _mm_add_epi32( sumDiff[k], _mm_madd_epi16( _mm_and_si128( m, d ), vone ) );
+          sumCount[k]     = _mm_sub_epi32( sumCount[k], _mm_madd_epi16( m, vone ) );
+        }
+      }
+      if( x > startX )
+      {
+        numAll += x - startX;
+      }
+      for( ; x < endX; x++ )
+      {
+        const int edgeType = sgn( srcLine[x] - srcLine[x + offA] ) + sgn( srcLine[x] - srcLine[x + offB] );
+        diff [edgeType] += ( orgLine[x] - srcLine[x] );
+        count[edgeType] ++;
+      }
+      srcLine += srcStride;
+      orgLine += orgStride;
+    }
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      sumAll = _mm_add_epi32( sumAll, _mm_add_epi32( _mm256_castsi256_si128( sumAll256 ), _mm256_extracti128_si256( sumAll256, 1 ) ) );
+      for( int k = 0; k < 4; k++ )
+      {
+        sumDiff [k] = _mm_add_epi32( sumDiff [k], _mm_add_epi32( _mm256_castsi256_si128( sumDiff256 [k] ), _mm256_extracti128_si256( sumDiff256 [k], 1 ) ) );
+        sumCount[k] = _mm_add_epi32( sumCount[k], _mm_add_epi32( _mm256_castsi256_si128( sumCount256[k] ), _mm256_extracti128_si256( sumCount256[k], 1 ) ) );
+      }
+    }
+#endif
+    int64_t diffAll = xSaoSumLanes( sumAll );
+    for( int k = 0; k < 4; k++ )
+    {
+      const int64_t classDiff  = xSaoSumLanes( sumDiff [k] );
+      const int64_t classCount = xSaoSumLanes( sumCount[k] );
+      diff [edgeTypes[k]] += classDiff;
+      count[edgeTypes[k]] += classCount;
+      diffAll             -= classDiff;
+      numAll              -= classCount;
+    }
+    diff [0] += diffAll;
+    count[0] += numAll;
+  }
+}
+
+// The band index and the difference are derived for a vector of samples and added to 32 bit histograms, which avoids
+// the dependency chains of the 64 bit statistics in the per sample loop.
+template<X86_VEXT vext>
+static void calcBandStats_SSE( const Pel* srcLine, int srcStride, const Pel* orgLine, int orgStride, int startX, int endX, int height
+                             , int shiftBits, int64_t* diff, int64_t* count )
+{
+  const __m128i vshift = _mm_cvtsi32_si128( shiftBits );
+
+  ALIGN_DATA( 32, int16_t bandIdx[16] );
+  ALIGN_DATA( 32, int16_t bandDiff[16] );
+
+  for( int y0 = 0; y0 < height; y0 += SAO_STATS_FLUSH_LINES )
+  {
+    const int yEnd = std::min( height, y0 + SAO_STATS_FLUSH_LINES );
+
+    int32_t sumDiff [NUM_SAO_BO_CLASSES] = { 0 };
+    int32_t sumCount[NUM_SAO_BO_CLASSES] = { 0 };
+
+    for( int y = y0; y < yEnd; y++ )
+    {
+      int x = startX;
+#ifdef USE_AVX2
+      if( vext >= AVX2 )
+      {
+        for( ; x + 16 <= endX; x += 16 )
+        {
+          const __m256i s = _mm256_loadu_si256( ( const __m256i* ) &srcLine[x] );
+          const __m256i o = _mm256_loadu_si256( ( const __m256i* ) &orgLine[x] );
+          _mm256_store_si256( ( __m256i* ) bandIdx,  _mm256_srl_epi16( s, vshift ) );
+          _mm256_store_si256( ( __m256i* ) bandDiff, _mm256_sub_epi16( o, s ) );
+
+          for( int i = 0; i < 16; i++ )
+          {
+            sumDiff [bandIdx[i]] += bandDiff[i];
+            sumCount[bandIdx[i]] ++;
+          }
+        }
+      }
+#endif
+      for( ; x + 8 <= endX; x += 8 )
+      {
+        const __m128i s = _mm_loadu_si128( ( const __m128i* ) &srcLine[x] );
+        const __m128i o = _mm_loadu_si128( ( const __m128i* ) &orgLine[x] );
+        _mm_store_si128( ( __m128i* ) bandIdx,  _mm_srl_epi16( s, vshift ) );
+        _mm_store_si128( ( __m128i* ) bandDiff, _mm_sub_epi16( o, s ) );
+
+        for( int i = 0; i < 8; i++ )
+        {
+          sumDiff [bandIdx[i]] += bandDiff[i];
+          sumCount[bandIdx[i]] ++;
+        }
+      }
+      for( ; x < endX; x++ )
+      {
+        const int idx = srcLine[x] >> shiftBits;
+        sumDiff [idx] += ( orgLine[x] - srcLine[x] );
+        sumCount[idx] ++;
+      }
+      srcLine += srcStride;
+      orgLine += orgStride;
+    }
+
+    for( int i = 0; i < NUM_SAO_BO_CLASSES; i++ )
+    {
+      diff [i] += sumDiff [i];
+      count[i] += sumCount[i];
+    }
+  }
+}
+
+template <X86_VEXT vext>
+void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86()
+{
+  m_offsetBlock = offsetBlock_SSE<vext>;
+  m_calcEdgeStats = calcEdgeStats_SSE<vext>;
+  m_calcBandStats = calcBandStats_SSE<vext>;
+}
+
+template void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86<SIMDX86>();
+
+//! \}
+
+#endif //TARGET_SIMD_X86
+#endif //ENABLE_SIMD_OPT_SAO
@@ -0,0 +1,331 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TemporalFilterOpsX86.h
+    \brief    block error, interpolation and bilateral kernels of TemporalFilterOps, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../TemporalFilterOps.h"
+
+#include <cmath>
+
+#if ENABLE_SIMD_OPT_MCTF
+#ifdef TARGET_SIMD_X86
+
+//! \ingroup CommonLib
+//! \{
+
+static_assert( sizeof( Pel ) == 2, "The SIMD temporal filter expects 16 bit samples" );
+
+// The sums of the interpolation exceed 16 bit after the first stage, so the vertical stage is evaluated with 32 bit
+// multiplications, which keeps all kernels bit-exact with the C code.
+
+template<X86_VEXT vext>
+int tempFilterBlockSSE_SSE( const Pel* org, int orgStride, const Pel* cur, int curStride, int width, int height, int maxError )
+{
+  if( ( width & 3 ) != 0 )
+  {
+    return tempFilterBlockSSECore( org, orgStride, cur, curStride, width, height, maxError );
+  }
+
+  int error = 0;
+
+  for( int y = 0; y < height; y++, org += orgStride, cur += curStride )
+  {
+    __m128i vsum = _mm_setzero_si128();
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 && width >= 16 )
+    {
+      __m256i vsum256 = _mm256_setzero_si256();
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i vdif = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) &org[x] ), _mm256_loadu_si256( ( const __m256i* ) &cur[x] ) );
+        vsum256 = _mm256_add_epi32( vsum256, _mm256_madd_epi16( vdif, vdif ) );
+      }
+      vsum = _mm_add_epi32( _mm256_castsi256_si128( vsum256 ), _mm256_extracti128_si256( vsum256, 1 ) );
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i vdif = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* ) &org[x] ), _mm_loadu_si128( ( const __m128i* ) &cur[x] ) );
+      vsum = _mm_add_epi32( vsum, _mm_madd_epi16( vdif, vdif ) );
+    }
+    if( x < width )
+    {
+      const __m128i vdif = _mm_sub_epi16( _mm_loadl_epi64( ( const __m128i* ) &org[x] ), _mm_loadl_epi64( ( const __m128i* ) &cur[x] ) );
+      vsum = _mm_add_epi32( vsum, _mm_madd_epi16( vdif, vdif ) );
+    }
+
+    vsum   = _mm_add_epi32( vsum, _mm_shuffle_epi32( vsum, 0x4e ) );
+    vsum   = _mm_add_epi32( vsum, _mm_shuffle_epi32( vsum, 0xb1 ) );
+    error += _mm_cvtsi128_si32( vsum );
+    if( error > maxError )
+    {
+      return error;
+    }
+  }
+
+  return error;
+}
+
+static ALWAYS_INLINE __m128i xTempFilterCoeffPair( const int* filter, int k )
+{
+  return _mm_set1_epi32( ( filter[k] & 0xffff ) | ( filter[k + 1] << 16 ) );
+}
+
+template<X86_VEXT vext>
+void tempFilterInterpolate_SSE( const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height, const int* xFilter, const int* yFilter, Pel maxValue )
+{
+  if( ( width & 3 ) != 0 || width > 64 || height > 64 )
+  {
+    tempFilterInterpolateCore( src, srcStride, dst, dstStride, width, height, xFilter, yFilter, maxValue );
+    return;
+  }
+
+  // horizontal stage: 6 taps at the offsets -2..3, the rows -2..height+2 are stored with a stride of width
+  int tempArray[( 64 + 6 ) * 64];
+
+  const __m128i vc12 = xTempFilterCoeffPair( xFilter, 1 );
+  const __m128i vc34 = xTempFilterCoeffPair( xFilter, 3 );
+  const __m128i vc56 = xTempFilterCoeffPair( xFilter, 5 );
+#ifdef USE_AVX2
+  const __m256i vc12_256 = _mm256_broadcastsi128_si256( vc12 );
+  const __m256i vc34_256 = _mm256_broadcastsi128_si256( vc34 );
+  const __m256i vc56_256 = _mm256_broadcastsi128_si256( vc56 );
+#endif
+
+  const Pel* srcRow = src - 2 * srcStride;
+  int*       tmpRow = tempArray;
+
+  for( int r = 0; r < height + 6; r++, srcRow += srcStride, tmpRow += width )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const Pel* s = srcRow + x;
+        const __m256i v0 = _mm256_loadu_si256( ( const __m256i* ) ( s - 2 ) );
+        const __m256i v1 = _mm256_loadu_si256( ( const __m256i* ) ( s - 1 ) );
+        const __m256i v2 = _mm256_loadu_si256( ( const __m256i* ) ( s     ) );
+        const __m256i v3 = _mm256_loadu_si256( ( const __m256i* ) ( s + 1 ) );
+        const __m256i v4 = _mm256_loadu_si256( ( const __m256i* ) ( s + 2 ) );
+        const __m256i v5 = _mm256_loadu_si256( ( const __m256i* ) ( s + 3 ) );
+
+        // samples 0..3 and 8..11 in vlo, 4..7 and 12..15 in vhi
+        __m256i vlo = _mm256_madd_epi16( _mm256_unpacklo_epi16( v0, v1 ), vc12_256 );
+        vlo = _mm256_add_epi32( vlo, _mm256_madd_epi16( _mm256_unpacklo_epi16( v2, v3 ), vc34_256 ) );
+        vlo = _mm256_add_epi32( vlo, _mm256_madd_epi16( _mm256_unpacklo_epi16( v4, v5 ), vc56_256 ) );
+        __m256i vhi = _mm256_madd_epi16( _mm256_unpackhi_epi16( v0, v1 ), vc12_256 );
+        vhi = _mm256_add_epi32( vhi, _mm256_madd_epi16( _mm256_unpackhi_epi16( v2, v3 ), vc34_256 ) );
+        vhi = _mm256_add_epi32( vhi, _mm256_madd_epi16( _mm256_unpackhi_epi16( v4, v5 ), vc56_256 ) );
+
+        _mm256_storeu_si256( ( __m256i* ) &tmpRow[x    ], _mm256_permute2x128_si256( vlo, vhi, 0x20 ) );
+        _mm256_storeu_si256( ( __m256i* ) &tmpRow[x + 8], _mm256_permute2x128_si256( vlo, vhi, 0x31 ) );
+      }
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const Pel* s = srcRow + x;
+      const __m128i v0 = _mm_loadu_si128( ( const __m128i* ) ( s - 2 ) );
+      const __m128i v1 = _mm_loadu_si128( ( const __m128i* ) ( s - 1 ) );
+      const __m128i v2 = _mm_loadu_si128( ( const __m128i* ) ( s     ) );
+      const __m128i v3 = _mm_loadu_si128( ( const __m128i* ) ( s + 1 ) );
+      const __m128i v4 = _mm_loadu_si128( ( const __m128i* ) ( s + 2 ) );
+      const __m128i v5 = _mm_loadu_si128( ( const __m128i* ) ( s + 3 ) );
+
+      __m128i vlo = _mm_madd_epi16( _mm_unpacklo_epi16( v0, v1 ), vc12 );
+      vlo = _mm_add_epi32( vlo, _mm_madd_epi16( _mm_unpacklo_epi16( v2, v3 ), vc34 ) );
+      vlo = _mm_add_epi32( vlo, _mm_madd_epi16( _mm_unpacklo_epi16( v4, v5 ), vc56 ) );
+      __m128i vhi = _mm_madd_epi16( _mm_unpackhi_epi16( v0, v1 ), vc12 );
+      vhi = _mm_add_epi32( vhi, _mm_madd_epi16( _mm_unpackhi_epi16( v2, v3 ), vc34 ) );
+      vhi = _mm_add_epi32( vhi, _mm_madd_epi16( _mm_unpackhi_epi16( v4, v5 ), vc56 ) );
+
+      _mm_storeu_si128( ( __m128i* ) &tmpRow[x    ], vlo );
+      _mm_storeu_si128( ( __m128i* ) &tmpRow[x + 4], vhi );
+    }
+    if( x < width )
+    {
+      const Pel* s = srcRow + x;
+      __m128i vlo = _mm_madd_epi16( _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) ( s - 2 ) ), _mm_loadl_epi64( ( const __m128i* ) ( s - 1 ) ) ), vc12 );
+      vlo = _mm_add_epi32( vlo, _mm_madd_epi16( _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) ( s     ) ), _mm_loadl_epi64( ( const __m128i* ) ( s + 1 ) ) ), vc34 ) );
+      vlo = _mm_add_epi32( vlo, _mm_madd_epi16( _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) ( s + 2 ) ), _mm_loadl_epi64( ( const __m128i* ) ( s + 3 ) ) ), vc56 ) );
+      _mm_storeu_si128( ( __m128i* ) &tmpRow[x], vlo );
+    }
+  }
+
+  // vertical stage
+  const __m128i vround = _mm_set1_epi32( 1 << 11 );
+  const __m128i vzero  = _mm_setzero_si128();
+  const __m128i vmax   = _mm_set1_epi32( maxValue );
+#ifdef USE_AVX2
+  const __m256i vround256 = _mm256_set1_epi32( 1 << 11 );
+  const __m256i vzero256  = _mm256_setzero_si256();
+  const __m256i vmax256   = _mm256_set1_epi32( maxValue );
+#endif
+
+  tmpRow = tempArray;
+
+  for( int by = 0; by < height; by++, tmpRow += width, dst += dstStride )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 8 <= width; x += 8 )
+      {
+        __m256i vsum = vround256;
+        for( int k = 1; k <= 6; k++ )
+        {
+          vsum = _mm256_add_epi32( vsum, _mm256_mullo_epi32( _mm256_loadu_si256( ( const __m256i* ) &tmpRow[( k - 1 ) * width + x] ), _mm256_set1_epi32( yFilter[k] ) ) );
+        }
+        vsum = _mm256_min_epi32( vmax256, _mm256_max_epi32( vzero256, _mm256_srai_epi32( vsum, 12 ) ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_packs_epi32( _mm256_castsi256_si128( vsum ), _mm256_extracti128_si256( vsum, 1 ) ) );
+      }
+    }
+#endif
+    for( ; x < width; x += 4 )
+    {
+      __m128i vsum = vround;
+      for( int k = 1; k <= 6; k++ )
+      {
+        vsum = _mm_add_epi32( vsum, _mm_mullo_epi32( _mm_loadu_si128( ( const __m128i* ) &tmpRow[( k - 1 ) * width + x] ), _mm_set1_epi32( yFilter[k] ) ) );
+      }
+      vsum = _mm_min_epi32( vmax, _mm_max_epi32( vzero, _mm_srai_epi32( vsum, 12 ) ) );
+      _mm_storel_epi64( ( __m128i* ) &dst[x], _mm_packs_epi32( vsum, vsum ) );
+    }
+  }
+}
+
+// The weights are looked up per difference, then all arithmetic is done per sample in the order of the C code, so
+// the result is the same. round() is evaluated as floor( v ) + ( v - floor( v ) >= 0.5 ), which is exact for the
+// non-negative weighted means.
+template<X86_VEXT vext>
+void tempFilterBilateralRow_SSE( const Pel* org, const Pel* const* refs, const double* const* weightLUTs, int numRefs, Pel* dst, int width, Pel maxValue )
+{
+  const __m128i vzero = _mm_setzero_si128();
+  const __m128i vmax  = _mm_set1_epi32( maxValue );
+  const __m128d vhalf = _mm_set1_pd( 0.5 );
+  const __m128d vone  = _mm_set1_pd( 1.0 );
+
+  int x = 0;
+  for( ; x + 4 <= width; x += 4 )
+  {
+    const __m128i vorg = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &org[x] ) );
+    __m128i vres;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      __m256d vnew = _mm256_cvtepi32_pd( vorg );
+      __m256d vsum = _mm256_set1_pd( 1.0 );
+      for( int i = 0; i < numRefs; i++ )
+      {
+        const __m128i vref = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &refs[i][x] ) );
+        const __m256d vwgt = _mm256_mask_i32gather_pd( _mm256_setzero_pd(), weightLUTs[i], _mm_sub_epi32( vref, vorg ), _mm256_castsi256_pd( _mm256_set1_epi64x( -1 ) ), 8 );
+        vnew = _mm256_add_pd( vnew, _mm256_mul_pd( vwgt, _mm256_cvtepi32_pd( vref ) ) );
+        vsum = _mm256_add_pd( vsum, vwgt );
+      }
+      vnew = _mm256_div_pd( vnew, vsum );
+      const __m256d vflr = _mm256_floor_pd( vnew );
+      const __m256d vrnd = _mm256_add_pd( vflr, _mm256_and_pd( _mm256_cmp_pd( _mm256_sub_pd( vnew, vflr ), _mm256_set1_pd( 0.5 ), _CMP_GE_OQ ), _mm256_set1_pd( 1.0 ) ) );
+      vres = _mm256_cvtpd_epi32( vrnd );
+    }
+    else
+#endif
+    {
+      const __m128i vorg23 = _mm_unpackhi_epi64( vorg, vorg );
+      __m128d vnew01 = _mm_cvtepi32_pd( vorg   );
+      __m128d vnew23 = _mm_cvtepi32_pd( vorg23 );
+      __m128d vsum01 = vone;
+      __m128d vsum23 = vone;
+      for( int i = 0; i < numRefs; i++ )
+      {
+        const __m128i vref = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &refs[i][x] ) );
+        const __m128i vdif = _mm_sub_epi32( vref, vorg );
+        const double* lut  = weightLUTs[i];
+        const __m128d vwgt01 = _mm_setr_pd( lut[_mm_extract_epi32( vdif, 0 )], lut[_mm_extract_epi32( vdif, 1 )] );
+        const __m128d vwgt23 = _mm_setr_pd( lut[_mm_extract_epi32( vdif, 2 )], lut[_mm_extract_epi32( vdif, 3 )] );
+        vnew01 = _mm_add_pd( vnew01, _mm_mul_pd( vwgt01, _mm_cvtepi32_pd( vref ) ) );
+        vnew23 = _mm_add_pd( vnew23, _mm_mul_pd( vwgt23, _mm_cvtepi32_pd( _mm_unpackhi_epi64( vref, vref ) ) ) );
+        vsum01 = _mm_add_pd( vsum01, vwgt01 );
+        vsum23 = _mm_add_pd( vsum23, vwgt23 );
+      }
+      vnew01 = _mm_div_pd( vnew01, vsum01 );
+      vnew23 = _mm_div_pd( vnew23, vsum23 );
+      const __m128d vflr01 = _mm_floor_pd( vnew01 );
+      const __m128d vflr23 = _mm_floor_pd( vnew23 );
+      const __m128d vrnd01 = _mm_add_pd( vflr01, _mm_and_pd( _mm_cmpge_pd( _mm_sub_pd( vnew01, vflr01 ), vhalf ), vone ) );
+      const __m128d vrnd23 = _mm_add_pd( vflr23, _mm_and_pd( _mm_cmpge_pd( _mm_sub_pd( vnew23, vflr23 ), vhalf ), vone ) );
+      vres = _mm_unpacklo_epi64( _mm_cvtpd_epi32( vrnd01 ), _mm_cvtpd_epi32( vrnd23 ) );
+    }
+    vres = _mm_min_epi32( vmax, _mm_max_epi32( vzero, vres ) );
+    _mm_storel_epi64( ( __m128i* ) &dst[x], _mm_packs_epi32( vres, vres ) );
+  }
+
+  for( ; x < width; x++ )
+  {
+    const int orgVal = ( int ) org[x];
+    double temporalWeightSum = 1.0;
+    double newVal = ( double ) orgVal;
+    for( int i = 0; i < numRefs; i++ )
+    {
+      const int    refVal = ( int ) refs[i][x];
+      const double weight = weightLUTs[i][refVal - orgVal];
+      newVal += weight * refVal;
+      temporalWeightSum += weight;
+    }
+    newVal /= temporalWeightSum;
+    Pel sampleVal = ( Pel ) round( newVal );
+    sampleVal = ( sampleVal < 0 ? 0 : ( sampleVal > maxValue ? maxValue : sampleVal ) );
+    dst[x] = sampleVal;
+  }
+}
+
+template<X86_VEXT vext>
+void TemporalFilterOps::_initTemporalFilterOpsX86()
+{
+  blockSSE     = tempFilterBlockSSE_SSE<vext>;
+  interpolate  = tempFilterInterpolate_SSE<vext>;
+  bilateralRow = tempFilterBilateralRow_SSE<vext>;
+}
+
+template void TemporalFilterOps::_initTemporalFilterOpsX86<SIMDX86>();
+
+//! \}
+
+#endif //TARGET_SIMD_X86
+#endif //ENABLE_SIMD_OPT_MCTF
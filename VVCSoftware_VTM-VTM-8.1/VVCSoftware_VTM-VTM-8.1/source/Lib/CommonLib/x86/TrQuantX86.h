@@ -0,0 +1,1123 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TrQuantX86.h
+    \brief    SIMD forward and inverse transforms of TrQuant
+*/
+
+#include "CommonDefX86.h"
+#include "../TrQuant.h"
+#include "../Rom.h"
+
+#if ENABLE_SIMD_OPT_TRAFO
+#ifdef TARGET_SIMD_X86
+
+//! \ingroup CommonLib
+//! \{
+
+static_assert( sizeof( TMatrixCoeff ) == 2, "The SIMD transforms expect 16 bit basis functions" );
+
+// basis functions of the transform, rows are indexed by the coefficient
+static const TMatrixCoeff* xTrMatrix( const int trType, const int size, const int dir = TRANSFORM_INVERSE )
+{
+  switch( trType )
+  {
+  case DCT2:
+    switch( size )
+    {
+    case  4: return g_trCoreDCT2P4 [dir][0];
+    case  8: return g_trCoreDCT2P8 [dir][0];
+    case 16: return g_trCoreDCT2P16[dir][0];
+    case 32: return g_trCoreDCT2P32[dir][0];
+    case 64: return g_trCoreDCT2P64[dir][0];
+    default: break;
+    }
+    break;
+  case DCT8:
+    switch( size )
+    {
+    case  4: return g_trCoreDCT8P4 [dir][0];
+    case  8: return g_trCoreDCT8P8 [dir][0];
+    case 16: return g_trCoreDCT8P16[dir][0];
+    case 32: return g_trCoreDCT8P32[dir][0];
+    default: break;
+    }
+    break;
+  case DST7:
+    switch( size )
+    {
+    case  4: return g_trCoreDST7P4 [dir][0];
+    case  8: return g_trCoreDST7P8 [dir][0];
+    case 16: return g_trCoreDST7P16[dir][0];
+    case 32: return g_trCoreDST7P32[dir][0];
+    default: break;
+    }
+    break;
+  default:
+    break;
+  }
+  THROW( "Unsupported transform" );
+  return nullptr;
+}
+
+// The coefficients k are multiplied in pairs (4p+r, 4p+r+2), r = 0, 1, so that pair 2p holds even and pair 2p+1
+// odd basis functions. The DCT-II output j and N-1-j are then the sum and the difference of the even and odd
+// parts, which halves the number of multiplications. The rows of the intermediate block are stored in the same
+// pair order, i.e. the columns of each group of 4 are reordered to 0, 2, 1, 3.
+
+static const int8_t g_trPairShuffle[16] = { 0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15 };
+static const int8_t g_trRevShuffle [16] = { 14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1 };
+
+#ifdef USE_AVX512
+// The 16 columns of the AVX-512 kernels are held as (0-3, 8-11, 4-7, 12-15) in the 128 bit lanes, packing two
+// rows of them leaves the 64 bit groups of the 1st row in the order 0, 4, 2, 6 and those of the 2nd in 1, 5, 3, 7.
+// g_trRowsPermute512 gathers the 1st row in the lower and the 2nd row in the upper half, g_trRevPermute512 reverses
+// the samples of both halves.
+static const int64_t g_trRowsPermute512[8] = { 0, 4, 2, 6, 1, 5, 3, 7 };
+static const int16_t g_trRevPermute512[32] = { 15, 14, 13, 12, 11, 10,  9,  8,  7,  6,  5,  4,  3,  2,  1,  0,
+                                               31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16 };
+#endif
+
+// --------------------------------------------------------------------------------------------------------------------
+// 1st (vertical) stage: the coefficient rows are multiplied with the basis functions, the result
+// is saturated to 16 bit (which is the clipping of the C code) and stored row by row in dst
+// --------------------------------------------------------------------------------------------------------------------
+
+template<X86_VEXT vext, bool bSym>
+static void xInvTrVer_SSE( const TCoeff* src, int16_t* dst, const int width, const int height, const int nzWidth, const int nzHeight, const TMatrixCoeff* iT, const int shift )
+{
+  const int numPairs = nzHeight >> 1;
+  const int numRows  = bSym ? height >> 1 : height;
+  const int tStride  = std::max( numRows, 4 );
+
+  // basis functions of the two coefficients of a pair interleaved, one 32 bit word per output row
+  int32_t tPair[( JVET_C0024_ZERO_OUT_TH >> 1 ) * ( MAX_TB_SIZEY >> 1 )];
+
+  for( int q = 0; q < numPairs; q++ )
+  {
+    const TMatrixCoeff* t0 = iT + ( 2 * ( q >> 1 ) * 2 + ( q & 1 ) ) * height;
+    const TMatrixCoeff* t1 = t0 + 2 * height;
+
+    for( int y = 0; y < numRows; y += 4 )
+    {
+      _mm_storeu_si128( ( __m128i* ) &tPair[q * tStride + y], _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) &t0[y] ), _mm_loadl_epi64( ( const __m128i* ) &t1[y] ) ) );
+    }
+  }
+
+  const __m128i vperm = _mm_loadu_si128( ( const __m128i* ) g_trPairShuffle );
+  int x = 0;
+
+#ifdef USE_AVX512
+  if( vext >= AVX512 )
+  {
+    const __m512i vadd     = _mm512_set1_epi32( 1 << ( shift - 1 ) );
+    const __m512i vperm512 = _mm512_broadcast_i32x4( vperm );
+    const __m512i vrows    = _mm512_loadu_si512( ( const void* ) g_trRowsPermute512 );
+    __m512i       vsrc[JVET_C0024_ZERO_OUT_TH >> 1];
+
+    for( ; x + 16 <= nzWidth; x += 16 )
+    {
+      for( int q = 0; q < numPairs; q++ )
+      {
+        const TCoeff* s0 = src + ( 2 * ( q >> 1 ) * 2 + ( q & 1 ) ) * width + x;
+        const TCoeff* s1 = s0 + 2 * width;
+        const __m256i r0 = _mm512_cvtsepi32_epi16( _mm512_loadu_si512( ( const void* ) s0 ) );
+        const __m256i r1 = _mm512_cvtsepi32_epi16( _mm512_loadu_si512( ( const void* ) s1 ) );
+
+        vsrc[q] = _mm512_inserti64x4( _mm512_castsi256_si512( _mm256_unpacklo_epi16( r0, r1 ) ), _mm256_unpackhi_epi16( r0, r1 ), 1 );
+      }
+
+      for( int y = 0; y < numRows; y += 2 - bSym )
+      {
+        const int y0 = y;
+        const int y1 = bSym ? height - 1 - y : y + 1;
+        __m512i   acc0;
+        __m512i   acc1;
+
+        if( bSym )
+        {
+          __m512i sumE = vadd;
+          __m512i sumO = _mm512_setzero_si512();
+
+          for( int q = 0; q < numPairs; q += 2 )
+          {
+            sumE = _mm512_add_epi32( sumE, _mm512_madd_epi16( vsrc[q    ], _mm512_set1_epi32( tPair[ q      * tStride + y] ) ) );
+            sumO = _mm512_add_epi32( sumO, _mm512_madd_epi16( vsrc[q + 1], _mm512_set1_epi32( tPair[( q + 1 ) * tStride + y] ) ) );
+          }
+
+          acc0 = _mm512_add_epi32( sumE, sumO );
+          acc1 = _mm512_sub_epi32( sumE, sumO );
+        }
+        else
+        {
+          acc0 = vadd;
+          acc1 = vadd;
+
+          for( int q = 0; q < numPairs; q++ )
+          {
+            acc0 = _mm512_add_epi32( acc0, _mm512_madd_epi16( vsrc[q], _mm512_set1_epi32( tPair[q * tStride + y    ] ) ) );
+            acc1 = _mm512_add_epi32( acc1, _mm512_madd_epi16( vsrc[q], _mm512_set1_epi32( tPair[q * tStride + y + 1] ) ) );
+          }
+        }
+
+        __m512i res = _mm512_packs_epi32( _mm512_srai_epi32( acc0, shift ), _mm512_srai_epi32( acc1, shift ) );
+        res = _mm512_shuffle_epi8( _mm512_permutexvar_epi64( vrows, res ), vperm512 );
+
+        _mm256_storeu_si256( ( __m256i* ) &dst[y0 * nzWidth + x], _mm512_castsi512_si256( res ) );
+        _mm256_storeu_si256( ( __m256i* ) &dst[y1 * nzWidth + x], _mm512_extracti64x4_epi64( res, 1 ) );
+      }
+    }
+  }
+#endif
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vadd   = _mm256_set1_epi32( 1 << ( shift - 1 ) );
+    const __m256i vperm2 = _mm256_broadcastsi128_si256( vperm );
+    __m256i       vsrc[JVET_C0024_ZERO_OUT_TH >> 1];
+
+    for( ; x + 8 <= nzWidth; x += 8 )
+    {
+      for( int q = 0; q < numPairs; q++ )
+      {
+        const TCoeff* s0 = src + ( 2 * ( q >> 1 ) * 2 + ( q & 1 ) ) * width + x;
+        const TCoeff* s1 = s0 + 2 * width;
+        const __m128i r0 = _mm_packs_epi32( _mm_loadu_si128( ( const __m128i* ) s0 ), _mm_loadu_si128( ( const __m128i* ) ( s0 + 4 ) ) );
+        const __m128i r1 = _mm_packs_epi32( _mm_loadu_si128( ( const __m128i* ) s1 ), _mm_loadu_si128( ( const __m128i* ) ( s1 + 4 ) ) );
+
+        vsrc[q] = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_unpacklo_epi16( r0, r1 ) ), _mm_unpackhi_epi16( r0, r1 ), 1 );
+      }
+
+      for( int y = 0; y < numRows; y += 2 - bSym )
+      {
+        const int y0 = y;
+        const int y1 = bSym ? height - 1 - y : y + 1;
+        __m256i   acc0;
+        __m256i   acc1;
+
+        if( bSym )
+        {
+          __m256i sumE = vadd;
+          __m256i sumO = _mm256_setzero_si256();
+
+          for( int q = 0; q < numPairs; q += 2 )
+          {
+            sumE = _mm256_add_epi32( sumE, _mm256_madd_epi16( vsrc[q    ], _mm256_set1_epi32( tPair[ q      * tStride + y] ) ) );
+            sumO = _mm256_add_epi32( sumO, _mm256_madd_epi16( vsrc[q + 1], _mm256_set1_epi32( tPair[( q + 1 ) * tStride + y] ) ) );
+          }
+
+          acc0 = _mm256_add_epi32( sumE, sumO );
+          acc1 = _mm256_sub_epi32( sumE, sumO );
+        }
+        else
+        {
+          acc0 = vadd;
+          acc1 = vadd;
+
+          for( int q = 0; q < numPairs; q++ )
+          {
+            acc0 = _mm256_add_epi32( acc0, _mm256_madd_epi16( vsrc[q], _mm256_set1_epi32( tPair[q * tStride + y    ] ) ) );
+            acc1 = _mm256_add_epi32( acc1, _mm256_madd_epi16( vsrc[q], _mm256_set1_epi32( tPair[q * tStride + y + 1] ) ) );
+          }
+        }
+
+        __m256i res = _mm256_packs_epi32( _mm256_srai_epi32( acc0, shift ), _mm256_srai_epi32( acc1, shift ) );
+        res = _mm256_shuffle_epi8( _mm256_permute4x64_epi64( res, 0xd8 ), vperm2 );
+
+        _mm_storeu_si128( ( __m128i* ) &dst[y0 * nzWidth + x], _mm256_castsi256_si128( res ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[y1 * nzWidth + x], _mm256_extracti128_si256( res, 1 ) );
+      }
+    }
+  }
+#endif
+
+  const __m128i vadd = _mm_set1_epi32( 1 << ( shift - 1 ) );
+  __m128i       vlo[JVET_C0024_ZERO_OUT_TH >> 1];
+  __m128i       vhi[JVET_C0024_ZERO_OUT_TH >> 1];
+
+  for( ; x < nzWidth; x += 8 )
+  {
+    // the last block is 4 columns wide if nzWidth is not a multiple of 8
+    const bool bFull = x + 8 <= nzWidth;
+
+    for( int q = 0; q < numPairs; q++ )
+    {
+      const TCoeff* s0 = src + ( 2 * ( q >> 1 ) * 2 + ( q & 1 ) ) * width + x;
+      const TCoeff* s1 = s0 + 2 * width;
+      const __m128i a0 = _mm_loadu_si128( ( const __m128i* ) s0 );
+      const __m128i a1 = _mm_loadu_si128( ( const __m128i* ) s1 );
+      const __m128i r0 = _mm_packs_epi32( a0, bFull ? _mm_loadu_si128( ( const __m128i* ) ( s0 + 4 ) ) : a0 );
+      const __m128i r1 = _mm_packs_epi32( a1, bFull ? _mm_loadu_si128( ( const __m128i* ) ( s1 + 4 ) ) : a1 );
+
+      vlo[q] = _mm_unpacklo_epi16( r0, r1 );
+      vhi[q] = _mm_unpackhi_epi16( r0, r1 );
+    }
+
+    for( int y = 0; y < numRows; y++ )
+    {
+      __m128i accLo[2];
+      __m128i accHi[2];
+
+      if( bSym )
+      {
+        __m128i sumLoE = vadd, sumLoO = _mm_setzero_si128();
+        __m128i sumHiE = vadd, sumHiO = _mm_setzero_si128();
+
+        for( int q = 0; q < numPairs; q += 2 )
+        {
+          const __m128i tE = _mm_set1_epi32( tPair[ q      * tStride + y] );
+          const __m128i tO = _mm_set1_epi32( tPair[( q + 1 ) * tStride + y] );
+
+          sumLoE = _mm_add_epi32( sumLoE, _mm_madd_epi16( vlo[q    ], tE ) );
+          sumLoO = _mm_add_epi32( sumLoO, _mm_madd_epi16( vlo[q + 1], tO ) );
+          sumHiE = _mm_add_epi32( sumHiE, _mm_madd_epi16( vhi[q    ], tE ) );
+          sumHiO = _mm_add_epi32( sumHiO, _mm_madd_epi16( vhi[q + 1], tO ) );
+        }
+
+        accLo[0] = _mm_add_epi32( sumLoE, sumLoO );
+        accHi[0] = _mm_add_epi32( sumHiE, sumHiO );
+        accLo[1] = _mm_sub_epi32( sumLoE, sumLoO );
+        accHi[1] = _mm_sub_epi32( sumHiE, sumHiO );
+      }
+      else
+      {
+        accLo[0] = vadd;
+        accHi[0] = vadd;
+
+        for( int q = 0; q < numPairs; q++ )
+        {
+          const __m128i t = _mm_set1_epi32( tPair[q * tStride + y] );
+
+          accLo[0] = _mm_add_epi32( accLo[0], _mm_madd_epi16( vlo[q], t ) );
+          accHi[0] = _mm_add_epi32( accHi[0], _mm_madd_epi16( vhi[q], t ) );
+        }
+      }
+
+      for( int i = 0; i < 1 + bSym; i++ )
+      {
+        const __m128i res = _mm_shuffle_epi8( _mm_packs_epi32( _mm_srai_epi32( accLo[i], shift ), _mm_srai_epi32( accHi[i], shift ) ), vperm );
+        int16_t*      d   = dst + ( i ? height - 1 - y : y ) * nzWidth + x;
+
+        if( bFull )
+        {
+          _mm_storeu_si128( ( __m128i* ) d, res );
+        }
+        else
+        {
+          _mm_storel_epi64( ( __m128i* ) d, res );
+        }
+      }
+    }
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// 2nd (horizontal) stage: the rows of the 1st stage are multiplied with the basis functions and
+// saturated to 16 bit, which is the clipping of the C code followed by the conversion to Pel
+// --------------------------------------------------------------------------------------------------------------------
+
+template<X86_VEXT vext>
+static void xInvTrHor_SSE( const int16_t* src, Pel* dst, const int dstStride, const int width, const int height, const int nzWidth, const TMatrixCoeff* iT, const int shift )
+{
+  const int numPairs = nzWidth >> 1;
+  int x = 0;
+
+#ifdef USE_AVX512
+  if( vext >= AVX512 )
+  {
+    const __m512i vadd  = _mm512_set1_epi32( 1 << ( shift - 1 ) );
+    const __m512i vrows = _mm512_loadu_si512( ( const void* ) g_trRowsPermute512 );
+    __m512i       vt[JVET_C0024_ZERO_OUT_TH >> 1];
+
+    for( ; x + 16 <= width; x += 16 )
+    {
+      for( int q = 0; q < numPairs; q++ )
+      {
+        const TMatrixCoeff* t0 = iT + ( 2 * ( q >> 1 ) * 2 + ( q & 1 ) ) * width + x;
+        const __m256i       r0 = _mm256_loadu_si256( ( const __m256i* ) t0 );
+        const __m256i       r1 = _mm256_loadu_si256( ( const __m256i* ) ( t0 + 2 * width ) );
+
+        vt[q] = _mm512_inserti64x4( _mm512_castsi256_si512( _mm256_unpacklo_epi16( r0, r1 ) ), _mm256_unpackhi_epi16( r0, r1 ), 1 );
+      }
+
+      for( int y = 0; y < height; y += 2 )
+      {
+        const int16_t* s0   = src + y * nzWidth;
+        const int16_t* s1   = s0 + nzWidth;
+        __m512i        acc0 = vadd;
+        __m512i        acc1 = vadd;
+
+        for( int q = 0; q < numPairs; q += 2 )
+        {
+          const __m512i c0 = _mm512_broadcastq_epi64( _mm_loadl_epi64( ( const __m128i* ) &s0[2 * q] ) );
+          const __m512i c1 = _mm512_broadcastq_epi64( _mm_loadl_epi64( ( const __m128i* ) &s1[2 * q] ) );
+
+          acc0 = _mm512_add_epi32( acc0, _mm512_madd_epi16( vt[q    ], _mm512_shuffle_epi32( c0, _MM_PERM_AAAA ) ) );
+          acc0 = _mm512_add_epi32( acc0, _mm512_madd_epi16( vt[q + 1], _mm512_shuffle_epi32( c0, _MM_PERM_BBBB ) ) );
+          acc1 = _mm512_add_epi32( acc1, _mm512_madd_epi16( vt[q    ], _mm512_shuffle_epi32( c1, _MM_PERM_AAAA ) ) );
+          acc1 = _mm512_add_epi32( acc1, _mm512_madd_epi16( vt[q + 1], _mm512_shuffle_epi32( c1, _MM_PERM_BBBB ) ) );
+        }
+
+        const __m512i res = _mm512_permutexvar_epi64( vrows, _mm512_packs_epi32( _mm512_srai_epi32( acc0, shift ), _mm512_srai_epi32( acc1, shift ) ) );
+
+        _mm256_storeu_si256( ( __m256i* ) &dst[ y      * dstStride + x], _mm512_castsi512_si256( res ) );
+        _mm256_storeu_si256( ( __m256i* ) &dst[( y + 1 ) * dstStride + x], _mm512_extracti64x4_epi64( res, 1 ) );
+      }
+    }
+  }
+#endif
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vadd = _mm256_set1_epi32( 1 << ( shift - 1 ) );
+    __m256i       vt[JVET_C0024_ZERO_OUT_TH >> 1];
+
+    for( ; x + 8 <= width; x += 8 )
+    {
+      for( int q = 0; q < numPairs; q++ )
+      {
+        const TMatrixCoeff* t0 = iT + ( 2 * ( q >> 1 ) * 2 + ( q & 1 ) ) * width + x;
+        const __m128i       r0 = _mm_loadu_si128( ( const __m128i* ) t0 );
+        const __m128i       r1 = _mm_loadu_si128( ( const __m128i* ) ( t0 + 2 * width ) );
+
+        vt[q] = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_unpacklo_epi16( r0, r1 ) ), _mm_unpackhi_epi16( r0, r1 ), 1 );
+      }
+
+      for( int y = 0; y < height; y += 2 )
+      {
+        const int16_t* s0   = src + y * nzWidth;
+        const int16_t* s1   = s0 + nzWidth;
+        __m256i        acc0 = vadd;
+        __m256i        acc1 = vadd;
+
+        for( int q = 0; q < numPairs; q += 2 )
+        {
+          const __m256i c0 = _mm256_broadcastq_epi64( _mm_loadl_epi64( ( const __m128i* ) &s0[2 * q] ) );
+          const __m256i c1 = _mm256_broadcastq_epi64( _mm_loadl_epi64( ( const __m128i* ) &s1[2 * q] ) );
+
+          acc0 = _mm256_add_epi32( acc0, _mm256_madd_epi16( vt[q    ], _mm256_shuffle_epi32( c0, 0x00 ) ) );
+          acc0 = _mm256_add_epi32( acc0, _mm256_madd_epi16( vt[q + 1], _mm256_shuffle_epi32( c0, 0x55 ) ) );
+          acc1 = _mm256_add_epi32( acc1, _mm256_madd_epi16( vt[q    ], _mm256_shuffle_epi32( c1, 0x00 ) ) );
+          acc1 = _mm256_add_epi32( acc1, _mm256_madd_epi16( vt[q + 1], _mm256_shuffle_epi32( c1, 0x55 ) ) );
+        }
+
+        const __m256i res = _mm256_permute4x64_epi64( _mm256_packs_epi32( _mm256_srai_epi32( acc0, shift ), _mm256_srai_epi32( acc1, shift ) ), 0xd8 );
+
+        _mm_storeu_si128( ( __m128i* ) &dst[ y      * dstStride + x], _mm256_castsi256_si128( res ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[( y + 1 ) * dstStride + x], _mm256_extracti128_si256( res, 1 ) );
+      }
+    }
+  }
+#endif
+
+  const __m128i vadd = _mm_set1_epi32( 1 << ( shift - 1 ) );
+  __m128i       vlo[JVET_C0024_ZERO_OUT_TH >> 1];
+  __m128i       vhi[JVET_C0024_ZERO_OUT_TH >> 1];
+
+  for( ; x < width; x += 8 )
+  {
+    // 4 samples wide blocks
+    const bool bFull = x + 8 <= width;
+
+    for( int q = 0; q < numPairs; q++ )
+    {
+      const TMatrixCoeff* t0 = iT + ( 2 * ( q >> 1 ) * 2 + ( q & 1 ) ) * width + x;
+      const __m128i       r0 = bFull ? _mm_loadu_si128( ( const __m128i* ) t0 ) : _mm_loadl_epi64( ( const __m128i* ) t0 );
+      const __m128i       r1 = bFull ? _mm_loadu_si128( ( const __m128i* ) ( t0 + 2 * width ) ) : _mm_loadl_epi64( ( const __m128i* ) ( t0 + 2 * width ) );
+
+      vlo[q] = _mm_unpacklo_epi16( r0, r1 );
+      vhi[q] = _mm_unpackhi_epi16( r0, r1 );
+    }
+
+    for( int y = 0; y < height; y++ )
+    {
+      const int16_t* s     = src + y * nzWidth;
+      __m128i        accLo = vadd;
+      __m128i        accHi = vadd;
+
+      for( int q = 0; q < numPairs; q += 2 )
+      {
+        const __m128i c  = _mm_loadl_epi64( ( const __m128i* ) &s[2 * q] );
+        const __m128i c0 = _mm_shuffle_epi32( c, 0x00 );
+        const __m128i c1 = _mm_shuffle_epi32( c, 0x55 );
+
+        accLo = _mm_add_epi32( accLo, _mm_add_epi32( _mm_madd_epi16( vlo[q], c0 ), _mm_madd_epi16( vlo[q + 1], c1 ) ) );
+        accHi = _mm_add_epi32( accHi, _mm_add_epi32( _mm_madd_epi16( vhi[q], c0 ), _mm_madd_epi16( vhi[q + 1], c1 ) ) );
+      }
+
+      const __m128i res = _mm_packs_epi32( _mm_srai_epi32( accLo, shift ), _mm_srai_epi32( accHi, shift ) );
+
+      if( bFull )
+      {
+        _mm_storeu_si128( ( __m128i* ) &dst[y * dstStride + x], res );
+      }
+      else
+      {
+        _mm_storel_epi64( ( __m128i* ) &dst[y * dstStride + x], res );
+      }
+    }
+  }
+}
+
+// DCT-II version of the 2nd stage, the outputs x and width-1-x are the sum and the difference of the
+// even and the odd part, the latter are stored with reversed sample order
+template<X86_VEXT vext>
+static void xInvTrHorDCT2_SSE( const int16_t* src, Pel* dst, const int dstStride, const int width, const int height, const int nzWidth, const TMatrixCoeff* iT, const int shift )
+{
+  const int numPairs = nzWidth >> 1;
+  const int half     = width >> 1;
+  const __m128i vrev = _mm_loadu_si128( ( const __m128i* ) g_trRevShuffle );
+  int x = 0;
+
+#ifdef USE_AVX512
+  if( vext >= AVX512 )
+  {
+    const __m512i vadd    = _mm512_set1_epi32( 1 << ( shift - 1 ) );
+    const __m512i vrows   = _mm512_loadu_si512( ( const void* ) g_trRowsPermute512 );
+    const __m512i vrev512 = _mm512_loadu_si512( ( const void* ) g_trRevPermute512 );
+    __m512i       vt[JVET_C0024_ZERO_OUT_TH >> 1];
+
+    for( ; x + 16 <= half; x += 16 )
+    {
+      for( int q = 0; q < numPairs; q++ )
+      {
+        const TMatrixCoeff* t0 = iT + ( 2 * ( q >> 1 ) * 2 + ( q & 1 ) ) * width + x;
+        const __m256i       r0 = _mm256_loadu_si256( ( const __m256i* ) t0 );
+        const __m256i       r1 = _mm256_loadu_si256( ( const __m256i* ) ( t0 + 2 * width ) );
+
+        vt[q] = _mm512_inserti64x4( _mm512_castsi256_si512( _mm256_unpacklo_epi16( r0, r1 ) ), _mm256_unpackhi_epi16( r0, r1 ), 1 );
+      }
+
+      for( int y = 0; y < height; y += 2 )
+      {
+        const int16_t* s0    = src + y * nzWidth;
+        const int16_t* s1    = s0 + nzWidth;
+        __m512i        sumE0 = vadd, sumO0 = _mm512_setzero_si512();
+        __m512i        sumE1 = vadd, sumO1 = _mm512_setzero_si512();
+
+        for( int q = 0; q < numPairs; q += 2 )
+        {
+          const __m512i c0 = _mm512_broadcastq_epi64( _mm_loadl_epi64( ( const __m128i* ) &s0[2 * q] ) );
+          const __m512i c1 = _mm512_broadcastq_epi64( _mm_loadl_epi64( ( const __m128i* ) &s1[2 * q] ) );
+
+          sumE0 = _mm512_add_epi32( sumE0, _mm512_madd_epi16( vt[q    ], _mm512_shuffle_epi32( c0, _MM_PERM_AAAA ) ) );
+          sumO0 = _mm512_add_epi32( sumO0, _mm512_madd_epi16( vt[q + 1], _mm512_shuffle_epi32( c0, _MM_PERM_BBBB ) ) );
+          sumE1 = _mm512_add_epi32( sumE1, _mm512_madd_epi16( vt[q    ], _mm512_shuffle_epi32( c1, _MM_PERM_AAAA ) ) );
+          sumO1 = _mm512_add_epi32( sumO1, _mm512_madd_epi16( vt[q + 1], _mm512_shuffle_epi32( c1, _MM_PERM_BBBB ) ) );
+        }
+
+        const __m512i lft = _mm512_packs_epi32( _mm512_srai_epi32( _mm512_add_epi32( sumE0, sumO0 ), shift ), _mm512_srai_epi32( _mm512_add_epi32( sumE1, sumO1 ), shift ) );
+        const __m512i rgt = _mm512_packs_epi32( _mm512_srai_epi32( _mm512_sub_epi32( sumE0, sumO0 ), shift ), _mm512_srai_epi32( _mm512_sub_epi32( sumE1, sumO1 ), shift ) );
+        const __m512i l   = _mm512_permutexvar_epi64( vrows, lft );
+        const __m512i r   = _mm512_permutexvar_epi16( vrev512, _mm512_permutexvar_epi64( vrows, rgt ) );
+
+        _mm256_storeu_si256( ( __m256i* ) &dst[ y      * dstStride + x], _mm512_castsi512_si256( l ) );
+        _mm256_storeu_si256( ( __m256i* ) &dst[( y + 1 ) * dstStride + x], _mm512_extracti64x4_epi64( l, 1 ) );
+        _mm256_storeu_si256( ( __m256i* ) &dst[ y      * dstStride + width - 16 - x], _mm512_castsi512_si256( r ) );
+        _mm256_storeu_si256( ( __m256i* ) &dst[( y + 1 ) * dstStride + width - 16 - x], _mm512_extracti64x4_epi64( r, 1 ) );
+      }
+    }
+  }
+#endif
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vadd  = _mm256_set1_epi32( 1 << ( shift - 1 ) );
+    const __m256i vrev2 = _mm256_broadcastsi128_si256( vrev );
+    __m256i       vt[JVET_C0024_ZERO_OUT_TH >> 1];
+
+    for( ; x + 8 <= half; x += 8 )
+    {
+      for( int q = 0; q < numPairs; q++ )
+      {
+        const TMatrixCoeff* t0 = iT + ( 2 * ( q >> 1 ) * 2 + ( q & 1 ) ) * width + x;
+        const __m128i       r0 = _mm_loadu_si128( ( const __m128i* ) t0 );
+        const __m128i       r1 = _mm_loadu_si128( ( const __m128i* ) ( t0 + 2 * width ) );
+
+        vt[q] = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_unpacklo_epi16( r0, r1 ) ), _mm_unpackhi_epi16( r0, r1 ), 1 );
+      }
+
+      for( int y = 0; y < height; y += 2 )
+      {
+        const int16_t* s0    = src + y * nzWidth;
+        const int16_t* s1    = s0 + nzWidth;
+        __m256i        sumE0 = vadd, sumO0 = _mm256_setzero_si256();
+        __m256i        sumE1 = vadd, sumO1 = _mm256_setzero_si256();
+
+        for( int q = 0; q < numPairs; q += 2 )
+        {
+          const __m256i c0 = _mm256_broadcastq_epi64( _mm_loadl_epi64( ( const __m128i* ) &s0[2 * q] ) );
+          const __m256i c1 = _mm256_broadcastq_epi64( _mm_loadl_epi64( ( const __m128i* ) &s1[2 * q] ) );
+
+          sumE0 = _mm256_add_epi32( sumE0, _mm256_madd_epi16( vt[q    ], _mm256_shuffle_epi32( c0, 0x00 ) ) );
+          sumO0 = _mm256_add_epi32( sumO0, _mm256_madd_epi16( vt[q + 1], _mm256_shuffle_epi32( c0, 0x55 ) ) );
+          sumE1 = _mm256_add_epi32( sumE1, _mm256_madd_epi16( vt[q    ], _mm256_shuffle_epi32( c1, 0x00 ) ) );
+          sumO1 = _mm256_add_epi32( sumO1, _mm256_madd_epi16( vt[q + 1], _mm256_shuffle_epi32( c1, 0x55 ) ) );
+        }
+
+        const __m256i lft = _mm256_packs_epi32( _mm256_srai_epi32( _mm256_add_epi32( sumE0, sumO0 ), shift ), _mm256_srai_epi32( _mm256_add_epi32( sumE1, sumO1 ), shift ) );
+        const __m256i rgt = _mm256_packs_epi32( _mm256_srai_epi32( _mm256_sub_epi32( sumE0, sumO0 ), shift ), _mm256_srai_epi32( _mm256_sub_epi32( sumE1, sumO1 ), shift ) );
+        const __m256i l   = _mm256_permute4x64_epi64( lft, 0xd8 );
+        const __m256i r   = _mm256_shuffle_epi8( _mm256_permute4x64_epi64( rgt, 0xd8 ), vrev2 );
+
+        _mm_storeu_si128( ( __m128i* ) &dst[ y      * dstStride + x], _mm256_castsi256_si128( l ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[( y + 1 ) * dstStride + x], _mm256_extracti128_si256( l, 1 ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[ y      * dstStride + width - 8 - x], _mm256_castsi256_si128( r ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[( y + 1 ) * dstStride + width - 8 - x], _mm256_extracti128_si256( r, 1 ) );
+      }
+    }
+  }
+#endif
+
+  const __m128i vadd = _mm_set1_epi32( 1 << ( shift - 1 ) );
+  __m128i       vlo[JVET_C0024_ZERO_OUT_TH >> 1];
+  __m128i       vhi[JVET_C0024_ZERO_OUT_TH >> 1];
+
+  for( ; x < half; x += 8 )
+  {
+    // the last block is 4 samples wide for a width of 8
+    const bool bFull = x + 8 <= half;
+
+    for( int q = 0; q < numPairs; q++ )
+    {
+      const TMatrixCoeff* t0 = iT + ( 2 * ( q >> 1 ) * 2 + ( q & 1 ) ) * width + x;
+      const __m128i       r0 = bFull ? _mm_loadu_si128( ( const __m128i* ) t0 ) : _mm_loadl_epi64( ( const __m128i* ) t0 );
+      const __m128i       r1 = bFull ? _mm_loadu_si128( ( const __m128i* ) ( t0 + 2 * width ) ) : _mm_loadl_epi64( ( const __m128i* ) ( t0 + 2 * width ) );
+
+      vlo[q] = _mm_unpacklo_epi16( r0, r1 );
+      vhi[q] = _mm_unpackhi_epi16( r0, r1 );
+    }
+
+    for( int y = 0; y < height; y++ )
+    {
+      const int16_t* s      = src + y * nzWidth;
+      __m128i        sumLoE = vadd, sumLoO = _mm_setzero_si128();
+      __m128i        sumHiE = vadd, sumHiO = _mm_setzero_si128();
+
+      for( int q = 0; q < numPairs; q += 2 )
+      {
+        const __m128i c  = _mm_loadl_epi64( ( const __m128i* ) &s[2 * q] );
+        const __m128i c0 = _mm_shuffle_epi32( c, 0x00 );
+        const __m128i c1 = _mm_shuffle_epi32( c, 0x55 );
+
+        sumLoE = _mm_add_epi32( sumLoE, _mm_madd_epi16( vlo[q    ], c0 ) );
+        sumLoO = _mm_add_epi32( sumLoO, _mm_madd_epi16( vlo[q + 1], c1 ) );
+        sumHiE = _mm_add_epi32( sumHiE, _mm_madd_epi16( vhi[q    ], c0 ) );
+        sumHiO = _mm_add_epi32( sumHiO, _mm_madd_epi16( vhi[q + 1], c1 ) );
+      }
+
+      const __m128i lft = _mm_packs_epi32( _mm_srai_epi32( _mm_add_epi32( sumLoE, sumLoO ), shift ), _mm_srai_epi32( _mm_add_epi32( sumHiE, sumHiO ), shift ) );
+      const __m128i rgt = _mm_shuffle_epi8( _mm_packs_epi32( _mm_srai_epi32( _mm_sub_epi32( sumLoE, sumLoO ), shift ), _mm_srai_epi32( _mm_sub_epi32( sumHiE, sumHiO ), shift ) ), vrev );
+
+      if( bFull )
+      {
+        _mm_storeu_si128( ( __m128i* ) &dst[y * dstStride + x], lft );
+        _mm_storeu_si128( ( __m128i* ) &dst[y * dstStride + width - 8 - x], rgt );
+      }
+      else
+      {
+        // only the lower half is valid, reversed it is in the upper half
+        _mm_storel_epi64( ( __m128i* ) &dst[y * dstStride + x], lft );
+        _mm_storel_epi64( ( __m128i* ) &dst[y * dstStride + width - 4 - x], _mm_unpackhi_epi64( rgt, rgt ) );
+      }
+    }
+  }
+}
+
+// 4x4 blocks are kept in registers: the 1st stage computes the intermediate block transposed, so that both stages
+// broadcast pairs of the block and multiply them with pairs of basis functions
+static inline void xInvTr4x4_SSE( const TCoeff* src, Pel* dst, const int dstStride, const TMatrixCoeff* iTHor, const TMatrixCoeff* iTVer, const int shift1st, const int shift2nd )
+{
+  const __m128i c0 = _mm_loadu_si128( ( const __m128i* ) &src[ 0] );
+  const __m128i c1 = _mm_loadu_si128( ( const __m128i* ) &src[ 4] );
+  const __m128i c2 = _mm_loadu_si128( ( const __m128i* ) &src[ 8] );
+  const __m128i c3 = _mm_loadu_si128( ( const __m128i* ) &src[12] );
+  const __m128i cE = _mm_unpacklo_epi16( _mm_packs_epi32( c0, c0 ), _mm_packs_epi32( c2, c2 ) );
+  const __m128i cO = _mm_unpacklo_epi16( _mm_packs_epi32( c1, c1 ), _mm_packs_epi32( c3, c3 ) );
+
+  const __m128i vE = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) &iTVer[ 0] ), _mm_loadl_epi64( ( const __m128i* ) &iTVer[ 8] ) );
+  const __m128i vO = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) &iTVer[ 4] ), _mm_loadl_epi64( ( const __m128i* ) &iTVer[12] ) );
+  const __m128i add1 = _mm_set1_epi32( 1 << ( shift1st - 1 ) );
+
+  // column x of the intermediate block
+  __m128i col[4];
+  col[0] = _mm_add_epi32( _mm_madd_epi16( vE, _mm_shuffle_epi32( cE, 0x00 ) ), _mm_madd_epi16( vO, _mm_shuffle_epi32( cO, 0x00 ) ) );
+  col[1] = _mm_add_epi32( _mm_madd_epi16( vE, _mm_shuffle_epi32( cE, 0x55 ) ), _mm_madd_epi16( vO, _mm_shuffle_epi32( cO, 0x55 ) ) );
+  col[2] = _mm_add_epi32( _mm_madd_epi16( vE, _mm_shuffle_epi32( cE, 0xaa ) ), _mm_madd_epi16( vO, _mm_shuffle_epi32( cO, 0xaa ) ) );
+  col[3] = _mm_add_epi32( _mm_madd_epi16( vE, _mm_shuffle_epi32( cE, 0xff ) ), _mm_madd_epi16( vO, _mm_shuffle_epi32( cO, 0xff ) ) );
+
+  for( int x = 0; x < 4; x++ )
+  {
+    col[x] = _mm_srai_epi32( _mm_add_epi32( col[x], add1 ), shift1st );
+  }
+
+  const __m128i tE = _mm_unpacklo_epi16( _mm_packs_epi32( col[0], col[0] ), _mm_packs_epi32( col[2], col[2] ) );
+  const __m128i tO = _mm_unpacklo_epi16( _mm_packs_epi32( col[1], col[1] ), _mm_packs_epi32( col[3], col[3] ) );
+
+  const __m128i hE = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) &iTHor[ 0] ), _mm_loadl_epi64( ( const __m128i* ) &iTHor[ 8] ) );
+  const __m128i hO = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) &iTHor[ 4] ), _mm_loadl_epi64( ( const __m128i* ) &iTHor[12] ) );
+  const __m128i add2 = _mm_set1_epi32( 1 << ( shift2nd - 1 ) );
+
+  __m128i row[4];
+  row[0] = _mm_add_epi32( _mm_madd_epi16( hE, _mm_shuffle_epi32( tE, 0x00 ) ), _mm_madd_epi16( hO, _mm_shuffle_epi32( tO, 0x00 ) ) );
+  row[1] = _mm_add_epi32( _mm_madd_epi16( hE, _mm_shuffle_epi32( tE, 0x55 ) ), _mm_madd_epi16( hO, _mm_shuffle_epi32( tO, 0x55 ) ) );
+  row[2] = _mm_add_epi32( _mm_madd_epi16( hE, _mm_shuffle_epi32( tE, 0xaa ) ), _mm_madd_epi16( hO, _mm_shuffle_epi32( tO, 0xaa ) ) );
+  row[3] = _mm_add_epi32( _mm_madd_epi16( hE, _mm_shuffle_epi32( tE, 0xff ) ), _mm_madd_epi16( hO, _mm_shuffle_epi32( tO, 0xff ) ) );
+
+  for( int y = 0; y < 4; y++ )
+  {
+    row[y] = _mm_srai_epi32( _mm_add_epi32( row[y], add2 ), shift2nd );
+  }
+
+  const __m128i r01 = _mm_packs_epi32( row[0], row[1] );
+  const __m128i r23 = _mm_packs_epi32( row[2], row[3] );
+
+  _mm_storel_epi64( ( __m128i* ) &dst[0 * dstStride], r01 );
+  _mm_storel_epi64( ( __m128i* ) &dst[1 * dstStride], _mm_unpackhi_epi64( r01, r01 ) );
+  _mm_storel_epi64( ( __m128i* ) &dst[2 * dstStride], r23 );
+  _mm_storel_epi64( ( __m128i* ) &dst[3 * dstStride], _mm_unpackhi_epi64( r23, r23 ) );
+}
+
+// Both stages are evaluated as matrix multiplications of 16 bit values with 32 bit accumulation. The
+// butterflies and the fast DST-VII/DCT-VIII of the C code compute the same integer sums, so the result
+// is bit exact. Only the non-zero region given by skipWidth/skipHeight is read and multiplied.
+template<X86_VEXT vext>
+void invTransform2D_SSE( const TCoeff* src, Pel* dst, const int dstStride, const int width, const int height, const int trTypeHor, const int trTypeVer,
+                         const int skipWidth, const int skipHeight, const int shift1st, const int shift2nd, const TCoeff clipMinimum, const TCoeff clipMaximum )
+{
+  // the 16 bit intermediate needs the clipping range of the non-extended precision processing
+  if( width < 4 || height < 4 || clipMinimum != std::numeric_limits<int16_t>::min() || clipMaximum != std::numeric_limits<int16_t>::max() )
+  {
+    TrQuant::invTransform2DCore( src, dst, dstStride, width, height, trTypeHor, trTypeVer, skipWidth, skipHeight, shift1st, shift2nd, clipMinimum, clipMaximum );
+    return;
+  }
+
+  if( width == 4 && height == 4 )
+  {
+    xInvTr4x4_SSE( src, dst, dstStride, xTrMatrix( trTypeHor, 4 ), xTrMatrix( trTypeVer, 4 ), shift1st, shift2nd );
+    return;
+  }
+
+  const int nzWidth  = width  - skipWidth;
+  const int nzHeight = height - skipHeight;
+
+  CHECKD( nzWidth > JVET_C0024_ZERO_OUT_TH || nzHeight > JVET_C0024_ZERO_OUT_TH, "Non-zero region exceeds the zero-out threshold" );
+  CHECKD( ( nzWidth & 3 ) || ( nzHeight & 3 ), "Non-zero region has to be a multiple of 4" );
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int16_t tmp[MAX_TB_SIZEY * JVET_C0024_ZERO_OUT_TH] );
+
+  if( trTypeVer == DCT2 )
+  {
+    xInvTrVer_SSE<vext, true >( src, tmp, width, height, nzWidth, nzHeight, xTrMatrix( trTypeVer, height ), shift1st );
+  }
+  else
+  {
+    xInvTrVer_SSE<vext, false>( src, tmp, width, height, nzWidth, nzHeight, xTrMatrix( trTypeVer, height ), shift1st );
+  }
+
+  if( trTypeHor == DCT2 && width >= 8 )
+  {
+    xInvTrHorDCT2_SSE<vext>( tmp, dst, dstStride, width, height, nzWidth, xTrMatrix( trTypeHor, width ), shift2nd );
+  }
+  else
+  {
+    xInvTrHor_SSE<vext>    ( tmp, dst, dstStride, width, height, nzWidth, xTrMatrix( trTypeHor, width ), shift2nd );
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// forward transforms
+// --------------------------------------------------------------------------------------------------------------------
+
+// Pairs of forward basis functions ( T[k][2j], T[k][2j+1] ) as 32 bit words, ordered by the sample pair j and
+// then by the coefficient k, so that the 1st stage loads the basis functions of consecutive coefficients.
+static const int32_t* xFwdTrPairs( const int trType, const int size )
+{
+  struct FwdTrPairs
+  {
+    // DCT-II from 4 to 64 points, DCT-VIII and DST-VII from 4 to 32 points
+    int32_t        pairs[( 8 + 32 + 128 + 512 + 2048 ) + 2 * ( 8 + 32 + 128 + 512 )];
+    const int32_t* table[NUM_TRANS_TYPE][MAX_TB_LOG2_SIZEY + 1];
+
+    FwdTrPairs()
+    {
+      int32_t* dst = pairs;
+
+      for( int trType = 0; trType < NUM_TRANS_TYPE; trType++ )
+      {
+        for( int log2Size = 0; log2Size <= MAX_TB_LOG2_SIZEY; log2Size++ )
+        {
+          const int size = 1 << log2Size;
+
+          if( size < 4 || size > ( trType == DCT2 ? 64 : 32 ) )
+          {
+            table[trType][log2Size] = nullptr;
+            continue;
+          }
+
+          const TMatrixCoeff* tc = xTrMatrix( trType, size, TRANSFORM_FORWARD );
+
+          table[trType][log2Size] = dst;
+
+          for( int j = 0; j < size; j += 2 )
+          {
+            for( int k = 0; k < size; k++ )
+            {
+              *dst++ = int32_t( uint16_t( tc[k * size + j] ) ) | ( int32_t( tc[k * size + j + 1] ) * ( 1 << 16 ) );
+            }
+          }
+        }
+      }
+
+      CHECK( dst != pairs + sizeof( pairs ) / sizeof( pairs[0] ), "Forward transform pair table size mismatch" );
+    }
+  };
+
+  static const FwdTrPairs fwdTrPairs;
+
+  return fwdTrPairs.table[trType][floorLog2( size )];
+}
+
+static inline int32_t xLoadPair( const int16_t* src )
+{
+  int32_t pair;
+  memcpy( &pair, src, sizeof( pair ) );
+  return pair;
+}
+
+static const int8_t g_trInterleaveShuffle[16] = { 0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15 };
+
+// --------------------------------------------------------------------------------------------------------------------
+// 1st (horizontal) stage: each pair of residual rows is multiplied with the basis functions of the first nzWidth
+// coefficients. The result is stored as 16 bit pairs of the two rows, dst[( y >> 1 ) * nzWidth + k], which are the
+// operands of the 2nd stage. Returns false if the result does not fit into 16 bit.
+// --------------------------------------------------------------------------------------------------------------------
+
+template<X86_VEXT vext>
+static bool xFwdTrHor_SSE( const Pel* src, const int srcStride, int32_t* dst, const int width, const int height, const int nzWidth, const int32_t* tPair, const int shift )
+{
+  const int     add   = shift > 0 ? 1 << ( shift - 1 ) : 0;
+  const __m128i vperm = _mm_loadu_si128( ( const __m128i* ) g_trInterleaveShuffle );
+  __m128i       vmin  = _mm_setzero_si128();
+  __m128i       vmax  = _mm_setzero_si128();
+
+  for( int y = 0; y < height; y += 2, src += 2 * srcStride, dst += nzWidth )
+  {
+    const Pel* src0 = src;
+    const Pel* src1 = src + srcStride;
+    int k = 0;
+
+#ifdef USE_AVX512
+    if( vext >= AVX512 )
+    {
+      const __m512i vadd     = _mm512_set1_epi32( add );
+      const __m512i vperm512 = _mm512_broadcast_i32x4( vperm );
+      __m512i       vmin512  = _mm512_setzero_si512();
+      __m512i       vmax512  = _mm512_setzero_si512();
+
+      for( ; k + 16 <= nzWidth; k += 16 )
+      {
+        __m512i vsum0 = vadd;
+        __m512i vsum1 = vadd;
+
+        for( int j = 0; j < width; j += 2 )
+        {
+          const __m512i vt = _mm512_loadu_si512( ( const void* ) &tPair[( j >> 1 ) * width + k] );
+
+          vsum0 = _mm512_add_epi32( vsum0, _mm512_madd_epi16( vt, _mm512_set1_epi32( xLoadPair( src0 + j ) ) ) );
+          vsum1 = _mm512_add_epi32( vsum1, _mm512_madd_epi16( vt, _mm512_set1_epi32( xLoadPair( src1 + j ) ) ) );
+        }
+
+        vsum0 = _mm512_srai_epi32( vsum0, shift );
+        vsum1 = _mm512_srai_epi32( vsum1, shift );
+
+        vmin512 = _mm512_min_epi32( vmin512, _mm512_min_epi32( vsum0, vsum1 ) );
+        vmax512 = _mm512_max_epi32( vmax512, _mm512_max_epi32( vsum0, vsum1 ) );
+
+        _mm512_storeu_si512( ( void* ) &dst[k], _mm512_shuffle_epi8( _mm512_packs_epi32( vsum0, vsum1 ), vperm512 ) );
+      }
+
+      vmin = _mm_min_epi32( vmin, _mm_set1_epi32( _mm512_reduce_min_epi32( vmin512 ) ) );
+      vmax = _mm_max_epi32( vmax, _mm_set1_epi32( _mm512_reduce_max_epi32( vmax512 ) ) );
+    }
+#endif
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vadd   = _mm256_set1_epi32( add );
+      const __m256i vperm2 = _mm256_broadcastsi128_si256( vperm );
+      __m256i       vmin2  = _mm256_setzero_si256();
+      __m256i       vmax2  = _mm256_setzero_si256();
+
+      for( ; k + 8 <= nzWidth; k += 8 )
+      {
+        __m256i vsum0 = vadd;
+        __m256i vsum1 = vadd;
+
+        for( int j = 0; j < width; j += 2 )
+        {
+          const __m256i vt = _mm256_loadu_si256( ( const __m256i* ) &tPair[( j >> 1 ) * width + k] );
+
+          vsum0 = _mm256_add_epi32( vsum0, _mm256_madd_epi16( vt, _mm256_set1_epi32( xLoadPair( src0 + j ) ) ) );
+          vsum1 = _mm256_add_epi32( vsum1, _mm256_madd_epi16( vt, _mm256_set1_epi32( xLoadPair( src1 + j ) ) ) );
+        }
+
+        vsum0 = _mm256_srai_epi32( vsum0, shift );
+        vsum1 = _mm256_srai_epi32( vsum1, shift );
+
+        vmin2 = _mm256_min_epi32( vmin2, _mm256_min_epi32( vsum0, vsum1 ) );
+        vmax2 = _mm256_max_epi32( vmax2, _mm256_max_epi32( vsum0, vsum1 ) );
+
+        _mm256_storeu_si256( ( __m256i* ) &dst[k], _mm256_shuffle_epi8( _mm256_packs_epi32( vsum0, vsum1 ), vperm2 ) );
+      }
+
+      vmin = _mm_min_epi32( vmin, _mm_min_epi32( _mm256_castsi256_si128( vmin2 ), _mm256_extracti128_si256( vmin2, 1 ) ) );
+      vmax = _mm_max_epi32( vmax, _mm_max_epi32( _mm256_castsi256_si128( vmax2 ), _mm256_extracti128_si256( vmax2, 1 ) ) );
+    }
+#endif
+
+    const __m128i vadd = _mm_set1_epi32( add );
+
+    for( ; k < nzWidth; k += 4 )
+    {
+      __m128i vsum0 = vadd;
+      __m128i vsum1 = vadd;
+
+      for( int j = 0; j < width; j += 2 )
+      {
+        const __m128i vt = _mm_loadu_si128( ( const __m128i* ) &tPair[( j >> 1 ) * width + k] );
+
+        vsum0 = _mm_add_epi32( vsum0, _mm_madd_epi16( vt, _mm_set1_epi32( xLoadPair( src0 + j ) ) ) );
+        vsum1 = _mm_add_epi32( vsum1, _mm_madd_epi16( vt, _mm_set1_epi32( xLoadPair( src1 + j ) ) ) );
+      }
+
+      vsum0 = _mm_srai_epi32( vsum0, shift );
+      vsum1 = _mm_srai_epi32( vsum1, shift );
+
+      vmin = _mm_min_epi32( vmin, _mm_min_epi32( vsum0, vsum1 ) );
+      vmax = _mm_max_epi32( vmax, _mm_max_epi32( vsum0, vsum1 ) );
+
+      _mm_storeu_si128( ( __m128i* ) &dst[k], _mm_shuffle_epi8( _mm_packs_epi32( vsum0, vsum1 ), vperm ) );
+    }
+  }
+
+  const __m128i vovf = _mm_or_si128( _mm_cmplt_epi32( vmin, _mm_set1_epi32( std::numeric_limits<int16_t>::min() ) ),
+                                     _mm_cmpgt_epi32( vmax, _mm_set1_epi32( std::numeric_limits<int16_t>::max() ) ) );
+
+  return _mm_test_all_zeros( vovf, vovf ) != 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// 2nd (vertical) stage: the first nzHeight coefficient rows are computed from the row pairs of the 1st stage, the
+// columns from nzWidth and the remaining rows are zero
+// --------------------------------------------------------------------------------------------------------------------
+
+template<X86_VEXT vext>
+static void xFwdTrVer_SSE( const int32_t* src, TCoeff* dst, const int width, const int height, const int nzWidth, const int nzHeight, const TMatrixCoeff* tc, const int shift )
+{
+  const int add = shift > 0 ? 1 << ( shift - 1 ) : 0;
+
+  for( int ky = 0; ky < nzHeight; ky += 2 )
+  {
+    const TMatrixCoeff* t0   = tc + ky * height;
+    const TMatrixCoeff* t1   = t0 + height;
+    TCoeff*             dst0 = dst + ky * width;
+    TCoeff*             dst1 = dst0 + width;
+    int kx = 0;
+
+#ifdef USE_AVX512
+    if( vext >= AVX512 )
+    {
+      const __m512i vadd = _mm512_set1_epi32( add );
+
+      for( ; kx + 16 <= nzWidth; kx += 16 )
+      {
+        __m512i vsum0 = vadd;
+        __m512i vsum1 = vadd;
+
+        for( int y = 0; y < height; y += 2 )
+        {
+          const __m512i vs = _mm512_loadu_si512( ( const void* ) &src[( y >> 1 ) * nzWidth + kx] );
+
+          vsum0 = _mm512_add_epi32( vsum0, _mm512_madd_epi16( vs, _mm512_set1_epi32( xLoadPair( t0 + y ) ) ) );
+          vsum1 = _mm512_add_epi32( vsum1, _mm512_madd_epi16( vs, _mm512_set1_epi32( xLoadPair( t1 + y ) ) ) );
+        }
+
+        _mm512_storeu_si512( ( void* ) &dst0[kx], _mm512_srai_epi32( vsum0, shift ) );
+        _mm512_storeu_si512( ( void* ) &dst1[kx], _mm512_srai_epi32( vsum1, shift ) );
+      }
+    }
+#endif
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vadd = _mm256_set1_epi32( add );
+
+      for( ; kx + 8 <= nzWidth; kx += 8 )
+      {
+        __m256i vsum0 = vadd;
+        __m256i vsum1 = vadd;
+
+        for( int y = 0; y < height; y += 2 )
+        {
+          const __m256i vs = _mm256_loadu_si256( ( const __m256i* ) &src[( y >> 1 ) * nzWidth + kx] );
+
+          vsum0 = _mm256_add_epi32( vsum0, _mm256_madd_epi16( vs, _mm256_set1_epi32( xLoadPair( t0 + y ) ) ) );
+          vsum1 = _mm256_add_epi32( vsum1, _mm256_madd_epi16( vs, _mm256_set1_epi32( xLoadPair( t1 + y ) ) ) );
+        }
+
+        _mm256_storeu_si256( ( __m256i* ) &dst0[kx], _mm256_srai_epi32( vsum0, shift ) );
+        _mm256_storeu_si256( ( __m256i* ) &dst1[kx], _mm256_srai_epi32( vsum1, shift ) );
+      }
+    }
+#endif
+
+    const __m128i vadd = _mm_set1_epi32( add );
+
+    for( ; kx < nzWidth; kx += 4 )
+    {
+      __m128i vsum0 = vadd;
+      __m128i vsum1 = vadd;
+
+      for( int y = 0; y < height; y += 2 )
+      {
+        const __m128i vs = _mm_loadu_si128( ( const __m128i* ) &src[( y >> 1 ) * nzWidth + kx] );
+
+        vsum0 = _mm_add_epi32( vsum0, _mm_madd_epi16( vs, _mm_set1_epi32( xLoadPair( t0 + y ) ) ) );
+        vsum1 = _mm_add_epi32( vsum1, _mm_madd_epi16( vs, _mm_set1_epi32( xLoadPair( t1 + y ) ) ) );
+      }
+
+      _mm_storeu_si128( ( __m128i* ) &dst0[kx], _mm_srai_epi32( vsum0, shift ) );
+      _mm_storeu_si128( ( __m128i* ) &dst1[kx], _mm_srai_epi32( vsum1, shift ) );
+    }
+
+    if( nzWidth < width )
+    {
+      memset( dst0 + nzWidth, 0, ( width - nzWidth ) * sizeof( TCoeff ) );
+      memset( dst1 + nzWidth, 0, ( width - nzWidth ) * sizeof( TCoeff ) );
+    }
+  }
+
+  if( nzHeight < height )
+  {
+    memset( dst + nzHeight * width, 0, ( height - nzHeight ) * width * sizeof( TCoeff ) );
+  }
+}
+
+// number of coefficient rows the C code computes: the DCT-II up to 32 points and the 4-point transforms
+// ignore the zero-out of the rows (e.g. for LFNST), all other transforms zero the rows from height-skipHeight
+static inline int xFwdTrRows( const int trTypeVer, const int height, const int skipHeight )
+{
+  return ( trTypeVer == DCT2 && height <= JVET_C0024_ZERO_OUT_TH ) || height == 4 ? height : height - skipHeight;
+}
+
+// Both stages are matrix multiplications of the non-zero output region only, i.e. width-skipWidth
+// coefficients per row and the coefficient rows computed by the C code. The 1st stage result is kept
+// in 16 bit, a block exceeding this range (only possible for extended precision) uses the C code.
+template<X86_VEXT vext>
+void fwdTransform2DMulti_SSE( const Pel* src, const int srcStride, TCoeff* const* dst, const int numTr, const int width, const int height, const int* trTypeHor, const int* trTypeVer,
+                              const int* skipWidth, const int* skipHeight, const int shift1st, const int shift2nd )
+{
+  if( width < 4 || height < 4 )
+  {
+    TrQuant::fwdTransform2DMultiCore( src, srcStride, dst, numTr, width, height, trTypeHor, trTypeVer, skipWidth, skipHeight, shift1st, shift2nd );
+    return;
+  }
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int32_t tmp[( MAX_TB_SIZEY >> 1 ) * JVET_C0024_ZERO_OUT_TH] );
+
+  bool done[NUM_TRAFO_MODES_MTS] = { false, };
+
+  CHECK( numTr > NUM_TRAFO_MODES_MTS, "Too many transform candidates" );
+
+  for( int i = 0; i < numTr; i++ )
+  {
+    if( done[i] )
+    {
+      continue;
+    }
+
+    const int nzWidth = width - skipWidth[i];
+
+    CHECKD( nzWidth > JVET_C0024_ZERO_OUT_TH || ( nzWidth & 3 ), "Unsupported non-zero width" );
+
+    const bool ok = xFwdTrHor_SSE<vext>( src, srcStride, tmp, width, height, nzWidth, xFwdTrPairs( trTypeHor[i], width ), shift1st );
+
+    // the 1st stage is shared by all candidates with the same horizontal transform
+    for( int j = i; j < numTr; j++ )
+    {
+      if( done[j] || trTypeHor[j] != trTypeHor[i] || skipWidth[j] != skipWidth[i] )
+      {
+        continue;
+      }
+
+      if( ok )
+      {
+        xFwdTrVer_SSE<vext>( tmp, dst[j], width, height, nzWidth, xFwdTrRows( trTypeVer[j], height, skipHeight[j] ), xTrMatrix( trTypeVer[j], height, TRANSFORM_FORWARD ), shift2nd );
+      }
+      else
+      {
+        TrQuant::fwdTransform2DCore( src, srcStride, dst[j], width, height, trTypeHor[j], trTypeVer[j], skipWidth[j], skipHeight[j], shift1st, shift2nd );
+      }
+
+      done[j] = true;
+    }
+  }
+}
+
+template<X86_VEXT vext>
+void fwdTransform2D_SSE( const Pel* src, const int srcStride, TCoeff* dst, const int width, const int height, const int trTypeHor, const int trTypeVer,
+                         const int skipWidth, const int skipHeight, const int shift1st, const int shift2nd )
+{
+  fwdTransform2DMulti_SSE<vext>( src, srcStride, &dst, 1, width, height, &trTypeHor, &trTypeVer, &skipWidth, &skipHeight, shift1st, shift2nd );
+}
+
+template <X86_VEXT vext>
+void TrQuant::_initTrQuantX86()
+{
+  m_invTrans2D = invTransform2D_SSE<vext>;
+  m_fwdTrans2D      = fwdTransform2D_SSE<vext>;
+  m_fwdTrans2DMulti = fwdTransform2DMulti_SSE<vext>;
+}
+
+template void TrQuant::_initTrQuantX86<SIMDX86>();
+
+//! \}
+
+#endif //TARGET_SIMD_X86
+#endif //ENABLE_SIMD_OPT_TRAFO
@@ -500,6 +500,9 @@ DecLib::DecLib()
 #if ENABLE_SIMD_OPT_BUFFER
   g_pelBufOP.initPelBufOpsX86();
 #endif
+#if ENABLE_SIMD_OPT_INTRA
+  g_intraPredOP.initIntraPredOpsX86();
+#endif
 }
 
 DecLib::~DecLib()
@@ -452,6 +452,7 @@ EncAdaptiveLoopFilter::EncAdaptiveLoopFilter( int& apsIdStart )
   m_diffFilterCoeff = nullptr;
 
   m_alfWSSD = 0;
+  m_covMaxSummed = 0;
 
 #if JVET_Q0795_CCALF
   m_alfCovarianceCcAlf[0] = nullptr;
@@ -467,6 +468,15 @@ void EncAdaptiveLoopFilter::create( const EncCfg* encCfg, const int picWidth, co
   CHECK( encCfg == nullptr, "encCfg must not be null" );
   m_encCfg = encCfg;
 
+  // the features of a sample are below 2^(bitDepth + 1) in magnitude and a 32 bit sum receives the products of up to
+  // two samples per madd, so 2^(29 - 2 * bitDepth) samples can be summed before flushing to the double statistics
+  const int maxBitDepth = std::max( inputBitDepth[CHANNEL_TYPE_LUMA], inputBitDepth[CHANNEL_TYPE_CHROMA] );
+  m_covMaxSummed = maxBitDepth <= 12 ? 1 << ( 29 - 2 * maxBitDepth ) : 0;
+  m_covFeatures.resize( MAX_NUM_ALF_CLASSES * m_covBatchSize * MaxAlfCovFeatures, 0 );
+  m_covSums.resize( MAX_NUM_ALF_CLASSES * MaxAlfCovFeatures * MaxAlfCovFeatures, 0 );
+  std::fill_n( m_covNumBatched, MAX_NUM_ALF_CLASSES, 0 );
+  std::fill_n( m_covNumSummed, MAX_NUM_ALF_CLASSES, 0 );
+
   for( int channelIdx = 0; channelIdx < MAX_NUM_CHANNEL_TYPE; channelIdx++ )
   {
     ChannelType chType = (ChannelType)channelIdx;
@@ -2350,6 +2360,8 @@ void EncAdaptiveLoopFilter::getBlkStats(AlfCovariance* alfCovariance, const AlfF
   const int numBins = AlfNumClippingValues[channel];
   int transposeIdx = 0;
   int classIdx = 0;
+  const int numFeatures = shape.numCoeff * numBins + 1;
+  const bool intSums = !m_alfWSSD && m_covMaxSummed >= m_covBatchSize;
 
   for( int i = 0; i < area.height; i++ )
   {
@@ -2375,6 +2387,25 @@ void EncAdaptiveLoopFilter::getBlkStats(AlfCovariance* alfCovariance, const AlfF
       }
       int yLocal = org[j] - rec[j];
       calcCovariance(ELocal, rec + j, recStride, shape, transposeIdx, channel, vbDistance);
+      if( intSums )
+      {
+        int16_t* features = getCovFeatures( classIdx );
+        for( int k = 0; k < shape.numCoeff; k++ )
+        {
+          for( int b = 0; b < numBins; b++ )
+          {
+            features[k * numBins + b] = ELocal[k][b];
+          }
+        }
+        features[numFeatures - 1] = yLocal;
+        std::fill( features + numFeatures, features + ( ( numFeatures + 7 ) & ~7 ), 0 );
+
+        if( ++m_covNumBatched[classIdx] == m_covBatchSize )
+        {
+          accumulateCovFeatures( alfCovariance[classIdx], classIdx, shape.numCoeff, numBins );
+        }
+        continue;
+      }
       for( int k = 0; k < shape.numCoeff; k++ )
       {
         for( int l = k; l < shape.numCoeff; l++ )
@@ -2420,6 +2451,21 @@ void EncAdaptiveLoopFilter::getBlkStats(AlfCovariance* alfCovariance, const AlfF
   }
 
   int numClasses = classifier ? MAX_NUM_ALF_CLASSES : 1;
+  if( intSums )
+  {
+    for( classIdx = 0; classIdx < numClasses; classIdx++ )
+    {
+      if( m_covNumBatched[classIdx] )
+      {
+        accumulateCovFeatures( alfCovariance[classIdx], classIdx, shape.numCoeff, numBins );
+      }
+      if( m_covNumSummed[classIdx] )
+      {
+        flushCovSums( alfCovariance[classIdx], classIdx, shape.numCoeff, numBins );
+      }
+    }
+  }
+
   for( classIdx = 0; classIdx < numClasses; classIdx++ )
   {
     for( int k = 1; k < shape.numCoeff; k++ )
@@ -2438,6 +2484,48 @@ void EncAdaptiveLoopFilter::getBlkStats(AlfCovariance* alfCovariance, const AlfF
   }
 }
 
+void EncAdaptiveLoopFilter::accumulateCovFeatures( AlfCovariance& alfCovariance, const int classIdx, const int numCoeff, const int numBins )
+{
+  const int numSamples = m_covNumBatched[classIdx];
+
+  if( m_covNumSummed[classIdx] + numSamples > m_covMaxSummed )
+  {
+    flushCovSums( alfCovariance, classIdx, numCoeff, numBins );
+  }
+
+  m_accumulateCovariance( &m_covFeatures[classIdx * m_covBatchSize * MaxAlfCovFeatures], numSamples, numCoeff * numBins + 1, numBins, &m_covSums[classIdx * MaxAlfCovFeatures * MaxAlfCovFeatures] );
+  m_covNumSummed[classIdx] += numSamples;
+  m_covNumBatched[classIdx] = 0;
+}
+
+void EncAdaptiveLoopFilter::flushCovSums( AlfCovariance& alfCovariance, const int classIdx, const int numCoeff, const int numBins )
+{
+  int*      sums = &m_covSums[classIdx * MaxAlfCovFeatures * MaxAlfCovFeatures];
+  const int yIdx = numCoeff * numBins;
+
+  for( int k = 0; k < numCoeff; k++ )
+  {
+    for( int l = k; l < numCoeff; l++ )
+    {
+      for( int b0 = 0; b0 < numBins; b0++ )
+      {
+        for( int b1 = 0; b1 < numBins; b1++ )
+        {
+          alfCovariance.E[b0][b1][k][l] += sums[( k * numBins + b0 ) * MaxAlfCovFeatures + l * numBins + b1];
+        }
+      }
+    }
+    for( int b = 0; b < numBins; b++ )
+    {
+      alfCovariance.y[b][k] += sums[( k * numBins + b ) * MaxAlfCovFeatures + yIdx];
+    }
+  }
+  alfCovariance.pixAcc += sums[yIdx * MaxAlfCovFeatures + yIdx];
+
+  std::fill_n( sums, ( yIdx + 1 ) * MaxAlfCovFeatures, 0 );
+  m_covNumSummed[classIdx] = 0;
+}
+
 void EncAdaptiveLoopFilter::calcCovariance(int ELocal[MAX_NUM_ALF_LUMA_COEFF][MaxAlfNumClippingValues], const Pel *rec, const int stride, const AlfFilterShape& shape, const int transposeIdx, const ChannelType channel, int vbDistance)
 {
   int clipTopRow = -4;
@@ -4153,6 +4241,9 @@ void EncAdaptiveLoopFilter::getBlkStatsCcAlf(AlfCovariance &alfCovariance, const
   }
 
   int ELocal[MAX_NUM_CC_ALF_CHROMA_COEFF][1];
+  const int numCoeff    = shape.numCoeff - 1;
+  const int numFeatures = numCoeff + 1;
+  const bool intSums    = !m_alfWSSD && m_covMaxSummed >= m_covBatchSize;
 
   for (int i = 0; i < compArea.height; i++)
   {
@@ -4170,6 +4261,22 @@ void EncAdaptiveLoopFilter::getBlkStatsCcAlf(AlfCovariance &alfCovariance, const
       int yLocal = org[j] - rec[compID][j];
 
       calcCovarianceCcAlf( ELocal, rec[COMPONENT_Y] + ( j << getComponentScaleX(compID, m_chromaFormat)), recStride[COMPONENT_Y], shape, vbDistance );
+      if( intSums )
+      {
+        int16_t* features = getCovFeatures( 0 );
+        for( int k = 0; k < numCoeff; k++ )
+        {
+          features[k] = ELocal[k][0];
+        }
+        features[numFeatures - 1] = yLocal;
+        std::fill( features + numFeatures, features + ( ( numFeatures + 7 ) & ~7 ), 0 );
+
+        if( ++m_covNumBatched[0] == m_covBatchSize )
+        {
+          accumulateCovFeatures( alfCovariance, 0, numCoeff, numBins );
+        }
+        continue;
+      }
 
       for( int k = 0; k < (shape.numCoeff - 1); k++ )
       {
@@ -4233,6 +4340,18 @@ void EncAdaptiveLoopFilter::getBlkStatsCcAlf(AlfCovariance &alfCovariance, const
     }
   }
 
+  if( intSums )
+  {
+    if( m_covNumBatched[0] )
+    {
+      accumulateCovFeatures( alfCovariance, 0, numCoeff, numBins );
+    }
+    if( m_covNumSummed[0] )
+    {
+      flushCovSums( alfCovariance, 0, numCoeff, numBins );
+    }
+  }
+
   for (int k = 1; k < (MAX_NUM_CC_ALF_CHROMA_COEFF - 1); k++)
   {
     for (int l = 0; l < k; l++)
@@ -269,6 +269,14 @@ private:
   int                    m_filterTmp[MAX_NUM_ALF_LUMA_COEFF];
   int                    m_clipTmp[MAX_NUM_ALF_LUMA_COEFF];
 
+  // integer statistics of the luma classes, summed in 32 bit and added to the double AlfCovariance before overflowing
+  static constexpr int   m_covBatchSize = 16;
+  std::vector<int16_t>   m_covFeatures;                              // [classIdx][batchIdx][featureIdx]
+  std::vector<int>       m_covSums;                                  // [classIdx][featureIdx][featureIdx]
+  int                    m_covNumBatched[MAX_NUM_ALF_CLASSES];
+  int                    m_covNumSummed[MAX_NUM_ALF_CLASSES];
+  int                    m_covMaxSummed;
+
 #if JVET_Q0795_CCALF
   int m_apsIdCcAlfStart[2];
 
@@ -330,6 +338,9 @@ private:
   void   deriveStatsForFiltering( PelUnitBuf& orgYuv, PelUnitBuf& recYuv, CodingStructure& cs );
   void   getBlkStats(AlfCovariance* alfCovariace, const AlfFilterShape& shape, AlfClassifier** classifier, Pel* org, const int orgStride, Pel* rec, const int recStride, const CompArea& areaDst, const CompArea& area, const ChannelType channel, int vbCTUHeight, int vbPos);
   void   calcCovariance(int ELocal[MAX_NUM_ALF_LUMA_COEFF][MaxAlfNumClippingValues], const Pel *rec, const int stride, const AlfFilterShape& shape, const int transposeIdx, const ChannelType channel, int vbDistance);
+  int16_t* getCovFeatures( const int classIdx ) { return &m_covFeatures[( classIdx * m_covBatchSize + m_covNumBatched[classIdx] ) * MaxAlfCovFeatures]; }
+  void   accumulateCovFeatures( AlfCovariance& alfCovariance, const int classIdx, const int numCoeff, const int numBins );
+  void   flushCovSums( AlfCovariance& alfCovariance, const int classIdx, const int numCoeff, const int numBins );
 #if JVET_Q0795_CCALF
   void   deriveStatsForCcAlfFiltering(const PelUnitBuf &orgYuv, const PelUnitBuf &recYuv, const int compIdx,
                                       const int maskStride, const uint8_t filterIdc, CodingStructure &cs);
@@ -3912,18 +3912,7 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
 
       if (B < 4) // image is too small to use WPSNR, resort to traditional PSNR
       {
-        uiTotalDiff = 0;
-        for (y = 0; y < H; y++)
-        {
-          for (x = 0; x < W; x++)
-          {
-            const           int64_t iDiff = (int64_t)pSrc0[x] - (int64_t)pSrc1[x];
-            uiTotalDiff += uint64_t(iDiff * iDiff);
-          }
-          pSrc0 += pic0.stride;
-          pSrc1 += pic1.stride;
-        }
-        return uiTotalDiff;
+        return m_pcEncLib->getRdCost()->getPlaneSSE(pic0, pic1);
       }
 
       double wmse = 0.0, sumAct = 0.0; // compute activity normalized SNR value
@@ -3960,17 +3949,7 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
   }
   else
   {
-    uiTotalDiff = 0;
-    for (int y = 0; y < pic0.height; y++)
-    {
-      for (int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
-        uiTotalDiff += uint64_t(iTemp * iTemp);
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
-    }
+    uiTotalDiff = m_pcEncLib->getRdCost()->getPlaneSSE(pic0, pic1);
   }
 
   return uiTotalDiff;
@@ -4010,19 +3989,7 @@ double EncGOP::xFindDistortionPlaneWPSNR(const CPelBuf& pic0, const CPelBuf& pic
   }
   else
   {
-    uiTotalDiffWPSNR = 0;
-    for (int y = 0; y < pic0.height; y++)
-    {
-      for (int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
-        double dW = m_pcEncLib->getRdCost()->getWPSNRLumaLevelWeight(pSrcLuma[x << getComponentScaleX(compID, chfmt)]);
-        uiTotalDiffWPSNR += dW * (double)iTemp * (double)iTemp;
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
-      pSrcLuma += picLuma0.stride << getComponentScaleY(compID, chfmt);
-    }
+    uiTotalDiffWPSNR = m_pcEncLib->getRdCost()->getPlaneWeightedSSE(pic0, pic1, picLuma0, getComponentScaleX(compID, chfmt), getComponentScaleY(compID, chfmt));
   }
 
   return uiTotalDiffWPSNR;
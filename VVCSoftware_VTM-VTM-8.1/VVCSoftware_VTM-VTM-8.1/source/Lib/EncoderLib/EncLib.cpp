@@ -43,6 +43,7 @@
 #include "CommonLib/Picture.h"
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/ChromaFormat.h"
+#include "CommonLib/TemporalFilterOps.h"
 #if ENABLE_SPLIT_PARALLELISM
 #include <omp.h>
 #endif
@@ -84,6 +85,12 @@ EncLib::EncLib( EncLibCommon* encLibCommon )
 #if ENABLE_SIMD_OPT_BUFFER
   g_pelBufOP.initPelBufOpsX86();
 #endif
+#if ENABLE_SIMD_OPT_INTRA
+  g_intraPredOP.initIntraPredOpsX86();
+#endif
+#if ENABLE_SIMD_OPT_MCTF
+  g_tempFilterOP.initTemporalFilterOpsX86();
+#endif
 
 #if JVET_O0756_CALCULATE_HDRMETRICS
   m_metricTime = std::chrono::milliseconds(0);
@@ -250,10 +250,18 @@ void EncSampleAdaptiveOffset::SAOProcess( CodingStructure& cs, bool* sliceEnable
 
 
 void EncSampleAdaptiveOffset::getPreDBFStatistics(CodingStructure& cs)
+{
+  for( uint32_t ctuRsAddr = 0; ctuRsAddr < cs.pcv->sizeInCtus; ctuRsAddr++ )
+  {
+    getPreDBFStatistics( cs, ctuRsAddr );
+  }
+}
+
+void EncSampleAdaptiveOffset::getPreDBFStatistics(CodingStructure& cs, const uint32_t ctuRsAddr)
 {
   PelUnitBuf org = cs.getOrgBuf();
   PelUnitBuf rec = cs.getRecoBuf();
-  getStatistics(m_preDBFstatData, org, rec, cs, true);
+  getCtuStatistics(m_preDBFstatData, org, rec, cs, ctuRsAddr, true);
 }
 
 void EncSampleAdaptiveOffset::addPreDBFStatistics(std::vector<SAOStatData**>& blkStats)
@@ -272,6 +280,14 @@ void EncSampleAdaptiveOffset::addPreDBFStatistics(std::vector<SAOStatData**>& bl
 }
 
 void EncSampleAdaptiveOffset::getStatistics(std::vector<SAOStatData**>& blkStats, PelUnitBuf& orgYuv, PelUnitBuf& srcYuv, CodingStructure& cs, bool isCalculatePreDeblockSamples)
+{
+  for( uint32_t ctuRsAddr = 0; ctuRsAddr < cs.pcv->sizeInCtus; ctuRsAddr++ )
+  {
+    getCtuStatistics( blkStats, orgYuv, srcYuv, cs, ctuRsAddr, isCalculatePreDeblockSamples );
+  }
+}
+
+void EncSampleAdaptiveOffset::getCtuStatistics(std::vector<SAOStatData**>& blkStats, PelUnitBuf& orgYuv, PelUnitBuf& srcYuv, CodingStructure& cs, const uint32_t ctuRsAddr, bool isCalculatePreDeblockSamples)
 {
   bool isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail;
 
@@ -285,60 +301,54 @@ void EncSampleAdaptiveOffset::getStatistics(std::vector<SAOStatData**>& blkStats
     m_signLineBuf2.resize(lineBufferSize);
   }
 
-  int ctuRsAddr = 0;
-  for( uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
-  {
-    for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
-    {
-      const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
-      const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
-      const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
-
-      deriveLoopFilterBoundaryAvailibility(cs, area.Y(), isLeftAvail, isAboveAvail, isAboveLeftAvail );
+  const uint32_t xPos   = ( ctuRsAddr % pcv.widthInCtus ) * pcv.maxCUWidth;
+  const uint32_t yPos   = ( ctuRsAddr / pcv.widthInCtus ) * pcv.maxCUHeight;
+  const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
+  const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
+  const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
 
-      //NOTE: The number of skipped lines during gathering CTU statistics depends on the slice boundary availabilities.
-      //For simplicity, here only picture boundaries are considered.
+  deriveLoopFilterBoundaryAvailibility(cs, area.Y(), isLeftAvail, isAboveAvail, isAboveLeftAvail );
 
-      isRightAvail      = (xPos + pcv.maxCUWidth  < pcv.lumaWidth );
-      isBelowAvail      = (yPos + pcv.maxCUHeight < pcv.lumaHeight);
-      isAboveRightAvail = ((yPos > 0) && (isRightAvail));
+  //NOTE: The number of skipped lines during gathering CTU statistics depends on the slice boundary availabilities.
+  //For simplicity, here only picture boundaries are considered.
 
-      int numHorVirBndry = 0, numVerVirBndry = 0;
-      int horVirBndryPos[] = { -1,-1,-1 };
-      int verVirBndryPos[] = { -1,-1,-1 };
-      int horVirBndryPosComp[] = { -1,-1,-1 };
-      int verVirBndryPosComp[] = { -1,-1,-1 };
-      bool isCtuCrossedByVirtualBoundaries = isCrossedByVirtualBoundaries(xPos, yPos, width, height, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, cs.picHeader );
+  isRightAvail      = (xPos + pcv.maxCUWidth  < pcv.lumaWidth );
+  isBelowAvail      = (yPos + pcv.maxCUHeight < pcv.lumaHeight);
+  isAboveRightAvail = ((yPos > 0) && (isRightAvail));
 
-      for(int compIdx = 0; compIdx < numberOfComponents; compIdx++)
-      {
-        const ComponentID compID = ComponentID(compIdx);
-        const CompArea& compArea = area.block( compID );
+  int numHorVirBndry = 0, numVerVirBndry = 0;
+  int horVirBndryPos[] = { -1,-1,-1 };
+  int verVirBndryPos[] = { -1,-1,-1 };
+  int horVirBndryPosComp[] = { -1,-1,-1 };
+  int verVirBndryPosComp[] = { -1,-1,-1 };
+  bool isCtuCrossedByVirtualBoundaries = isCrossedByVirtualBoundaries(xPos, yPos, width, height, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, cs.picHeader );
 
-        int  srcStride  = srcYuv.get(compID).stride;
-        Pel* srcBlk     = srcYuv.get(compID).bufAt( compArea );
+  for(int compIdx = 0; compIdx < numberOfComponents; compIdx++)
+  {
+    const ComponentID compID = ComponentID(compIdx);
+    const CompArea& compArea = area.block( compID );
 
-        int  orgStride  = orgYuv.get(compID).stride;
-        Pel* orgBlk     = orgYuv.get(compID).bufAt( compArea );
+    int  srcStride  = srcYuv.get(compID).stride;
+    Pel* srcBlk     = srcYuv.get(compID).bufAt( compArea );
 
-        for (int i = 0; i < numHorVirBndry; i++)
-        {
-          horVirBndryPosComp[i] = (horVirBndryPos[i] >> ::getComponentScaleY(compID, area.chromaFormat)) - compArea.y;
-        }
-        for (int i = 0; i < numVerVirBndry; i++)
-        {
-          verVirBndryPosComp[i] = (verVirBndryPos[i] >> ::getComponentScaleX(compID, area.chromaFormat)) - compArea.x;
-        }
+    int  orgStride  = orgYuv.get(compID).stride;
+    Pel* orgBlk     = orgYuv.get(compID).bufAt( compArea );
 
-        getBlkStats(compID, cs.sps->getBitDepth(toChannelType(compID)), blkStats[ctuRsAddr][compID]
-                  , srcBlk, orgBlk, srcStride, orgStride, compArea.width, compArea.height
-                  , isLeftAvail,  isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail
-                  , isCalculatePreDeblockSamples
-                  , isCtuCrossedByVirtualBoundaries, horVirBndryPosComp, verVirBndryPosComp, numHorVirBndry, numVerVirBndry
-                  );
-      }
-      ctuRsAddr++;
+    for (int i = 0; i < numHorVirBndry; i++)
+    {
+      horVirBndryPosComp[i] = (horVirBndryPos[i] >> ::getComponentScaleY(compID, area.chromaFormat)) - compArea.y;
     }
+    for (int i = 0; i < numVerVirBndry; i++)
+    {
+      verVirBndryPosComp[i] = (verVirBndryPos[i] >> ::getComponentScaleX(compID, area.chromaFormat)) - compArea.x;
+    }
+
+    getBlkStats(compID, cs.sps->getBitDepth(toChannelType(compID)), blkStats[ctuRsAddr][compID]
+              , srcBlk, orgBlk, srcStride, orgStride, compArea.width, compArea.height
+              , isLeftAvail,  isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail
+              , isCalculatePreDeblockSamples
+              , isCtuCrossedByVirtualBoundaries, horVirBndryPosComp, verVirBndryPosComp, numHorVirBndry, numVerVirBndry
+              );
   }
 }
 
@@ -1129,6 +1139,14 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
                         , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
                         )
 {
+  if (!isCtuCrossedByVirtualBoundaries)
+  {
+    getBlkStatsNoVirtualBoundaries(compIdx, channelBitDepth, statsDataTypes, srcBlk, orgBlk, srcStride, orgStride, width, height
+                                 , isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail
+                                 , isCalculatePreDeblockSamples);
+    return;
+  }
+
   int x,y, startX, startY, endX, endY, edgeType, firstLineStartX, firstLineEndX;
   int8_t signLeft, signRight, signDown;
   int64_t *diff, *count;
@@ -1538,6 +1556,109 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
   }
 }
 
+// Same sample ranges as getBlkStats, without virtual boundaries the edge class of every sample only depends on its two
+// neighbours, so each range is collected with a single call of the statistics kernels instead of the sign line buffers.
+// The SAO types keep separate passes: their ranges differ, and the CTU block stays in the cache between the passes.
+void EncSampleAdaptiveOffset::getBlkStatsNoVirtualBoundaries(const ComponentID compIdx, const int channelBitDepth, SAOStatData* statsDataTypes
+                        , Pel* srcBlk, Pel* orgBlk, int srcStride, int orgStride, int width, int height
+                        , bool isLeftAvail,  bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail
+                        , bool isCalculatePreDeblockSamples
+                        )
+{
+  const int* skipLinesR = m_skipLinesR[compIdx];
+  const int* skipLinesB = m_skipLinesB[compIdx];
+
+  // range of the lines below the CTU statistics, which are only collected from the pre-deblocking samples
+  const int skipLineStartX = isLeftAvail  ? 0     : 1;
+  const int skipLineEndX   = isRightAvail ? width : (width - 1);
+
+  for(int typeIdx=0; typeIdx< NUM_SAO_NEW_TYPES; typeIdx++)
+  {
+    SAOStatData& statsData= statsDataTypes[typeIdx];
+    statsData.reset();
+
+    const int skipR = skipLinesR[typeIdx];
+    const int skipB = skipLinesB[typeIdx];
+    int64_t* diff   = statsData.diff  + 2;
+    int64_t* count  = statsData.count + 2;
+
+    switch(typeIdx)
+    {
+    case SAO_TYPE_EO_0:
+      {
+        const int endY   = isBelowAvail ? (height - skipB) : height;
+        const int startX = (!isCalculatePreDeblockSamples) ? skipLineStartX : (isRightAvail ? (width - skipR) : (width - 1));
+        const int endX   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipR) : (width - 1)) : skipLineEndX;
+
+        m_calcEdgeStats(srcBlk, srcStride, orgBlk, orgStride, startX, endX, endY, -1, 1, diff, count);
+        if (isCalculatePreDeblockSamples && isBelowAvail)
+        {
+          m_calcEdgeStats(srcBlk + endY * srcStride, srcStride, orgBlk + endY * orgStride, orgStride, skipLineStartX, skipLineEndX, skipB, -1, 1, diff, count);
+        }
+      }
+      break;
+    case SAO_TYPE_EO_90:
+      {
+        const int startY = isAboveAvail ? 0 : 1;
+        const int endY   = isBelowAvail ? (height - skipB) : (height - 1);
+        const int startX = (!isCalculatePreDeblockSamples) ? 0 : (isRightAvail ? (width - skipR) : width);
+        const int endX   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipR) : width) : width;
+
+        m_calcEdgeStats(srcBlk + startY * srcStride, srcStride, orgBlk + startY * orgStride, orgStride, startX, endX, endY - startY, -srcStride, srcStride, diff, count);
+        if (isCalculatePreDeblockSamples && isBelowAvail)
+        {
+          m_calcEdgeStats(srcBlk + endY * srcStride, srcStride, orgBlk + endY * orgStride, orgStride, 0, width, skipB, -srcStride, srcStride, diff, count);
+        }
+      }
+      break;
+    case SAO_TYPE_EO_135:
+    case SAO_TYPE_EO_45:
+      {
+        const bool      is135  = typeIdx == SAO_TYPE_EO_135;
+        const ptrdiff_t offA   = is135 ? -srcStride - 1 : -srcStride + 1;
+        const ptrdiff_t offB   = is135 ?  srcStride + 1 :  srcStride - 1;
+        const int endY         = isBelowAvail ? (height - skipB) : (height - 1);
+        const int startX       = (!isCalculatePreDeblockSamples) ? skipLineStartX : (isRightAvail ? (width - skipR) : (width - 1));
+        const int endX         = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipR) : (width - 1)) : skipLineEndX;
+        int firstLineStartX    = startX;
+        int firstLineEndX      = endX;
+        if (!isCalculatePreDeblockSamples)
+        {
+          firstLineStartX = is135 ? (isAboveLeftAvail ? 0 : 1) : (isAboveAvail ? startX : endX);
+          firstLineEndX   = is135 ? (isAboveAvail ? endX : 1) : ((!isRightAvail && isAboveRightAvail) ? width : endX);
+        }
+
+        m_calcEdgeStats(srcBlk, srcStride, orgBlk, orgStride, firstLineStartX, firstLineEndX, 1, offA, offB, diff, count);
+        m_calcEdgeStats(srcBlk + srcStride, srcStride, orgBlk + orgStride, orgStride, startX, endX, endY - 1, offA, offB, diff, count);
+        if (isCalculatePreDeblockSamples && isBelowAvail)
+        {
+          const int skipLineY = std::max(endY, 1);
+          m_calcEdgeStats(srcBlk + skipLineY * srcStride, srcStride, orgBlk + skipLineY * orgStride, orgStride, skipLineStartX, skipLineEndX, skipB, offA, offB, diff, count);
+        }
+      }
+      break;
+    case SAO_TYPE_BO:
+      {
+        const int endY      = isBelowAvail ? (height - skipB) : height;
+        const int startX    = (!isCalculatePreDeblockSamples) ? 0 : (isRightAvail ? (width - skipR) : width);
+        const int endX      = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipR) : width) : width;
+        const int shiftBits = channelBitDepth - NUM_SAO_BO_CLASSES_LOG2;
+
+        m_calcBandStats(srcBlk, srcStride, orgBlk, orgStride, startX, endX, endY, shiftBits, statsData.diff, statsData.count);
+        if (isCalculatePreDeblockSamples && isBelowAvail)
+        {
+          m_calcBandStats(srcBlk + endY * srcStride, srcStride, orgBlk + endY * orgStride, orgStride, 0, width, skipB, shiftBits, statsData.diff, statsData.count);
+        }
+      }
+      break;
+    default:
+      {
+        THROW("Not a supported SAO type");
+      }
+    }
+  }
+}
+
 void EncSampleAdaptiveOffset::deriveLoopFilterBoundaryAvailibility(CodingStructure& cs, const Position &pos, bool& isLeftAvail, bool& isAboveAvail, bool& isAboveLeftAvail) const
 {
   bool isLoopFiltAcrossSlicePPS = cs.pps->getLoopFilterAcrossSlicesEnabledFlag();
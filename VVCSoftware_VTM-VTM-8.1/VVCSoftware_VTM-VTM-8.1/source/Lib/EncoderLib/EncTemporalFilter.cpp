@@ -36,6 +36,7 @@
 */
 
 #include "EncTemporalFilter.h"
+#include "CommonLib/TemporalFilterOps.h"
 #include <math.h>
 
 
@@ -279,82 +280,23 @@ int EncTemporalFilter::motionErrorLuma(const PelStorage &orig,
   const Pel *buffOrigin = buffer.Y().buf;
   const int buffStride  = buffer.Y().stride;
 
-  int error = 0;// dx * 10 + dy * 10;
   if (((dx | dy) & 0xF) == 0)
   {
     dx /= m_motionVectorFactor;
     dy /= m_motionVectorFactor;
-    for (int y1 = 0; y1 < bs; y1++)
-    {
-      const Pel* origRowStart = origOrigin + (y+y1)*origStride + x;
-      const Pel* bufferRowStart = buffOrigin + (y+y1+dy)*buffStride + (x+dx);
-      for (int x1 = 0; x1 < bs; x1 += 2)
-      {
-        int diff = origRowStart[x1] - bufferRowStart[x1];
-        error += diff * diff;
-        diff = origRowStart[x1 + 1] - bufferRowStart[x1 + 1];
-        error += diff * diff;
-      }
-      if (error > besterror)
-      {
-        return error;
-      }
-    }
+    return g_tempFilterOP.blockSSE(origOrigin + y*origStride + x, origStride, buffOrigin + (y+dy)*buffStride + (x+dx), buffStride, bs, bs, besterror);
   }
   else
   {
     const int *xFilter = m_interpolationFilter[dx & 0xF];
     const int *yFilter = m_interpolationFilter[dy & 0xF];
-    int tempArray[64 + 8][64];
-
-    int sum, base;
-    for (int y1 = 1; y1 < bs + 7; y1++)
-    {
-      const int yOffset = y + y1 + (dy >> 4) - 3;
-      const Pel *sourceRow = buffOrigin + (yOffset)*buffStride + 0;
-      for (int x1 = 0; x1 < bs; x1++)
-      {
-        sum = 0;
-        base = x + x1 + (dx >> 4) - 3;
-        const Pel *rowStart = sourceRow + base;
-
-        sum += xFilter[1] * rowStart[1];
-        sum += xFilter[2] * rowStart[2];
-        sum += xFilter[3] * rowStart[3];
-        sum += xFilter[4] * rowStart[4];
-        sum += xFilter[5] * rowStart[5];
-        sum += xFilter[6] * rowStart[6];
-
-        tempArray[y1][x1] = sum;
-      }
-    }
+    Pel tempBlock[64 * 64];
 
     const Pel maxSampleValue = (1<<m_internalBitDepth[CHANNEL_TYPE_LUMA])-1;
-    for (int y1 = 0; y1 < bs; y1++)
-    {
-      const Pel *origRow = origOrigin + (y+y1)*origStride + 0;
-      for (int x1 = 0; x1 < bs; x1++)
-      {
-        sum = 0;
-        sum += yFilter[1] * tempArray[y1 + 1][x1];
-        sum += yFilter[2] * tempArray[y1 + 2][x1];
-        sum += yFilter[3] * tempArray[y1 + 3][x1];
-        sum += yFilter[4] * tempArray[y1 + 4][x1];
-        sum += yFilter[5] * tempArray[y1 + 5][x1];
-        sum += yFilter[6] * tempArray[y1 + 6][x1];
-
-        sum = (sum + (1 << 11)) >> 12;
-        sum = sum < 0 ? 0 : (sum > maxSampleValue ? maxSampleValue : sum);
-
-        error += (sum - origRow[x + x1]) * (sum - origRow[x + x1]);
-      }
-      if (error > besterror)
-      {
-        return error;
-      }
-    }
+    g_tempFilterOP.interpolate(buffOrigin + (y + (dy >> 4))*buffStride + (x + (dx >> 4)), buffStride, tempBlock, bs, bs, bs, xFilter, yFilter, maxSampleValue);
+
+    return g_tempFilterOP.blockSSE(origOrigin + y*origStride + x, origStride, tempBlock, bs, bs, bs, besterror);
   }
-  return error;
 }
 
 void EncTemporalFilter::motionEstimationLuma(Array2D<MotionVector> &mvs, const PelStorage &orig, const PelStorage &buffer, const int blockSize,
@@ -501,52 +443,8 @@ void EncTemporalFilter::applyMotion(const Array2D<MotionVector> &mvs, const PelS
 
         const int *xFilter = m_interpolationFilter[dx & 0xf];
         const int *yFilter = m_interpolationFilter[dy & 0xf]; // will add 6 bit.
-        const int numFilterTaps=7;
-        const int centreTapOffset=3;
 
-        int tempArray[lumaBlockSize + numFilterTaps][lumaBlockSize];
-
-        for (int by = 1; by < blockSizeY + numFilterTaps; by++)
-        {
-          const int yOffset = y + by + yInt - centreTapOffset;
-          const Pel *sourceRow = srcImage+yOffset*srcStride;
-          for (int bx = 0; bx < blockSizeX; bx++)
-          {
-            int base = x + bx + xInt - centreTapOffset;
-            const Pel *rowStart = sourceRow + base;
-
-            int sum = 0;
-            sum += xFilter[1] * rowStart[1];
-            sum += xFilter[2] * rowStart[2];
-            sum += xFilter[3] * rowStart[3];
-            sum += xFilter[4] * rowStart[4];
-            sum += xFilter[5] * rowStart[5];
-            sum += xFilter[6] * rowStart[6];
-
-            tempArray[by][bx] = sum;
-          }
-        }
-
-        Pel *dstRow = dstImage+y*dstStride;
-        for (int by = 0; by < blockSizeY; by++, dstRow+=dstStride)
-        {
-          Pel *dstPel=dstRow+x;
-          for (int bx = 0; bx < blockSizeX; bx++, dstPel++)
-          {
-            int sum = 0;
-
-            sum += yFilter[1] * tempArray[by + 1][bx];
-            sum += yFilter[2] * tempArray[by + 2][bx];
-            sum += yFilter[3] * tempArray[by + 3][bx];
-            sum += yFilter[4] * tempArray[by + 4][bx];
-            sum += yFilter[5] * tempArray[by + 5][bx];
-            sum += yFilter[6] * tempArray[by + 6][bx];
-
-            sum = (sum + (1 << 11)) >> 12;
-            sum = sum < 0 ? 0 : (sum > maxValue ? maxValue : sum);
-            *dstPel = sum;
-          }
-        }
+        g_tempFilterOP.interpolate(srcImage + (y + yInt)*srcStride + (x + xInt), srcStride, dstImage + y*dstStride + x, dstStride, blockSizeX, blockSizeY, xFilter, yFilter, maxValue);
       }
     }
   }
@@ -592,32 +490,31 @@ void EncTemporalFilter::bilateralFilter(const PelStorage &orgPic,
     const Pel maxSampleValue = (1<<m_internalBitDepth[toChannelType(compID)])-1;
     const double bitDepthDiffWeighting=1024.0 / (maxSampleValue+1);
 
+    // the weight only depends on the sample difference, so it is tabulated for all differences of each reference
+    std::vector<double> weightTable(numRefs * (2 * maxSampleValue + 1));
+    std::vector<const double*> weightLUTs(numRefs);
+    for (int i = 0; i < numRefs; i++)
+    {
+      double *lut = &weightTable[i * (2 * maxSampleValue + 1) + maxSampleValue];
+      const int index = std::min(1, std::abs(srcFrameInfo[i].origOffset) - 1);
+      for (int d = -maxSampleValue; d <= maxSampleValue; d++)
+      {
+        double diff = (double)d;
+        diff *= bitDepthDiffWeighting;
+        double diffSq = diff * diff;
+        lut[d] = weightScaling * m_refStrengths[refStrengthRow][index] * exp(-diffSq / (2 * sigmaSq));
+      }
+      weightLUTs[i] = lut;
+    }
+
+    std::vector<const Pel*> correctedRows(numRefs);
     for (int y = 0; y < height; y++, srcPelRow+=srcStride, dstPelRow+=dstStride)
     {
-      const Pel *srcPel=srcPelRow;
-      Pel *dstPel=dstPelRow;
-      for (int x = 0; x < width; x++, srcPel++, dstPel++)
+      for (int i = 0; i < numRefs; i++)
       {
-        const int orgVal = (int) *srcPel;
-        double temporalWeightSum = 1.0;
-        double newVal = (double) orgVal;
-        for (int i = 0; i < numRefs; i++)
-        {
-          const Pel *pCorrectedPelPtr=correctedPics[i].bufs[c].buf+(y*correctedPics[i].bufs[c].stride+x);
-          const int refVal = (int) *pCorrectedPelPtr;
-          double diff = (double)(refVal - orgVal);
-          diff *= bitDepthDiffWeighting;
-          double diffSq = diff * diff;
-          const int index = std::min(1, std::abs(srcFrameInfo[i].origOffset) - 1);
-          const double weight = weightScaling * m_refStrengths[refStrengthRow][index] * exp(-diffSq / (2 * sigmaSq));
-          newVal += weight * refVal;
-          temporalWeightSum += weight;
-        }
-        newVal /= temporalWeightSum;
-        Pel sampleVal = (Pel)round(newVal);
-        sampleVal=(sampleVal<0?0 : (sampleVal>maxSampleValue ? maxSampleValue : sampleVal));
-        *dstPel = sampleVal;
+        correctedRows[i] = correctedPics[i].bufs[c].buf + y*correctedPics[i].bufs[c].stride;
       }
+      g_tempFilterOP.bilateralRow(srcPelRow, correctedRows.data(), weightLUTs.data(), numRefs, dstPelRow, width, maxSampleValue);
     }
   }
 }
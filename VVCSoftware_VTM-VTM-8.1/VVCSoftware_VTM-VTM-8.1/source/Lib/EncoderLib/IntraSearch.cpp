@@ -68,6 +68,7 @@ IntraSearch::IntraSearch()
   {
     m_pSharedPredTransformSkip[ch] = nullptr;
   }
+  m_mipPredAllModes = nullptr;
   m_truncBinBits = nullptr;
   m_escapeNumBins = nullptr;
   m_minErrorIndexMap = nullptr;
@@ -159,6 +160,8 @@ void IntraSearch::destroy()
     delete[] m_pSharedPredTransformSkip[ch];
     m_pSharedPredTransformSkip[ch] = nullptr;
   }
+  delete[] m_mipPredAllModes;
+  m_mipPredAllModes = nullptr;
 
   m_tmpStorageLCU.destroy();
   m_colorTransResiBuf.destroy();
@@ -239,6 +242,7 @@ void IntraSearch::init( EncCfg*        pcEncCfg,
   {
     m_pSharedPredTransformSkip[ch] = new Pel[MAX_CU_SIZE * MAX_CU_SIZE];
   }
+  m_mipPredAllModes = new Pel[MAX_NUM_MIP_MODE * MIP_MAX_WIDTH * MIP_MAX_HEIGHT];
 
   uint32_t numWidths  = gp_sizeIdxInfo->numWidths();
   uint32_t numHeights = gp_sizeIdxInfo->numHeights();
@@ -766,6 +770,7 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
 
               initIntraPatternChType(cu, pu.Y());
               initIntraMip(pu, pu.Y());
+              predIntraMipAllModes(COMPONENT_Y, m_mipPredAllModes, pu);
 
               const int transpOff    = getNumModesMip(pu.Y());
               const int numModesFull = (transpOff << 1);
@@ -776,7 +781,9 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
 
                 pu.mipTransposedFlag           = isTransposed;
                 pu.intraDir[CHANNEL_TYPE_LUMA] = uiMode;
-                predIntraMip(COMPONENT_Y, piPred, pu);
+                // the costs are measured directly on the prediction of the mode in the all modes buffer
+                distParamSad.cur = CPelBuf(m_mipPredAllModes + uiModeFull * pu.Y().area(), pu.Y());
+                distParamHad.cur = distParamSad.cur;
 
                 // Use the min between SAD and HAD as the cost criterion
                 // SAD is scaled by 2 to align with the scaling of HAD
@@ -797,6 +804,8 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
                 updateCandList(ModeInfo(true, isTransposed, 0, NOT_INTRA_SUBPARTITIONS, uiMode),
                                0.8 * double(minSadHad), uiHadModeList, CandHadList, numHadCand);
               }
+              distParamSad.cur = piPred;
+              distParamHad.cur = piPred;
 
               const double thresholdHadCost = 1.0 + 1.4 / sqrt((double) (pu.lwidth() * pu.lheight()));
               reduceHadCandList(uiRdModeList, CandCostList, numModesForFullRD, thresholdHadCost, mipHadCost, pu,
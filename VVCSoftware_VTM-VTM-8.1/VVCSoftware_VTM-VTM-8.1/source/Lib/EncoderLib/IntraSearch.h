@@ -269,6 +269,7 @@ class IntraSearch : public IntraPrediction
 private:
   EncModeCtrl    *m_modeCtrl;
   Pel*            m_pSharedPredTransformSkip[MAX_NUM_TBLOCKS];
+  Pel*            m_mipPredAllModes;
 
   XUCache         m_unitCache;
 
@@ -68,39 +68,12 @@ using namespace std;
  */
 static void scalePlane( PelBuf& areaBuf, const int shiftbits, const Pel minval, const Pel maxval)
 {
-  const unsigned width  = areaBuf.width;
-  const unsigned height = areaBuf.height;
-  const unsigned stride = areaBuf.stride;
-        Pel*        img = areaBuf.bufAt(0,0);
-
   if( 0 == shiftbits )
   {
     return;
   }
 
-  if( shiftbits > 0)
-  {
-    for( unsigned y = 0; y < height; y++, img+=stride)
-    {
-      for( unsigned x = 0; x < width; x++)
-      {
-        img[x] <<= shiftbits;
-      }
-    }
-  }
-  else if (shiftbits < 0)
-  {
-    const int shiftbitsr =- shiftbits;
-    const Pel rounding = 1 << (shiftbitsr-1);
-
-    for( unsigned y = 0; y < height; y++, img+=stride)
-    {
-      for( unsigned x = 0; x < width; x++)
-      {
-        img[x] = Clip3(minval, maxval, Pel((img[x] + rounding) >> shiftbitsr));
-      }
-    }
-  }
+  g_pelBufOP.scaleSamples( areaBuf.bufAt( 0, 0 ), areaBuf.stride, areaBuf.width, areaBuf.height, shiftbits, minval, maxval );
 }
 
 
@@ -336,44 +309,11 @@ static bool readPlane(Pel* dst,
       if ((y444&mask_y_dest)==0)
       {
         // process current destination line
-        if (csx_file < csx_dest)
-        {
-          // eg file is 444, dest is 422.
-          const uint32_t sx=csx_dest-csx_file;
-          if (!is16bit)
-          {
-            for (uint32_t x = 0; x < width_dest; x++)
-            {
-              pDstBuf[x] = buf[x<<sx];
-            }
-          }
-          else
-          {
-            for (uint32_t x = 0; x < width_dest; x++)
-            {
-              pDstBuf[x] = Pel(buf[(x<<sx)*2+0]) | (Pel(buf[(x<<sx)*2+1])<<8);
-            }
-          }
-        }
-        else
-        {
-          // eg file is 422, dest is 444.
-          const uint32_t sx=csx_file-csx_dest;
-          if (!is16bit)
-          {
-            for (uint32_t x = 0; x < width_dest; x++)
-            {
-              pDstBuf[x] = buf[x>>sx];
-            }
-          }
-          else
-          {
-            for (uint32_t x = 0; x < width_dest; x++)
-            {
-              pDstBuf[x] = Pel(buf[(x>>sx)*2+0]) | (Pel(buf[(x>>sx)*2+1])<<8);
-            }
-          }
-        }
+        // eg file is 444, dest is 422: subsample by 1<<sxDown
+        // eg file is 422, dest is 444: replicate by 1<<sxUp
+        const int sxDown = csx_file < csx_dest ? csx_dest - csx_file : 0;
+        const int sxUp   = csx_file < csx_dest ? 0 : csx_file - csx_dest;
+        g_pelBufOP.unpackSamples( buf, pDstBuf, width_dest, is16bit, sxDown, sxUp );
 
         // process right hand side padding
         const Pel val=dst[width_dest-1];
@@ -451,6 +391,9 @@ static bool verifyPlane(Pel* dst,
  * @param srcFormat    chroma format of image
  * @param fileFormat   chroma format of file
  * @param fileBitDepth component bit depth in file
+ * @param shiftbits    bit depth scaling applied while writing, see scalePlane()
+ * @param minval       minimum clipping value when dividing.
+ * @param maxval       maximum clipping value when dividing.
  * @return true for success, false in case of error
  */
 static bool writePlane( uint32_t orgWidth, uint32_t orgHeight, ostream& fd, const Pel* src,
@@ -461,6 +404,7 @@ static bool writePlane( uint32_t orgWidth, uint32_t orgHeight, ostream& fd, cons
                        const ChromaFormat srcFormat,
                        const ChromaFormat fileFormat,
                        const uint32_t fileBitDepth,
+                       const int shiftbits, const Pel minval, const Pel maxval,
                        const uint32_t packedYUVOutputMode = 0)
 {
   const uint32_t csx_file =getComponentScaleX(compID, fileFormat);
@@ -618,47 +562,8 @@ static bool writePlane( uint32_t orgWidth, uint32_t orgHeight, ostream& fd, cons
     {
       if ((y444 & mask_y_file) == 0)
       {
-        // write a new line
-        if (csx_file < csx_src)
-        {
-          // eg file is 444, source is 422.
-          const uint32_t sx = csx_src - csx_file;
-          if (!is16bit)
-          {
-            for (uint32_t x = 0; x < width_file; x++)
-            {
-              buf[x] = (uint8_t)(pSrcBuf[x>>sx]);
-            }
-          }
-          else
-          {
-            for (uint32_t x = 0; x < width_file; x++)
-            {
-              buf[2*x  ] = (pSrcBuf[x>>sx]>>0) & 0xff;
-              buf[2*x+1] = (pSrcBuf[x>>sx]>>8) & 0xff;
-            }
-          }
-        }
-        else
-        {
-          // eg file is 422, source is 444.
-          const uint32_t sx = csx_file - csx_src;
-          if (!is16bit)
-          {
-            for (uint32_t x = 0; x < width_file; x++)
-            {
-              buf[x] = (uint8_t)(pSrcBuf[x<<sx]);
-            }
-          }
-          else
-          {
-            for (uint32_t x = 0; x < width_file; x++)
-            {
-              buf[2*x  ] = (pSrcBuf[x<<sx]>>0) & 0xff;
-              buf[2*x+1] = (pSrcBuf[x<<sx]>>8) & 0xff;
-            }
-          }
-        }
+        // write a new line, the file and source chroma formats are the same (see check above)
+        g_pelBufOP.packSamples( pSrcBuf, buf, width_file, is16bit, shiftbits, minval, maxval );
 
         fd.write (reinterpret_cast<const char*>(buf), stride_file);
         if (fd.eof() || fd.fail())
@@ -994,7 +899,6 @@ bool VideoIOYuv::write( uint32_t orgWidth, uint32_t orgHeight, const CPelUnitBuf
 
   // compute actual YUV frame size excluding padding size
   bool is16bit = false;
-  bool nonZeroBitDepthShift=false;
 
   for(uint32_t ch=0; ch<MAX_NUM_CHANNEL_TYPE; ch++)
   {
@@ -1002,10 +906,6 @@ bool VideoIOYuv::write( uint32_t orgWidth, uint32_t orgHeight, const CPelUnitBuf
     {
       is16bit=true;
     }
-    if (m_bitdepthShift[ch] != 0)
-    {
-      nonZeroBitDepthShift=true;
-    }
   }
 
   bool retval = true;
@@ -1014,27 +914,7 @@ bool VideoIOYuv::write( uint32_t orgWidth, uint32_t orgHeight, const CPelUnitBuf
     format= picC.chromaFormat;
   }
 
-  PelStorage picZ;
-  if (nonZeroBitDepthShift)
-  {
-    picZ.create( picC.chromaFormat, Area( Position(), picC.Y() ) );
-    picZ.copyFrom( picC );
-
-    for(uint32_t comp=0; comp < ::getNumberValidComponents( picZ.chromaFormat ); comp++)
-    {
-      const ComponentID compID=ComponentID(comp);
-      const ChannelType ch=toChannelType(compID);
-      const bool b709Compliance = bClipToRec709 && (-m_bitdepthShift[ch] < 0 && m_MSBExtendedBitDepth[ch] >= 8);     /* ITU-R BT.709 compliant clipping for converting say 10b to 8b */
-      const Pel minval = b709Compliance? ((   1 << (m_MSBExtendedBitDepth[ch] - 8))   ) : 0;
-      const Pel maxval = b709Compliance? ((0xff << (m_MSBExtendedBitDepth[ch] - 8)) -1) : (1 << m_MSBExtendedBitDepth[ch]) - 1;
-
-      scalePlane( picZ.get(compID), -m_bitdepthShift[ch], minval, maxval);
-    }
-  }
-
-  const CPelUnitBuf& picO = nonZeroBitDepthShift ? picZ : picC;
-
-  const CPelBuf areaY     = picO.get(COMPONENT_Y);
+  const CPelBuf areaY     = picC.get(COMPONENT_Y);
   const uint32_t    width444  = areaY.width - confLeft - confRight;
   const uint32_t    height444 = areaY.height -  confTop  - confBottom;
 
@@ -1055,11 +935,15 @@ bool VideoIOYuv::write( uint32_t orgWidth, uint32_t orgHeight, const CPelUnitBuf
     const ChannelType ch          = toChannelType(compID);
     const uint32_t    csx         = ::getComponentScaleX(compID, format);
     const uint32_t    csy         = ::getComponentScaleY(compID, format);
-    const CPelBuf     area        = picO.get(compID);
+    const CPelBuf     area        = picC.get(compID);
     const int         planeOffset = (confLeft >> csx) + (confTop >> csy) * area.stride;
+    // the bit depth scaling is done by writePlane() while packing the samples
+    const bool b709Compliance = bClipToRec709 && (-m_bitdepthShift[ch] < 0 && m_MSBExtendedBitDepth[ch] >= 8);     /* ITU-R BT.709 compliant clipping for converting say 10b to 8b */
+    const Pel minval = b709Compliance? ((   1 << (m_MSBExtendedBitDepth[ch] - 8))   ) : 0;
+    const Pel maxval = b709Compliance? ((0xff << (m_MSBExtendedBitDepth[ch] - 8)) -1) : (1 << m_MSBExtendedBitDepth[ch]) - 1;
     if( !writePlane( orgWidth, orgHeight, m_cHandle, area.bufAt( 0, 0 ) + planeOffset, is16bit, area.stride,
-                     width444, height444, compID, picO.chromaFormat, format, m_fileBitdepth[ch],
-                     bPackedYUVOutputMode ? 1 : 0))
+                     width444, height444, compID, picC.chromaFormat, format, m_fileBitdepth[ch],
+                     -m_bitdepthShift[ch], minval, maxval, bPackedYUVOutputMode ? 1 : 0))
     {
       retval = false;
     }